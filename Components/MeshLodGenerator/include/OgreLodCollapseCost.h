@@ -44,9 +44,13 @@ namespace Ogre
 class _OgreLodExport LodCollapseCost {
 public:
     virtual ~LodCollapseCost() {}
-    /// This is called after the LodInputProvider has initialized LodData.
+    /** This is called after the LodInputProvider has initialized LodData.
+
+        It calls computeVertexCollapseCost for many vertices in parallel, which may only modify the edges
+        of the vertex it was called for.
+    */
     virtual void initCollapseCosts(LodData* data);
-    /// Called from initCollapseCosts for every edge.
+    /// Computes the cost of a vertex, which is not in the collapse cost heap yet, and adds it to the heap.
     virtual void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
     /// Called when edge cost gets invalid.
     virtual void updateVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
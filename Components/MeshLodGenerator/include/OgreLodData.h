@@ -64,7 +64,7 @@ struct _OgreLodExport LodData {
     typedef std::vector<Vertex> VertexList;
     typedef std::vector<Triangle> TriangleList;
     typedef std::unordered_set<Vertex*, VertexHash, VertexEqual> UniqueVertexSet;
-    typedef std::multimap<Real, Vertex*> CollapseCostHeap;
+    class CollapseCostHeap;
 
     typedef VectorSet<Edge, 8> VEdges;
     typedef VectorSet<Triangle*, 7> VTriangles;
@@ -104,7 +104,7 @@ struct _OgreLodExport LodData {
         
         Vertex* collapseTo;
         bool seam;
-        CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+        size_t costHeapPosition; /// Index of the vertex in mCollapseCostHeap, which allows fast update and remove.
 
         void addEdge(const Edge& edge);
         void removeEdge(const Edge& edge);
@@ -131,6 +131,56 @@ struct _OgreLodExport LodData {
         bool isMalformed();
     };
 
+    /** Indexed binary min-heap of vertices ordered by their collapse cost.
+
+        Every vertex stores its own position in the heap, so changing or removing its cost
+        does not need a search and does not allocate.
+    */
+    class _OgreLodExport CollapseCostHeap {
+    public:
+        struct Entry {
+            Real cost;
+            Vertex* vertex;
+        };
+        typedef std::vector<Entry> EntryList;
+        /// Iterates the entries in heap order, not in cost order.
+        typedef EntryList::const_iterator const_iterator;
+
+        /// Value of Vertex::costHeapPosition for vertices, which are not in the heap.
+        static const size_t NOT_IN_HEAP = ~size_t(0);
+
+        bool empty() const { return mEntries.empty(); }
+        size_t size() const { return mEntries.size(); }
+        void reserve(size_t count) { mEntries.reserve(count); }
+        /// Doesn't touch the vertices, because they may already be freed.
+        void clear() { mEntries.clear(); }
+        const_iterator begin() const { return mEntries.begin(); }
+        const_iterator end() const { return mEntries.end(); }
+
+        /// The vertex with the smallest collapse cost.
+        const Entry& top() const { return mEntries.front(); }
+        Real getCost(const Vertex* vertex) const;
+        void push(Vertex* vertex, Real cost);
+        void update(Vertex* vertex, Real cost);
+        void erase(Vertex* vertex);
+
+        /** Adds a vertex without restoring the heap order.
+
+            Call rebuild() after all vertices were added. This is faster than calling push()
+            for every vertex, when the heap is filled for the first time.
+        */
+        void pushUnordered(Vertex* vertex, Real cost);
+        /// Restores the heap order after pushUnordered().
+        void rebuild();
+    private:
+        EntryList mEntries;
+
+        static bool isLess(const Entry& a, const Entry& b);
+        void place(size_t pos, const Entry& entry);
+        void siftUp(size_t pos);
+        void siftDown(size_t pos);
+    };
+
     union IndexBufferPointer {
         unsigned short* pshort;
         unsigned int* pint;
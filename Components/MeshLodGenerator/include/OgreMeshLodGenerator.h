@@ -70,6 +70,16 @@ public:
      */
     virtual void generateLodLevels(LodConfig& lodConfig, LodCollapseCostPtr cost = LodCollapseCostPtr(), LodDataPtr data = LodDataPtr(), LodInputProviderPtr input = LodInputProviderPtr(), LodOutputProviderPtr output = LodOutputProviderPtr(), LodCollapserPtr collapser = LodCollapserPtr());
 
+    /**
+     * @brief Generates the Lod levels for many meshes concurrently.
+     *
+     * Every mesh is reduced on its own thread and the results are injected on the calling thread
+     * before the function returns. The meshes must be different. useBackgroundQueue is ignored.
+     *
+     * @param lodConfigs Specification of the requested Lod levels for every mesh.
+     */
+    void generateLodLevels(std::vector<LodConfig>& lodConfigs);
+
     /**
      * @brief Generates the Lod levels for a mesh without configuring it.
      *
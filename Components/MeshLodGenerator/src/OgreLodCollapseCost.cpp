@@ -27,28 +27,54 @@
  */
 
 #include "OgreMeshLodPrecompiledHeaders.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
+    namespace
+    {
+        /// Vertices handed to a worker at once. Small meshes are processed on the calling thread.
+        const size_t VERTICES_PER_CHUNK = 1024;
+    }
+
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
         data->mCollapseCostHeap.clear();
-        LodData::VertexList::iterator it = data->mVertexList.begin();
-        LodData::VertexList::iterator itEnd = data->mVertexList.end();
-        for (; it != itEnd; it++) {
-            if (!it->edges.empty()) {
-                initVertexCollapseCost(data, &*it);
+        size_t vertexCount = data->mVertexList.size();
+
+        // The initial costs of the vertices don't depend on each other, so they are computed on all cores.
+        // computeVertexCollapseCost only writes the edges of the vertex it was called for.
+        std::vector<Real> costs(vertexCount, LodData::UNINITIALIZED_COLLAPSE_COST);
+        size_t chunkCount = (vertexCount + VERTICES_PER_CHUNK - 1) / VERTICES_PER_CHUNK;
+        parallelFor(chunkCount, [&](size_t chunk) {
+            size_t end = std::min(vertexCount, (chunk + 1) * VERTICES_PER_CHUNK);
+            for (size_t i = chunk * VERTICES_PER_CHUNK; i < end; i++) {
+                LodData::Vertex* vertex = &data->mVertexList[i];
+                if (!vertex->edges.empty()) {
+                    LodData::Vertex* collapseTo = NULL;
+                    computeVertexCollapseCost(data, vertex, costs[i], collapseTo);
+                    vertex->collapseTo = collapseTo;
+                }
+            }
+        });
+
+        data->mCollapseCostHeap.reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++) {
+            LodData::Vertex* vertex = &data->mVertexList[i];
+            if (!vertex->edges.empty()) {
+                data->mCollapseCostHeap.pushUnordered(vertex, costs[i]);
             } else {
 #if OGRE_DEBUG_MODE
                 LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
                     << "Vertex position: ("
-                    << it->position.x << ", "
-                    << it->position.y << ", "
-                    << it->position.z << ") "
+                    << vertex->position.x << ", "
+                    << vertex->position.y << ", "
+                    << vertex->position.z << ") "
                     << "It will be excluded from Lod level calculations.";
 #endif
             }
         }
+        data->mCollapseCostHeap.rebuild();
     }
 
     void LodCollapseCost::computeVertexCollapseCost( LodData* data, LodData::Vertex* vertex, Real& collapseCost, LodData::Vertex*& collapseTo )
@@ -71,7 +97,7 @@ namespace Ogre
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -80,16 +106,14 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
+        if (vertex->collapseTo != collapseTo || collapseCost != data->mCollapseCostHeap.getCost(vertex)) {
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST) {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+                data->mCollapseCostHeap.update(vertex, collapseCost);
             } else {
+                data->mCollapseCostHeap.erase(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
@@ -34,20 +34,35 @@
 
 #include "OgreLodCollapseCostQuadric.h"
 #include "OgreVector3.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
+    namespace
+    {
+        /// Triangles or vertices handed to a worker at once.
+        const size_t ELEMENTS_PER_CHUNK = 1024;
+    }
 
     void LodCollapseCostQuadric::initCollapseCosts( LodData* data )
     {
-        mTrianglePlaneQuadricList.resize(data->mTriangleList.size());
-        for(size_t i=0;i<mTrianglePlaneQuadricList.size();i++){
-            computeTrianglePlaneQuadric(data, i);
-        }
-        mVertexQuadricList.resize(data->mVertexList.size());
-        for (size_t i=0;i<mVertexQuadricList.size();i++) {
-            computeVertexQuadric(data, i);
-        }
+        // Every quadric only depends on the input mesh, so they are computed on all cores.
+        size_t triangleCount = data->mTriangleList.size();
+        mTrianglePlaneQuadricList.resize(triangleCount);
+        parallelFor((triangleCount + ELEMENTS_PER_CHUNK - 1) / ELEMENTS_PER_CHUNK, [&](size_t chunk) {
+            size_t end = std::min(triangleCount, (chunk + 1) * ELEMENTS_PER_CHUNK);
+            for (size_t i = chunk * ELEMENTS_PER_CHUNK; i < end; i++) {
+                computeTrianglePlaneQuadric(data, i);
+            }
+        });
+        size_t vertexCount = data->mVertexList.size();
+        mVertexQuadricList.resize(vertexCount);
+        parallelFor((vertexCount + ELEMENTS_PER_CHUNK - 1) / ELEMENTS_PER_CHUNK, [&](size_t chunk) {
+            size_t end = std::min(vertexCount, (chunk + 1) * ELEMENTS_PER_CHUNK);
+            for (size_t i = chunk * ELEMENTS_PER_CHUNK; i < end; i++) {
+                computeVertexQuadric(data, i);
+            }
+        });
         LodCollapseCost::initCollapseCosts(data);
     }
 
@@ -118,4 +118,112 @@ bool LodData::Edge::operator== (const LodData::Edge& other) const
     return dst == other.dst;
 }
 
+Real LodData::CollapseCostHeap::getCost(const Vertex* vertex) const
+{
+    OgreAssertDbg(vertex->costHeapPosition < mEntries.size() && mEntries[vertex->costHeapPosition].vertex == vertex, "Vertex is not in the heap");
+    return mEntries[vertex->costHeapPosition].cost;
+}
+
+void LodData::CollapseCostHeap::push(Vertex* vertex, Real cost)
+{
+    pushUnordered(vertex, cost);
+    siftUp(mEntries.size() - 1);
+}
+
+void LodData::CollapseCostHeap::update(Vertex* vertex, Real cost)
+{
+    size_t pos = vertex->costHeapPosition;
+    OgreAssertDbg(pos < mEntries.size() && mEntries[pos].vertex == vertex, "Vertex is not in the heap");
+    Real oldCost = mEntries[pos].cost;
+    mEntries[pos].cost = cost;
+    if (cost < oldCost) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::erase(Vertex* vertex)
+{
+    size_t pos = vertex->costHeapPosition;
+    OgreAssertDbg(pos < mEntries.size() && mEntries[pos].vertex == vertex, "Vertex is not in the heap");
+    vertex->costHeapPosition = NOT_IN_HEAP;
+    Entry last = mEntries.back();
+    mEntries.pop_back();
+    if (pos == mEntries.size()) {
+        return; // Removed the last entry.
+    }
+    // Move the last entry into the hole, then restore the order in whichever direction it is broken.
+    place(pos, last);
+    if (pos > 0 && isLess(last, mEntries[(pos - 1) / 2])) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::pushUnordered(Vertex* vertex, Real cost)
+{
+    Entry entry;
+    entry.cost = cost;
+    entry.vertex = vertex;
+    vertex->costHeapPosition = mEntries.size();
+    mEntries.push_back(entry);
+}
+
+void LodData::CollapseCostHeap::rebuild()
+{
+    // Floyd's heap construction is O(n), while pushing every entry one by one is O(n log n).
+    for (size_t pos = mEntries.size() / 2; pos-- > 0;) {
+        siftDown(pos);
+    }
+}
+
+bool LodData::CollapseCostHeap::isLess(const Entry& a, const Entry& b)
+{
+    // Break ties on the vertex address, so the collapse order is the same on every run.
+    return a.cost < b.cost || (a.cost == b.cost && a.vertex < b.vertex);
+}
+
+void LodData::CollapseCostHeap::place(size_t pos, const Entry& entry)
+{
+    mEntries[pos] = entry;
+    entry.vertex->costHeapPosition = pos;
+}
+
+void LodData::CollapseCostHeap::siftUp(size_t pos)
+{
+    Entry entry = mEntries[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!isLess(entry, mEntries[parent])) {
+            break;
+        }
+        place(pos, mEntries[parent]);
+        pos = parent;
+    }
+    place(pos, entry);
+}
+
+void LodData::CollapseCostHeap::siftDown(size_t pos)
+{
+    Entry entry = mEntries[pos];
+    size_t count = mEntries.size();
+    for (;;) {
+        size_t child = pos * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && isLess(mEntries[child + 1], mEntries[child])) {
+            child++;
+        }
+        if (!isLess(mEntries[child], entry)) {
+            break;
+        }
+        place(pos, mEntries[child]);
+        pos = child;
+    }
+    place(pos, entry);
+}
+
 }
@@ -27,6 +27,7 @@
  */
 
 #include "OgreMeshLodPrecompiledHeaders.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
@@ -217,6 +218,54 @@ void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
     }
 }
 
+void MeshLodGenerator::generateLodLevels(std::vector<LodConfig>& lodConfigs)
+{
+    struct Job {
+        size_t configIndex;
+        LodConfig config;
+        LodCollapseCostPtr cost;
+        LodDataPtr data;
+        LodInputProviderPtr input;
+        LodOutputProviderPtr output;
+        LodCollapserPtr collapser;
+    };
+    std::vector<Job> jobs;
+    jobs.reserve(lodConfigs.size());
+    for(size_t i = 0; i < lodConfigs.size(); i++) {
+        bool hasGeneratedLevels = false;
+        for(size_t n = 0; n < lodConfigs[i].levels.size(); n++) {
+            if(lodConfigs[i].levels[n].manualMeshName.empty()) {
+                hasGeneratedLevels = true;
+                break;
+            }
+        }
+        if(!hasGeneratedLevels) {
+            _generateManualLodLevels(lodConfigs[i]);
+            continue;
+        }
+        // The buffer providers copy the mesh here, so the workers never touch hardware buffers.
+        // The injection of the results is still done on this thread below.
+        jobs.push_back(Job());
+        Job& job = jobs.back();
+        job.configIndex = i;
+        job.config = lodConfigs[i];
+        job.config.advanced.useBackgroundQueue = true;
+        _resolveComponents(job.config, job.cost, job.data, job.input, job.output, job.collapser);
+    }
+
+    parallelFor(jobs.size(), [&](size_t i) {
+        Job& job = jobs[i];
+        _process(job.config, job.cost.get(), job.data.get(), job.input.get(), job.output.get(), job.collapser.get());
+    });
+
+    for(size_t i = 0; i < jobs.size(); i++) {
+        LodConfig& lodConfig = lodConfigs[jobs[i].configIndex];
+        jobs[i].output->inject();
+        lodConfig.levels = jobs[i].config.levels;
+        _configureMeshLodUsage(lodConfig);
+    }
+}
+
 void MeshLodGenerator::computeLods(LodConfig& lodConfig,
                                    LodData* data,
                                    LodCollapseCost* cost,
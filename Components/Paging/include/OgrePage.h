@@ -57,6 +57,8 @@ namespace Ogre
         unsigned long mFrameLastHeld;
         ContentCollectionList mContentCollections;
         uint16 mWorkQueueChannel;
+        WorkQueue::RequestID mLoadRequestID;
+        uint8 mLoadPriority;
         bool mDeferredProcessInProgress;
         bool mModified;
 
@@ -130,6 +132,16 @@ namespace Ogre
         */
         virtual void unload();
 
+        /** Set the priority with which this page is loaded in the background.
+        @remarks
+            If a background load is already queued, it is re-prioritised as long
+            as it did not start yet.
+        @param priority See WorkQueue::RequestPriority
+        */
+        virtual void setLoadPriority(uint8 priority);
+        /// Get the priority with which this page is loaded in the background
+        uint8 getLoadPriority() const { return mLoadPriority; }
+
 
         /** Returns whether this page was 'held' in the last frame, that is
             was it either directly needed, or requested to stay in memory (held - as
@@ -31,6 +31,7 @@ THE SOFTWARE.
 
 #include "OgrePagingPrerequisites.h"
 #include "OgreAxisAlignedBox.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
@@ -174,8 +175,12 @@ namespace Ogre
             on whether threading is enabled.
         @param pageID The page ID to load
         @param forceSynchronous If true, the page will always be loaded synchronously
+        @param priority Priority of the background load, see WorkQueue::RequestPriority.
+            Page strategies use it to load the pages close to the camera first. A page
+            requested again with a different priority is re-prioritised while it waits.
         */
-        virtual void loadPage(PageID pageID, bool forceSynchronous = false);
+        virtual void loadPage(PageID pageID, bool forceSynchronous = false,
+                              uint8 priority = WorkQueue::RP_NORMAL);
 
         /** Ask for a page to be unloaded with the given (section-relative) PageID
         @remarks
@@ -338,8 +338,10 @@ namespace Ogre
                 PageID pageID = stratData->calculatePageID(cx, cy);
                 if (cx >= loadxmin && cx <= loadxmax && cy >= loadymin && cy <= loadymax)
                 {
-                    // in the 'load' range, request it
-                    section->loadPage(pageID);
+                    // in the 'load' range, request it, closer pages first
+                    uint32 dist = std::max(std::abs(cx - x), std::abs(cy - y));
+                    uint32 falloff = std::min<uint32>(dist * 8, WorkQueue::RP_HIGH - WorkQueue::RP_LOW);
+                    section->loadPage(pageID, false, uint8(WorkQueue::RP_HIGH - falloff));
                 }
                 else
                 {
@@ -53,6 +53,8 @@ namespace Ogre
     Page::Page(PageID pageID, PagedWorldSection* parent)
         : mID(pageID)
         , mParent(parent)
+        , mLoadRequestID(0)
+        , mLoadPriority(WorkQueue::RP_NORMAL)
         , mDeferredProcessInProgress(false)
         , mModified(false)
         , mDebugNode(0)
@@ -184,12 +186,26 @@ namespace Ogre
             destroyAllContentCollections();
             PageRequest req(this);
             mDeferredProcessInProgress = true;
-            Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
-                Any(req), 0, synchronous);
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            if (synchronous)
+                wq->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, Any(req), 0, true);
+            else
+                mLoadRequestID = wq->addPrioritisedRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST,
+                    Any(req), mLoadPriority);
         }
 
     }
     //---------------------------------------------------------------------
+    void Page::setLoadPriority(uint8 priority)
+    {
+        if (priority == mLoadPriority)
+            return;
+
+        mLoadPriority = priority;
+        if (mLoadRequestID)
+            Root::getSingleton().getWorkQueue()->setRequestPriority(mLoadRequestID, priority);
+    }
+    //---------------------------------------------------------------------
     void Page::unload()
     {
         destroyAllContentCollections();
@@ -200,10 +216,8 @@ namespace Ogre
         PageRequest preq = any_cast<PageRequest>(req->getData());
         // only deal with own requests
         // we do this because if we delete a page we want any pending tasks to be discarded
-        if (preq.srcPage != this)
-            return false;
-        else
-            return RequestHandler::canHandleRequest(req, srcQ);
+        // aborted requests are handled too, so that the response tells us the load ended
+        return preq.srcPage == this;
 
     }
     //---------------------------------------------------------------------
@@ -228,6 +242,10 @@ namespace Ogre
         if (preq.srcPage != this)
             return 0;
 
+        // don't prepare anything, handleResponse only needs to know it was aborted
+        if (req->getAborted())
+            return OGRE_NEW WorkQueue::Response(req, false, Any(PageResponse()), "aborted");
+
         PageResponse res;
         res.pageData = OGRE_NEW PageData();
         WorkQueue::Response* response = 0;
@@ -249,6 +267,14 @@ namespace Ogre
     void Page::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
     {
         // Main thread
+        if (res->getRequest()->getAborted())
+        {
+            // Data was already deleted, just allow loading again
+            mLoadRequestID = 0;
+            mDeferredProcessInProgress = false;
+            return;
+        }
+
         PageResponse pres = any_cast<PageResponse>(res->getData());
         PageRequest preq = any_cast<PageRequest>(res->getRequest()->getData());
 
@@ -267,6 +293,7 @@ namespace Ogre
 
         OGRE_DELETE pres.pageData;
 
+        mLoadRequestID = 0;
         mDeferredProcessInProgress = false;
 
     }
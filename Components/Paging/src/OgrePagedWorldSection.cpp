@@ -195,7 +195,7 @@ namespace Ogre
         return getPage(id);
     }
     //---------------------------------------------------------------------
-    void PagedWorldSection::loadPage(PageID pageID, bool sync)
+    void PagedWorldSection::loadPage(PageID pageID, bool sync, uint8 priority)
     {
         if (!mParent->getManager()->getPagingOperationsEnabled())
             return;
@@ -217,10 +217,14 @@ namespace Ogre
                     ret.first->second = page;
                 }
             }
+            page->setLoadPriority(priority);
             page->load(sync);
         }
         else
+        {
             i->second->touch();
+            i->second->setLoadPriority(priority);
+        }
     }
     //---------------------------------------------------------------------
     void PagedWorldSection::unloadPage(PageID pageID, bool sync)
@@ -50,7 +50,8 @@ class _OgreRTSSExport FFPTransform : public SubRenderState
 
 // Interface.
 public:
-    
+    FFPTransform();
+
     /** 
     @see SubRenderState::getType.
     */
@@ -319,6 +319,8 @@ public:
     explicit BinaryOpAtom(char op, int groupOrder) : mOp(op) { mGroupExecutionOrder = groupOrder; }
     BinaryOpAtom(char op, const In& a, const In& b, const Out& dst, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
+    /** Return the operator */
+    char getOperator() const { return mOp; }
 };
 
 typedef std::vector<FunctionAtom*>                 FunctionAtomInstanceList;
@@ -420,6 +420,44 @@ public:
     bool getCreateShaderOverProgrammablePass() const { return mCreateShaderOverProgrammablePass; }
 
 
+    /** Listener, which is notified about the progress of validateScheme.
+    */
+    class _OgreRTSSExport ValidationListener
+    {
+    public:
+        virtual ~ValidationListener() {}
+
+        /** Called after the programs of a technique were acquired.
+        @param schemeName The scheme being validated.
+        @param validated The number of techniques validated so far.
+        @param total The number of techniques this validation builds.
+        */
+        virtual void techniqueValidated(const String& schemeName, size_t validated, size_t total) = 0;
+    };
+
+    /** Set the listener, which is notified about the progress of validateScheme.
+    @param listener The listener or NULL to remove it.
+    */
+    void setValidationListener(ValidationListener* listener) { mValidationListener = listener; }
+
+    /** Get the listener, which is notified about the progress of validateScheme. */
+    ValidationListener* getValidationListener() const { return mValidationListener; }
+
+    /** Sets whether validateScheme generates the programs of several techniques in parallel.
+    @remarks
+    The render states are built and the GPU programs are created on the calling thread, while
+    the sub render states synthesize the CPU programs and the source code is written on the
+    TaskScheduler. Custom sub render states must not change shared state in their
+    createCpuSubPrograms method when this is enabled. Disabled by default.
+    @param enable The value to set.
+    */
+    void setParallelValidation(bool enable) { mParallelValidation = enable; }
+
+    /** Returns whether validateScheme generates the programs of several techniques in parallel.
+    @see setParallelValidation().
+    */
+    bool getParallelValidation() const { return mParallelValidation; }
+
     /** Returns the amount of schemes used in the for RT shader generation
     */
     size_t getRTShaderSchemeCount() const;
@@ -487,6 +525,11 @@ protected:
         /** Acquire the CPU/GPU programs for this pass. */
         void acquirePrograms();
 
+        /** Prepare the programs of this pass for acquirePrograms.
+        @see TargetRenderState::prepareGpuPrograms
+        */
+        void prepareGpuPrograms(ProgramWriter* programWriter);
+
         /** Release the CPU/GPU programs of this pass. */
         void releasePrograms();
 
@@ -551,6 +594,11 @@ protected:
         /** Acquire the CPU/GPU programs for this technique. */
         void acquirePrograms();
 
+        /** Prepare the programs of the passes for acquirePrograms, may run on any thread.
+        @see TargetRenderState::prepareGpuPrograms
+        */
+        void prepareGpuPrograms(ProgramWriter* programWriter);
+
 		/** Build the render state for illumination passes. */
 		void buildIlluminationTargetRenderState();
 
@@ -714,6 +762,11 @@ protected:
         /** Synchronize the fog settings of this scheme with the current settings of the scene. */
         void synchronizeWithFogSettings();
 
+        /** Build and acquire the programs of the given techniques, preparing them on the TaskScheduler.
+        @see ShaderGenerator::setParallelValidation.
+        */
+        void validateParallel(const SGTechniqueList& techniques, size_t threadCount);
+
 
     protected:
         // Scheme name.
@@ -886,6 +939,10 @@ protected:
     bool mCreateShaderOverProgrammablePass;
     // A flag to indicate finalizing
     bool mIsFinalizing;
+    // Tells whether schemes are validated in parallel.
+    bool mParallelValidation;
+    // Listener notified about the validation progress.
+    ValidationListener* mValidationListener;
 
     uint32 ID_RT_SHADER_SYSTEM;
 private:
@@ -69,6 +69,7 @@ class FunctionStageRef;
 class FFPRenderStateBuilder;
 class ShaderGenerator;
 class SGMaterialSerializerListener;
+class ProgramWriter;
 class ProgramWriterFactory;
 class ProgramWriterManager;
 
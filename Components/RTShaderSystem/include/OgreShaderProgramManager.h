@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgreSingleton.h"
 #include "OgreGpuProgram.h"
 #include "OgreStringVector.h"
+#include "OgreShaderProgramSet.h"
 
 namespace Ogre {
 namespace RTShader {
@@ -107,6 +108,9 @@ protected:
     typedef ProgramProcessorMap::const_iterator         ProgramProcessorConstIterator;
     typedef std::vector<ProgramProcessor*>             ProgramProcessorList;
 
+    //-----------------------------------------------------------------------------
+    typedef std::map<String, String>                   ProgramKeyMap;
+
     
 protected:
     /** Create default program processors. */
@@ -134,8 +138,23 @@ protected:
     */
     void destroyCpuProgram(Program* shaderProgram);
 
-    /** Create GPU programs for the given program set based on the CPU programs it contains.
+    /** Get the shared program writer of the given language, create it if needed. */
+    ProgramWriter* getProgramWriter(const String& language);
+
+    /** Prepare the GPU programs of the given program set.
+    @remarks
+    Runs the pre creation step of the program processor, looks the programs up by their key and
+    writes the source code of the ones, which were not found. No GPU program is created, so this
+    may run concurrently for different program sets as long as no GPU program is created or
+    released meanwhile.
     @param programSet The program set container.
+    @param programWriter The program writer to use, which must not be shared with other threads.
+    */
+    void prepareGpuPrograms(ProgramSet* programSet, ProgramWriter* programWriter);
+
+    /** Create GPU programs for the given program set based on the CPU programs it contains.
+    @param programSet The program set container. Unless prepareGpuPrograms was called for it
+    already, it is prepared with the shared program writer first.
     */
     void createGpuPrograms(ProgramSet* programSet);
         
@@ -147,16 +166,30 @@ protected:
     */
     static String generateHash(const String& programString, const String& defines);
 
+    /**
+    Generates a key, which identifies the source code a CPU program translates to
+    @remarks
+    The key describes the structure the sub render states synthesized, i.e. the parameters,
+    functions and atoms of the program, so an existing GPU program can be found before any
+    source code is written.
+    @param shaderProgram The CPU program instance.
+    @param language The target shader language.
+    @param profiles The profiles string for program compilation.
+    @return A string representing a 128 bit hash value of the program structure or an empty
+    string if the program contains atoms of unknown types
+    */
+    static String generateKey(Program* shaderProgram, const String& language, const String& profiles);
+
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
-    @param programWriter The program writer instance.
+    @param prepared The key, name and source code written by prepareGpuPrograms.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
     @param profilesList The profiles string for program compilation as string list.
     @param cachePath The output path to write the program into.
     */
     GpuProgramPtr createGpuProgram(Program* shaderProgram, 
-        ProgramWriter* programWriter,
+        const ProgramSet::PreparedGpuProgram& prepared,
         const String& language,
         const String& profiles,
         const StringVector& profilesList,
@@ -203,6 +236,8 @@ protected:
     GpuProgramsMap mFragmentShaderMap;
     // The default program processors.
     ProgramProcessorList mDefaultProgramProcessors;
+    // Map between program keys and the names of the generated programs.
+    ProgramKeyMap mProgramKeyMap;
 
 private:
     friend class ProgramSet;
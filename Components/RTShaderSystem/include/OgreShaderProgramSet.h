@@ -76,6 +76,19 @@ protected:
     // Fragment shader CPU program.
     GpuProgramPtr mPSGpuProgram;
 
+    // Key, name and source code of a GPU program, which were generated ahead of its creation.
+    struct PreparedGpuProgram
+    {
+        String key;
+        String name;
+        // Empty if an existing program was found by its key.
+        String source;
+    };
+    // The prepared vertex and fragment programs, indexed by GpuProgramType.
+    PreparedGpuProgram mPreparedGpuPrograms[2];
+    // Tells if the GPU programs were prepared and wait for their creation.
+    bool mGpuProgramsPrepared;
+
 private:
     friend class ProgramManager;
     friend class TargetRenderState;
@@ -169,6 +169,16 @@ public:
     */
     void acquirePrograms(Pass* pass);
 
+    /** Create the CPU programs and prepare the GPU programs, so acquirePrograms only has to
+    create them.
+    @remarks
+    Does not touch the pass or any shared state, so it may run concurrently for different
+    render states.
+    @see ProgramManager::prepareGpuPrograms
+    @param programWriter The program writer to use.
+    */
+    void prepareGpuPrograms(ProgramWriter* programWriter);
+
     /** Release CPU/GPU programs set associated with the given render state and pass.
     @param pass The pass to release the programs from.
     */
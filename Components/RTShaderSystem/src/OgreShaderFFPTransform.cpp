@@ -35,13 +35,17 @@ namespace RTShader {
 /************************************************************************/
 String FFPTransform::Type = "FFP_Transform";
 
+//-----------------------------------------------------------------------
+FFPTransform::FFPTransform() : mSetPointSize(false)
+{
+}
+
 //-----------------------------------------------------------------------
 const String& FFPTransform::getType() const
 {
     return Type;
 }
 
-
 //-----------------------------------------------------------------------
 int FFPTransform::getExecutionOrder() const
 {
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre {
 
@@ -128,7 +129,8 @@ ShaderGenerator& ShaderGenerator::getSingleton()
 ShaderGenerator::ShaderGenerator() :
     mActiveSceneMgr(NULL), mShaderLanguage(""),
     mFSLayer(0), mActiveViewportValid(false), mVSOutputCompactPolicy(VSOCP_LOW),
-    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false)
+    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false), mParallelValidation(false),
+    mValidationListener(NULL)
 {
     mLightCount[0]              = 0;
     mLightCount[1]              = 0;
@@ -1552,6 +1554,13 @@ void ShaderGenerator::SGPass::acquirePrograms()
     mTargetRenderState->acquirePrograms(mDstPass);
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGPass::prepareGpuPrograms(ProgramWriter* programWriter)
+{
+    if(!mTargetRenderState) return;
+    mTargetRenderState->prepareGpuPrograms(programWriter);
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGPass::releasePrograms()
 {
@@ -1742,6 +1751,14 @@ void ShaderGenerator::SGTechnique::acquirePrograms()
 			(*itPass)->acquirePrograms();
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGTechnique::prepareGpuPrograms(ProgramWriter* programWriter)
+{
+	for(SGPassIterator itPass = mPassEntries.begin(); itPass != mPassEntries.end(); ++itPass)
+		if(!(*itPass)->isIlluminationPass())
+			(*itPass)->prepareGpuPrograms(programWriter);
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGTechnique::buildIlluminationTargetRenderState()
 {
@@ -1903,23 +1920,39 @@ void ShaderGenerator::SGScheme::validate()
         return;
     
     SGTechniqueIterator itTech;
+    SGTechniqueList buildTechniques;
 
-    // Build render state for each technique.
+    // Collect the techniques to build.
     for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
     {
-        SGTechnique* curTechEntry = *itTech;
-
-        if (curTechEntry->getBuildDestinationTechnique())
-            curTechEntry->buildTargetRenderState();     
+        if ((*itTech)->getBuildDestinationTechnique())
+            buildTechniques.push_back(*itTech);
     }
 
-    // Acquire GPU programs for each technique.
-    for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
+    TaskScheduler* scheduler = TaskScheduler::getDefault();
+    if (ShaderGenerator::getSingleton().getParallelValidation() && scheduler &&
+        scheduler->getWorkerCount() > 0 && buildTechniques.size() > 1)
     {
-        SGTechnique* curTechEntry = *itTech;
-        
-        if (curTechEntry->getBuildDestinationTechnique())
-            curTechEntry->acquirePrograms();        
+        validateParallel(buildTechniques, scheduler->getWorkerCount() + 1);
+    }
+    else
+    {
+        ValidationListener* listener = ShaderGenerator::getSingleton().getValidationListener();
+
+        // Build render state for each technique.
+        for (itTech = buildTechniques.begin(); itTech != buildTechniques.end(); ++itTech)
+        {
+            (*itTech)->buildTargetRenderState();
+        }
+
+        // Acquire GPU programs for each technique.
+        for (size_t i = 0; i < buildTechniques.size(); ++i)
+        {
+            buildTechniques[i]->acquirePrograms();
+
+            if (listener)
+                listener->techniqueValidated(mName, i + 1, buildTechniques.size());
+        }
     }
 
     // Turn off the build destination technique flag.
@@ -1934,6 +1967,47 @@ void ShaderGenerator::SGScheme::validate()
     mOutOfDate = false;
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGScheme::validateParallel(const SGTechniqueList& techniques, size_t threadCount)
+{
+    // Techniques are validated in chunks, so the progress is reported as it goes and only
+    // the source code of one chunk is held at a time.
+    const size_t chunkSize = 64;
+
+    // The program writers keep state while writing, so every thread needs its own one.
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+    std::vector<std::unique_ptr<ProgramWriter> > programWriters;
+    for (size_t i = 0; i < threadCount; ++i)
+        programWriters.emplace_back(ProgramWriterManager::getSingleton().createProgramWriter(language));
+
+    ValidationListener* listener = ShaderGenerator::getSingleton().getValidationListener();
+
+    for (size_t begin = 0; begin < techniques.size(); begin += chunkSize)
+    {
+        size_t end = std::min(begin + chunkSize, techniques.size());
+
+        // Building changes the materials, so it stays on this thread.
+        for (size_t i = begin; i < end; ++i)
+            techniques[i]->buildTargetRenderState();
+
+        // Synthesize the CPU programs and write their source code.
+        std::atomic<size_t> next(begin);
+        parallelFor(programWriters.size(), [&](size_t writer) {
+            for (size_t i = next++; i < end; i = next++)
+                techniques[i]->prepareGpuPrograms(programWriters[writer].get());
+        });
+
+        // Create the GPU programs in order, as the serial validation does.
+        for (size_t i = begin; i < end; ++i)
+        {
+            techniques[i]->acquirePrograms();
+
+            if (listener)
+                listener->techniqueValidated(mName, i + 1, techniques.size());
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGScheme::synchronizeWithLightSettings()
 {
@@ -34,6 +34,87 @@ RTShader::ProgramManager* Singleton<RTShader::ProgramManager>::msSingleton = 0;
 
 namespace RTShader {
 
+namespace {
+    /// Compact binary description of the structure of a CPU program
+    struct ProgramKeyWriter
+    {
+        String key;
+
+        void write(size_t value)
+        {
+            key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void write(const String& str)
+        {
+            write(str.size());
+            key.append(str);
+        }
+
+        void write(const ParameterPtr& param)
+        {
+            if (!param)
+            {
+                write(size_t(0));
+                return;
+            }
+            // the name or the value of constants
+            write(param->toString());
+            write(param->getType());
+            write(param->getSemantic());
+            write(param->getIndex());
+            write(param->getContent());
+            write(param->getSize());
+        }
+
+        template<typename T>
+        void write(const std::vector<T>& params)
+        {
+            write(params.size());
+            for (size_t i = 0; i < params.size(); ++i)
+                write(params[i]);
+        }
+
+        bool write(FunctionAtom* atom)
+        {
+            // other atoms may have state, which we don't know about
+            if (FunctionInvocation* invocation = dynamic_cast<FunctionInvocation*>(atom))
+            {
+                if (typeid(*atom) != typeid(FunctionInvocation))
+                    return false;
+                write(1);
+                write(invocation->getFunctionName());
+                write(invocation->getReturnType());
+            }
+            else if (BinaryOpAtom* binaryOp = dynamic_cast<BinaryOpAtom*>(atom))
+            {
+                if (typeid(*atom) != typeid(BinaryOpAtom))
+                    return false;
+                write(2);
+                write(binaryOp->getOperator());
+            }
+            else if (typeid(*atom) == typeid(AssignmentAtom))
+                write(3);
+            else if (typeid(*atom) == typeid(SampleTextureAtom))
+                write(4);
+            else
+                return false;
+
+            write(atom->getGroupExecutionOrder());
+            const FunctionAtom::OperandVector& operands = atom->getOperandList();
+            write(operands.size());
+            for (size_t i = 0; i < operands.size(); ++i)
+            {
+                write(operands[i].getParameter());
+                write(operands[i].getSemantic());
+                write(operands[i].getMask());
+                write(operands[i].getIndirectionLevel());
+            }
+            return true;
+        }
+    };
+}
+
 
 //-----------------------------------------------------------------------
 ProgramManager* ProgramManager::getSingletonPtr()
@@ -94,6 +175,7 @@ void ProgramManager::releasePrograms(const ProgramSet* programSet)
 //-----------------------------------------------------------------------------
 void ProgramManager::flushGpuProgramsCache()
 {
+    mProgramKeyMap.clear();
     flushGpuProgramsCache(mVertexShaderMap);
     flushGpuProgramsCache(mFragmentShaderMap);
 }
@@ -196,7 +278,23 @@ void ProgramManager::destroyProgramWriters()
 }
 
 //-----------------------------------------------------------------------------
-void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+ProgramWriter* ProgramManager::getProgramWriter(const String& language)
+{
+    ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
+
+    // No writer found -> create new one.
+    if (itWriter == mProgramWritersMap.end())
+    {
+        ProgramWriter* programWriter = ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
+        mProgramWritersMap[language] = programWriter;
+        return programWriter;
+    }
+
+    return itWriter->second;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::prepareGpuPrograms(ProgramSet* programSet, ProgramWriter* programWriter)
 {
     // Before we start we need to make sure that the pixel shader input
     //  parameters are the same as the vertex output, this required by 
@@ -209,48 +307,78 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         synchronizePixelnToBeVertexOut(programSet);
     }
 
-    // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
-    ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
-    ProgramWriter* programWriter = NULL;
-
-    // No writer found -> create new one.
-    if (itWriter == mProgramWritersMap.end())
-    {
-        programWriter = ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
-        mProgramWritersMap[language] = programWriter;
-    }
-    else
-    {
-        programWriter = itWriter->second;
-    }
-
-    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
-    ProgramProcessor* programProcessor = NULL;
+    ProgramProcessorConstIterator itProcessor = mProgramProcessorsMap.find(language);
 
     if (itProcessor == mProgramProcessorsMap.end())
     {
         OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
             "Could not find processor for language '" + language,
-            "ProgramManager::createGpuPrograms");       
+            "ProgramManager::prepareGpuPrograms");
     }
 
-    programProcessor = itProcessor->second;
-    
     // Call the pre creation of GPU programs method.
-    if (!programProcessor->preCreateGpuPrograms(programSet))
+    if (!itProcessor->second->preCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
+
+    const String& cachePath = ShaderGenerator::getSingleton().getShaderCachePath();
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        Program* shaderProgram = programSet->getCpuProgram(type);
+        ProgramSet::PreparedGpuProgram& prepared = programSet->mPreparedGpuPrograms[type];
+        const GpuProgramsMap& programsMap =
+            type == GPT_VERTEX_PROGRAM ? mVertexShaderMap : mFragmentShaderMap;
+
+        prepared.source.clear();
+
+        // Look the program up by its structure first, which saves writing the source code.
+        prepared.key = generateKey(shaderProgram, language,
+                                   ShaderGenerator::getSingleton().getShaderProfiles(type) + cachePath);
+        if (!prepared.key.empty())
+        {
+            ProgramKeyMap::const_iterator itKey = mProgramKeyMap.find(prepared.key);
+            if (itKey != mProgramKeyMap.end() && programsMap.find(itKey->second) != programsMap.end())
+            {
+                prepared.name = itKey->second;
+                continue;
+            }
+        }
+
+        stringstream sourceCodeStringStream;
+
+        // Generate source code.
+        programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
+        prepared.source = sourceCodeStringStream.str();
+
+        // Generate program name.
+        prepared.name = generateHash(prepared.source, shaderProgram->getPreprocessorDefines());
+        prepared.name += type == GPT_VERTEX_PROGRAM ? "_VS" : "_FS";
+    }
+
+    programSet->mGpuProgramsPrepared = true;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+{
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+
+    if (!programSet->mGpuProgramsPrepared)
+        prepareGpuPrograms(programSet, getProgramWriter(language));
+    programSet->mGpuProgramsPrepared = false;
+
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type),
+                                           programSet->mPreparedGpuPrograms[type], language,
                                            ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderProfilesList(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
 
         OgreAssert(gpuProgram, "gpu program could not be created");
         programSet->setGpuProgram(gpuProgram);
+        programSet->mPreparedGpuPrograms[type] = ProgramSet::PreparedGpuProgram();
     }
 
     //update flags
@@ -258,34 +386,30 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getSkeletalAnimationIncluded());
 
     // Call the post creation of GPU programs method.
-    if(!programProcessor->postCreateGpuPrograms(programSet))
+    if(!mProgramProcessorsMap[language]->postCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "postCreateGpuPrograms failed");
 }
 
 //-----------------------------------------------------------------------------
 GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
-                                               ProgramWriter* programWriter,
+                                               const ProgramSet::PreparedGpuProgram& prepared,
                                                const String& language,
                                                const String& profiles,
                                                const StringVector& profilesList,
                                                const String& cachePath)
 {
-    stringstream sourceCodeStringStream;
-
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
-
-    // Generate program name.
-    String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
-
-    if (shaderProgram->getType() == GPT_VERTEX_PROGRAM)
-    {
-        programName += "_VS";
-    }
-    else if (shaderProgram->getType() == GPT_FRAGMENT_PROGRAM)
+    GpuProgramsMap& programsMap =
+        shaderProgram->getType() == GPT_VERTEX_PROGRAM ? mVertexShaderMap : mFragmentShaderMap;
+    const String& programName = prepared.name;
+    const String& programKey = prepared.key;
+
+    // Programs prepared together may have the same name, so the first one created it already.
+    GpuProgramsMapIterator itProgram = programsMap.find(programName);
+    if (itProgram != programsMap.end())
     {
-        programName += "_FS";
+        if (!programKey.empty())
+            mProgramKeyMap[programKey] = programName;
+        return itProgram->second;
     }
 
     // Try to get program by name.
@@ -297,6 +421,15 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
         return static_pointer_cast<GpuProgram>(pGpuProgram);
     }
 
+    String source = prepared.source;
+    if (source.empty())
+    {
+        // The program found by its key was released since.
+        stringstream sourceCodeStringStream;
+        getProgramWriter(language)->writeSourceCode(sourceCodeStringStream, shaderProgram);
+        source = sourceCodeStringStream.str();
+    }
+
     // Case the program doesn't exist yet.
     // Create new GPU program.
     pGpuProgram = HighLevelGpuProgramManager::getSingleton().createProgram(programName,
@@ -368,14 +501,9 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
     }
 
     // Add the created GPU program to local cache.
-    if (pGpuProgram->getType() == GPT_VERTEX_PROGRAM)
-    {
-        mVertexShaderMap[programName] = pGpuProgram;
-    }
-    else if (pGpuProgram->getType() == GPT_FRAGMENT_PROGRAM)
-    {
-        mFragmentShaderMap[programName] = pGpuProgram;
-    }
+    programsMap[programName] = pGpuProgram;
+    if (!programKey.empty())
+        mProgramKeyMap[programKey] = programName;
     
     return static_pointer_cast<GpuProgram>(pGpuProgram);
 }
@@ -394,6 +522,45 @@ String ProgramManager::generateHash(const String& programString, const String& d
 }
 
 
+//-----------------------------------------------------------------------------
+String ProgramManager::generateKey(Program* shaderProgram, const String& language, const String& profiles)
+{
+    ProgramKeyWriter writer;
+    writer.write(language);
+    writer.write(profiles);
+    writer.write(shaderProgram->getType());
+    writer.write(shaderProgram->getEntryPointFunction()->getName());
+    writer.write(shaderProgram->getUseColumnMajorMatrices());
+
+    writer.write(shaderProgram->getDependencyCount());
+    for (unsigned int i = 0; i < shaderProgram->getDependencyCount(); ++i)
+        writer.write(shaderProgram->getDependency(i));
+
+    writer.write(shaderProgram->getParameters());
+
+    const ShaderFunctionList& functions = shaderProgram->getFunctions();
+    writer.write(functions.size());
+    for (ShaderFunctionConstIterator it = functions.begin(); it != functions.end(); ++it)
+    {
+        Function* function = *it;
+        writer.write(function->getName());
+        writer.write(function->getFunctionType());
+        writer.write(function->getInputParameters());
+        writer.write(function->getOutputParameters());
+        writer.write(function->getLocalParameters());
+
+        const FunctionAtomInstanceList& atoms = function->getAtomInstances();
+        writer.write(atoms.size());
+        for (FunctionAtomInstanceConstIterator itAtom = atoms.begin(); itAtom != atoms.end(); ++itAtom)
+        {
+            if (!writer.write(*itAtom))
+                return BLANKSTRING;
+        }
+    }
+
+    return generateHash(writer.key, shaderProgram->getPreprocessorDefines());
+}
+
 //-----------------------------------------------------------------------------
 void ProgramManager::addProgramProcessor(ProgramProcessor* processor)
 {
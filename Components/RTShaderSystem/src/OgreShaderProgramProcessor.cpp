@@ -35,7 +35,9 @@ ProgramProcessor::ProgramProcessor()
 {
     mMaxTexCoordSlots = 16;
     mMaxTexCoordFloats = mMaxTexCoordSlots * 4;
-    
+
+    // Built up front, since processors are shared by threads preparing programs.
+    buildMergeCombinations();
 }
 
 //-----------------------------------------------------------------------------
@@ -285,13 +287,6 @@ void ProgramProcessor::mergeParameters(ShaderParameterList paramsTable[4], Merge
 void ProgramProcessor::mergeParametersByPredefinedCombinations(ShaderParameterList paramsTable[4], 
                                                                MergeParameterList& mergedParams)
 {
-
-    // Make sure the merge combinations are ready.
-    if (mParamMergeCombinations.empty())
-    {
-        buildMergeCombinations();
-    }
-
     // Create the full used merged params - means FLOAT4 params that all of their components are used.
     for (unsigned int i=0; i < mParamMergeCombinations.size(); ++i)
     {
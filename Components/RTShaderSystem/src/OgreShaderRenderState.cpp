@@ -159,7 +159,8 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
 
 void TargetRenderState::acquirePrograms(Pass* pass)
 {
-    createCpuPrograms();
+    if (!mProgramSet || !mProgramSet->mGpuProgramsPrepared)
+        createCpuPrograms();
 
     ProgramManager::getSingleton().createGpuPrograms(mProgramSet.get());
 
@@ -221,6 +222,14 @@ void TargetRenderState::createCpuPrograms()
     }
 }
 
+//-----------------------------------------------------------------------
+void TargetRenderState::prepareGpuPrograms(ProgramWriter* programWriter)
+{
+    createCpuPrograms();
+
+    ProgramManager::getSingleton().prepareGpuPrograms(mProgramSet.get(), programWriter);
+}
+
 //-----------------------------------------------------------------------
 ProgramSet* TargetRenderState::createProgramSet()
 {
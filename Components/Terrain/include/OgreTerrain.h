@@ -39,6 +39,8 @@ THE SOFTWARE.
 #include "OgreWorkQueue.h"
 #include "OgreTerrainLodManager.h"
 
+#include <atomic>
+
 namespace Ogre
 {
     /** \addtogroup Optional
@@ -288,6 +290,10 @@ namespace Ogre
         static const uint16 TERRAINDERIVEDDATA_CHUNK_VERSION;
         static const uint32 TERRAINGENERALINFO_CHUNK_ID;
         static const uint16 TERRAINGENERALINFO_CHUNK_VERSION;
+        static const uint32 TERRAINTILEINDEX_CHUNK_ID;
+        static const uint16 TERRAINTILEINDEX_CHUNK_VERSION;
+        static const uint32 TERRAINTILE_CHUNK_ID;
+        static const uint16 TERRAINTILE_CHUNK_VERSION;
 
         static const size_t LOD_MORPH_CUSTOM_PARAM;
 
@@ -819,6 +825,22 @@ namespace Ogre
         /// @overload
         float getHeightAtWorldPosition(const Vector3& pos) const;
 
+        /** Get the heights, and optionally the normals, for many world positions at once.
+        @remarks
+            Each height is the one getHeightAtWorldPosition returns for the position. Large
+            batches are spread over the default TaskScheduler, so this is considerably
+            faster than querying the positions one by one, e.g. for placing vegetation or
+            for physics. It can be called from any thread as long as no parallel write to
+            the heightmap data occurs.
+        @param positions The world positions to project down on to the terrain
+        @param count The number of positions
+        @param outHeights Receives count heights
+        @param outNormals Optional, receives count unit normals in world space of the
+            triangles below the positions
+        */
+        void getHeightsAtWorldPositions(const Vector3* positions, size_t count,
+            float* outHeights, Vector3* outNormals = 0) const;
+
         /** Get a pointer to all the delta data for this terrain.
         @remarks
             The delta data is a measure at a given vertex of by how much vertically
@@ -1215,6 +1237,8 @@ namespace Ogre
         @param rect Rectangle describing the area in which heights have altered 
         @return A Rectangle describing the area which was updated (may be wider
             than the input rectangle)
+        @remarks
+            The rows of each LOD level are spread over the default TaskScheduler.
         */
         Rect calculateHeightDeltas(const Rect& rect);
 
@@ -1231,6 +1255,8 @@ namespace Ogre
         @param rect Rectangle describing the area of heights that were changed
         @param outFinalRect Output rectangle describing the area updated
         @return Pointer to a PixelBox full of normals (caller responsible for deletion)
+        @remarks
+            Blocks of rows are spread over the default TaskScheduler.
         */
         PixelBox* calculateNormals(const Rect& rect, Rect& outFinalRect);
 
@@ -1249,6 +1275,10 @@ namespace Ogre
             needs to be calculated additionally (e.g. from a neighbour)
         @param outFinalRect Output rectangle describing the area updated in the lightmap
         @return Pointer to a PixelBox full of lighting data (caller responsible for deletion)
+        @remarks
+            Blocks of rows are spread over the default TaskScheduler. The shadow rays skip the
+            intersection tests of blocks of quads, which lie entirely below or above them,
+            using a min / max height pyramid built for the call.
         */
         PixelBox* calculateLightmap(const Rect& rect, const Rect& extraTargetRect, Rect& outFinalRect);
 
@@ -1279,6 +1309,22 @@ namespace Ogre
          */
         std::pair<bool, Vector3> rayIntersects(const Ray& ray, 
             bool cascadeToNeighbours = false, Real distanceLimit = 0); //const;
+
+        /** Test many rays for intersection with the terrain at once.
+        @remarks
+            The results are the same as those of the single ray version. The rays march
+            over a min / max height pyramid of the terrain, which skips whole blocks of
+            quads the ray passes above or below. The pyramid is kept between calls and
+            only the parts covered by dirtyRect are rebuilt. Large batches are spread over
+            the default TaskScheduler. The same threading rules as for the single ray
+            version apply.
+        @param rays The rays to test
+        @param count The number of rays
+        @param results Receives count results, as returned by the single ray version
+        @param cascadeToNeighbours, distanceLimit See the single ray version
+        */
+        void rayIntersects(const Ray* rays, size_t count, std::pair<bool, Vector3>* results,
+            bool cascadeToNeighbours = false, Real distanceLimit = 0);
         
         /// Get the AABB (local coords) of the entire terrain
         const AxisAlignedBox& getAABB() const;
@@ -1309,6 +1355,24 @@ namespace Ogre
         /// Overridden from SceneManager::Listener
         void sceneManagerDestroyed(SceneManager* source);
 
+        /** Update the LOD of the terrain for a viewport.
+        @remarks
+            Done at most once per LOD camera, frame and viewport height, and skipped
+            entirely while neither the camera nor the terrain changed since the last
+            update. Called by preFindVisibleObjects, or in advance by TerrainGroup,
+            which updates all of its terrains in parallel after calling
+            _prepareLodUpdate on the main thread.
+        */
+        void _updateLod(Viewport* vp);
+        /** Bring lazily computed state, which _updateLod reads, up to date.
+        @remarks
+            After this call _updateLod can run for several terrains at once, each on
+            its own thread, provided the cameras of the viewport were prepared too.
+        */
+        void _prepareLodUpdate();
+        /// Notify the terrain that the LOD has to be recalculated, e.g. because nodes were loaded
+        void _dirtyLod() { mLodDirty = true; }
+
         /// Get the render queue group that this terrain will be rendered into
         uint8 getRenderQueueGroup(void) const { return mRenderQueueGroup; }
         /** Set the render queue group that this terrain will be rendered into.
@@ -1670,6 +1734,12 @@ namespace Ogre
         void copyGlobalOptions();
         void checkLayers(bool includeGPUResources);
         void checkDeclaration();
+        /// Read the independently compressed tiles of a terrain chunk since version 3
+        bool readTiles(StreamSerialiser& stream);
+        /// Read the packed data of one blend texture
+        void readBlendTexture(StreamSerialiser& stream, int index, uint8 numLayers);
+        /// Read one TERRAINDERIVEDDATA chunk
+        void readDerivedData(StreamSerialiser& stream);
         void deriveUVMultipliers();
         PixelFormat getBlendTextureFormat(uint8 textureIndex, uint8 numLayers) const;
 
@@ -1698,6 +1768,14 @@ namespace Ogre
         float* mHeightData;
         /// The delta information defining how a vertex moves before it is removed at a lower LOD
         float* mDeltaData;
+        /// Min / max heights of square blocks of quads, finest level first
+        struct HeightBoundsPyramid;
+        /// Cached bounds for batched ray queries, built on demand
+        HeightBoundsPyramid* mHeightBounds;
+        /// Region of the height data changed since mHeightBounds was updated
+        Rect mHeightBoundsDirtyRect;
+        std::atomic<bool> mHeightBoundsValid;
+        OGRE_WQ_MUTEX(mHeightBoundsMutex);
         Alignment mAlign;
         Real mWorldSize;
         uint16 mSize;
@@ -1835,6 +1913,13 @@ namespace Ogre
         const Camera* mLastLODCamera;
         unsigned long mLastLODFrame;
         int mLastViewportHeight;
+        /// Inputs of the last LOD calculation, which are compared to skip it
+        Affine3 mLastLODViewMatrix;
+        Matrix4 mLastLODProjMatrix;
+        Real mLastLODCFactor;
+        bool mLastLODRayBoxDistance;
+        /// Whether the nodes, their bounds or the material changed since the last LOD calculation
+        mutable bool mLodDirty;
 
         Terrain* mNeighbours[NEIGHBOUR_COUNT];
 
@@ -1860,8 +1945,22 @@ namespace Ogre
         int getHighestLodLoaded() const { return (mLodManager) ? mLodManager->getHighestLodLoaded() : -1; };
         int getTargetLodLevel() const { return (mLodManager) ? mLodManager->getTargetLodLevel() : -1; };
     private:
+        /// The plane, in terrain space, of the triangle below a terrain space position
+        Vector4 getPlaneAtTerrainPosition(Real x, Real y) const;
+        /// The bounds for the current height data, updated if necessary
+        const HeightBoundsPyramid* getHeightBounds();
+        /// Note a change of the height data for the cached bounds
+        void dirtyHeightBounds(const Rect& rect);
         /// Test a single quad of the terrain for ray intersection.
         OGRE_FORCE_INLINE std::pair<bool, Vector3> checkQuadIntersection(int x, int y, const Ray& ray) const;
+        /// rayIntersects, skipping the blocks of quads the bounds prove the ray can't hit
+        std::pair<bool, Vector3> rayIntersectsImpl(const Ray& ray, bool cascadeToNeighbours,
+            Real distanceLimit, const HeightBoundsPyramid* bounds);
+        /** Find the largest block of quads around the given one, which the local ray can't hit.
+        @return The level of the block in the pyramid, or -1 if the ray might hit the quad
+        */
+        int findEmptyBlock(const HeightBoundsPyramid& bounds, const Ray& localRay,
+            int quadX, int quadZ) const;
     };
 
 
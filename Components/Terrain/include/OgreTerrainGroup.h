@@ -70,7 +70,7 @@ namespace Ogre
         component. 
     */
     class _OgreTerrainExport TerrainGroup : public WorkQueue::RequestHandler, 
-        public WorkQueue::ResponseHandler, public TerrainAlloc
+        public WorkQueue::ResponseHandler, public SceneManager::Listener, public TerrainAlloc
     {
     public:
         /** Constructor.
@@ -257,6 +257,27 @@ namespace Ogre
             primary thread (default false, operations are threaded if possible)
         */
         virtual void loadTerrain(long x, long y, bool synchronous = false);
+
+        /** Load a specific terrain slot with the given background priority.
+        @remarks
+            Same as loadTerrain(long, long, bool), but the background preparation
+            is queued with the given priority instead of WorkQueue::RP_NORMAL.
+        @param x, y The coordinates of the terrain slot relative to the centre slot (signed).
+        @param synchronous Whether we should force this to happen entirely in the
+            primary thread
+        @param priority Priority of the background preparation, see WorkQueue::RequestPriority
+        */
+        void loadTerrain(long x, long y, bool synchronous, uint8 priority);
+
+        /** Change the priority of a terrain, which is being prepared in the background.
+        @remarks
+            Has no effect once the preparation started or if the terrain is not
+            being loaded.
+        @param x, y The coordinates of the terrain slot relative to the centre slot (signed).
+        @param priority See WorkQueue::RequestPriority
+        @return Whether the queued request was re-prioritised
+        */
+        bool setTerrainLoadPriority(long x, long y, uint8 priority);
         
         /** Load a terrain.cfg as used by the terrain scene manager into a single terrain slot
          *
@@ -397,6 +418,7 @@ namespace Ogre
             /// Position at which the intersection occurred
             Vector3 position;
 
+            RayResult() : hit(false), terrain(0), position(Vector3::ZERO) {}
             RayResult(bool _hit, Terrain* _terrain, const Vector3& _pos)
                 : hit(_hit), terrain(_terrain), position(_pos) {}
         };
@@ -419,6 +441,23 @@ namespace Ogre
         */
         float getHeightAtWorldPosition(const Vector3& pos, Terrain** ppTerrain = 0);
 
+        /** Get the heights, and optionally the normals, for many world positions at once.
+        @remarks
+            The positions are sorted by the terrain slot they fall into and each terrain
+            processes its positions as a batch, spread over the default TaskScheduler.
+            Positions without a loaded terrain get a height of 0.
+        @param positions Positions in world space
+        @param count The number of positions
+        @param outHeights Receives count heights, as returned by getHeightAtWorldPosition
+        @param outTerrains Optional, receives count pointers to the terrains resolving the
+            queries, or null where none were
+        @param outNormals Optional, receives count unit normals in world space, or
+            Vector3::ZERO where there was no terrain
+        @see Terrain::getHeightsAtWorldPositions
+        */
+        void getHeightsAtWorldPositions(const Vector3* positions, size_t count, float* outHeights,
+            Terrain** outTerrains = 0, Vector3* outNormals = 0) const;
+
         /** Test for intersection of a given ray with any terrain in the group. If the ray hits
          a terrain, the point of intersection and terrain instance is returned.
          @param ray The ray to test for intersection
@@ -429,6 +468,21 @@ namespace Ogre
          the terrain data occurs.
          */
         RayResult rayIntersects(const Ray& ray, Real distanceLimit = 0) const; 
+
+        /** Test many rays for intersection with the terrains in the group at once.
+        @remarks
+            Gives the same results as testing the rays one by one, but the rays are
+            spread over the default TaskScheduler and march over the cached height
+            bounds of the terrains (see Terrain::rayIntersects for batches). The same
+            threading rules as for the single ray version apply.
+        @param rays The rays to test
+        @param count The number of rays
+        @param results Receives count results
+        @param distanceLimit The distance from the ray origins at which we will stop looking,
+            0 indicates no limit
+        */
+        void rayIntersects(const Ray* rays, size_t count, RayResult* results,
+            Real distanceLimit = 0) const;
         
         typedef std::vector<Terrain*> TerrainList; 
         /** Test intersection of a box with the terrain. 
@@ -488,6 +542,16 @@ namespace Ogre
         /// WorkQueue::ResponseHandler override
         void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ);
 
+        /** SceneManager::Listener override.
+        @remarks
+            Calculates the LOD of all loaded terrains in parallel, before each terrain
+            would do so on its own.
+        */
+        void preFindVisibleObjects(SceneManager* source,
+            SceneManager::IlluminationRenderStage irs, Viewport* v);
+        /// SceneManager::Listener override
+        void sceneManagerDestroyed(SceneManager* source);
+
         /// Convert coordinates to a packed integer index
         uint32 packIndex(long x, long y) const;
         
@@ -550,6 +614,8 @@ namespace Ogre
         String mResourceGroup;
         TerrainAutoUpdateLod *mAutoUpdateLod;
         Terrain::DefaultGpuBufferAllocator mBufferAllocator;
+        /// Loaded terrains, whose LOD is being updated
+        std::vector<Terrain*> mLodUpdateTerrains;
         
         /// Get the position of a terrain instance
         Vector3 getTerrainSlotPosition(long x, long y);
@@ -558,8 +624,12 @@ namespace Ogre
         TerrainSlot* getTerrainSlot(long x, long y) const;
         void freeTerrainSlotInstance(TerrainSlot* slot);
         void connectNeighbour(TerrainSlot* slot, long offsetx, long offsety);
+        /// Order of indices, which sorts the given positions by terrain slot
+        void sortBySlot(const Vector3* positions, size_t count,
+            std::vector<std::pair<uint32, size_t> >& order) const;
+        RayResult rayIntersectsImpl(const Ray& ray, Real distanceLimit, bool batched) const;
 
-        void loadTerrainImpl(TerrainSlot* slot, bool synchronous);
+        void loadTerrainImpl(TerrainSlot* slot, bool synchronous, uint8 priority = WorkQueue::RP_NORMAL);
 
         /// Structure for holding the load request
         struct LoadRequest
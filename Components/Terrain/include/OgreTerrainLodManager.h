@@ -54,6 +54,14 @@ namespace Ogre
     public:
         static const uint32 TERRAINLODDATA_CHUNK_ID;
         static const uint16 TERRAINLODDATA_CHUNK_VERSION;
+
+        /// How LOD data and the tiles of a terrain are stored in a file
+        enum Compression
+        {
+            COMPRESSION_NONE = 0,
+            /// zlib, through DeflateStream
+            COMPRESSION_DEFLATE = 1
+        };
         typedef std::vector<float> LodData;
         typedef std::vector<LodData> LodsData;
 
@@ -101,6 +109,17 @@ namespace Ogre
         /// Save each LOD level separately compressed so seek is possible
         static void saveLodData(StreamSerialiser& stream, Terrain* terrain);
 
+        /// COMPRESSION_DEFLATE if Ogre was built with zip support, COMPRESSION_NONE otherwise
+        static uint8 getDefaultCompression();
+        /** Uncompress data, which was read from a file as is.
+        @remarks
+            Can be called from any thread.
+        @param stored The data as stored in the file
+        @param compression The Compression of the data
+        @return A stream of the uncompressed data, which is stored itself for COMPRESSION_NONE
+        */
+        static DataStreamPtr decompress(const DataStreamPtr& stored, uint8 compression);
+
         /** Copy geometry data from buffer to mHeightData/mDeltaData
           @param lodLevel A LOD level to work with
           @param data Buffer which holds geometry data if separated form
@@ -111,8 +130,8 @@ namespace Ogre
         /** Read separated geometry data from file into allocated memory
           @param lowerLodBound Lower bound of LOD levels to load
           @param higherLodBound Upper bound of LOD levels to load
-          @remarks Geometry data are uncompressed using inflate() and stored into
-                allocated buffer
+          @remarks Geometry data of all levels are read first and then uncompressed
+                in parallel, directly into mHeightData/mDeltaData
           */
         void readLodData(uint16 lowerLodBound, uint16 higherLodBound);
         void waitForDerivedProcesses();
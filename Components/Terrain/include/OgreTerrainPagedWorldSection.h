@@ -143,8 +143,13 @@ namespace Ogre
         /// Get the interval between the loading of single pages in milliseconds (ms)
         virtual uint32 getLoadingIntervalMs() const;
 
-        /// Overridden from PagedWorldSection
-        void loadPage(PageID pageID, bool forceSynchronous = false);
+        /** Overridden from PagedWorldSection
+        @remarks
+            Pages waiting to be loaded are kept ordered so that the one with the highest
+            priority is loaded next.
+        */
+        void loadPage(PageID pageID, bool forceSynchronous = false,
+                      uint8 priority = WorkQueue::RP_NORMAL);
         /// Overridden from PagedWorldSection
         void unloadPage(PageID pageID, bool forceSynchronous = false);
 
@@ -175,7 +180,13 @@ namespace Ogre
     protected:
         TerrainGroup* mTerrainGroup;
         TerrainDefiner* mTerrainDefiner;
-        std::list<PageID> mPagesInLoading;
+        struct PageLoad
+        {
+            PageID pageID;
+            uint8 priority;
+        };
+        /// Pages waiting to be defined, by decreasing priority except for the front one
+        std::list<PageLoad> mPagesInLoading;
         bool mHasRunningTasks;
         uint16 mWorkQueueChannel;
         unsigned long mNextLoadingTime;
@@ -49,6 +49,7 @@ THE SOFTWARE.
 #include "OgreTimer.h"
 #include "OgreTerrainMaterialGeneratorA.h"
 #include "OgreFileSystemLayer.h"
+#include "OgreTaskScheduler.h"
 
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
 // we do lots of conversions here, casting them all is tedious & cluttered, we know what we're doing
@@ -58,9 +59,13 @@ namespace Ogre
 {
     //---------------------------------------------------------------------
     const uint32 Terrain::TERRAIN_CHUNK_ID = StreamSerialiser::makeIdentifier("TERR");
-    const uint16 Terrain::TERRAIN_CHUNK_VERSION = 2;
+    const uint16 Terrain::TERRAIN_CHUNK_VERSION = 3;
     const uint32 Terrain::TERRAINGENERALINFO_CHUNK_ID = StreamSerialiser::makeIdentifier("TGIN");
     const uint16 Terrain::TERRAINGENERALINFO_CHUNK_VERSION = 1;
+    const uint32 Terrain::TERRAINTILEINDEX_CHUNK_ID = StreamSerialiser::makeIdentifier("TTIX");
+    const uint16 Terrain::TERRAINTILEINDEX_CHUNK_VERSION = 1;
+    const uint32 Terrain::TERRAINTILE_CHUNK_ID = StreamSerialiser::makeIdentifier("TTIL");
+    const uint16 Terrain::TERRAINTILE_CHUNK_VERSION = 1;
     const uint32 Terrain::TERRAINLAYERDECLARATION_CHUNK_ID = StreamSerialiser::makeIdentifier("TDCL");
     const uint16 Terrain::TERRAINLAYERDECLARATION_CHUNK_VERSION = 1;
     const uint32 Terrain::TERRAINLAYERSAMPLER_CHUNK_ID = StreamSerialiser::makeIdentifier("TSAM");
@@ -136,6 +141,112 @@ namespace Ogre
     //---------------------------------------------------------------------
     NameGenerator Terrain::msBlendTextureGenerator = NameGenerator("TerrBlend");
     //---------------------------------------------------------------------
+    namespace
+    {
+        /// Contents of a tile, see Terrain::TERRAINTILEINDEX_CHUNK_ID
+        enum TileType
+        {
+            /// Layer declaration, layer instances and blend map size
+            TILE_LAYERS = 0,
+            /// Packed data of one blend texture
+            TILE_BLENDTEXTURE = 1,
+            /// One TERRAINDERIVEDDATA chunk
+            TILE_DERIVEDDATA = 2,
+            /// The height deltas of the quadtree nodes
+            TILE_QUADTREE = 3
+        };
+
+        void beginTile(StreamSerialiser& stream, uint8 compression)
+        {
+            stream.writeChunkBegin(Terrain::TERRAINTILE_CHUNK_ID, Terrain::TERRAINTILE_CHUNK_VERSION);
+            if (compression == TerrainLodManager::COMPRESSION_DEFLATE)
+                stream.startDeflate();
+        }
+
+        void endTile(StreamSerialiser& stream, uint8 compression)
+        {
+            if (compression == TerrainLodManager::COMPRESSION_DEFLATE)
+                stream.stopDeflate();
+            stream.writeChunkEnd(Terrain::TERRAINTILE_CHUNK_ID);
+        }
+    }
+    //---------------------------------------------------------------------
+    struct Terrain::HeightBoundsPyramid
+    {
+        struct Level
+        {
+            /// Number of blocks along each edge
+            long size;
+            std::vector<float> minHeight;
+            std::vector<float> maxHeight;
+        };
+        /// Level n has blocks of 2^n x 2^n quads
+        std::vector<Level> levels;
+
+        explicit HeightBoundsPyramid(const Terrain* terrain)
+        {
+            long quads = terrain->getSize() - 1;
+            levels.resize(Bitwise::mostSignificantBitSet(static_cast<unsigned int>(quads)) + 1);
+            for (size_t l = 0; l < levels.size(); ++l)
+            {
+                Level& level = levels[l];
+                level.size = quads >> l;
+                level.minHeight.resize(level.size * level.size);
+                level.maxHeight.resize(level.size * level.size);
+            }
+            update(terrain, Rect(0, 0, terrain->getSize(), terrain->getSize()));
+        }
+
+        /// Recalculate the blocks touching a rectangle of vertices
+        void update(const Terrain* terrain, const Rect& rect)
+        {
+            // a vertex is shared by the quads on both sides of it
+            long quads = levels[0].size;
+            long x0 = std::max(rect.left - 1, 0L);
+            long z0 = std::max(rect.top - 1, 0L);
+            long x1 = std::min(rect.right, quads);
+            long z1 = std::min(rect.bottom, quads);
+            if (x0 >= x1 || z0 >= z1)
+                return;
+
+            Level& quadLevel = levels[0];
+            parallelFor(z1 - z0, [&](size_t row)
+            {
+                long z = z0 + static_cast<long>(row);
+                for (long x = x0; x < x1; ++x)
+                {
+                    float h[4] = { *terrain->getHeightData(x, z), *terrain->getHeightData(x + 1, z),
+                                   *terrain->getHeightData(x, z + 1), *terrain->getHeightData(x + 1, z + 1) };
+                    quadLevel.minHeight[z * quads + x] = std::min(std::min(h[0], h[1]), std::min(h[2], h[3]));
+                    quadLevel.maxHeight[z * quads + x] = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+                }
+            });
+
+            for (size_t l = 1; l < levels.size(); ++l)
+            {
+                x0 >>= 1;
+                z0 >>= 1;
+                x1 = (x1 + 1) >> 1;
+                z1 = (z1 + 1) >> 1;
+                const Level& src = levels[l - 1];
+                Level& dst = levels[l];
+                for (long z = z0; z < z1; ++z)
+                {
+                    for (long x = x0; x < x1; ++x)
+                    {
+                        long s0 = (2 * z) * src.size + 2 * x, s1 = s0 + src.size;
+                        dst.minHeight[z * dst.size + x] = std::min(
+                            std::min(src.minHeight[s0], src.minHeight[s0 + 1]),
+                            std::min(src.minHeight[s1], src.minHeight[s1 + 1]));
+                        dst.maxHeight[z * dst.size + x] = std::max(
+                            std::max(src.maxHeight[s0], src.maxHeight[s0 + 1]),
+                            std::max(src.maxHeight[s1], src.maxHeight[s1 + 1]));
+                    }
+                }
+            }
+        }
+    };
+    //---------------------------------------------------------------------
     Terrain::Terrain(SceneManager* sm)
         : mSceneMgr(sm)
         , mResourceGroup(BLANKSTRING)
@@ -144,6 +255,9 @@ namespace Ogre
         , mHeightDataModified(false)
         , mHeightData(0)
         , mDeltaData(0)
+        , mHeightBounds(0)
+        , mHeightBoundsDirtyRect(0, 0, 0, 0)
+        , mHeightBoundsValid(false)
         , mAlign(ALIGN_X_Z)
         , mWorldSize(0)
         , mSize(0)
@@ -195,6 +309,9 @@ namespace Ogre
         , mLastLODCamera(0)
         , mLastLODFrame(0)
         , mLastViewportHeight(0)
+        , mLastLODCFactor(0)
+        , mLastLODRayBoxDistance(false)
+        , mLodDirty(true)
         , mCustomGpuBufferAllocator(0)
         , mLodManager(0)
 
@@ -349,32 +466,39 @@ namespace Ogre
 
         TerrainLodManager::saveLodData(stream,this);
 
-        // start compressing
-        stream.startDeflate();
-
-        writeLayerDeclaration(mLayerDecl, stream);
-
-        // Layers
+        // Everything else goes into independently compressed tiles, listed in an
+        // index up front, so that they can be inflated in parallel when loading
         checkLayers(false);
         uint8 numLayers = (uint8)mLayers.size();
+        // save from CPU data if it's there, it means GPU data was never created
+        bool cpuBlendData = !mCpuBlendMapStorage.empty();
+        int numBlendTex = cpuBlendData ? getBlendTextureCount(numLayers) : (int)mBlendTextureList.size();
+        uint8 compression = TerrainLodManager::getDefaultCompression();
+
+        std::vector<uint8> tileTypes(1, TILE_LAYERS);
+        tileTypes.insert(tileTypes.end(), numBlendTex, TILE_BLENDTEXTURE);
+        int numDerived = (mNormalMapRequired ? 1 : 0) + (mGlobalColourMapEnabled ? 1 : 0) +
+            (mLightMapRequired ? 1 : 0) + (mCompositeMapRequired ? 1 : 0);
+        tileTypes.insert(tileTypes.end(), numDerived, TILE_DERIVEDDATA);
+        tileTypes.push_back(TILE_QUADTREE);
+        std::vector<uint8> tileCompression(tileTypes.size(), compression);
+
+        stream.writeChunkBegin(TERRAINTILEINDEX_CHUNK_ID, TERRAINTILEINDEX_CHUNK_VERSION);
+        uint16 numTiles = (uint16)tileTypes.size();
+        stream.write(&numTiles);
+        stream.write(&tileTypes[0], numTiles);
+        stream.write(&tileCompression[0], numTiles);
+        stream.writeChunkEnd(TERRAINTILEINDEX_CHUNK_ID);
+
+        // Layers
+        beginTile(stream, compression);
+        writeLayerDeclaration(mLayerDecl, stream);
         writeLayerInstanceList(mLayers, stream);
 
         // Packed layer blend data
-        if(!mCpuBlendMapStorage.empty())
+        if (cpuBlendData)
         {
-            // save from CPU data if it's there, it means GPU data was never created
             stream.write(&mLayerBlendMapSize);
-
-            // load packed CPU data
-            int numBlendTex = getBlendTextureCount(numLayers);
-            for (int i = 0; i < numBlendTex; ++i)
-            {
-                PixelFormat fmt = getBlendTextureFormat(i, numLayers);
-                size_t channels = PixelUtil::getNumElemBytes(fmt);
-                size_t dataSz = channels * mLayerBlendMapSize * mLayerBlendMapSize;
-                uint8* pData = mCpuBlendMapStorage[i];
-                stream.write(pData, dataSz);
-            }
         }
         else
         {
@@ -385,25 +509,41 @@ namespace Ogre
                     "on this hardware, which means the quality has been degraded");
             }
             stream.write(&mLayerBlendMapSizeActual);
-            uint8* tmpData = (uint8*)OGRE_MALLOC(mLayerBlendMapSizeActual * mLayerBlendMapSizeActual * 4, MEMCATEGORY_GENERAL);
-            uint8 texIndex = 0;
-            for (TexturePtrList::iterator i = mBlendTextureList.begin(); i != mBlendTextureList.end(); ++i, ++texIndex)
+        }
+        endTile(stream, compression);
+
+        uint8* tmpData = cpuBlendData ? 0 :
+            (uint8*)OGRE_MALLOC(mLayerBlendMapSizeActual * mLayerBlendMapSizeActual * 4, MEMCATEGORY_GENERAL);
+        for (int i = 0; i < numBlendTex; ++i)
+        {
+            beginTile(stream, compression);
+            if (cpuBlendData)
+            {
+                PixelFormat fmt = getBlendTextureFormat(i, numLayers);
+                size_t channels = PixelUtil::getNumElemBytes(fmt);
+                size_t dataSz = channels * mLayerBlendMapSize * mLayerBlendMapSize;
+                stream.write(mCpuBlendMapStorage[i], dataSz);
+            }
+            else
             {
                 // Must blit back in CPU format!
-                PixelFormat cpuFormat = getBlendTextureFormat(texIndex, getLayerCount());
+                const TexturePtr& tex = mBlendTextureList[i];
+                PixelFormat cpuFormat = getBlendTextureFormat(i, numLayers);
                 PixelBox dst(mLayerBlendMapSizeActual, mLayerBlendMapSizeActual, 1, cpuFormat, tmpData);
-                (*i)->getBuffer()->blitToMemory(dst);
-                size_t dataSz = PixelUtil::getNumElemBytes((*i)->getFormat()) * 
+                tex->getBuffer()->blitToMemory(dst);
+                size_t dataSz = PixelUtil::getNumElemBytes(tex->getFormat()) *
                     mLayerBlendMapSizeActual * mLayerBlendMapSizeActual;
                 stream.write(tmpData, dataSz);
             }
-            OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
+            endTile(stream, compression);
         }
+        OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
 
         // other data
         // normals
 		if (mNormalMapRequired)
 		{
+			beginTile(stream, compression);
 			stream.writeChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
 			String normalDataType("normalmap");
 			stream.write(&normalDataType);
@@ -422,11 +562,13 @@ namespace Ogre
 				OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
 			}
 			stream.writeChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
+			endTile(stream, compression);
 		}
 
         // colourmap
         if (mGlobalColourMapEnabled)
         {
+            beginTile(stream, compression);
             stream.writeChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
             String colourDataType("colourmap");
             stream.write(&colourDataType);
@@ -445,12 +587,14 @@ namespace Ogre
                 OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
             }
             stream.writeChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
+            endTile(stream, compression);
 
         }
 
         // lightmap
         if (mLightMapRequired)
         {
+            beginTile(stream, compression);
             stream.writeChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
             String lightmapDataType("lightmap");
             stream.write(&lightmapDataType);
@@ -469,11 +613,13 @@ namespace Ogre
                 OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
             }
             stream.writeChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
+            endTile(stream, compression);
         }
 
         // composite map
         if (mCompositeMapRequired)
         {
+            beginTile(stream, compression);
             stream.writeChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
             String compositeMapDataType("compositemap");
             stream.write(&compositeMapDataType);
@@ -493,13 +639,13 @@ namespace Ogre
                 OGRE_FREE(tmpData, MEMCATEGORY_GENERAL);
             }
             stream.writeChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
+            endTile(stream, compression);
         }
 
         // write the quadtree
+        beginTile(stream, compression);
         mQuadTree->save(stream);
-
-        // stop compressing
-        stream.stopDeflate();
+        endTile(stream, compression);
 
         stream.writeChunkEnd(TERRAIN_CHUNK_ID);
 
@@ -699,6 +845,18 @@ namespace Ogre
                 stream.readChunkEnd(TerrainLodManager::TERRAINLODDATA_CHUNK_ID);
             }
 
+            if (mainChunk->version > 2)
+            {
+                if (!readTiles(stream))
+                    return false;
+                stream.readChunkEnd(TERRAIN_CHUNK_ID);
+
+                mModified = false;
+                mHeightDataModified = false;
+                mPrepareInProgress = false;
+                return true;
+            }
+
             // start uncompressing
             stream.startDeflate( mainChunk->length - stream.getOffsetFromChunkStart() );
         }
@@ -725,60 +883,12 @@ namespace Ogre
         // load packed CPU data
         int numBlendTex = getBlendTextureCount(numLayers);
         for (int i = 0; i < numBlendTex; ++i)
-        {
-            PixelFormat fmt = getBlendTextureFormat(i, numLayers);
-            size_t channels = PixelUtil::getNumElemBytes(fmt);
-            size_t dataSz = channels * mLayerBlendMapSize * mLayerBlendMapSize;
-            uint8* pData = (uint8*)OGRE_MALLOC(dataSz, MEMCATEGORY_RESOURCE);
-            stream.read(pData, dataSz);
-            mCpuBlendMapStorage.push_back(pData);
-        }
+            readBlendTexture(stream, i, numLayers);
 
         // derived data
         while (!stream.isEndOfChunk(TERRAIN_CHUNK_ID) && 
             stream.peekNextChunkID() == TERRAINDERIVEDDATA_CHUNK_ID)
-        {
-            stream.readChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
-            // name
-            String name;
-            stream.read(&name);
-            uint16 sz;
-            stream.read(&sz);
-            if (name == "normalmap")
-            {
-                mNormalMapRequired = true;
-                uint8* pData = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 3, MEMCATEGORY_GENERAL));
-                mCpuTerrainNormalMap = OGRE_NEW PixelBox(sz, sz, 1, PF_BYTE_RGB, pData);
-
-                stream.read(pData, sz * sz * 3);
-                
-            }
-            else if (name == "colourmap")
-            {
-                mGlobalColourMapEnabled = true;
-                mGlobalColourMapSize = sz;
-                mCpuColourMapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 3, MEMCATEGORY_GENERAL));
-                stream.read(mCpuColourMapStorage, sz * sz * 3);
-            }
-            else if (name == "lightmap")
-            {
-                mLightMapRequired = true;
-                mLightmapSize = sz;
-                mCpuLightmapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz, MEMCATEGORY_GENERAL));
-                stream.read(mCpuLightmapStorage, sz * sz);
-            }
-            else if (name == "compositemap")
-            {
-                mCompositeMapRequired = true;
-                mCompositeMapSize = sz;
-                mCpuCompositeMapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 4, MEMCATEGORY_GENERAL));
-                stream.read(mCpuCompositeMapStorage, sz * sz * 4);
-            }
-
-            stream.readChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
-
-
-        }
+            readDerivedData(stream);
 
         if(mainChunk->version == 1)
         {
@@ -805,6 +915,128 @@ namespace Ogre
         return true;
     }
     //---------------------------------------------------------------------
+    bool Terrain::readTiles(StreamSerialiser& stream)
+    {
+        if (!stream.readChunkBegin(TERRAINTILEINDEX_CHUNK_ID, TERRAINTILEINDEX_CHUNK_VERSION))
+            return false;
+        uint16 numTiles;
+        stream.read(&numTiles);
+        std::vector<uint8> tileTypes(numTiles), tileCompression(numTiles);
+        stream.read(&tileTypes[0], numTiles);
+        stream.read(&tileCompression[0], numTiles);
+        stream.readChunkEnd(TERRAINTILEINDEX_CHUNK_ID);
+
+        // The source stream is read in one sequential pass, then all tiles are
+        // inflated at the same time
+        std::vector<DataStreamPtr> tiles(numTiles);
+        for (uint16 i = 0; i < numTiles; ++i)
+        {
+            const StreamSerialiser::Chunk* c = stream.readChunkBegin(TERRAINTILE_CHUNK_ID, TERRAINTILE_CHUNK_VERSION);
+            if (!c)
+                return false;
+            MemoryDataStream* stored = OGRE_NEW MemoryDataStream(c->length, true, true);
+            stream.read(stored->getPtr(), c->length);
+            tiles[i] = DataStreamPtr(stored);
+            stream.readChunkEnd(TERRAINTILE_CHUNK_ID);
+        }
+        parallelFor(numTiles, [&](size_t i)
+        {
+            tiles[i] = TerrainLodManager::decompress(tiles[i], tileCompression[i]);
+        });
+
+        uint8 numLayers = 0;
+        int blendTexture = 0;
+        for (uint16 i = 0; i < numTiles; ++i)
+        {
+            StreamSerialiser tile(tiles[i], stream.getEndian(), false, stream.getRealStorageFormat());
+            switch (tileTypes[i])
+            {
+            case TILE_LAYERS:
+                // Layer declaration
+                if (!readLayerDeclaration(tile, mLayerDecl))
+                    return false;
+                checkDeclaration();
+
+                // Layers
+                if (!readLayerInstanceList(tile, mLayerDecl.samplers.size(), mLayers))
+                    return false;
+                deriveUVMultipliers();
+
+                numLayers = (uint8)mLayers.size();
+                tile.read(&mLayerBlendMapSize);
+                mLayerBlendMapSizeActual = mLayerBlendMapSize; // for now, until we check
+                break;
+            case TILE_BLENDTEXTURE:
+                readBlendTexture(tile, blendTexture++, numLayers);
+                break;
+            case TILE_DERIVEDDATA:
+                readDerivedData(tile);
+                break;
+            case TILE_QUADTREE:
+                // Create & load quadtree
+                mQuadTree = OGRE_NEW TerrainQuadTreeNode(this, 0, 0, 0, mSize, mNumLodLevels - 1, 0, 0);
+                mQuadTree->prepare(tile);
+                break;
+            default:
+                // written by a later version, which knows what to do with it
+                break;
+            }
+        }
+        return mQuadTree != 0;
+    }
+    //---------------------------------------------------------------------
+    void Terrain::readBlendTexture(StreamSerialiser& stream, int index, uint8 numLayers)
+    {
+        PixelFormat fmt = getBlendTextureFormat(index, numLayers);
+        size_t channels = PixelUtil::getNumElemBytes(fmt);
+        size_t dataSz = channels * mLayerBlendMapSize * mLayerBlendMapSize;
+        uint8* pData = (uint8*)OGRE_MALLOC(dataSz, MEMCATEGORY_RESOURCE);
+        stream.read(pData, dataSz);
+        mCpuBlendMapStorage.push_back(pData);
+    }
+    //---------------------------------------------------------------------
+    void Terrain::readDerivedData(StreamSerialiser& stream)
+    {
+        stream.readChunkBegin(TERRAINDERIVEDDATA_CHUNK_ID, TERRAINDERIVEDDATA_CHUNK_VERSION);
+        // name
+        String name;
+        stream.read(&name);
+        uint16 sz;
+        stream.read(&sz);
+        if (name == "normalmap")
+        {
+            mNormalMapRequired = true;
+            uint8* pData = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 3, MEMCATEGORY_GENERAL));
+            mCpuTerrainNormalMap = OGRE_NEW PixelBox(sz, sz, 1, PF_BYTE_RGB, pData);
+
+            stream.read(pData, sz * sz * 3);
+            
+        }
+        else if (name == "colourmap")
+        {
+            mGlobalColourMapEnabled = true;
+            mGlobalColourMapSize = sz;
+            mCpuColourMapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 3, MEMCATEGORY_GENERAL));
+            stream.read(mCpuColourMapStorage, sz * sz * 3);
+        }
+        else if (name == "lightmap")
+        {
+            mLightMapRequired = true;
+            mLightmapSize = sz;
+            mCpuLightmapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz, MEMCATEGORY_GENERAL));
+            stream.read(mCpuLightmapStorage, sz * sz);
+        }
+        else if (name == "compositemap")
+        {
+            mCompositeMapRequired = true;
+            mCompositeMapSize = sz;
+            mCpuCompositeMapStorage = static_cast<uint8*>(OGRE_MALLOC(sz * sz * 4, MEMCATEGORY_GENERAL));
+            stream.read(mCpuCompositeMapStorage, sz * sz * 4);
+        }
+
+        stream.readChunkEnd(TERRAINDERIVEDDATA_CHUNK_ID);
+    }
+    //---------------------------------------------------------------------
     bool Terrain::prepare(const ImportData& importData)
     {
         mPrepareInProgress = true;
@@ -1248,6 +1480,14 @@ namespace Ogre
     }
     //---------------------------------------------------------------------
     float Terrain::getHeightAtTerrainPosition(Real x, Real y) const
+    {
+        Vector4 plane = getPlaneAtTerrainPosition(x, y);
+
+        // Solve plane equation for z
+        return (-plane.x * x - plane.y * y - plane.w) / plane.z;
+    }
+    //---------------------------------------------------------------------
+    Vector4 Terrain::getPlaneAtTerrainPosition(Real x, Real y) const
     {
         // get left / bottom points (rounded down)
         Real factor = (Real)mSize - 1.0f;
@@ -1308,9 +1548,7 @@ namespace Ogre
             else
                 plane = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
         }
-
-        // Solve plane equation for z
-        return (-plane.x * x - plane.y * y - plane.w) / plane.z;
+        return plane;
     }
     //---------------------------------------------------------------------
     float Terrain::getHeightAtWorldPosition(Real x, Real y, Real z) const
@@ -1325,6 +1563,33 @@ namespace Ogre
         return getHeightAtWorldPosition(pos.x, pos.y, pos.z);
     }
     //---------------------------------------------------------------------
+    void Terrain::getHeightsAtWorldPositions(const Vector3* positions, size_t count,
+        float* outHeights, Vector3* outNormals) const
+    {
+        // enough work per block to be worth handing to another thread
+        const size_t blockSize = 256;
+        parallelFor((count + blockSize - 1) / blockSize, [&](size_t block)
+        {
+            size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i)
+            {
+                Vector3 terrPos;
+                getTerrainPosition(positions[i], &terrPos);
+                Vector4 plane = getPlaneAtTerrainPosition(terrPos.x, terrPos.y);
+                outHeights[i] = (-plane.x * terrPos.x - plane.y * terrPos.y - plane.w) / plane.z;
+                if (outNormals)
+                {
+                    // terrain space x & y are scaled down by the world size, the height is not
+                    Vector3 normal(plane.x / mWorldSize, plane.y / mWorldSize, plane.z);
+                    if (normal.z < 0)
+                        normal = -normal;
+                    normal.normalise();
+                    convertTerrainToWorldAxes(mAlign, normal, &outNormals[i]);
+                }
+            }
+        });
+    }
+    //---------------------------------------------------------------------
     const float* Terrain::getDeltaData() const
     {
         return mDeltaData;
@@ -1852,6 +2117,7 @@ namespace Ogre
             mRootNode->setPosition(pos);
             updateBaseScale();
             mModified = true;
+            mLodDirty = true;
         }
     }
     //---------------------------------------------------------------------
@@ -1882,6 +2148,7 @@ namespace Ogre
         mDirtyGeometryRectForNeighbours.merge(rect);
         mDirtyDerivedDataRect.merge(rect);
         mCompositeMapDirtyRect.merge(rect);
+        dirtyHeightBounds(rect);
 
         mModified = true;
         mHeightDataModified = true;
@@ -1922,6 +2189,7 @@ namespace Ogre
         {
             mQuadTree->updateVertexData(true, false, mDirtyGeometryRect, false);
             mDirtyGeometryRect.setNull();
+            mLodDirty = true;
         }
 
         // propagate changes
@@ -1934,6 +2202,7 @@ namespace Ogre
         {
             mQuadTree->updateVertexData(true, false, mDirtyGeometryRect, false);
             mDirtyGeometryRect.setNull();
+            mLodDirty = true;
         }
     }
     //---------------------------------------------------------------------
@@ -2008,6 +2277,11 @@ namespace Ogre
         OGRE_FREE(mDeltaData, MEMCATEGORY_GEOMETRY);
         mDeltaData = 0;
 
+        OGRE_DELETE_T(mHeightBounds, HeightBoundsPyramid, MEMCATEGORY_GEOMETRY);
+        mHeightBounds = 0;
+        mHeightBoundsDirtyRect.setNull();
+        mHeightBoundsValid.store(false);
+
         OGRE_DELETE mQuadTree;
         mQuadTree = 0;
 
@@ -2100,6 +2374,14 @@ namespace Ogre
 
         mQuadTree->preDeltaCalculation(clampedRect);
 
+        // Quadtree nodes share the vertices on their common edges. Vertices in the same
+        // row / column class of the leaf grid (on a leaf edge or strictly between two)
+        // belong to the same nodes, so the rows only keep the largest delta per class
+        // and the quadtree is notified once per class afterwards.
+        const long leafStep = std::min((long)mSize, (long)mMaxBatchSize) - 1;
+        const long classCount = 2 * ((mSize - 1) / leafStep) + 1;
+        const Real noDelta = -std::numeric_limits<Real>::max();
+
         /// Iterate over target levels, 
         for (int targetLevel = 1; targetLevel < mNumLodLevels; ++targetLevel)
         {
@@ -2130,114 +2412,148 @@ namespace Ogre
             if (lodRect.bottom % step)
                 lodRect.bottom += step - (lodRect.bottom % step);
 
-            for (long j = lodRect.top; j < lodRect.bottom - step; j += step )
+            long rowCount = std::max(0L, lodRect.height() / step - 1);
+            if (rowCount == 0)
+                continue;
+
+            // rows are processed in a few blocks, each with its own maximum per class
+            size_t blockCount = std::min(rowCount, 16L);
+            std::vector<Real> blockDeltas(blockCount * classCount * classCount, noDelta);
+
+            parallelFor(blockCount, [&](size_t block)
             {
-                for (long i = lodRect.left; i < lodRect.right - step; i += step )
+                Real* classDeltas = &blockDeltas[block * classCount * classCount];
+                long rowBegin = rowCount * block / blockCount;
+                long rowEnd = rowCount * (block + 1) / blockCount;
+                for (long j = lodRect.top + rowBegin * step; j < lodRect.top + rowEnd * step; j += step)
                 {
-                    // Form planes relating to the lower detail tris to be produced
-                    // For even tri strip rows, they are this shape:
-                    // 2---3
-                    // | / |
-                    // 0---1
-                    // For odd tri strip rows, they are this shape:
-                    // 2---3
-                    // | \ |
-                    // 0---1
-
-                    Vector3 v0, v1, v2, v3;
-                    getPointAlign(i, j, ALIGN_X_Y, &v0);
-                    getPointAlign(i + step, j, ALIGN_X_Y, &v1);
-                    getPointAlign(i, j + step, ALIGN_X_Y, &v2);
-                    getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
-
-                    Vector4 t1, t2;
-                    bool backwardTri = false;
-                    // Odd or even in terms of target level
-                    if ((j / step) % 2 == 0)
-                    {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
-                    }
-                    else
+                    for (long i = lodRect.left; i < lodRect.right - step; i += step )
                     {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v1, v3, v2);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
-                        backwardTri = true;
-                    }
+                        // Form planes relating to the lower detail tris to be produced
+                        // For even tri strip rows, they are this shape:
+                        // 2---3
+                        // | / |
+                        // 0---1
+                        // For odd tri strip rows, they are this shape:
+                        // 2---3
+                        // | \ |
+                        // 0---1
+
+                        Vector3 v0, v1, v2, v3;
+                        getPointAlign(i, j, ALIGN_X_Y, &v0);
+                        getPointAlign(i + step, j, ALIGN_X_Y, &v1);
+                        getPointAlign(i, j + step, ALIGN_X_Y, &v2);
+                        getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
+
+                        Vector4 t1, t2;
+                        bool backwardTri = false;
+                        // Odd or even in terms of target level
+                        if ((j / step) % 2 == 0)
+                        {
+                            t1 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
+                            t2 = Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
+                        }
+                        else
+                        {
+                            t1 = Math::calculateFaceNormalWithoutNormalize(v1, v3, v2);
+                            t2 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
+                            backwardTri = true;
+                        }
 
-                    // include the bottommost row of vertices if this is the last row
-                    int yubound = (j == (mSize - step)? step : step - 1);
-                    for ( int y = 0; y <= yubound; y++ )
-                    {
-                        // include the rightmost col of vertices if this is the last col
-                        int xubound = (i == (mSize - step)? step : step - 1);
-                        for ( int x = 0; x <= xubound; x++ )
+                        // include the bottommost row of vertices if this is the last row
+                        int yubound = (j == (mSize - step)? step : step - 1);
+                        for ( int y = 0; y <= yubound; y++ )
                         {
-                            int fulldetailx = static_cast<int>(i + x);
                             int fulldetaily = static_cast<int>(j + y);
-                            if ( fulldetailx % step == 0 && 
-                                fulldetaily % step == 0 )
-                            {
-                                // Skip, this one is a vertex at this level
-                                continue;
-                            }
-
-                            Real ypct = (Real)y / (Real)step;
-                            Real xpct = (Real)x / (Real)step;
+                            long classY = 2 * (fulldetaily / leafStep) + (fulldetaily % leafStep ? 1 : 0);
 
-                            //interpolated height
-                            Vector3 actualPos;
-                            getPointAlign(fulldetailx, fulldetaily, ALIGN_X_Y, &actualPos);
-                            Real interp_h;
-                            // Determine which tri we're on 
-                            if ((xpct > ypct && !backwardTri) ||
-                                (xpct > (1-ypct) && backwardTri))
-                            {
-                                // Solve for x/z
-                                interp_h = 
-                                    (-t1.x * actualPos.x
-                                    - t1.y * actualPos.y
-                                    - t1.w) / t1.z;
-                            }
-                            else
+                            // include the rightmost col of vertices if this is the last col
+                            int xubound = (i == (mSize - step)? step : step - 1);
+                            for ( int x = 0; x <= xubound; x++ )
                             {
-                                // Second tri
-                                interp_h = 
-                                    (-t2.x * actualPos.x
-                                    - t2.y * actualPos.y
-                                    - t2.w) / t2.z;
-                            }
-
-                            Real actual_h = actualPos.z;
-                            Real delta = interp_h - actual_h;
-
-                            // max(delta) is the worst case scenario at this LOD
-                            // compared to the original heightmap
+                                int fulldetailx = static_cast<int>(i + x);
+                                if ( fulldetailx % step == 0 && 
+                                    fulldetaily % step == 0 )
+                                {
+                                    // Skip, this one is a vertex at this level
+                                    continue;
+                                }
+
+                                Real ypct = (Real)y / (Real)step;
+                                Real xpct = (Real)x / (Real)step;
+
+                                //interpolated height
+                                Vector3 actualPos;
+                                getPointAlign(fulldetailx, fulldetaily, ALIGN_X_Y, &actualPos);
+                                Real interp_h;
+                                // Determine which tri we're on 
+                                if ((xpct > ypct && !backwardTri) ||
+                                    (xpct > (1-ypct) && backwardTri))
+                                {
+                                    // Solve for x/z
+                                    interp_h = 
+                                        (-t1.x * actualPos.x
+                                        - t1.y * actualPos.y
+                                        - t1.w) / t1.z;
+                                }
+                                else
+                                {
+                                    // Second tri
+                                    interp_h = 
+                                        (-t2.x * actualPos.x
+                                        - t2.y * actualPos.y
+                                        - t2.w) / t2.z;
+                                }
+
+                                Real actual_h = actualPos.z;
+                                Real delta = interp_h - actual_h;
+
+                                // max(delta) is the worst case scenario at this LOD
+                                // compared to the original heightmap
+
+                                // remember it for the quadtree
+                                long classX = 2 * (fulldetailx / leafStep) + (fulldetailx % leafStep ? 1 : 0);
+                                Real& classDelta = classDeltas[classY * classCount + classX];
+                                classDelta = std::max(classDelta, delta);
+
+
+                                // If this vertex is being removed at this LOD, 
+                                // then save the height difference since that's the move
+                                // it will need to make. Vertices to be removed at this LOD
+                                // are halfway between the steps, but exclude those that
+                                // would have been eliminated at earlier levels
+                                int halfStep = step / 2;
+                                if (
+                                 ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
+                                 ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
+                                {
+                                    // Save height difference 
+                                    mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
+                                }
 
-                            // tell the quadtree about this 
-                            mQuadTree->notifyDelta(fulldetailx, fulldetaily, sourceLevel, delta);
-
-
-                            // If this vertex is being removed at this LOD, 
-                            // then save the height difference since that's the move
-                            // it will need to make. Vertices to be removed at this LOD
-                            // are halfway between the steps, but exclude those that
-                            // would have been eliminated at earlier levels
-                            int halfStep = step / 2;
-                            if (
-                             ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
-                             ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
-                            {
-                                // Save height difference 
-                                mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
                             }
 
                         }
+                    } // i
+                } // j
+            });
 
-                    }
-                } // i
-            } // j
-
+            // tell the quadtree about the deltas, using any vertex of each class
+            for (long classY = 0; classY < classCount; ++classY)
+            {
+                for (long classX = 0; classX < classCount; ++classX)
+                {
+                    Real delta = noDelta;
+                    for (size_t block = 0; block < blockCount; ++block)
+                        delta = std::max(delta, blockDeltas[(block * classCount + classY) * classCount + classX]);
+                    if (delta == noDelta)
+                        continue;
+
+                    long x = (classX / 2) * leafStep + (classX % 2);
+                    long y = (classY / 2) * leafStep + (classY % 2);
+                    mQuadTree->notifyDelta(static_cast<uint16>(x), static_cast<uint16>(y), sourceLevel, delta);
+                }
+            }
         } // targetLevel
 
         mQuadTree->postDeltaCalculation(clampedRect);
@@ -2259,6 +2575,7 @@ namespace Ogre
         mQuadTree->finaliseDeltaValues(clampedRect);
         // delta vertex data
         mQuadTree->updateVertexData(false, true, clampedRect, cpuData);
+        mLodDirty = true;
 
     }
 
@@ -2296,6 +2613,15 @@ namespace Ogre
                 updateCompositeMap();
         }
         mLastMillis = currMillis;
+
+        _updateLod(v);
+    }
+    //---------------------------------------------------------------------
+    void Terrain::_updateLod(Viewport* v)
+    {
+        if (!mIsLoaded)
+            return;
+
         // only calculate LOD once per LOD camera, per frame, per viewport height
         const Camera* lodCamera = v->getCamera()->getLodCamera();
         unsigned long frameNum = Root::getSingleton().getNextFrameNumber();
@@ -2310,6 +2636,12 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    void Terrain::_prepareLodUpdate()
+    {
+        if (mIsLoaded && mQuadTree)
+            getMaterial();
+    }
+    //---------------------------------------------------------------------
     void Terrain::sceneManagerDestroyed(SceneManager* source)
     {
         unload();
@@ -2337,12 +2669,72 @@ namespace Ogre
             // CFactor = A / T
             Real cFactor = A / T;
 
+            // a still camera looking at unchanged terrain selects the same LODs again,
+            // the culling frustum is not compared, so its LODs are always calculated
+            getMaterial(); // a regenerated material marks the LOD dirty
+            bool rayBoxDistance = TerrainGlobalOptions::getSingleton().getUseRayBoxDistanceCalculation();
+            if (!mLodDirty && !cam->getCullingFrustum() &&
+                cFactor == mLastLODCFactor && rayBoxDistance == mLastLODRayBoxDistance &&
+                cam->getViewMatrix() == mLastLODViewMatrix && cam->getProjectionMatrix() == mLastLODProjMatrix)
+                return;
+            mLastLODViewMatrix = cam->getViewMatrix();
+            mLastLODProjMatrix = cam->getProjectionMatrix();
+            mLastLODCFactor = cFactor;
+            mLastLODRayBoxDistance = rayBoxDistance;
+            mLodDirty = false;
+
             mQuadTree->calculateCurrentLod(cam, cFactor);
         }
     }
     //---------------------------------------------------------------------
     std::pair<bool, Vector3> Terrain::rayIntersects(const Ray& ray, 
         bool cascadeToNeighbours /* = false */, Real distanceLimit /* = 0 */)
+    {
+        return rayIntersectsImpl(ray, cascadeToNeighbours, distanceLimit, 0);
+    }
+    //---------------------------------------------------------------------
+    void Terrain::rayIntersects(const Ray* rays, size_t count, std::pair<bool, Vector3>* results,
+        bool cascadeToNeighbours /* = false */, Real distanceLimit /* = 0 */)
+    {
+        const HeightBoundsPyramid* bounds = getHeightBounds();
+        const size_t blockSize = 16;
+        parallelFor((count + blockSize - 1) / blockSize, [&](size_t block)
+        {
+            size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i)
+                results[i] = rayIntersectsImpl(rays[i], cascadeToNeighbours, distanceLimit, bounds);
+        });
+    }
+    //---------------------------------------------------------------------
+    const Terrain::HeightBoundsPyramid* Terrain::getHeightBounds()
+    {
+        if (!mHeightData)
+            return 0;
+        if (mHeightBoundsValid.load(std::memory_order_acquire))
+            return mHeightBounds;
+
+        OGRE_WQ_LOCK_MUTEX(mHeightBoundsMutex);
+        if (!mHeightBoundsValid.load(std::memory_order_relaxed))
+        {
+            if (!mHeightBounds)
+                mHeightBounds = OGRE_NEW_T(HeightBoundsPyramid, MEMCATEGORY_GEOMETRY)(this);
+            else if (!mHeightBoundsDirtyRect.isNull())
+                mHeightBounds->update(this, mHeightBoundsDirtyRect);
+            mHeightBoundsDirtyRect.setNull();
+            mHeightBoundsValid.store(true, std::memory_order_release);
+        }
+        return mHeightBounds;
+    }
+    //---------------------------------------------------------------------
+    void Terrain::dirtyHeightBounds(const Rect& rect)
+    {
+        OGRE_WQ_LOCK_MUTEX(mHeightBoundsMutex);
+        mHeightBoundsDirtyRect.merge(rect);
+        mHeightBoundsValid.store(false, std::memory_order_release);
+    }
+    //---------------------------------------------------------------------
+    std::pair<bool, Vector3> Terrain::rayIntersectsImpl(const Ray& ray,
+        bool cascadeToNeighbours, Real distanceLimit, const HeightBoundsPyramid* bounds)
     {
         typedef std::pair<bool, Vector3> Result;
         // first step: convert the ray to a local vertex space
@@ -2400,7 +2792,8 @@ namespace Ogre
                 OGRE_LOCK_RW_MUTEX_READ(mNeighbourMutex);
                 Terrain* neighbour = raySelectNeighbour(ray, distanceLimit);
                 if (neighbour)
-                    return neighbour->rayIntersects(ray, cascadeToNeighbours, distanceLimit);
+                    return neighbour->rayIntersectsImpl(ray, cascadeToNeighbours, distanceLimit,
+                        bounds ? neighbour->getHeightBounds() : 0);
             }
             return Result(false, Vector3());
         }
@@ -2424,6 +2817,34 @@ namespace Ogre
             if (quadX < 0 || quadX >= (int)mSize-1 || quadZ < 0 || quadZ >= (int)mSize-1)
                 break;
 
+            // find the largest block of quads around this one, which the ray misses
+            int emptyLevel = bounds ? findEmptyBlock(*bounds, localRay, quadX, quadZ) : -1;
+            if (emptyLevel >= 0)
+            {
+                // skip the whole block, continue with the quad the ray enters behind it
+                result.first = false;
+                int blockSize = 1 << emptyLevel;
+                int blockX = (quadX >> emptyLevel) << emptyLevel;
+                int blockZ = (quadZ >> emptyLevel) << emptyLevel;
+                Real xDist = Math::RealEqual(rayDirection.x, 0.0) ? dummyHighValue :
+                    (blockX + flipX * blockSize - cur.x) / rayDirection.x;
+                Real zDist = Math::RealEqual(rayDirection.z, 0.0) ? dummyHighValue :
+                    (blockZ + flipZ * blockSize - cur.z) / rayDirection.z;
+                if (xDist < zDist)
+                {
+                    cur += rayDirection * xDist;
+                    quadX = xDir < 0 ? blockX - 1 : blockX + blockSize;
+                    quadZ = Math::Clamp(static_cast<int>(std::floor(cur.z)), blockZ, blockZ + blockSize - 1);
+                }
+                else
+                {
+                    cur += rayDirection * zDist;
+                    quadZ = zDir < 0 ? blockZ - 1 : blockZ + blockSize;
+                    quadX = Math::Clamp(static_cast<int>(std::floor(cur.x)), blockX, blockX + blockSize - 1);
+                }
+                continue;
+            }
+
             result = checkQuadIntersection(quadX, quadZ, localRay);
             if (result.first)
                 break;
@@ -2475,11 +2896,66 @@ namespace Ogre
         {
             Terrain* neighbour = raySelectNeighbour(ray, distanceLimit);
             if (neighbour)
-                result = neighbour->rayIntersects(ray, cascadeToNeighbours, distanceLimit);
+                result = neighbour->rayIntersectsImpl(ray, cascadeToNeighbours, distanceLimit,
+                    bounds ? neighbour->getHeightBounds() : 0);
         }
         return result;
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        /// Clip the ray parameter range [tmin, tmax] to lo <= origin + t * dir <= hi
+        bool clipSlab(Real origin, Real dir, Real lo, Real hi, Real& tmin, Real& tmax)
+        {
+            if (dir == 0)
+                return origin >= lo && origin <= hi;
+            Real t0 = (lo - origin) / dir;
+            Real t1 = (hi - origin) / dir;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tmin = std::max(tmin, t0);
+            tmax = std::min(tmax, t1);
+            return tmin <= tmax;
+        }
+    }
+    //---------------------------------------------------------------------
+    int Terrain::findEmptyBlock(const HeightBoundsPyramid& bounds, const Ray& localRay,
+        int quadX, int quadZ) const
+    {
+        const Vector3& origin = localRay.getOrigin();
+        const Vector3& dir = localRay.getDirection();
+
+        for (int level = (int)bounds.levels.size() - 1; level >= 0; --level)
+        {
+            const HeightBoundsPyramid::Level& l = bounds.levels[level];
+            long blockX = quadX >> level;
+            long blockZ = quadZ >> level;
+            if (blockX >= l.size || blockZ >= l.size)
+                continue;
+            long index = blockZ * l.size + blockX;
+
+            // checkQuadIntersection accepts hits up to 0.01 outside of a quad, so
+            // widen the block a little and allow for the slope of the triangles there
+            Real x0 = (Real)(blockX << level);
+            Real z0 = (Real)(blockZ << level);
+            Real x1 = x0 + (Real)(1 << level);
+            Real z1 = z0 + (Real)(1 << level);
+            Real margin = (l.maxHeight[index] - l.minHeight[index]) * 0.05f + 1e-3f;
+
+            Real tmin = 0;
+            Real tmax = std::numeric_limits<Real>::max();
+            if (!clipSlab(origin.x, dir.x, x0 - 0.02f, x1 + 0.02f, tmin, tmax) ||
+                !clipSlab(origin.z, dir.z, z0 - 0.02f, z1 + 0.02f, tmin, tmax))
+                return level; // the ray doesn't cross the block at all
+            Real y0 = origin.y + dir.y * tmin;
+            Real y1 = origin.y + dir.y * tmax;
+            if (std::min(y0, y1) > l.maxHeight[index] + margin ||
+                std::max(y0, y1) < l.minHeight[index] - margin)
+                return level; // the ray passes above or below the whole block
+        }
+        return -1;
+    }
+    //---------------------------------------------------------------------
     std::pair<bool, Vector3> Terrain::checkQuadIntersection(int x, int z, const Ray& ray) const
     {
         // build the two planes belonging to the quad's triangles
@@ -2553,6 +3029,8 @@ namespace Ogre
             }
             mMaterialGenerationCount = mMaterialGenerator->getChangeCount();
             mMaterialDirty = false;
+            // the material LOD of the nodes may differ
+            mLodDirty = true;
         }
         if (mMaterialParamsDirty)
         {
@@ -3356,46 +3834,62 @@ namespace Ogre
         //  | / | \ |
         //  5---6---7
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        const long width = widenedRect.width();
+        const long blockRows = 16;
+        size_t blockCount = (widenedRect.height() + blockRows - 1) / blockRows;
+        parallelFor(blockCount, [&](size_t block)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            long yBegin = widenedRect.top + block * blockRows;
+            long yEnd = std::min(yBegin + blockRows, widenedRect.bottom);
+
+            // Points of the rows y-1, y and y+1 from x-1 to x+1, each one is
+            // fetched once instead of by all of its 9 neighbours
+            std::vector<Vector3> points(3 * (width + 2));
+            Vector3* rows[3] = { &points[0], &points[width + 2], &points[2 * (width + 2)] };
+            for (long r = 0; r < 2; ++r)
             {
-                Vector3 cumulativeNormal = Vector3::ZERO;
-
-                // Build points to sample
-                Vector3 centrePoint;
-                Vector3 adjacentPoints[8];
-                getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
-                getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
-                getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
-                getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
-                getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
-                getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
-                getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
-                getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
-                getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
-
-                for (int i = 0; i < 8; ++i)
+                for (long i = 0; i < width + 2; ++i)
+                    getPointFromSelfOrNeighbour(widenedRect.left + i - 1, yBegin + r - 1, &rows[r][i]);
+            }
+
+            for (long y = yBegin; y < yEnd; ++y)
+            {
+                for (long i = 0; i < width + 2; ++i)
+                    getPointFromSelfOrNeighbour(widenedRect.left + i - 1, y + 1, &rows[2][i]);
+
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
                 {
-                    cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
-                }
+                    Vector3 cumulativeNormal = Vector3::ZERO;
+
+                    // Build points to sample
+                    long i = x - widenedRect.left;
+                    const Vector3& centrePoint = rows[1][i + 1];
+                    const Vector3* adjacentPoints[8] = {
+                        &rows[1][i + 2], &rows[2][i + 2], &rows[2][i + 1], &rows[2][i],
+                        &rows[1][i], &rows[0][i], &rows[0][i + 1], &rows[0][i + 2] };
 
-                // normalise & store normal
-                cumulativeNormal.normalise();
+                    for (int n = 0; n < 8; ++n)
+                    {
+                        cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, *adjacentPoints[n], *adjacentPoints[(n+1)%8]);
+                    }
 
-                // encode as RGB, object space
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                    // normalise & store normal
+                    cumulativeNormal.normalise();
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
-                *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                    // encode as RGB, object space
+                    // invert the Y to deal with image space
+                    long storeX = x - widenedRect.left;
+                    long storeY = widenedRect.bottom - y - 1;
 
+                    uint8* pStore = pData + ((storeY * width) + storeX) * 3;
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                }
 
+                std::rotate(rows, rows + 1, rows + 3);
             }
-        }
+        });
 
         finalRect = widenedRect;
 
@@ -3533,41 +4027,50 @@ namespace Ogre
 
         Real heightPad = (getMaxHeight() - getMinHeight()) * 1.0e-3f;
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        HeightBoundsPyramid bounds(this);
+
+        const long blockRows = 16;
+        size_t blockCount = (widenedRect.height() + blockRows - 1) / blockRows;
+        parallelFor(blockCount, [&](size_t block)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            long yBegin = widenedRect.top + block * blockRows;
+            long yEnd = std::min(yBegin + blockRows, widenedRect.bottom);
+            for (long y = yBegin; y < yEnd; ++y)
             {
-                float litVal = 1.0f;
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
+                {
+                    float litVal = 1.0f;
 
-                // convert to terrain space (not points, allow this to go between points)
-                float Tx = (float)x / (float)(mLightmapSizeActual-1);
-                float Ty = (float)y / (float)(mLightmapSizeActual-1);
+                    // convert to terrain space (not points, allow this to go between points)
+                    float Tx = (float)x / (float)(mLightmapSizeActual-1);
+                    float Ty = (float)y / (float)(mLightmapSizeActual-1);
 
-                // get world space point
-                // add a little height padding to stop shadowing self
-                Vector3 wpos = Vector3::ZERO;
-                getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
-                wpos += getPosition();
-                // build ray, cast backwards along light direction
-                Ray ray(wpos, -lightVec);
+                    // get world space point
+                    // add a little height padding to stop shadowing self
+                    Vector3 wpos = Vector3::ZERO;
+                    getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
+                    wpos += getPosition();
+                    // build ray, cast backwards along light direction
+                    Ray ray(wpos, -lightVec);
 
-                // Cascade into neighbours when casting, but don't travel further
-                // than world size
-                std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
+                    // Cascade into neighbours when casting, but don't travel further
+                    // than world size
+                    std::pair<bool, Vector3> rayHit = rayIntersectsImpl(ray, true, mWorldSize, &bounds);
 
-                if (rayHit.first)
-                    litVal = 0.0f;
+                    if (rayHit.first)
+                        litVal = 0.0f;
 
-                // encode as L8
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                    // encode as L8
+                    // invert the Y to deal with image space
+                    long storeX = x - widenedRect.left;
+                    long storeY = widenedRect.bottom - y - 1;
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
-                *pStore = (unsigned char)(litVal * 255.0);
+                    uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
+                    *pStore = (unsigned char)(litVal * 255.0);
 
+                }
             }
-        }
+        });
 
         return pixbox;
 
@@ -32,6 +32,9 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreTerrainAutoUpdateLod.h"
 #include "OgreTerrainMaterialGeneratorA.h"
+#include "OgreCamera.h"
+#include "OgreViewport.h"
+#include "OgreTaskScheduler.h"
 #include <cmath>
 #include <iomanip>
 
@@ -66,6 +69,8 @@ namespace Ogre
         wq->addRequestHandler(mWorkQueueChannel, this);
         wq->addResponseHandler(mWorkQueueChannel, this);
 
+        // registered before any of our terrains, so we are called first
+        mSceneManager->addListener(this);
     }
     //---------------------------------------------------------------------
     TerrainGroup::TerrainGroup(SceneManager* sm)
@@ -90,6 +95,8 @@ namespace Ogre
         mWorkQueueChannel = wq->getChannel("Ogre/TerrainGroup");
         wq->addRequestHandler(mWorkQueueChannel, this);
         wq->addResponseHandler(mWorkQueueChannel, this);
+
+        mSceneManager->addListener(this);
     }
     //---------------------------------------------------------------------
     TerrainGroup::~TerrainGroup()
@@ -113,6 +120,8 @@ namespace Ogre
         wq->removeRequestHandler(mWorkQueueChannel, this);
         wq->removeResponseHandler(mWorkQueueChannel, this);
 
+        if (mSceneManager)
+            mSceneManager->removeListener(this);
     }
     //---------------------------------------------------------------------
     void TerrainGroup::setOrigin(const Vector3& pos)
@@ -287,11 +296,16 @@ namespace Ogre
     }
     //---------------------------------------------------------------------
     void TerrainGroup::loadTerrain(long x, long y, bool synchronous /*= false*/)
+    {
+        loadTerrain(x, y, synchronous, WorkQueue::RP_NORMAL);
+    }
+    //---------------------------------------------------------------------
+    void TerrainGroup::loadTerrain(long x, long y, bool synchronous, uint8 priority)
     {
         TerrainSlot* slot = getTerrainSlot(x, y, false);
         if (slot)
         {
-            loadTerrainImpl(slot, synchronous);
+            loadTerrainImpl(slot, synchronous, priority);
         }
 
     }
@@ -362,7 +376,7 @@ namespace Ogre
     }
 
     //---------------------------------------------------------------------
-    void TerrainGroup::loadTerrainImpl(TerrainSlot* slot, bool synchronous)
+    void TerrainGroup::loadTerrainImpl(TerrainSlot* slot, bool synchronous, uint8 priority)
     {
         if (!slot->instance && 
             (!slot->def.filename.empty() || slot->def.importData))
@@ -378,15 +392,28 @@ namespace Ogre
             req.origin = this;
             std::pair<TerrainPrepareRequestMap::iterator, bool> ret = mTerrainPrepareRequests.emplace(slot, 0);
             assert(ret.second == true);
-            WorkQueue::RequestID id =
-                Root::getSingleton().getWorkQueue()->addRequest(
-                    mWorkQueueChannel, WORKQUEUE_LOAD_REQUEST,
-                    Any(req), 0, synchronous);
-            if (!synchronous)
-                ret.first->second = id;
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            if (synchronous)
+                wq->addRequest(mWorkQueueChannel, WORKQUEUE_LOAD_REQUEST, Any(req), 0, true);
+            else
+                ret.first->second = wq->addPrioritisedRequest(mWorkQueueChannel, WORKQUEUE_LOAD_REQUEST,
+                    Any(req), priority);
         }
     }
     //---------------------------------------------------------------------
+    bool TerrainGroup::setTerrainLoadPriority(long x, long y, uint8 priority)
+    {
+        TerrainSlot* slot = getTerrainSlot(x, y, false);
+        if (!slot)
+            return false;
+
+        TerrainPrepareRequestMap::iterator it = mTerrainPrepareRequests.find(slot);
+        if (it == mTerrainPrepareRequests.end() || !it->second)
+            return false;
+
+        return Root::getSingleton().getWorkQueue()->setRequestPriority(it->second, priority);
+    }
+    //---------------------------------------------------------------------
     void TerrainGroup::increaseLodLevel(long x, long y, bool synchronous /* = false */)
     {
         TerrainSlot* slot = getTerrainSlot(x, y, false);
@@ -512,7 +539,100 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    void TerrainGroup::getHeightsAtWorldPositions(const Vector3* positions, size_t count,
+        float* outHeights, Terrain** outTerrains /* = 0 */, Vector3* outNormals /* = 0 */) const
+    {
+        std::vector<std::pair<uint32, size_t> > order;
+        sortBySlot(positions, count, order);
+
+        // gather the positions, so that every terrain gets a contiguous batch
+        std::vector<Vector3> sorted(count);
+        std::vector<size_t> runs;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sorted[i] = positions[order[i].second];
+            if (i == 0 || order[i].first != order[i - 1].first)
+                runs.push_back(i);
+        }
+        runs.push_back(count);
+
+        std::vector<float> heights(count);
+        std::vector<Vector3> normals(outNormals ? count : 0);
+        std::vector<Terrain*> terrains(count);
+        parallelFor(runs.size() - 1, [&](size_t run)
+        {
+            size_t begin = runs[run], end = runs[run + 1];
+            long x, y;
+            convertWorldPositionToTerrainSlot(sorted[begin], &x, &y);
+            TerrainSlot* slot = getTerrainSlot(x, y);
+            Terrain* terrain = slot && slot->instance && slot->instance->isLoaded() ? slot->instance : 0;
+            if (terrain)
+            {
+                terrain->getHeightsAtWorldPositions(&sorted[begin], end - begin, &heights[begin],
+                    outNormals ? &normals[begin] : 0);
+            }
+            else
+            {
+                std::fill(heights.begin() + begin, heights.begin() + end, 0.0f);
+                if (outNormals)
+                    std::fill(normals.begin() + begin, normals.begin() + end, Vector3::ZERO);
+            }
+            std::fill(terrains.begin() + begin, terrains.begin() + end, terrain);
+        });
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t index = order[i].second;
+            outHeights[index] = heights[i];
+            if (outTerrains)
+                outTerrains[index] = terrains[i];
+            if (outNormals)
+                outNormals[index] = normals[i];
+        }
+    }
+    //---------------------------------------------------------------------
+    void TerrainGroup::sortBySlot(const Vector3* positions, size_t count,
+        std::vector<std::pair<uint32, size_t> >& order) const
+    {
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            long x, y;
+            convertWorldPositionToTerrainSlot(positions[i], &x, &y);
+            order[i] = std::make_pair(packIndex(x, y), i);
+        }
+        std::sort(order.begin(), order.end());
+    }
+    //---------------------------------------------------------------------
     TerrainGroup::RayResult TerrainGroup::rayIntersects(const Ray& ray, Real distanceLimit /* = 0*/) const 
+    {
+        return rayIntersectsImpl(ray, distanceLimit, false);
+    }
+    //---------------------------------------------------------------------
+    void TerrainGroup::rayIntersects(const Ray* rays, size_t count, RayResult* results,
+        Real distanceLimit /* = 0 */) const
+    {
+        // rays starting in the same slot will mostly visit the same terrains
+        std::vector<Vector3> origins(count);
+        for (size_t i = 0; i < count; ++i)
+            origins[i] = rays[i].getOrigin();
+        std::vector<std::pair<uint32, size_t> > order;
+        sortBySlot(origins.empty() ? 0 : &origins[0], count, order);
+
+        const size_t blockSize = 16;
+        parallelFor((count + blockSize - 1) / blockSize, [&](size_t block)
+        {
+            size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i)
+            {
+                size_t index = order[i].second;
+                results[index] = rayIntersectsImpl(rays[index], distanceLimit, true);
+            }
+        });
+    }
+    //---------------------------------------------------------------------
+    TerrainGroup::RayResult TerrainGroup::rayIntersectsImpl(const Ray& ray, Real distanceLimit,
+        bool batched) const
     {
         long curr_x, curr_z;
         convertWorldPositionToTerrainSlot(ray.getOrigin(), &curr_x, &curr_z);
@@ -627,7 +747,11 @@ namespace Ogre
             {
                 numGaps = 0;
                 // don't cascade into neighbours
-                std::pair<bool, Vector3> raypair = slot->instance->rayIntersects(ray, false, distanceLimit);
+                std::pair<bool, Vector3> raypair;
+                if (batched)
+                    slot->instance->rayIntersects(&ray, 1, &raypair, false, distanceLimit);
+                else
+                    raypair = slot->instance->rayIntersects(ray, false, distanceLimit);
                 if (raypair.first)
                 {
                     keepSearching = false;
@@ -826,6 +950,44 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    void TerrainGroup::preFindVisibleObjects(SceneManager* source,
+        SceneManager::IlluminationRenderStage irs, Viewport* v)
+    {
+        mLodUpdateTerrains.clear();
+        for (TerrainSlotMap::iterator i = mTerrainSlots.begin(); i != mTerrainSlots.end(); ++i)
+        {
+            Terrain* t = i->second->instance;
+            if (t && t->isLoaded())
+                mLodUpdateTerrains.push_back(t);
+        }
+        // a single terrain is just as well updated by its own listener
+        if (mLodUpdateTerrains.size() < 2)
+            return;
+
+        // derive everything lazily computed on the main thread, then the
+        // terrains only read shared state while calculating their LOD
+        const Camera* lodCamera = v->getCamera()->getLodCamera();
+        lodCamera->getDerivedPosition();
+        lodCamera->getViewMatrix();
+        lodCamera->getProjectionMatrix();
+        lodCamera->getFrustumPlanes();
+        if (const Frustum* cullFrustum = lodCamera->getCullingFrustum())
+            cullFrustum->getFrustumPlanes();
+        for (size_t i = 0; i < mLodUpdateTerrains.size(); ++i)
+            mLodUpdateTerrains[i]->_prepareLodUpdate();
+
+        parallelFor(mLodUpdateTerrains.size(), [this, v](size_t i)
+        {
+            mLodUpdateTerrains[i]->_updateLod(v);
+        });
+    }
+    //---------------------------------------------------------------------
+    void TerrainGroup::sceneManagerDestroyed(SceneManager* source)
+    {
+        if (source == mSceneManager)
+            mSceneManager = 0;
+    }
+    //---------------------------------------------------------------------
     void TerrainGroup::connectNeighbour(TerrainSlot* slot, long offsetx, long offsety)
     {
         TerrainSlot* neighbourSlot = getTerrainSlot(slot->x + offsetx, slot->y + offsety);
@@ -31,12 +31,14 @@ THE SOFTWARE.
 #include "OgreStreamSerialiser.h"
 #include "OgreLogManager.h"
 #include "OgreTerrain.h"
+#include "OgreDeflate.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
     const uint16 TerrainLodManager::WORKQUEUE_LOAD_LOD_DATA_REQUEST = 1;
     const uint32 TerrainLodManager::TERRAINLODDATA_CHUNK_ID = StreamSerialiser::makeIdentifier("TLDA");
-    const uint16 TerrainLodManager::TERRAINLODDATA_CHUNK_VERSION = 1;
+    const uint16 TerrainLodManager::TERRAINLODDATA_CHUNK_VERSION = 2;
 
     TerrainLodManager::TerrainLodManager(Terrain* t, DataStreamPtr& stream)
         : mTerrain(t)
@@ -312,16 +314,44 @@ namespace Ogre
         separateData(terrain->mHeightData, terrain->getSize(), numLodLevels, lods);
         separateData(terrain->mDeltaData, terrain->getSize(), numLodLevels, lods);
 
+        uint8 compression = getDefaultCompression();
         for (int level = numLodLevels - 1; level >=0; level--)
         {
             stream.writeChunkBegin(TERRAINLODDATA_CHUNK_ID, TERRAINLODDATA_CHUNK_VERSION);
-            stream.startDeflate();
+            stream.write(&compression);
+            if (compression == COMPRESSION_DEFLATE)
+                stream.startDeflate();
             stream.write(&(lods[level][0]), lods[level].size());
-            stream.stopDeflate();
+            if (compression == COMPRESSION_DEFLATE)
+                stream.stopDeflate();
             stream.writeChunkEnd(TERRAINLODDATA_CHUNK_ID);
         }
     }
 
+    uint8 TerrainLodManager::getDefaultCompression()
+    {
+#if OGRE_NO_ZIP_ARCHIVE == 0
+        return COMPRESSION_DEFLATE;
+#else
+        return COMPRESSION_NONE;
+#endif
+    }
+
+    DataStreamPtr TerrainLodManager::decompress(const DataStreamPtr& stored, uint8 compression)
+    {
+        if (compression == COMPRESSION_NONE)
+            return stored;
+#if OGRE_NO_ZIP_ARCHIVE == 0
+        if (compression == COMPRESSION_DEFLATE)
+        {
+            DeflateStream inflater(stored, "", stored->size());
+            return DataStreamPtr(OGRE_NEW MemoryDataStream(inflater));
+        }
+#endif
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                    "Terrain data is compressed in an unsupported way", "TerrainLodManager::decompress");
+    }
+
     void TerrainLodManager::readLodData(uint16 lowerLodBound, uint16 higherLodBound)
     {
         if(!mDataStream) // No file to read from
@@ -346,28 +376,45 @@ namespace Ogre
                 stream.readChunkEnd(TERRAINLODDATA_CHUNK_ID);
             }
 
-            // uncompress
-            uint maxSize = 2 * mTerrain->getGeoDataSizeAtLod(higherLodBound);
-            float *lodData = OGRE_ALLOC_T(float, maxSize, MEMCATEGORY_GENERAL);
-
+            // read the stored data of all levels, before any of it is uncompressed
+            std::vector<DataStreamPtr> lodStreams;
+            std::vector<uint8> compression;
             for(int level=lowerLodBound; level>=higherLodBound; level-- )
             {
-                // both height data and delta data
-                uint dataSize = 2 * mTerrain->getGeoDataSizeAtLod(level);
-
-                // reach and read the target lod data
                 const StreamSerialiser::Chunk *c = stream.readChunkBegin(TERRAINLODDATA_CHUNK_ID,
                         TERRAINLODDATA_CHUNK_VERSION);
-                stream.startDeflate(c->length);
-                stream.read(lodData, dataSize);
-                stream.stopDeflate();
+                size_t length = c->length;
+                if (c->version > 1)
+                {
+                    uint8 type;
+                    stream.read(&type);
+                    compression.push_back(type);
+                    length -= sizeof(uint8);
+                }
+                else
+                    compression.push_back(COMPRESSION_DEFLATE);
+                MemoryDataStream* stored = OGRE_NEW MemoryDataStream(length, true, true);
+                stream.read(stored->getPtr(), length);
+                lodStreams.push_back(DataStreamPtr(stored));
                 stream.readChunkEnd(TERRAINLODDATA_CHUNK_ID);
-
-                fillBufferAtLod(level, lodData, dataSize);
             }
             stream.readChunkEnd(Terrain::TERRAIN_CHUNK_ID);
 
-            OGRE_FREE(lodData, MEMCATEGORY_GENERAL);
+            // every level fills its own vertices, so they can be processed in parallel
+            parallelFor(lodStreams.size(), [&](size_t i)
+            {
+                uint level = lowerLodBound - static_cast<uint>(i);
+                // both height data and delta data
+                uint dataSize = 2 * mTerrain->getGeoDataSizeAtLod(level);
+                float *lodData = OGRE_ALLOC_T(float, dataSize, MEMCATEGORY_GENERAL);
+
+                StreamSerialiser lodStream(decompress(lodStreams[i], compression[i]),
+                    stream.getEndian(), false, stream.getRealStorageFormat());
+                lodStream.read(lodData, dataSize);
+                fillBufferAtLod(level, lodData, dataSize);
+
+                OGRE_FREE(lodData, MEMCATEGORY_GENERAL);
+            });
         }
     }
     void TerrainLodManager::fillBufferAtLod(uint lodLevel, const float* data, uint dataSize )
@@ -396,6 +443,7 @@ namespace Ogre
             if (y+inc > size)
                 break;
         }
+        mTerrain->dirtyHeightBounds(Rect(0, 0, size, size));
     }
     void TerrainLodManager::waitForDerivedProcesses()
     {
@@ -225,7 +225,7 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
-    void TerrainPagedWorldSection::loadPage(PageID pageID, bool forceSynchronous)
+    void TerrainPagedWorldSection::loadPage(PageID pageID, bool forceSynchronous, uint8 priority)
     {
         if (!mParent->getManager()->getPagingOperationsEnabled())
             return;
@@ -233,12 +233,33 @@ namespace Ogre
         PageMap::iterator i = mPages.find(pageID);
         if (i == mPages.end())
         {
-            std::list<PageID>::iterator it = find( mPagesInLoading.begin(), mPagesInLoading.end(), pageID);
+            // a single pass finds the page and the place its priority puts it at, the
+            // front page is being defined in the background and stays where it is
+            std::list<PageLoad>::iterator it = mPagesInLoading.begin();
+            std::list<PageLoad>::iterator pos = mPagesInLoading.end();
+            for( ; it!=mPagesInLoading.end() && it->pageID!=pageID; ++it)
+            {
+                if(pos==mPagesInLoading.end() && it!=mPagesInLoading.begin() && it->priority<priority)
+                    pos = it;
+            }
+
             if(it==mPagesInLoading.end())
             {
-                mPagesInLoading.push_back(pageID);
+                PageLoad load = { pageID, priority };
+                mPagesInLoading.insert(pos, load);
                 mHasRunningTasks = true;
             }
+            else if(it!=mPagesInLoading.begin() && it->priority!=priority)
+            {
+                // moves up in front of pos, or down behind the pages it now ranks below
+                it->priority = priority;
+                if(pos==mPagesInLoading.end())
+                {
+                    pos = it;
+                    while(++pos!=mPagesInLoading.end() && pos->priority>=priority) {}
+                }
+                mPagesInLoading.splice(pos, mPagesInLoading, it);
+            }
             
             // no running tasks, start the new one
             if(mPagesInLoading.size()==1)
@@ -249,7 +270,7 @@ namespace Ogre
             }
         }
 
-        PagedWorldSection::loadPage(pageID, forceSynchronous);
+        PagedWorldSection::loadPage(pageID, forceSynchronous, priority);
     }
     //---------------------------------------------------------------------
     void TerrainPagedWorldSection::unloadPage(PageID pageID, bool forceSynchronous)
@@ -259,7 +280,9 @@ namespace Ogre
 
         PagedWorldSection::unloadPage(pageID, forceSynchronous);
 
-        std::list<PageID>::iterator it = find( mPagesInLoading.begin(), mPagesInLoading.end(), pageID);
+        std::list<PageLoad>::iterator it = mPagesInLoading.begin();
+        while(it!=mPagesInLoading.end() && it->pageID!=pageID)
+            ++it;
         // hasn't been loaded, just remove from the queue
         if(it!=mPagesInLoading.end())
         {
@@ -291,7 +314,7 @@ namespace Ogre
             OGRE_THREAD_SLEEP(mNextLoadingTime - currentTime);
         }
 
-        PageID pageID = mPagesInLoading.front();
+        PageID pageID = mPagesInLoading.front().pageID;
 
         // call the TerrainDefiner from the background thread
         long x, y;
@@ -311,13 +334,13 @@ namespace Ogre
     {
         if(!mPagesInLoading.empty())
         {
-            PageID pageID = mPagesInLoading.front();
+            const PageLoad& load = mPagesInLoading.front();
 
             // trigger terrain load
             long x, y;
             // pageID is the same as a packed index
-            mTerrainGroup->unpackIndex(pageID, &x, &y);
-            mTerrainGroup->loadTerrain(x, y, false);
+            mTerrainGroup->unpackIndex(load.pageID, &x, &y);
+            mTerrainGroup->loadTerrain(x, y, false, load.priority);
             mPagesInLoading.pop_front();
 
             unsigned long currentTime = Root::getSingletonPtr()->getTimer()->getMilliseconds();
@@ -272,7 +272,10 @@ namespace Ogre
             mLocalNode = mTerrain->_getRootSceneNode()->createChildSceneNode(mLocalCentre);
 
         if (!mMovable->isAttached())
+        {
             mLocalNode->attachObject(mMovable);
+            mTerrain->_dirtyLod();
+        }
     }
     //---------------------------------------------------------------------
     void TerrainQuadTreeNode::unload()
@@ -284,7 +287,10 @@ namespace Ogre
         destroyGpuVertexData();
 
         if (mMovable->isAttached())
+        {
             mLocalNode->detachObject(mMovable);
+            mTerrain->_dirtyLod();
+        }
     }
 
     void TerrainQuadTreeNode::unload(uint16 treeDepthStart, uint16 treeDepthEnd)
@@ -300,7 +306,10 @@ namespace Ogre
         {
             destroyGpuVertexData();
             if (mMovable->isAttached())
+            {
                 mLocalNode->detachObject(mMovable);
+                mTerrain->_dirtyLod();
+            }
 
         }
     }
@@ -71,6 +71,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** A plane.
@@ -102,6 +110,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** A not rotated cube.
@@ -244,6 +260,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** Builds the union between two sources.
@@ -271,6 +295,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** Builds the difference between two sources.
@@ -299,6 +331,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -359,6 +399,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     /** Scales the given volume source.
@@ -386,6 +434,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
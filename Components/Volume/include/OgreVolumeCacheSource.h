@@ -29,10 +29,13 @@ THE SOFTWARE.
 #define __Ogre_Volume_CacheSource_H__
 
 #include "OgreVector4.h"
+#include "Threading/OgreThreadHeaders.h"
 
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
 
+#include <atomic>
+
 namespace Ogre {
 namespace Volume {
     /** \addtogroup Optional
@@ -52,48 +55,128 @@ namespace Volume {
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
     /** A caching Source.
+    @remarks
+        The density values and gradients are kept in a bounded hash table, which is split
+        into shards with their own lock, so the source can be shared by the chunks loading
+        in parallel. When a shard is full, entries which were not used since the last sweep
+        are evicted (clock algorithm).
+    @par
+        Positions can optionally be snapped to a lattice before the lookup, so samples of
+        neighbouring chunks, which only differ by rounding, share one entry. The wrapped source
+        is then evaluated at the snapped position.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
+    public:
+
+        /// The default memory budget of the cache in bytes.
+        static const size_t DEFAULT_MEMORY_BUDGET;
+
     protected:
-        
-        /// Map for the cache
-        typedef std::map<Vector3, Vector4> UMapPositionValue;
-        mutable UMapPositionValue mCache;
+
+        /// The amount of independently locked parts of the cache.
+        static const size_t SHARD_COUNT = 16;
+
+        /// A cached density value and gradient.
+        typedef struct Entry
+        {
+            /// The (snapped) position.
+            Vector3 position;
+            /// The density value (w-component) and the gradient (x, y and z component).
+            Vector4 value;
+            /// Whether the entry holds a value.
+            bool used;
+            /// Whether the entry was read since the clock hand passed it.
+            bool referenced;
+        } Entry;
+
+        /// To hold the entries of a shard.
+        typedef std::vector<Entry> VecEntry;
+
+        /// An open addressing hash table with linear probing.
+        typedef struct Shard
+        {
+            OGRE_WQ_MUTEX(mutex);
+            VecEntry entries;
+            /// The amount of used entries.
+            size_t count;
+            /// The position of the clock hand.
+            size_t hand;
+        } Shard;
+
+        /// The shards of the cache.
+        mutable Shard mShards[SHARD_COUNT];
+
+        /// The capacity of each shard, a power of two.
+        size_t mShardCapacity;
+
+        /// The maximum amount of used entries of each shard.
+        size_t mShardMaxCount;
+
+        /// The configured memory budget in bytes.
+        size_t mMemoryBudget;
+
+        /// The lattice spacing of the positions, 0 for the exact positions.
+        Real mQuantum;
+
+        /// The amount of lookups, which were answered from the cache.
+        mutable std::atomic<size_t> mHits;
+
+        /// The amount of lookups, which needed the source.
+        mutable std::atomic<size_t> mMisses;
+
+        /// The amount of evicted entries.
+        mutable std::atomic<size_t> mEvictions;
 
         /// The source to cache.
         const Source *mSrc;
-        
+
+        /** Hashes a position.
+        @param position
+            The position.
+        @return
+            The hash value.
+        */
+        static size_t hash(const Vector3 &position);
+
+        /** Gets the index of the entry of a position in a shard or the free slot to insert it.
+        @param shard
+            The shard to search.
+        @param position
+            The position.
+        @param h
+            The hash of the position.
+        @return
+            The index of the entry.
+        */
+        size_t findSlot(const Shard &shard, const Vector3 &position, size_t h) const;
+
+        /** Evicts one entry of a full shard.
+        @param shard
+            The shard.
+        */
+        void evict(Shard &shard) const;
+
         /** Gets a density value and gradient from the cache.
         @param position
             The position of the density value and gradient.
         @return
             The density value (w-component) and the gradient (x, y and z component).
         */
-        inline Vector4 getFromCache(const Vector3 &position) const
-        {
-            Vector4 result;
-            std::map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
-            {
-                result = it->second;
-            }
-            return result;
-        }
+        Vector4 getFromCache(const Vector3 &position) const;
 
     public:
         
         /** Constructor.
         @param src
             The source to cache.
+        @param memoryBudget
+            The maximum amount of memory of the cached entries in bytes.
+        @param quantum
+            The lattice spacing the positions are snapped to, 0 to cache the exact positions.
         */
-        CacheSource(const Source *src);
-        
+        CacheSource(const Source *src, size_t memoryBudget = DEFAULT_MEMORY_BUDGET, Real quantum = 0);
+
         /** Overridden from Source.
         */
         virtual Vector4 getValueAndGradient(const Vector3 &position) const;
@@ -102,6 +185,67 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Sets the memory budget, which clears the cache.
+        @param memoryBudget
+            The maximum amount of memory of the cached entries in bytes.
+        */
+        void setMemoryBudget(size_t memoryBudget);
+
+        /** Gets the memory budget.
+        @return
+            The maximum amount of memory of the cached entries in bytes.
+        */
+        size_t getMemoryBudget(void) const
+        {
+            return mMemoryBudget;
+        }
+
+        /** Gets the amount of entries, which fit into the memory budget.
+        @return
+            The capacity.
+        */
+        size_t getCapacity(void) const
+        {
+            return mShardMaxCount * SHARD_COUNT;
+        }
+
+        /** Gets the amount of currently cached entries.
+        @return
+            The amount of entries.
+        */
+        size_t getCachedCount(void) const;
+
+        /** Gets the amount of lookups, which were answered from the cache.
+        @return
+            The hit count.
+        */
+        size_t getHits(void) const
+        {
+            return mHits.load(std::memory_order_relaxed);
+        }
+
+        /** Gets the amount of lookups, which needed to evaluate the source.
+        @return
+            The miss count.
+        */
+        size_t getMisses(void) const
+        {
+            return mMisses.load(std::memory_order_relaxed);
+        }
+
+        /** Gets the amount of entries, which were evicted to stay in the memory budget.
+        @return
+            The eviction count.
+        */
+        size_t getEvictions(void) const
+        {
+            return mEvictions.load(std::memory_order_relaxed);
+        }
+
+        /** Removes all entries and resets the counters.
+        */
+        void clear(void);
+
     };
     /** @} */
     /** @} */
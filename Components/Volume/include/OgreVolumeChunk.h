@@ -46,6 +46,7 @@ namespace Volume {
     class Source;
     class MeshBuilderCallback;
     class ChunkHandler;
+    struct ChunkRequest;
     class MeshBuilder;
     class DualGridGenerator;
     class OctreeNode;
@@ -96,12 +97,15 @@ namespace Volume {
         /// Whether to load the chunks async. if set to false, the call to load waits for the whole chunk. false is the default.
         bool async;
 
+        /// Whether the chunks keep their octrees, so an update just re-splits the nodes within updateFrom and updateTo. Costs the memory of the octrees, false is the default.
+        bool incrementalUpdate;
+
         /** Constructor.
         */
         ChunkParameters(void) :
             sceneManager(0), src(0), baseError((Real)0.0), errorMultiplicator((Real)1.0), createOctreeVisualization(false),
             createDualGridVisualization(false), skirtFactor(0), lodCallback(0), scale((Real)1.0), maxScreenSpaceError(0), createGeometryFromLevel(0),
-            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false)
+            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false), incrementalUpdate(false)
         {
         }
     } ChunkParameters;
@@ -178,6 +182,18 @@ namespace Volume {
         /// Holds some shared data among all chunks of the tree.
         ChunkTreeSharedData *mShared;
 
+        /// The octree of the last load, kept for incremental updates. Only touched on the main thread.
+        OctreeNode *mOctreeRoot;
+
+        /// The amount of requests of this chunk the WorkQueue works on.
+        size_t mRequestsInFlight;
+
+        /// The area of the incremental updates, which came while the octree was in flight.
+        AxisAlignedBox mPendingUpdate;
+
+        /// Whether the octree in flight missed a change and is to be dropped once it is back.
+        bool mDropOctreeInFlight;
+
         /** Loads a single chunk of the tree.
         @param parent
             The parent scene node for the volume
@@ -242,6 +258,15 @@ namespace Volume {
             The maximum amount of levels.
         */
         virtual void doLoad(SceneNode *parent, const Vector3 &from, const Vector3 &to, const Vector3 &totalFrom, const Vector3 &totalTo, const size_t level, const size_t maxLevels);
+
+        /** Publishes the octree of a processed request and starts the updates, which waited for it.
+        @param req
+            The request the WorkQueue processed, its root is null if it failed.
+        */
+        void requestDone(const ChunkRequest &req);
+
+        /// Frees the geometry of the chunk before it gets loaded again.
+        void freeGeometry(void);
         
         /** Prepares the geometry of the chunk request. To be called in a different thread.
         @param level
@@ -256,8 +281,11 @@ namespace Volume {
             The back lower left corner of the world.
         @param totalTo
             The front upper rightcorner of the world.
+        @param resplitRegion
+            The area to re-split the given octree in, null to split it completely.
         */
-        virtual void prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo);
+        virtual void prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo,
+            const AxisAlignedBox &resplitRegion);
 
         /** Loads the actual geometry when the processing is done.
         @param meshBuilder
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_Chunk_Handler_H__
 
 #include "OgreWorkQueue.h"
+#include "OgreAxisAlignedBox.h"
 
 #include "OgreVolumePrerequisites.h"
 
@@ -58,6 +59,12 @@ namespace Volume {
         /// The front upper rightcorner of the world.
         Vector3 totalTo;
 
+        /// The back lower left corner of the chunk.
+        Vector3 from;
+
+        /// The front upper right corner of the chunk.
+        Vector3 to;
+
         /// The current LOD level.
         size_t level;
 
@@ -78,6 +85,9 @@ namespace Volume {
 
         /// Whether this is an update of an existing tree
         bool isUpdate;
+
+        /// The area to re-split the kept octree in. Null to split a new octree.
+        AxisAlignedBox resplitRegion;
         
         /** Stream operator <<.
         @param o
@@ -103,6 +113,9 @@ namespace Volume {
 
         /// The workqueue channel.
         uint16 mWorkQueueChannel;
+
+        /// The amount of chunk trees using the handler.
+        size_t mTrees;
         
         /** Initializes the WorkQueue (once).
         */
@@ -118,6 +131,15 @@ namespace Volume {
         */
         virtual ~ChunkHandler(void);
         
+        /** Registers a chunk tree, which will send requests.
+        */
+        void addTree(void);
+
+        /** Unregisters a chunk tree. After the last one, the handler leaves the WorkQueue,
+            the next tree might use the one of another Root.
+        */
+        void removeTree(void);
+
         /** Adds a new ChunkRequest to be loaded to the WorkQueue.
         @param req
             The ChunkRequest.
@@ -101,6 +101,23 @@ namespace Volume {
         /// The total to.
         Vector3 mTotalTo;
 
+        /// A dualcell, which is still to be contoured.
+        typedef struct PendingCell
+        {
+            Vector3 corners[8];
+            Vector4 values[8];
+            bool hasValues;
+        } PendingCell;
+
+        /// To hold the dualcells to be contoured.
+        typedef std::vector<PendingCell> VecPendingCell;
+
+        /// The dualcells of the current generation, contoured after the grid is complete.
+        VecPendingCell mPendingCells;
+
+        /// The amount of dualcells contoured by one task.
+        static const size_t CELLS_PER_TASK;
+
         /** Adds a dualcell.
          @param c0
             The first corner.
@@ -150,45 +167,78 @@ namespace Volume {
             {
                 mDualCells.push_back(DualCell(c0, c1, c2, c3, c4, c5, c6, c7));
             }
+            mPendingCells.push_back(PendingCell());
+            PendingCell &cell = mPendingCells.back();
+            cell.corners[0] = c0;
+            cell.corners[1] = c1;
+            cell.corners[2] = c2;
+            cell.corners[3] = c3;
+            cell.corners[4] = c4;
+            cell.corners[5] = c5;
+            cell.corners[6] = c6;
+            cell.corners[7] = c7;
+            cell.hasValues = values != 0;
+            if (values)
+            {
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    cell.values[i] = values[i];
+                }
+            }
+        }
 
-            Vector3 corners[8];
-            corners[0] = c0;
-            corners[1] = c1;
-            corners[2] = c2;
-            corners[3] = c3;
-            corners[4] = c4;
-            corners[5] = c5;
-            corners[6] = c6;
-            corners[7] = c7;
-            mIs->addMarchingCubesTriangles(corners, values, mMb);
+        /** Contours a dualcell with Marching Cubes and the skirts with Marching Squares.
+        @param corners
+            The corners of the cell.
+        @param mcValues
+            The values at the corners for Marching Cubes or 0 to calculate them.
+        @param msValues
+            The values at the corners for Marching Squares or 0 to calculate them.
+        @param mb
+            To store the triangles of the contour.
+        */
+        inline void contourCell(const Vector3 *corners, const Vector4 *mcValues, const Vector4 *msValues, MeshBuilder *mb) const
+        {
+            mIs->addMarchingCubesTriangles(corners, mcValues, mb);
             Vector3 from = mRoot->getFrom();
             Vector3 to = mRoot->getTo();
             if (corners[0].z == from.z && corners[0].z != mTotalFrom.z)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_BACK, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_BACK, mMaxMSDistance, mb);
             }
             if (corners[2].z == to.z && corners[2].z != mTotalTo.z)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_FRONT, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_FRONT, mMaxMSDistance, mb);
             }
             if (corners[0].x == from.x && corners[0].x != mTotalFrom.x)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_LEFT, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_LEFT, mMaxMSDistance, mb);
             }
             if (corners[1].x == to.x && corners[1].x != mTotalTo.x)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_RIGHT, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_RIGHT, mMaxMSDistance, mb);
             }
             if (corners[5].y == to.y && corners[5].y != mTotalTo.y)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_TOP, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_TOP, mMaxMSDistance, mb);
             }
             if (corners[0].y == from.y && corners[0].y != mTotalFrom.y)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_BOTTOM, mMaxMSDistance, mMb);
+                mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_BOTTOM, mMaxMSDistance, mb);
             }
         }
 
+        /** Contours a range of the pending dualcells. The densities of cells without
+            values are fetched from the source in one batch.
+        @param start
+            The first cell.
+        @param end
+            One after the last cell.
+        @param mb
+            To store the triangles of the contour.
+        */
+        void contourCells(size_t start, size_t end, MeshBuilder *mb) const;
+
         /* Startpoint for the creation recursion.
         @param n
             The node to start with.
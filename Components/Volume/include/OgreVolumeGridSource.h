@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_GridSource_H__
 
 #include "OgreVector4.h"
+#include "OgreAxisAlignedBox.h"
 
 #include "OgreVolumePrerequisites.h"
 #include "OgreVolumeSource.h"
@@ -49,6 +50,9 @@ namespace Volume {
     {
     protected:
 
+        /// The amount of cells around the changed ones, whose positions might have changed values, too.
+        static const int DIRTY_BORDER;
+
         /// The texture width.
         size_t mWidth;
 
@@ -78,6 +82,9 @@ namespace Volume {
 
         /// Factor to come from volume coordinate to world coordinate.
         Real mVolumeSpaceToWorldSpaceFactor;
+
+        /// The area, in which the values or gradients changed since the last clearDirtyRegion.
+        AxisAlignedBox mDirtyRegion;
         
         /** Overridden from VolumeSource.
         */
@@ -191,6 +198,24 @@ namespace Volume {
             because the density outside of the sphere is needed, too.
         */
         virtual void combineWithSource(CSGOperationSource *operation, Source *source, const Vector3 &center, Real radius);
+
+        /** Gets the area, in which the values or gradients might have changed by combineWithSource
+            since the last call of clearDirtyRegion. Use it as updateFrom and updateTo of the
+            ChunkParameters to remesh just the changed part.
+        @return
+            The changed area, null if nothing changed.
+        */
+        const AxisAlignedBox& getDirtyRegion(void) const
+        {
+            return mDirtyRegion;
+        }
+
+        /** Forgets the changed area, for example after the mesh got updated.
+        */
+        void clearDirtyRegion(void)
+        {
+            mDirtyRegion.setNull();
+        }
     
         
         /** Overridden from VolumeSource.
@@ -82,6 +82,15 @@ namespace Volume {
 
         virtual ~IsoSurface(void);
         
+        /** Gets the source of the density values.
+        @return
+            The source.
+        */
+        const Source *getSource(void) const
+        {
+            return mSrc;
+        }
+
         /** Adds triangles to a MeshBuilder via Marching Cubes.
         @param corners
             The corners of the cube to triangulate via Marching Cubes.
@@ -301,6 +301,19 @@ namespace Volume {
             addVertex(Vertex(v2, n2));
         }
 
+        /** Appends the triangles of another MeshBuilder, reusing already existent vertices.
+            The result is the same as if the triangles were added to this instance directly.
+        @param other
+            The MeshBuilder to take the triangles from.
+        */
+        inline void addTriangles(const MeshBuilder &other)
+        {
+            for (VecIndices::const_iterator it = other.mIndices.begin(); it != other.mIndices.end(); ++it)
+            {
+                addVertex(other.mVertices[*it]);
+            }
+        }
+
         /** Generates the vertex- and indexbuffer of this mesh on the given
             RenderOperation.
         @param operation
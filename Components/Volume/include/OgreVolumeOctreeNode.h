@@ -53,6 +53,9 @@ namespace Volume {
         /// Factor to the diagonal of the cell to decide whether this cell is near the isosurface or not.
         static const Real NEAR_FACTOR;
 
+        /// Nodes bigger than the maximum cell size times this factor split their children in parallel.
+        static const Real PARALLEL_SPLIT_CELL_FACTOR;
+
         /// To count some indices while creating the debug view and recursing through the instances.
         static uint32 mGridPositionCount;
 
@@ -80,6 +83,22 @@ namespace Volume {
             The manual object to add the lines to if this is a leaf in the octree.
         */
         void buildOctreeGridLines(ManualObject *manual) const;
+
+        /** Creates the eight children of this node.
+        */
+        void createChildren(void);
+
+        /** Splits or re-splits the children of this node, in parallel for big nodes.
+        @param splitPolicy
+            Defines the policy deciding whether to split a node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error.
+        @param region
+            The changed area to re-split the existing children in or 0 to split new children.
+        */
+        void splitChildren(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox *region);
     public:
 
         /// Even in an OCtree, the amount of children should not be hardcoded.
@@ -146,6 +165,20 @@ namespace Volume {
         */
         void split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError);
 
+        /** Updates an already split octree after the source changed in a region. Only the nodes
+            touching the region are evaluated again, the others are kept. The result is the same
+            as splitting a new octree.
+        @param splitPolicy
+            Defines the policy deciding whether to split this node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error, must be the one of the initial split.
+        @param region
+            The area, in which the values of the source might have changed.
+        */
+        void resplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &region);
+
         /** Getter for the octree debug visualization of the octree starting with
             this node.
         @param sceneManager
@@ -116,6 +116,15 @@ namespace Volume {
             true if the node should be split.
         */
         virtual bool doSplit(OctreeNode *node, const Real geometricError) const;
+
+        /** Gets the maximum size when the splitting will stop anyway.
+        @return
+            The maximum cell size.
+        */
+        Real getMaxCellSize(void) const
+        {
+            return mMaxCellSize;
+        }
     };
     /** @} */
     /** @} */
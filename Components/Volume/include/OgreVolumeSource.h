@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_Source_H__
 
 #include "OgreVector3.h"
+#include "OgreVector4.h"
 #include "OgreVolumePrerequisites.h"
 
 namespace Ogre {
@@ -101,6 +102,33 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values and gradients at many positions at once.
+        @remarks
+            The results equal the ones of getValueAndGradient. The default implementation
+            just calls it for every position, sources which can share work between the
+            positions override it. Like the single value getters, this can be called
+            from several threads at once.
+        @param positions
+            The positions.
+        @param count
+            The amount of positions.
+        @param values
+            Receives count vectors with x, y, z containing the gradient and w containing the density.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Gets the density values at many positions at once.
+        @remarks
+            The results equal the ones of getValue. See getValuesAndGradients.
+        @param positions
+            The positions.
+        @param count
+            The amount of positions.
+        @param values
+            Receives count densities.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
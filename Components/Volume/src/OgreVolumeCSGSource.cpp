@@ -30,6 +30,9 @@ THE SOFTWARE.
 namespace Ogre {
 namespace Volume {
 
+    /// The amount of positions evaluated together by the batch functions of the combining sources
+    static const size_t BATCH_SIZE = 64;
+
     Vector3 CSGCubeSource::mBoxNormals[6] = {
         Vector3::UNIT_X,
         Vector3::UNIT_Y,
@@ -69,6 +72,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGSphereSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Same expression as getValueAndGradient, so the results are identical
+            Vector3 gradient = positions[i] - mCenter;
+            values[i] = Vector4(gradient.x, gradient.y, gradient.z, mR - gradient.normalise());
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = mR - (positions[i] - mCenter).length();
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGPlaneSource::CSGPlaneSource(const Real d, const Vector3 &normal) : mD(d), mNormal(normal.normalisedCopy())
     {
     }
@@ -96,6 +121,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGPlaneSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = Vector4(mNormal.x, mNormal.y, mNormal.z, mD - mNormal.dotProduct(positions[i]));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = mD - mNormal.dotProduct(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGCubeSource::CSGCubeSource(const Vector3 &min, const Vector3 &max)
     {
         mBox.setExtents(min, max);
@@ -205,6 +250,49 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGIntersectionSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        // Evaluate each operand for all positions, then combine them
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, batch, values + start);
+            mB->getValuesAndGradients(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Vector4 valueB = valuesB[i];
+                if (!(values[start + i].w < valueB.w))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValues(positions + start, batch, values + start);
+            mB->getValues(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Real valueB = valuesB[i];
+                if (!(values[start + i] < valueB))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnionSource::CSGUnionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -243,6 +331,49 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGUnionSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        // Evaluate each operand for all positions, then combine them
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, batch, values + start);
+            mB->getValuesAndGradients(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Vector4 valueB = valuesB[i];
+                if (!(values[start + i].w > valueB.w))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValues(positions + start, batch, values + start);
+            mB->getValues(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Real valueB = valuesB[i];
+                if (!(values[start + i] > valueB))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGDifferenceSource::CSGDifferenceSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -281,6 +412,49 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGDifferenceSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        // Evaluate each operand for all positions, then combine them
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, batch, values + start);
+            mB->getValuesAndGradients(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Vector4 valueB = (Real)-1.0 * valuesB[i];
+                if (!(values[start + i].w < valueB.w))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            mA->getValues(positions + start, batch, values + start);
+            mB->getValues(positions + start, batch, valuesB);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                Real valueB = (Real)-1.0 * valuesB[i];
+                if (!(values[start + i] < valueB))
+                {
+                    values[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnarySource::CSGUnarySource(const Source *src) : mSrc(src)
     {
     }
@@ -333,6 +507,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNegateSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        mSrc->getValuesAndGradients(positions, count, values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        mSrc->getValues(positions, count, values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGScaleSource::CSGScaleSource(const Source *src, const Real scale) : CSGUnarySource(src), mScale(scale)
     {
     }
@@ -353,6 +549,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGScaleSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        Vector3 scaled[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                scaled[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValuesAndGradients(scaled, batch, values + start);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                values[start + i] = values[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        Vector3 scaled[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batch = std::min(count - start, BATCH_SIZE);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                scaled[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValues(scaled, batch, values + start);
+            for (size_t i = 0; i < batch; ++i)
+            {
+                values[start + i] = values[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void CSGNoiseSource::setData(void)
     {
         mGradientOff = fabs(mFrequencies[0]);
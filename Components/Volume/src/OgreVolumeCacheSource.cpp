@@ -25,10 +25,14 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreVolumeCacheSource.h"
+#include "OgreBitwise.h"
+#include "OgreCommon.h"
 
 namespace Ogre {
 namespace Volume {
     
+    const size_t CacheSource::DEFAULT_MEMORY_BUDGET = 32 * 1024 * 1024;
+
     //-----------------------------------------------------------------------
 
     bool operator<(const Vector3& a, const Vector3& b)
@@ -38,8 +42,130 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
-    CacheSource::CacheSource(const Source *src) : mSrc(src)
+    CacheSource::CacheSource(const Source *src, size_t memoryBudget, Real quantum) :
+        mShardCapacity(0), mShardMaxCount(0), mMemoryBudget(0), mQuantum(quantum), mHits(0), mMisses(0), mEvictions(0), mSrc(src)
+    {
+        setMemoryBudget(memoryBudget);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::hash(const Vector3 &position)
+    {
+        return FastHash((const char*)&position, sizeof(Vector3));
+    }
+    
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::findSlot(const Shard &shard, const Vector3 &position, size_t h) const
+    {
+        size_t mask = mShardCapacity - 1;
+        size_t i = (h / SHARD_COUNT) & mask;
+        while (shard.entries[i].used && memcmp(&shard.entries[i].position, &position, sizeof(Vector3)) != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CacheSource::evict(Shard &shard) const
+    {
+        size_t mask = mShardCapacity - 1;
+
+        // Give referenced entries a second chance.
+        while (!shard.entries[shard.hand].used || shard.entries[shard.hand].referenced)
+        {
+            shard.entries[shard.hand].referenced = false;
+            shard.hand = (shard.hand + 1) & mask;
+        }
+
+        // Remove the entry and move the following ones of the probe sequence back to close the gap.
+        size_t i = shard.hand;
+        size_t j = i;
+        shard.entries[i].used = false;
+        while (true)
+        {
+            j = (j + 1) & mask;
+            if (!shard.entries[j].used)
+            {
+                break;
+            }
+            size_t home = (hash(shard.entries[j].position) / SHARD_COUNT) & mask;
+            bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays)
+            {
+                shard.entries[i] = shard.entries[j];
+                shard.entries[j].used = false;
+                i = j;
+            }
+        }
+        --shard.count;
+        mEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    Vector4 CacheSource::getFromCache(const Vector3 &position) const
     {
+        Vector3 key = position;
+        if (mQuantum > (Real)0.0)
+        {
+            key.x = Math::Floor(position.x / mQuantum + (Real)0.5) * mQuantum;
+            key.y = Math::Floor(position.y / mQuantum + (Real)0.5) * mQuantum;
+            key.z = Math::Floor(position.z / mQuantum + (Real)0.5) * mQuantum;
+        }
+        if (!mShardCapacity)
+        {
+            mMisses.fetch_add(1, std::memory_order_relaxed);
+            return mSrc->getValueAndGradient(key);
+        }
+
+        size_t h = hash(key);
+        Shard &shard = mShards[h % SHARD_COUNT];
+        {
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            if (!shard.entries.empty())
+            {
+                Entry &entry = shard.entries[findSlot(shard, key, h)];
+                if (entry.used)
+                {
+                    entry.referenced = true;
+                    mHits.fetch_add(1, std::memory_order_relaxed);
+                    return entry.value;
+                }
+            }
+        }
+
+        // Evaluate without holding the lock, the source might be expensive.
+        Vector4 result = mSrc->getValueAndGradient(key);
+        mMisses.fetch_add(1, std::memory_order_relaxed);
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        if (shard.entries.empty())
+        {
+            Entry empty;
+            empty.used = false;
+            empty.referenced = false;
+            shard.entries.resize(mShardCapacity, empty);
+        }
+        size_t i = findSlot(shard, key, h);
+        if (!shard.entries[i].used)
+        {
+            if (shard.count >= mShardMaxCount)
+            {
+                evict(shard);
+                i = findSlot(shard, key, h);
+            }
+            Entry &entry = shard.entries[i];
+            entry.position = key;
+            entry.value = result;
+            entry.used = true;
+            entry.referenced = false;
+            ++shard.count;
+        }
+        return result;
     }
     
     //-----------------------------------------------------------------------
@@ -55,6 +181,47 @@ namespace Volume {
     {
         return getFromCache(position).w;
     }
+    
+    //-----------------------------------------------------------------------
 
+    void CacheSource::setMemoryBudget(size_t memoryBudget)
+    {
+        mMemoryBudget = memoryBudget;
+        size_t entries = memoryBudget / (sizeof(Entry) * SHARD_COUNT);
+        // Open addressing needs some free slots, keep the load factor at 3/4.
+        mShardCapacity = entries >= 4 ? Bitwise::firstPO2From(uint32(entries + 1)) / 2 : 0;
+        mShardMaxCount = mShardCapacity / 4 * 3;
+        clear();
+    }
+    
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getCachedCount(void) const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[i].mutex);
+            count += mShards[i].count;
+        }
+        return count;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CacheSource::clear(void)
+    {
+        for (size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[i].mutex);
+            VecEntry().swap(mShards[i].entries);
+            mShards[i].count = 0;
+            mShards[i].hand = 0;
+        }
+        mHits = 0;
+        mMisses = 0;
+        mEvictions = 0;
+    }
+
+}
 }
-}
\ No newline at end of file
@@ -62,21 +62,45 @@ namespace Volume {
         }
         if (mShared->parameters->createGeometryFromLevel == 0 || level <= mShared->parameters->createGeometryFromLevel)
         {
+            bool isUpdate = mShared->parameters->updateFrom != Vector3::ZERO || mShared->parameters->updateTo != Vector3::ZERO;
+            AxisAlignedBox updated(mShared->parameters->updateFrom, mShared->parameters->updateTo);
+            if (isUpdate && mShared->parameters->incrementalUpdate && mRequestsInFlight)
+            {
+                // The octree is with the worker, the update follows once it is back.
+                mPendingUpdate.merge(updated);
+                return;
+            }
+
             mShared->chunksBeingProcessed++;
 
             // Call worker
             ChunkRequest req;
             req.totalFrom = totalFrom;
             req.totalTo = totalTo;
+            req.from = from;
+            req.to = to;
             req.level = level;
             req.maxLevels = maxLevels;
-            req.isUpdate = mShared->parameters->updateFrom != Vector3::ZERO || mShared->parameters->updateTo != Vector3::ZERO;
+            req.isUpdate = isUpdate;
 
             req.origin = this;
-            req.root = OGRE_NEW OctreeNode(from, to);
+            if (req.isUpdate && mShared->parameters->incrementalUpdate && mOctreeRoot)
+            {
+                // Just the nodes within the updated area get evaluated again.
+                req.root = mOctreeRoot;
+                mOctreeRoot = 0;
+                req.resplitRegion = updated;
+            }
+            else
+            {
+                OGRE_DELETE mOctreeRoot;
+                mOctreeRoot = 0;
+                req.root = OGRE_NEW OctreeNode(from, to);
+            }
             req.meshBuilder = OGRE_NEW MeshBuilder();
             req.dualGridGenerator = OGRE_NEW DualGridGenerator();
 
+            mRequestsInFlight++;
             mChunkHandler.addRequest(req);
         }
         else
@@ -162,16 +186,7 @@ namespace Volume {
                 return;
             }
             // Free memory from old mesh version
-            if (mRenderOp.vertexData)
-            {
-                OGRE_DELETE mRenderOp.vertexData;
-                mRenderOp.vertexData = 0;
-            }
-            if (mRenderOp.indexData)
-            {
-                OGRE_DELETE mRenderOp.indexData;
-                mRenderOp.indexData = 0;
-            }
+            freeGeometry();
         }
 
         // Set to invisible for now.
@@ -181,6 +196,11 @@ namespace Volume {
         // Don't generate this chunk if it doesn't contribute to the whole volume.
         if (!contributesToVolumeMesh(from, to))
         {
+            // A kept octree would miss this change on the next update, so would the one in flight.
+            OGRE_DELETE mOctreeRoot;
+            mOctreeRoot = 0;
+            mDropOctreeInFlight = mRequestsInFlight > 0;
+            mPendingUpdate.setNull();
             return;
         }
     
@@ -191,12 +211,88 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
-    void Chunk::prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo)
+    void Chunk::requestDone(const ChunkRequest &req)
+    {
+        mRequestsInFlight--;
+        mShared->chunksBeingProcessed--;
+
+        // The worker is done with the octree, so it is published here on the main thread.
+        if (mShared->parameters->incrementalUpdate && !mDropOctreeInFlight)
+        {
+            OGRE_DELETE mOctreeRoot;
+            mOctreeRoot = req.root;
+        }
+        else
+        {
+            OGRE_DELETE req.root;
+        }
+
+        if (mRequestsInFlight)
+        {
+            return;
+        }
+        mDropOctreeInFlight = false;
+
+        if (!mPendingUpdate.isNull())
+        {
+            // Replace the geometry just loaded with the one of the updates, which waited.
+            freeGeometry();
+            mShared->chunksBeingProcessed++;
+
+            ChunkRequest update = req;
+            update.isUpdate = true;
+            if (mOctreeRoot)
+            {
+                update.root = mOctreeRoot;
+                mOctreeRoot = 0;
+                update.resplitRegion = mPendingUpdate;
+            }
+            else
+            {
+                update.root = OGRE_NEW OctreeNode(req.from, req.to);
+                update.resplitRegion.setNull();
+            }
+            mPendingUpdate.setNull();
+            update.meshBuilder = OGRE_NEW MeshBuilder();
+            update.dualGridGenerator = OGRE_NEW DualGridGenerator();
+
+            mRequestsInFlight++;
+            mChunkHandler.addRequest(update);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::freeGeometry(void)
+    {
+        if (mRenderOp.vertexData)
+        {
+            OGRE_DELETE mRenderOp.vertexData;
+            mRenderOp.vertexData = 0;
+        }
+        if (mRenderOp.indexData)
+        {
+            OGRE_DELETE mRenderOp.indexData;
+            mRenderOp.indexData = 0;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo,
+        const AxisAlignedBox &resplitRegion)
     {
         OctreeNodeSplitPolicy policy(mShared->parameters->src,
             mShared->parameters->errorMultiplicator * mShared->parameters->baseError);
         mError = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError;
-        root->split(&policy, mShared->parameters->src, mError);
+        if (resplitRegion.isNull())
+        {
+            root->split(&policy, mShared->parameters->src, mError);
+        }
+        else
+        {
+            root->resplit(&policy, mShared->parameters->src, mError, resplitRegion);
+        }
         Real maxMSDistance = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError * mShared->parameters->skirtFactor;
         IsoSurface *is = OGRE_NEW IsoSurfaceMC(mShared->parameters->src);
         dualGridGenerator->generateDualGrid(root, is, meshBuilder, maxMSDistance, totalFrom, totalTo,
@@ -245,13 +341,12 @@ namespace Volume {
             mNode->attachObject(mOctree);
             mOctree->setVisible(false);
         }
-        mShared->chunksBeingProcessed--;
     }
     
     //-----------------------------------------------------------------------
 
     Chunk::Chunk(void) : mNode(0), mError(false), mDualGrid(0), mOctree(0), mChildren(0),
-        mInvisible(false), isRoot(false), mShared(0)
+        mInvisible(false), isRoot(false), mShared(0), mOctreeRoot(0), mRequestsInFlight(0), mDropOctreeInFlight(false)
     {
     }
     
@@ -261,6 +356,7 @@ namespace Volume {
     {
         OGRE_DELETE mRenderOp.indexData;
         OGRE_DELETE mRenderOp.vertexData;
+        OGRE_DELETE mOctreeRoot;
 
         // Root might already be shutdown.
         if (Root::getSingletonPtr())
@@ -285,6 +381,7 @@ namespace Volume {
         delete[] mChildren;
         if (isRoot)
         {
+            mChunkHandler.removeTree();
             delete mShared;
         }
     }
@@ -325,11 +422,13 @@ namespace Volume {
         // Don't recreate the shared parameters on update.
         if (parameters->updateFrom == Vector3::ZERO && parameters->updateTo == Vector3::ZERO)
         {
+            if (!mShared)
+            {
+                mChunkHandler.addTree();
+            }
             mShared = new ChunkTreeSharedData(parameters);
             parent->scale(Vector3(parameters->scale));
         }
-
-        mShared->chunksBeingProcessed = 0;
         
         doLoad(parent, from, to, from, to, level, level);
 
@@ -364,6 +463,7 @@ namespace Volume {
         bool trilinearGradient = StringConverter::parseBool(config.getSetting("trilinearGradient"));
         bool sobelGradient = StringConverter::parseBool(config.getSetting("sobelGradient"));
         bool async = StringConverter::parseBool(config.getSetting("async"));
+        bool incrementalUpdate = StringConverter::parseBool(config.getSetting("incrementalUpdate"));
 
         TextureSource *textureSource = new TextureSource(source, dimensions.x, dimensions.y, dimensions.z, trilinearValue, trilinearGradient, sobelGradient);
     
@@ -386,6 +486,7 @@ namespace Volume {
         parameters.createDualGridVisualization = StringConverter::parseBool(config.getSetting("createDualGridVisualization"));
         parameters.skirtFactor = StringConverter::parseReal(config.getSetting("skirtFactor"));
         parameters.async = async;
+        parameters.incrementalUpdate = incrementalUpdate;
     
         load(parent, from, to, level, &parameters);
         
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreRoot.h"
+#include "OgreLogManager.h"
 
 #include "OgreVolumeChunkHandler.h"
 #include "OgreVolumeChunk.h"
@@ -52,7 +53,7 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
     
-    ChunkHandler::ChunkHandler(void) : mWQ(0), mWorkQueueChannel(0)
+    ChunkHandler::ChunkHandler(void) : mWQ(0), mWorkQueueChannel(0), mTrees(0)
     {
     }
 
@@ -68,6 +69,30 @@ namespace Volume {
         }
     }
 
+    //-----------------------------------------------------------------------
+
+    void ChunkHandler::addTree(void)
+    {
+        mTrees++;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void ChunkHandler::removeTree(void)
+    {
+        mTrees--;
+        if (mTrees == 0 && mWQ)
+        {
+            // Root might already be shutdown, its WorkQueue is gone then.
+            if (Root::getSingletonPtr())
+            {
+                mWQ->removeRequestHandler(mWorkQueueChannel, this);
+                mWQ->removeResponseHandler(mWorkQueueChannel, this);
+            }
+            mWQ = 0;
+        }
+    }
+
     //-----------------------------------------------------------------------
   
     void ChunkHandler::addRequest(const ChunkRequest &req)
@@ -88,7 +113,14 @@ namespace Volume {
     WorkQueue::Response* ChunkHandler::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         ChunkRequest cReq = any_cast<ChunkRequest>(req->getData());
-        cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo);
+        try
+        {
+            cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo, cReq.resplitRegion);
+        }
+        catch (Exception& e)
+        {
+            return OGRE_NEW WorkQueue::Response(req, false, Any(), e.getFullDescription());
+        }
         return OGRE_NEW WorkQueue::Response(req, true, Any());
     }
     
@@ -96,14 +128,22 @@ namespace Volume {
 
     void ChunkHandler::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
     {
+        ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
         if (res->succeeded())
         {
-            ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
             cReq.origin->loadGeometry(cReq.meshBuilder, cReq.dualGridGenerator, cReq.root, cReq.level, cReq.isUpdate);
+        }
+        else
+        {
+            LogManager::getSingleton().stream(LML_CRITICAL) << "Volume chunk failed to load: " << res->getMessages();
+            // The octree might be split halfway, the next update builds a new one.
             OGRE_DELETE cReq.root;
-            OGRE_DELETE cReq.dualGridGenerator;
-            OGRE_DELETE cReq.meshBuilder;
+            cReq.root = 0;
         }
+        OGRE_DELETE cReq.dualGridGenerator;
+        OGRE_DELETE cReq.meshBuilder;
+        // Keeps or frees the octree, also sends the updates which waited for this request
+        cReq.origin->requestDone(cReq);
     }
 }
 }
@@ -28,11 +28,17 @@ THE SOFTWARE.
 #include "OgreManualObject.h"
 #include "OgreSceneManager.h"
 #include "OgreVolumeMeshBuilder.h"
+#include "OgreVolumeSource.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre {
 namespace Volume {
 
     size_t DualGridGenerator::mDualGridI = 0;
+    const size_t DualGridGenerator::CELLS_PER_TASK = 256;
+
+    /// The amount of dualcells, whose corners are evaluated with one call to the source.
+    static const size_t BATCH_CELLS = 64;
     
     //-----------------------------------------------------------------------
 
@@ -479,6 +485,7 @@ namespace Volume {
         mTotalFrom = totalFrom;
         mTotalTo = totalTo;
         mSaveDualCells = saveDualCells;
+        mPendingCells.clear();
 
         nodeProc(root);
 
@@ -503,6 +510,82 @@ namespace Volume {
             addDualCell(root->getCenterLeft(), root->getCenter(), root->getCenterFront(), root->getCenterFrontLeft(),
                 root->getCenterLeftTop(), root->getCenterTop(), root->getCenterFrontTop(), root->getCorner7());
         }
+
+        // Contour the collected cells. Blocks of cells are triangulated into their own
+        // MeshBuilder in parallel and merged in order, so the mesh is the same as a serial run.
+        size_t cellCount = mPendingCells.size();
+        TaskScheduler* scheduler = TaskScheduler::getDefault();
+        if (cellCount <= CELLS_PER_TASK || !scheduler || scheduler->getWorkerCount() == 0)
+        {
+            contourCells(0, cellCount, mMb);
+        }
+        else
+        {
+            size_t blockCount = (cellCount + CELLS_PER_TASK - 1) / CELLS_PER_TASK;
+            std::vector<MeshBuilder*> blocks(blockCount);
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                blocks[i] = OGRE_NEW MeshBuilder();
+            }
+            parallelFor(blockCount, [this, cellCount, &blocks](size_t i) {
+                size_t start = i * CELLS_PER_TASK;
+                contourCells(start, std::min(start + CELLS_PER_TASK, cellCount), blocks[i]);
+            });
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                mMb->addTriangles(*blocks[i]);
+                OGRE_DELETE blocks[i];
+            }
+        }
+        VecPendingCell().swap(mPendingCells);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::contourCells(size_t start, size_t end, MeshBuilder *mb) const
+    {
+        const Source *src = mIs->getSource();
+        Vector3 corners[BATCH_CELLS * 8];
+        Vector4 values[BATCH_CELLS * 8];
+        while (start < end)
+        {
+            // Gather the corners of the cells without values to evaluate them in one go.
+            size_t batchEnd = std::min(start + BATCH_CELLS, end);
+            size_t count = 0;
+            for (size_t i = start; i < batchEnd; ++i)
+            {
+                const PendingCell &cell = mPendingCells[i];
+                if (!cell.hasValues)
+                {
+                    for (size_t j = 0; j < 8; ++j)
+                    {
+                        corners[count++] = cell.corners[j];
+                    }
+                }
+            }
+            if (count)
+            {
+                src->getValuesAndGradients(corners, count, values);
+            }
+
+            // Marching Squares only uses the density of given values and recalculates the
+            // gradients itself, so it still gets the original values to keep the skirts as they were.
+            const Vector4 *batchValues = values;
+            for (size_t i = start; i < batchEnd; ++i)
+            {
+                const PendingCell &cell = mPendingCells[i];
+                if (cell.hasValues)
+                {
+                    contourCell(cell.corners, cell.values, cell.values, mb);
+                }
+                else
+                {
+                    contourCell(cell.corners, batchValues, 0, mb);
+                    batchValues += 8;
+                }
+            }
+            start = batchEnd;
+        }
     }
     
     //-----------------------------------------------------------------------
@@ -32,6 +32,10 @@ THE SOFTWARE.
 
 namespace Ogre {
 namespace Volume {
+
+    const int GridSource::DIRTY_BORDER = 2;
+
+    //-----------------------------------------------------------------------
     
     Vector3 GridSource::getIntersectionStart(const Ray &ray, Real maxDistance) const
     {
@@ -256,6 +260,15 @@ namespace Volume {
             }
         }
 
+        // The interpolation and the gradients read the neighbouring cells, so positions up to
+        // two cells away from the changed ones might have changed, too.
+        if (xStart < xEnd && yStart < yEnd && zStart < zEnd)
+        {
+            mDirtyRegion.merge(AxisAlignedBox(
+                (Real)(xStart - DIRTY_BORDER) * worldWidthScale, (Real)(yStart - DIRTY_BORDER) * worldHeightScale, (Real)(zStart - DIRTY_BORDER) * worldDepthScale,
+                (Real)(xEnd - 1 + DIRTY_BORDER) * worldWidthScale, (Real)(yEnd - 1 + DIRTY_BORDER) * worldHeightScale, (Real)(zEnd - 1 + DIRTY_BORDER) * worldDepthScale));
+        }
+
         mTrilinearValue = oldTrilinearValue;
     }
  
@@ -30,11 +30,13 @@ THE SOFTWARE.
 #include "OgreVolumeSource.h"
 #include "OgreVolumeOctreeNodeSplitPolicy.h"
 #include "OgreSceneManager.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre {
 namespace Volume {
     
     const Real OctreeNode::NEAR_FACTOR = (Real)2.0;
+    const Real OctreeNode::PARALLEL_SPLIT_CELL_FACTOR = (Real)8.0;
     const size_t OctreeNode::OCTREE_CHILDREN_COUNT = 8;
     uint32 OctreeNode::mGridPositionCount = 0;
     size_t OctreeNode::mNodeI = 0;
@@ -107,33 +109,8 @@ namespace Volume {
     {
         if (splitPolicy->doSplit(this, geometricError))
         {
-            Vector3 newCenter, xWidth, yWidth, zWidth;
-            OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
-            /*
-               4 5
-              7 6
-               0 1
-              3 2
-              0 == from
-              6 == to
-            */
-            mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
-            mChildren[0] = createInstance(mFrom, newCenter);
-            mChildren[0]->split(splitPolicy, src, geometricError);
-            mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
-            mChildren[1]->split(splitPolicy, src, geometricError);
-            mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
-            mChildren[2]->split(splitPolicy, src, geometricError);
-            mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
-            mChildren[3]->split(splitPolicy, src, geometricError);
-            mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
-            mChildren[4]->split(splitPolicy, src, geometricError);
-            mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
-            mChildren[5]->split(splitPolicy, src, geometricError);
-            mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
-            mChildren[6]->split(splitPolicy, src, geometricError);
-            mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
-            mChildren[7]->split(splitPolicy, src, geometricError);
+            createChildren();
+            splitChildren(splitPolicy, src, geometricError, 0);
         }
         else
         {
@@ -146,6 +123,109 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void OctreeNode::resplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &region)
+    {
+        // The split policy and the dualgrid only sample inside of the node.
+        if (!region.intersects(AxisAlignedBox(mFrom, mTo)))
+        {
+            return;
+        }
+
+        // Start over like a new node, but keep the children to reuse the unchanged ones.
+        mCenterValue = Vector4::ZERO;
+        if (splitPolicy->doSplit(this, geometricError))
+        {
+            if (mChildren)
+            {
+                splitChildren(splitPolicy, src, geometricError, &region);
+            }
+            else
+            {
+                createChildren();
+                splitChildren(splitPolicy, src, geometricError, 0);
+            }
+        }
+        else
+        {
+            if (mChildren)
+            {
+                for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+                {
+                    OGRE_DELETE mChildren[i];
+                }
+                delete[] mChildren;
+                mChildren = 0;
+            }
+            if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+            {
+                setCenterValue(src->getValueAndGradient(getCenter()));
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::createChildren(void)
+    {
+        Vector3 newCenter, xWidth, yWidth, zWidth;
+        OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
+        /*
+           4 5
+          7 6
+           0 1
+          3 2
+          0 == from
+          6 == to
+        */
+        mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
+        mChildren[0] = createInstance(mFrom, newCenter);
+        mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
+        mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
+        mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
+        mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
+        mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
+        mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
+        mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::splitChildren(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox *region)
+    {
+        // The subtrees are independent. Split them in parallel while they can still
+        // be a few levels deep, below that a task costs more than the work it holds.
+        if (mTo.x - mFrom.x > splitPolicy->getMaxCellSize() * PARALLEL_SPLIT_CELL_FACTOR)
+        {
+            parallelFor(OCTREE_CHILDREN_COUNT, [&](size_t i)
+            {
+                if (region)
+                {
+                    mChildren[i]->resplit(splitPolicy, src, geometricError, *region);
+                }
+                else
+                {
+                    mChildren[i]->split(splitPolicy, src, geometricError);
+                }
+            });
+        }
+        else
+        {
+            for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+            {
+                if (region)
+                {
+                    mChildren[i]->resplit(splitPolicy, src, geometricError, *region);
+                }
+                else
+                {
+                    mChildren[i]->split(splitPolicy, src, geometricError);
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     Entity* OctreeNode::getOctreeGrid(SceneManager *sceneManager)
     {
         if (!mOctreeGrid)
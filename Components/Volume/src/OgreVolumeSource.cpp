@@ -61,6 +61,26 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
+    void Source::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = getValueAndGradient(positions[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Source::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = getValue(positions[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     void Source::serialize(const Vector3 &from, const Vector3 &to, float voxelWidth, const String &file)
     {
         Real maxClampedAbsoluteDensity = (from - to).length() / (Real)16.0;
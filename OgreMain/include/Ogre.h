@@ -54,6 +54,7 @@ THE SOFTWARE.
 #include "OgreDataStream.h"
 #include "OgreEntity.h"
 #include "OgreException.h"
+#include "OgreFrameCounters.h"
 #include "OgreFrameListener.h"
 #include "OgreFrustum.h"
 #include "OgreGpuProgram.h"
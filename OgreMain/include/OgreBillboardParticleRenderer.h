@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreParticleSystemRenderer.h"
 #include "OgreBillboardSet.h"
+#include "OgreBillboard.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -54,6 +55,8 @@ namespace Ogre {
     protected:
         /// The billboard set that's doing the rendering
         BillboardSet* mBillboardSet;
+        /// The particles as billboards, injected all at once
+        std::vector<Billboard> mBillboards;
     public:
         BillboardParticleRenderer();
         ~BillboardParticleRenderer();
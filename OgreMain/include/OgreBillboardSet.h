@@ -222,6 +222,9 @@ namespace Ogre {
         /// Number of visible billboards (will be == getNumBillboards if mCullIndividual == false)
         unsigned short mNumVisibleBillboards;
 
+        /// Billboards passing the culling, waiting for genVisibleBillboards
+        std::vector<const Billboard*> mVisibleBillboards;
+
         /// Internal method for increasing pool size
         virtual void increasePool(size_t size);
 
@@ -236,7 +239,7 @@ namespace Ogre {
         @remarks
             Optional parameter pBill is only present for type BBT_ORIENTED_SELF and BBT_PERPENDICULAR_SELF
         */
-        void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill = 0);
+        void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill = 0) const;
 
         /** Internal method, generates parametric offsets based on origin.
         */
@@ -245,8 +248,22 @@ namespace Ogre {
         /** Internal method for generating vertex data. 
         @param offsets Array of 4 Vector3 offsets
         @param pBillboard Reference to billboard
+        @param pDest Where to write the vertices, advanced past them on return
+        */
+        void genVertices(const Vector3* const offsets, const Billboard& pBillboard, float*& pDest) const;
+
+        /** Internal method for generating the vertex data of one billboard, including
+            the axes and offsets it needs of its own.
+        @param bb Reference to billboard
+        @param pDest Where to write the vertices, advanced past them on return
         */
-        void genVertices(const Vector3* const offsets, const Billboard& pBillboard);
+        void genBillboard(const Billboard& bb, float*& pDest) const;
+
+        /** Internal method generating the vertices for mVisibleBillboards into the locked
+            buffer. Large sets are split over the available hardware threads, each one
+            writing a disjoint range of the buffer.
+        */
+        void genVisibleBillboards(void);
 
         /** Internal method generates vertex offsets.
         @remarks
@@ -257,7 +274,7 @@ namespace Ogre {
         */
         void genVertOffsets(Real inleft, Real inright, Real intop, Real inbottom,
             Real width, Real height,
-            const Vector3& x, const Vector3& y, Vector3* pDestVec);
+            const Vector3& x, const Vector3& y, Vector3* pDestVec) const;
 
 
         /** Sort by direction functor */
@@ -542,6 +559,14 @@ namespace Ogre {
         void beginBillboards(size_t numBillboards = 0);
         /** Define a billboard. */
         void injectBillboard(const Billboard& bb);
+        /** Define a number of billboards at once.
+        @remarks
+            Same as calling injectBillboard for each of them, but the vertices of
+            large batches are generated on all hardware threads.
+        @param billboards Array of billboards
+        @param count Number of billboards in the array
+        */
+        void injectBillboards(const Billboard* billboards, size_t count);
         /** Finish defining billboards. */
         void endBillboards(void);
         /** Set the bounds of the BillboardSet.
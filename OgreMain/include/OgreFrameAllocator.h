@@ -0,0 +1,112 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __FrameAllocator_H__
+#define __FrameAllocator_H__
+
+#include "OgrePlatform.h"
+#include <memory>
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** Linear memory for transient data, which is released at the end of the frame.
+    @remarks
+        It is used through FrameAllocator, e.g. with frame_vector. Every thread allocates
+        from its own arena by bumping a pointer, without locking. At the end of each frame Root starts
+        a new frame and every arena rewinds before its next allocation, keeping its
+        blocks for reuse. So once warmed up, transient containers in the frame loop don't
+        touch the heap at all.
+    @par
+        Memory must not be used after the frame it was allocated in ended. Code using it
+        on other threads must finish before the frame ends, i.e. the frame must wait for it.
+    */
+    class _OgreExport FrameMemory
+    {
+    public:
+        /** Allocate memory for the current frame.
+            @param size The size of memory need to allocate.
+            @param alignment The alignment of result pointer, must be power of two
+                and at most OGRE_SIMD_ALIGNMENT.
+        */
+        static DECL_MALLOC void* allocate(size_t size, size_t alignment = OGRE_SIMD_ALIGNMENT);
+
+        /** Deallocate memory allocated with allocate.
+            @remarks
+                Only the most recent allocation of the calling thread is reclaimed right away,
+                e.g. a short lived temporary. Everything else is reclaimed when the frame ends.
+        */
+        static void deallocate(void* p, size_t size);
+
+        /** Start a new frame, which lets all arenas rewind.
+            @remarks Called by Root at the end of each frame.
+        */
+        static void _endFrame();
+
+        /// Allocations made in the last finished frame, on all threads
+        static size_t getLastFrameAllocationCount();
+
+        /// Blocks the arenas allocated from the heap so far, on all threads
+        static size_t getHeapAllocationCount();
+    };
+
+    /// STL compatible wrapper for @ref FrameMemory
+    template<typename T>
+    struct FrameAllocator : public std::allocator<T>
+    {
+        FrameAllocator() : std::allocator<T>() {}
+
+        template <class U>
+        FrameAllocator(const FrameAllocator<U>&) {}
+
+        template<class Other>
+        struct rebind { using other = FrameAllocator<Other>; };
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(FrameMemory::allocate(n * sizeof(T)));
+        }
+        T* allocate(size_t n, const void*) { // deprecated in C++17
+            return static_cast<T*>(FrameMemory::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) {
+            FrameMemory::deallocate(p, n * sizeof(T));
+        }
+    };
+    /** @} */
+    /** @} */
+
+}
+
+#endif  // __FrameAllocator_H__
@@ -0,0 +1,148 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __FrameCounters_H__
+#define __FrameCounters_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHeaderPrefix.h"
+
+#include <atomic>
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** Always-on counters of the work done per frame.
+    @remarks
+        Every thread counts into its own block of counters, which only it writes, so
+        counting costs a plain add and threads don't share cache lines. The counters only
+        grow; Root sums the blocks of all threads at the end of every frame and publishes
+        the difference to the previous sum. The published counts stay readable with
+        getLastFrame until the next frame ends. While the Profiler records trace events,
+        they are also added to the trace as counter events.
+    @par
+        The blocks of threads, which exited, are reused by new threads.
+    */
+    class _OgreExport FrameCounters
+    {
+    public:
+        enum Counter
+        {
+            /// Nodes, which updated their derived transform
+            FC_NODES_UPDATED,
+            /// Movable objects, which were visible and queued for rendering
+            FC_OBJECTS_VISIBLE,
+            /** Movable objects, which were hidden or culled
+            @remarks Objects below a culled node are not visited, so they are not counted */
+            FC_OBJECTS_CULLED,
+            /// Renderables added to the render queue, see also getLastFrameQueued
+            FC_RENDERABLES_QUEUED,
+            /// Calls of SceneManager::_setPass
+            FC_PASSES_SET,
+            /// Calls of SceneManager::_setPass with the pass, which was already set
+            FC_PASS_CACHE_HITS,
+            /// Automatic GPU program constants written
+            FC_AUTO_PARAMS_WRITTEN,
+            /// Lights tested by SceneManager::_populateLightList
+            FC_LIGHTS_EVALUATED,
+            /// Vertices blended by Mesh::softwareVertexBlend
+            FC_SOFTWARE_SKINNED_VERTICES,
+            /// Calls of HardwareBuffer::lock
+            FC_BUFFER_LOCKS,
+            FC_COUNT
+        };
+
+        /// Number of render queue groups with separate counters
+        static const size_t QUEUE_GROUP_COUNT = 256;
+
+        /// Count n occurrences in the current frame
+        static void add(Counter counter, size_t n = 1)
+        {
+            increment(getThreadCounters().counts[counter], n);
+        }
+        /// Count a renderable queued in the given render queue group
+        static void addQueuedRenderable(uint8 groupID)
+        {
+            ThreadCounters& counters = getThreadCounters();
+            increment(counters.queued[groupID], 1);
+            increment(counters.counts[FC_RENDERABLES_QUEUED], 1);
+        }
+
+        /// Count of the last finished frame
+        static size_t getLastFrame(Counter counter) { return msLastFrame[counter]; }
+        /// Renderables queued in a render queue group during the last finished frame
+        static size_t getLastFrameQueued(uint8 groupID) { return msLastFrameQueued[groupID]; }
+        /// Count of the current frame so far, sums the counters of all threads
+        static size_t getCurrent(Counter counter);
+        /// Name of a counter, e.g. for logging
+        static const char* getName(Counter counter);
+
+        /** Publish the counts of the current frame and start a new one
+        @remarks Called by Root at the end of each frame.
+        */
+        static void _endFrame();
+
+    private:
+        /// Counters of one thread, atomic only so that _endFrame may read them
+        struct ThreadCounters
+        {
+            std::atomic<size_t> counts[FC_COUNT];
+            std::atomic<size_t> queued[QUEUE_GROUP_COUNT];
+            /// Whether a running thread owns this block
+            std::atomic<bool> inUse;
+            ThreadCounters* next;
+        };
+
+        /// Only the owning thread writes, so a load and a store do without a locked add
+        static void increment(std::atomic<size_t>& counter, size_t n)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+        /// The block of the calling thread, which is claimed on first use
+        static ThreadCounters& getThreadCounters();
+
+        /// Blocks of all threads, which ever counted
+        static std::atomic<ThreadCounters*> msThreads;
+        /// Sums of all blocks when the current frame started
+        static size_t msFrameStart[FC_COUNT];
+        static size_t msFrameStartQueued[QUEUE_GROUP_COUNT];
+        static size_t msLastFrame[FC_COUNT];
+        static size_t msLastFrameQueued[QUEUE_GROUP_COUNT];
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __FrameCounters_H__
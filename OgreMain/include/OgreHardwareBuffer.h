@@ -31,6 +31,7 @@ THE SOFTWARE.
 // Precompiler options
 #include "OgrePrerequisites.h"
 #include "OgreException.h"
+#include "OgreFrameCounters.h"
 
 namespace Ogre {
 
@@ -213,6 +214,7 @@ namespace Ogre {
             virtual void* lock(size_t offset, size_t length, LockOptions options)
             {
                 assert(!isLocked() && "Cannot lock this buffer, it is already locked!");
+                FrameCounters::add(FrameCounters::FC_BUFFER_LOCKS);
 
                 void* ret = NULL;
                 if ((length + offset) > mSizeInBytes)
@@ -143,6 +143,12 @@ namespace Ogre
         /// When true remove the memory of the IndexData we've created because no one else will
         bool mRemoveOwnIndexData;
 
+        /// World bounding spheres of the instanced entities in SoA layout (all x, then y, z
+        /// and radius), filled by cullInstances
+        std::vector<float>  mCullSpheres;
+        /// Visibility of each of mInstancedEntities, as found by the last call to cullInstances
+        std::vector<char>   mVisibleInstances;
+
         virtual void setupVertices( const SubMesh* baseSubMesh ) = 0;
         virtual void setupIndices( const SubMesh* baseSubMesh ) = 0;
         virtual void createAllInstancedEntities(void);
@@ -160,8 +166,27 @@ namespace Ogre
         /// Returns false on errors that would prevent building this batch from the given submesh
         virtual bool checkSubMeshCompatibility( const SubMesh* baseSubMesh );
 
+        /// Sets mVisible when at least one instanced entity is visible. Culls in small groups
+        /// through cullInstances and stops at the first group with a visible entity
         void updateVisibility(void);
 
+        /** Culls all our instanced entities against the camera at once, gives the same results
+            as calling InstancedEntity::findVisible on each of them.
+        @remarks
+            Results are stored in mVisibleInstances, in the same order as mInstancedEntities.
+        @return The number of visible instanced entities
+        */
+        size_t cullInstances( Camera *camera );
+
+        /** Same as cullInstances( Camera* ), but only culls numEntities instanced entities
+            starting at first.
+        @remarks
+            mVisibleInstances must already hold an entry per instanced entity; only the entries
+            in the range are written.
+        @return The number of visible instanced entities in the range
+        */
+        size_t cullInstances( Camera *camera, size_t first, size_t numEntities );
+
         /** @see _defragmentBatch */
         void defragmentBatchNoCull( InstancedEntityVec &usedEntities, CustomParamsVec &usedParams );
 
@@ -62,12 +62,19 @@ namespace Ogre
     {
         bool    mKeepStatic;
 
+        /// Where each chunk of instances starts writing in updateVertexBuffer, in instances
+        std::vector<size_t> mChunkOffsets;
+
         void setupVertices( const SubMesh* baseSubMesh );
         void setupIndices( const SubMesh* baseSubMesh );
 
         void removeBlendData();
         virtual bool checkSubMeshCompatibility( const SubMesh* baseSubMesh );
 
+        /** Culls the instances and writes the visible ones to the instance buffer. Big
+            batches are written in chunks spread over the available hardware threads.
+        @return The number of instances written
+        */
         size_t updateVertexBuffer( Camera *currentCamera );
 
     public:
@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
 
+#include <atomic>
+
 namespace Ogre {
 
     /** \addtogroup Core
@@ -97,16 +99,27 @@ namespace Ogre {
     class _OgreExport Log : public LogAlloc
     {
     protected:
+        /// Written by the background writer while asynchronous output is enabled
         std::ofstream   mLog;
-        LoggingLevel    mLogLevel;
-        bool            mDebugOut;
-        bool            mSuppressFile;
-        bool            mTimeStamp;
+        /// Settings read by logMessage without locking
+        std::atomic<LoggingLevel> mLogLevel;
+        std::atomic<bool> mDebugOut;
+        const bool      mSuppressFile;
+        std::atomic<bool> mTimeStamp;
         String          mLogName;
         bool            mTermHasColours;
 
         typedef std::vector<LogListener*> mtLogListener;
-        mtLogListener mListeners;
+        /// Immutable list, replaced on change and NULL if empty, so logMessage only locks if there are listeners
+        std::shared_ptr<const mtLogListener> mListeners;
+
+        /// Background writer of the asynchronous output, NULL if disabled
+        struct AsyncWriter;
+        std::atomic<AsyncWriter*> mAsyncWriter;
+
+        /// Write a message to the debugger and the file on the calling thread
+        void writeMessage(const String& message, LogMessageLevel lml, bool console, bool timeStamp, time_t time);
+        void writeConsole(const String& message, LogMessageLevel lml);
     public:
 
         class Stream;
@@ -135,9 +148,45 @@ namespace Ogre {
 
         /** Log a message to the debugger and to log file (the default is
             "<code>OGRE.log</code>"),
+        @remarks
+            Listeners are always called on the calling thread, before the message is
+            written or queued for asynchronous output. They are called one at a time,
+            threads logging at the same time wait for each other.
         */
         void logMessage( const String& message, LogMessageLevel lml = LML_NORMAL, bool maskDebug = false );
 
+        /** Enable or disable asynchronous output.
+        @remarks
+            By default every message is written and flushed on the calling thread, which
+            makes threads that log a lot wait for each other and for the disk. With
+            asynchronous output messages are put into a lock-free queue instead and a
+            background thread writes them in batches. LML_CRITICAL messages still wait
+            until they are on disk, so the log is complete up to the error if the
+            application crashes afterwards. Other messages still queued are lost when
+            the process is killed by a signal or crashes, as there is no signal safe way
+            to write them. Before a regular exit or from a std::terminate handler the
+            application can call flush() to write them.
+        @par
+            Only change this while no other thread is logging to this log, e.g. right
+            after creating it. Without thread support output is always synchronous.
+        @param async Whether to write asynchronously
+        @param queueSize Number of messages the queue can hold before logging threads
+            have to wait for the writer, rounded up to a power of two
+        */
+        void setAsyncOutputEnabled(bool async, size_t queueSize = 4096);
+        /// Get whether messages are written by a background thread
+        bool isAsyncOutputEnabled() const { return mAsyncWriter != 0; }
+
+        /** Wait until all messages logged so far have been written.
+        @remarks
+            Only needed with asynchronous output, e.g. from a std::terminate handler
+            installed by the application. Returns at once with synchronous output.
+        @note
+            This locks a mutex and waits for the writer thread, so it must not be
+            called from a signal handler.
+        */
+        void flush();
+
         /** Get a stream object targeting this log. */
         Stream stream(LogMessageLevel lml = LML_NORMAL, bool maskDebug = false);
 
@@ -169,7 +218,8 @@ namespace Ogre {
 
         /**
         @remarks
-            Unregister a listener from this log
+            Unregister a listener from this log. Waits until other threads are done
+            calling the listeners, so it is not called any more once this returns.
         @param listener
             A valid listener derived class
         */
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #define __MemoryAllocatorConfig_H__
 
 #include "OgreAlignedAllocator.h"
+#include "OgreFrameAllocator.h"
 
 namespace Ogre
 {
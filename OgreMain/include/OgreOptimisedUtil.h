@@ -203,6 +203,31 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Cull bounding spheres against a set of planes.
+        @remarks
+            A sphere is culled when its centre is further than its radius on
+            the negative side of any of the planes, exactly as
+            Frustum::isVisible(const Sphere&) does.
+        @param planes The planes to test against, usually the frustum planes.
+        @param numPlanes Number of planes.
+        @param centresX, centresY, centresZ, radii The spheres in SoA layout,
+            i.e. one array per component. No SIMD alignment requirement but
+            loss performance for unaligned data.
+        @param visibilities An array of flags for store results, the flag is
+            true if the corresponding sphere is not culled by any plane, false
+            otherwise. This array no alignment requires.
+        @param numSpheres Number of spheres to cull.
+        */
+        virtual void cullSpheres(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centresX,
+            const float* centresY,
+            const float* centresZ,
+            const float* radii,
+            char* visibilities,
+            size_t numSpheres) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -239,6 +239,9 @@ namespace Ogre {
     class SubEntity;
     class SubMesh;
     class TagPoint;
+    class TaskGraph;
+    class TaskGroup;
+    class TaskScheduler;
     class Technique;
     class TempBlendedBufferInfo;
     class ExternalTextureSource;
@@ -342,6 +345,10 @@ namespace Ogre
     template <typename T, size_t Alignment = OGRE_SIMD_ALIGNMENT>
     using aligned_vector = std::vector<T, AlignedAllocator<T, Alignment>>;
 
+    /// vector for transient data, which must not outlive the frame, see FrameMemory
+    template <typename T>
+    using frame_vector = std::vector<T, FrameAllocator<T>>;
+
     template <typename T>
     struct OGRE_DEPRECATED list
     { 
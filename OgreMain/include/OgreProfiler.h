@@ -43,8 +43,11 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 
 #include "OgrePrerequisites.h"
 #include "OgreSingleton.h"
+#include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
 
+#include <atomic>
+
 #if OGRE_PROFILING == 1
 #   define OgreProfile( a ) Ogre::Profile _OgreProfileInstance( (a) )
 #   define OgreProfileBegin( a ) Ogre::Profiler::getSingleton().beginProfile( (a) )
@@ -55,6 +58,7 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #   define OgreProfileBeginGPUEvent( g ) Ogre::Profiler::getSingleton().beginGPUEvent(g)
 #   define OgreProfileEndGPUEvent( g ) Ogre::Profiler::getSingleton().endGPUEvent(g)
 #   define OgreProfileMarkGPUEvent( e ) Ogre::Profiler::getSingleton().markGPUEvent(e)
+#   define OgreProfileTrace( a ) Ogre::ProfileTraceScope OGRE_TOKEN_PASTE(_OgreProfileTrace, __LINE__) ( (a) )
 #else
 #   define OgreProfile( a )
 #   define OgreProfileBegin( a )
@@ -65,6 +69,7 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #   define OgreProfileBeginGPUEvent( e )
 #   define OgreProfileEndGPUEvent( e )
 #   define OgreProfileMarkGPUEvent( e )
+#   define OgreProfileTrace( a )
 #endif
 
 namespace Ogre {
@@ -142,6 +147,26 @@ namespace Ogre {
 
     };
 
+    /// A finished trace event, see Profiler::beginTraceEvent and Profiler::addTraceCounter
+    struct ProfileTraceEvent
+    {
+        /// Name of the event, truncated to fit
+        char name[48];
+        /// Start in nanoseconds since the Profiler was created
+        uint64 start;
+        /// Duration in nanoseconds, 0 for counters
+        uint64 duration;
+        /// Value of a counter
+        uint64 value;
+        /// Whether the event is a counter sample instead of a zone
+        bool isCounter;
+        /// The recording thread, see Profiler::getTraceThreadName
+        uint32 threadId;
+        /// Nesting level on the recording thread, 0 being the outermost event
+        uint32 depth;
+    };
+    typedef std::vector<ProfileTraceEvent> ProfileTraceEventList;
+
     /// Represents an individual profile call
     class _OgreExport ProfileInstance : public ProfilerAlloc
     {
@@ -217,6 +242,13 @@ namespace Ogre {
         
         /// Here we get the real profiling information which we can use 
         virtual void displayResults(const ProfileInstance& instance, ulong maxTotalFrameTime) {};
+
+        /** Here we get the trace events of all threads, which ended since the last call
+        @remarks
+            Only called while tracing is enabled, see Profiler::setTraceEnabled. The events
+            of each thread are in the order they ended.
+        */
+        virtual void traceEventsRecorded(const ProfileTraceEventList& events) {}
     };
 
     /** The profiler allows you to measure the performance of your code
@@ -275,6 +307,60 @@ namespace Ogre {
             */
             void endProfile(const String& profileName, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT);
 
+            /** Add a profile, which was timed elsewhere, as child of the current profile
+            @remarks
+                Used for work, which ran on other threads, e.g. the phases of a TaskGraph.
+                Must be called between the beginProfile and endProfile of the parent.
+            @param profileName Must be unique and must not be an empty string
+            @param microseconds Measured duration of the profile
+            @param groupID A profile group identifier, which can allow you to mask profiles
+            */
+            void addProfileSample(const String& profileName, uint64 microseconds, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT);
+
+            /** Sets whether trace events are recorded
+            @remarks
+                Unlike profiles, trace events are not aggregated. Every event is kept with
+                nanosecond timestamps and handed to ProfileSessionListener::traceEventsRecorded,
+                so the concurrency of a whole frame can be inspected, e.g. with a
+                ChromeTraceSessionListener. Tracing works independently of setEnabled.
+            @par
+                While tracing, beginProfile and endProfile also record trace events. On other
+                threads than the one which created the Profiler, they only record trace events.
+            */
+            void setTraceEnabled(bool enabled);
+
+            /** Gets whether trace events are recorded */
+            bool getTraceEnabled() const { return mTraceEnabled.load(std::memory_order_relaxed); }
+
+            /** Begins a trace event on the calling thread
+            @remarks
+                Use the macro OgreProfileTrace(name) instead of calling this directly.
+                Recording is lock-free, only the first event of a thread registers it with
+                the profiler. Events must be ended on the same thread in reverse order.
+            */
+            void beginTraceEvent(const char* name);
+
+            /** Ends the innermost trace event of the calling thread */
+            void endTraceEvent();
+
+            /** Records the value of a counter on the calling thread, e.g. see FrameCounters */
+            void addTraceCounter(const char* name, uint64 value);
+
+            /** Passes the recorded trace events of all threads to the listeners
+            @remarks
+                Called automatically whenever the creating thread ended its outermost
+                trace event, usually the frame profile.
+            */
+            void flushTraceEvents();
+
+            /** Sets the name of the calling thread in traces
+            @remarks Can also be called before the profiler exists.
+            */
+            static void setCurrentThreadName(const String& name);
+
+            /** Gets the name of a thread given by ProfileTraceEvent::threadId */
+            String getTraceThreadName(uint32 threadId) const;
+
             /** Mark the beginning of a GPU event group
              @remarks Can be safely called in the middle of the profile.
              */
@@ -394,6 +480,17 @@ namespace Ogre {
             /** Handles a change of the profiler's enabled state*/
             void changeEnableState();
 
+            /** Begins a profile in the hierarchy, main thread only */
+            void beginProfileInstance(const String& profileName);
+            /** Ends a profile in the hierarchy, main thread only */
+            void endProfileInstance(const String& profileName, uint32 groupID);
+            /** Whether the calling thread created the profiler */
+            bool isMainThread() const;
+
+            struct TraceRecorder;
+            /** Recorder of the calling thread, registered on first use */
+            TraceRecorder* getTraceRecorder();
+
             // lol. Uses typedef; put's original container type in name.
             typedef std::set<String> DisabledProfileMap;
             typedef ProfileInstance::ProfileChildren ProfileChildren;
@@ -438,6 +535,18 @@ namespace Ogre {
             Real mAverageFrameTime;
             bool mResetExtents;
 
+            /// Whether trace events are recorded
+            std::atomic<bool> mTraceEnabled;
+            /// Incremented whenever tracing is enabled, so events open before are dropped
+            std::atomic<uint32> mTraceSession;
+            /// Identifies this profiler in the thread local data of the recorders
+            uint32 mGeneration;
+            /// Time the profiler was created, trace timestamps are relative to it
+            uint64 mTraceEpoch;
+            /// Recorders of all threads, which recorded trace events
+            std::vector<TraceRecorder*> mTraceRecorders;
+            OGRE_WQ_MUTEX(mTraceMutex);
+
 
     }; // end class
 
@@ -468,6 +577,70 @@ namespace Ogre {
         /// The group ID
         uint32 mGroupID;
     };
+
+    /** A trace event, which lasts for the scope
+        @remarks
+            Use the macro OgreProfileTrace(name) instead of instantiating this directly.
+            Unlike Profile, it can be used on any thread and does nothing if there is no
+            Profiler or tracing is disabled.
+    */
+    class ProfileTraceScope
+    {
+    public:
+        ProfileTraceScope(const char* name) : mProfiler(Profiler::getSingletonPtr())
+        {
+            begin(name);
+        }
+        ProfileTraceScope(const String& name) : mProfiler(Profiler::getSingletonPtr())
+        {
+            begin(name.c_str());
+        }
+        ~ProfileTraceScope()
+        {
+            if (mProfiler)
+                mProfiler->endTraceEvent();
+        }
+
+    private:
+        Profiler* mProfiler;
+
+        void begin(const char* name)
+        {
+            if (mProfiler && mProfiler->getTraceEnabled())
+                mProfiler->beginTraceEvent(name);
+            else
+                mProfiler = 0;
+        }
+    };
+
+    /** Writes trace events to a file in the Chrome trace event format
+        @remarks
+            The file can be loaded in chrome://tracing or the Perfetto UI. It is created
+            when the profiler session is initialized and completed with the names of the
+            recorded threads when the session is finalized, i.e. when the Profiler is enabled
+            and disabled. Tracing itself must be enabled with Profiler::setTraceEnabled.
+    */
+    class _OgreExport ChromeTraceSessionListener : public ProfileSessionListener, public ProfilerAlloc
+    {
+    public:
+        ChromeTraceSessionListener(const String& fileName);
+        ~ChromeTraceSessionListener();
+
+        void initializeSession();
+        void finializeSession();
+        void traceEventsRecorded(const ProfileTraceEventList& events);
+
+        const String& getFileName() const { return mFileName; }
+
+    private:
+        String mFileName;
+        std::ofstream mStream;
+        /// Threads, which appeared in the written events
+        std::set<uint32> mThreads;
+        bool mFirstEvent;
+
+        void beginEvent();
+    };
     /** @} */
     /** @} */
 
@@ -317,6 +317,16 @@ namespace Ogre {
         */
         void abortRequest( BackgroundProcessTicket ticket );
 
+        /** Change the priority of a background process, which did not start yet.
+        @remarks
+            Processes are queued with WorkQueue::RP_NORMAL. Raise the priority of
+            resources, which are needed soon, e.g. those close to the camera.
+        @param ticket The ticket which was returned when the process was queued
+        @param priority The new priority, see WorkQueue::RequestPriority
+        @return false if the process already started or completed
+        */
+        bool setPriority(BackgroundProcessTicket ticket, uint8 priority);
+
         /// Implementation for WorkQueue::RequestHandler
         bool canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
         /// Implementation for WorkQueue::RequestHandler
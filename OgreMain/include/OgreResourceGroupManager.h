@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreCommon.h"
 #include "Threading/OgreThreadHeaders.h"
 #include <ctime>
+#include <memory>
 #include "OgreHeaderPrefix.h"
 
 // If X11/Xlib.h gets included before this header (for example it happens when
@@ -347,6 +348,16 @@ namespace Ogre {
         /// Map from resource group names to groups
         typedef std::map<String, ResourceGroup*> ResourceGroupMap;
         ResourceGroupMap mResourceGroupMap;
+        /** Immutable copy of mResourceGroupMap, which getResourceGroup reads without locking.
+        @remarks
+            Groups are created and destroyed rarely, but looked up for every resource
+            lookup. Only accessed with std::atomic_load and std::atomic_store, so a
+            replaced copy is freed once the last reader released it. A destroyed group
+            is only deleted after the snapshots still holding it are released.
+        */
+        std::shared_ptr<const ResourceGroupMap> mResourceGroupSnapshot;
+        /// Publish the current mResourceGroupMap to getResourceGroup
+        void updateResourceGroupSnapshot();
 
         /// Group name for world resources
         String mWorldGroupName;
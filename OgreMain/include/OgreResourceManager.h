@@ -315,10 +315,14 @@ namespace Ogre {
         virtual void removeUnreferencedResources(bool reloadableOnly = true);
 
         /** Retrieves a pointer to a resource by name, or null if the resource does not exist.
+        @note
+            This does not take the manager mutex, only the lock of the lookup stripe the
+            name belongs to. Threads looking up different resources rarely contend.
         */
         virtual ResourcePtr getResourceByName(const String& name, const String& groupName OGRE_RESOURCE_GROUP_INIT);
 
         /** Retrieves a pointer to a resource by handle, or null if the resource does not exist.
+        @copydetails ResourceManager::getResourceByName
         */
         virtual ResourcePtr getByHandle(ResourceHandle handle);
         
@@ -504,6 +508,41 @@ namespace Ogre {
         ResourceHandleMap mResourcesByHandle;
         ResourceMap mResources;
         ResourceWithGroupMap mResourcesWithGroup;
+
+        /** One part of the concurrent lookup index over the maps above.
+        @remarks
+            Names and handles are spread over the stripes by their hash, and each stripe
+            has its own mutex, so lookups neither take the manager mutex nor wait for
+            lookups of other resources. The entries point to the ResourcePtr stored in the
+            maps instead of holding a reference of their own, so use counts are unchanged.
+            Resources are added to the maps before they are indexed and removed from the
+            index before they are erased from the maps, which keeps these pointers valid
+            for any thread holding the stripe lock.
+        */
+        struct LookupStripe
+        {
+            struct NameEntry
+            {
+                /// Entry in mResources, if any
+                const ResourcePtr* global;
+                /// Entries in mResourcesWithGroup with the group they are filed under, sorted by group
+                std::vector<std::pair<String, const ResourcePtr*> > grouped;
+
+                NameEntry() : global(0) {}
+            };
+            std::unordered_map<String, NameEntry> byName;
+            std::unordered_map<ResourceHandle, const ResourcePtr*> byHandle;
+            OGRE_WQ_MUTEX(mutex);
+        };
+        enum { LOOKUP_STRIPE_COUNT = 16 };
+        LookupStripe mLookupStripes[LOOKUP_STRIPE_COUNT];
+
+        LookupStripe& getLookupStripe(const String& name);
+        LookupStripe& getLookupStripe(ResourceHandle handle);
+        /// Index an entry of the name maps, group is empty for the global pool
+        void indexName(const String& group, const ResourcePtr& entry);
+        /// Remove an entry of the name maps from the index, group is empty for the global pool
+        void unindexName(const String& group, const ResourcePtr& entry);
         size_t mMemoryBudget; /// In bytes
         AtomicScalar<ResourceHandle> mNextHandle;
         AtomicScalar<size_t> mMemoryUsage; /// In bytes
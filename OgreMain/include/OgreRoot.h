@@ -84,6 +84,7 @@ namespace Ogre
         std::unique_ptr<ScriptCompilerManager> mCompilerManager;
         std::unique_ptr<DynLibManager> mDynLibManager;
         std::unique_ptr<Timer> mTimer;
+        std::unique_ptr<TaskScheduler> mTaskScheduler;
         std::unique_ptr<WorkQueue> mWorkQueue;
         std::unique_ptr<ResourceGroupManager> mResourceGroupManager;
         std::unique_ptr<ResourceBackgroundQueue> mResourceBackgroundQueue;
@@ -173,6 +174,9 @@ namespace Ogre
         /// Internal method for one-time tasks after first window creation
         void oneTimePostWindowInit(void);
 
+        /// (Re)start the TaskScheduler with the hardware threads the WorkQueue does not use
+        void startTaskScheduler(void);
+
         /** Set of registered frame listeners */
         std::set<FrameListener*> mFrameListeners;
 
@@ -934,6 +938,15 @@ namespace Ogre
             at shutdown, so do not destroy it yourself.
         */
         void setWorkQueue(WorkQueue* queue);
+
+        /** Get the TaskScheduler used for fine grained parallelism inside the engine.
+            Unlike the WorkQueue, its tasks are short and waited for by the submitting
+            thread, see parallelFor and TaskGroup. It runs one worker less than there
+            are hardware threads, as the waiting thread takes part in the work, minus the
+            worker threads of a DefaultWorkQueue, so the two pools together do not
+            oversubscribe the CPU. It is resized when the WorkQueue is started.
+        */
+        TaskScheduler* getTaskScheduler() const { return mTaskScheduler.get(); }
             
         /** Sets whether blend indices information needs to be passed to the GPU.
             When entities use software animation they remove blend information such as
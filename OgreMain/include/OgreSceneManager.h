@@ -547,6 +547,9 @@ namespace Ogre {
         uint8 mWorldGeometryRenderQueue;
         
         unsigned long mLastFrameNumber;
+        /// Controller and animation updates of _renderScene
+        std::unique_ptr<TaskGraph> mFrameUpdateGraph;
+        bool mConcurrentFrameUpdates;
         bool mResetIdentityView;
         bool mResetIdentityProj;
 
@@ -666,6 +669,9 @@ namespace Ogre {
             TexturePtr mNullShadowTexture;
             CameraList mShadowTextureCameras;
             LightList mShadowTextureCurrentCasterLightList;
+            /// Light lists of the additive passes and of the shadow volumes, kept to reuse their memory
+            LightList mAdditiveLightList;
+            LightList mShadowVolumeLightList;
             // ShadowCamera to light mapping
             ShadowCamLightMapping mShadowCamLightMapping;
             // Array defining shadow texture index in light list.
@@ -3273,6 +3279,32 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets whether the phases of the frame update may run concurrently.
+        @remarks
+            Before the scene graph is updated, the controllers (including the particle
+            systems) and the scene animations are updated. By default they run one after
+            the other on the rendering thread. When enabled, the phases run on the
+            TaskScheduler of Root, overlapping where their dependencies allow.
+        @par
+            The scene animations depend on the controllers by default, as both request
+            updates of the parents of the nodes they change, which is not thread safe even
+            for disjoint nodes. Only remove this dependency if no controller moves nodes or
+            updates the bounds of attached objects, and add own phases with dependencies
+            on every phase touching the same nodes.
+        */
+        void setConcurrentFrameUpdates(bool concurrent) { mConcurrentFrameUpdates = concurrent; }
+
+        /// Gets whether the phases of the frame update may run concurrently
+        bool getConcurrentFrameUpdates(void) const { return mConcurrentFrameUpdates; }
+
+        /** Get the phases updating the scene once per frame, before the scene graph.
+        @remarks
+            Phase 0 updates the controllers and phase 1, which depends on phase 0, the
+            scene animations. Own phases may be added, with dependencies on these. Their timings are
+            reported to the Profiler within the profile of the rendered camera.
+        */
+        TaskGraph* getFrameUpdateGraph(void) const { return mFrameUpdateGraph.get(); }
+
         /** Set whether to automatically normalise normals on objects whenever they
             are scaled.
         @remarks
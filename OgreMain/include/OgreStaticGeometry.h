@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgreMovableObject.h"
 #include "OgreRenderable.h"
 #include "OgreMesh.h"
+#include "OgreResourceGroupManager.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -177,6 +178,8 @@ namespace Ogre {
             Vector3 scale;
         };
         typedef std::vector<QueuedGeometry*> QueuedGeometryList;
+        /// System memory copies of the source buffers referenced by a build
+        typedef std::map<const HardwareBuffer*, std::vector<uchar> > SourceDataCache;
         
         // forward declarations
         class LODBucket;
@@ -206,6 +209,12 @@ namespace Ogre {
             HardwareIndexBuffer::IndexType mIndexType;
             /// Maximum vertex indexable
             size_t mMaxVertexIndex;
+            /// Packed vertex data per buffer, filled by prepare and released by build
+            /// unless StaticGeometry::setRetainBuildData is set
+            std::vector<std::vector<uchar> > mVertexStaging;
+            /// Packed index data, filled by prepare and released by build
+            /// unless StaticGeometry::setRetainBuildData is set
+            std::vector<uchar> mIndexStaging;
 
             template<typename T>
             void copyIndexes(const T* src, T* dst, size_t count, size_t indexOffset)
@@ -225,6 +234,9 @@ namespace Ogre {
         public:
             GeometryBucket(MaterialBucket* parent, const String& formatString, 
                 const VertexData* vData, const IndexData* iData);
+            /// Constructor for geometry restored by load
+            GeometryBucket(MaterialBucket* parent, const String& formatString,
+                HardwareIndexBuffer::IndexType indexType);
             virtual ~GeometryBucket();
             MaterialBucket* getParent(void) { return mParent; }
             /// Get the vertex data for this geometry 
@@ -244,10 +256,25 @@ namespace Ogre {
             @return false if there is no room left in this bucket
             */
             bool assign(QueuedGeometry* qsm);
-            /// Build
+            /** Copy the source buffers of the assigned geometry to system memory.
+            @note Reads hardware buffers, so must be called from the main thread.
+            */
+            void _cacheSourceData(SourceDataCache& cache) const;
+            /** Transform and pack the assigned geometry into system memory.
+            @remarks
+                No hardware buffers are touched, so this may be called from a
+                worker thread once _cacheSourceData has filled the cache.
+                The packed data is uploaded by build.
+            */
+            void prepare(bool stencilShadows, const SourceDataCache& cache);
+            /// Build, preparing the geometry first if this was not done yet
             void build(bool stencilShadows);
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
+            /// Write the built vertex / index data, @see StaticGeometry::save
+            void save(StreamSerialiser& stream) const;
+            /// Read the data written by save, ready to be uploaded by build
+            void load(StreamSerialiser& stream);
         };
         /** A MaterialBucket is a collection of smaller buckets with the same 
             Material (and implicitly the same LOD). */
@@ -297,6 +324,10 @@ namespace Ogre {
             Technique* getCurrentTechnique(void) const { return mTechnique; }
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
+            /// Write the built geometry buckets, @see StaticGeometry::save
+            void save(StreamSerialiser& stream) const;
+            /// Restore the geometry buckets written by save
+            void load(StreamSerialiser& stream);
             void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables);
         };
         /** A LODBucket is a collection of smaller buckets with the same LOD. 
@@ -368,6 +399,10 @@ namespace Ogre {
             MaterialIterator getMaterialIterator(void);
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
+            /// Write the built material buckets, @see StaticGeometry::save
+            void save(StreamSerialiser& stream) const;
+            /// Restore the material buckets written by save
+            void load(StreamSerialiser& stream);
             void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables);
             EdgeData* getEdgeList() const { return mEdgeList; }
             ShadowCaster::ShadowRenderableList& getShadowRenderableList() { return mShadowRenderables; }
@@ -437,6 +472,8 @@ namespace Ogre {
             StaticGeometry* getParent(void) const { return mParent;}
             /// Assign a queued mesh to this region, read for final build
             void assign(QueuedSubMesh* qmesh);
+            /// Distribute the assigned meshes into LOD buckets, ready for build
+            void createLodBuckets(void);
             /// Build this region
             void build(bool stencilShadows);
             /// Get the region ID of this region
@@ -470,6 +507,10 @@ namespace Ogre {
 
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
+            /// Write the built LOD buckets and bounds, @see StaticGeometry::save
+            void save(StreamSerialiser& stream) const;
+            /// Restore the LOD buckets and bounds written by save
+            void load(StreamSerialiser& stream);
             
         };
         /** Indexed region map based on packed x/y/z region index, 10 bits for
@@ -488,6 +529,7 @@ namespace Ogre {
         Real mUpperDistance;
         Real mSquaredUpperDistance;
         bool mCastShadows;
+        bool mRetainBuildData;
         Vector3 mRegionDimensions;
         Vector3 mHalfRegionDimensions;
         Vector3 mOrigin;
@@ -524,6 +566,8 @@ namespace Ogre {
         virtual Region* getRegion(ushort x, ushort y, ushort z, bool autoCreate);
         /** Get the region using a packed index, returns null if it doesn't exist. */
         virtual Region* getRegion(uint32 index);
+        /** Create a region with the given packed index and centre. */
+        virtual Region* createRegion(uint32 index, const Vector3& centre);
         /** Get the region indexes for a point.
         */
         virtual void getRegionIndexes(const Vector3& point, 
@@ -583,6 +627,17 @@ namespace Ogre {
         }
         
     public:
+        static const uint32 STATICGEOMETRY_CHUNK_ID;
+        static const uint16 STATICGEOMETRY_CHUNK_VERSION;
+        static const uint32 STATICGEOMETRYREGION_CHUNK_ID;
+        static const uint16 STATICGEOMETRYREGION_CHUNK_VERSION;
+        static const uint32 STATICGEOMETRYLOD_CHUNK_ID;
+        static const uint16 STATICGEOMETRYLOD_CHUNK_VERSION;
+        static const uint32 STATICGEOMETRYMATERIAL_CHUNK_ID;
+        static const uint16 STATICGEOMETRYMATERIAL_CHUNK_VERSION;
+        static const uint32 STATICGEOMETRYGEOMETRY_CHUNK_ID;
+        static const uint16 STATICGEOMETRYGEOMETRY_CHUNK_VERSION;
+
         /// Constructor; do not use directly (@see SceneManager::createStaticGeometry)
         StaticGeometry(SceneManager* owner, const String& name);
         /// Destructor
@@ -638,6 +693,10 @@ namespace Ogre {
             options which have been set, this method constructs the batched 
             geometry structures required. The batches are added to the scene 
             and will be rendered unless you specifically hide them.
+        @par
+            With thread support enabled, transforming and packing the geometry
+            is spread over the available hardware threads. The hardware buffers
+            are still created on the calling thread.
         @note
             Once you have called this method, you can no longer add any more 
             entities.
@@ -704,6 +763,16 @@ namespace Ogre {
         /// Will the geometry from this object cast shadows?
         virtual bool getCastShadows(void) { return mCastShadows; }
 
+        /** Sets whether a system memory copy of the built geometry is kept.
+        @remarks
+            The hardware buffers of the built geometry are write only, so 'save'
+            writes this copy instead of reading them back. Off by default.
+        @note Must be called before 'build' or 'load'.
+        */
+        virtual void setRetainBuildData(bool retain) { mRetainBuildData = retain; }
+        /// Is a system memory copy of the built geometry kept?
+        virtual bool getRetainBuildData(void) const { return mRetainBuildData; }
+
         /** Sets the size of a single region of geometry.
         @remarks
             This method allows you to configure the physical world size of 
@@ -769,6 +838,41 @@ namespace Ogre {
         */
         virtual void dump(const String& filename) const;
 
+        /** Get a key identifying the input of build.
+        @remarks
+            The key is derived from the queued meshes and their vertex / index 
+            data, the materials and placements and from the options affecting
+            the built geometry. It is stored by save so that load can reject
+            data built from a different input.
+        */
+        virtual uint32 getBuildKey(void) const;
+
+        /** Save the built geometry to a stream.
+        @remarks
+            Writes the regions, their bounds and LOD values and the packed 
+            vertex / index data of every GeometryBucket, so that load can 
+            restore them later without transforming the geometry again. The
+            vertex data is stored in the native layout of the platform.
+        @note Must be called after 'build' or 'load', with setRetainBuildData
+            enabled before.
+        */
+        virtual void save(StreamSerialiser& stream);
+        /// @overload
+        virtual void save(const String& filename);
+
+        /** Restore geometry written by save, as an alternative to build.
+        @remarks
+            The same entities / nodes must have been added as when the geometry
+            was saved, with the same batching options. If the stored build key
+            does not match getBuildKey nothing is restored, and you should
+            call build (and save again) instead.
+        @return true if the geometry was restored
+        */
+        virtual bool load(StreamSerialiser& stream);
+        /// @overload
+        virtual bool load(const String& filename,
+            const String& groupName = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
 
     };
     /** @} */
@@ -137,6 +137,12 @@ namespace Ogre
         */
         virtual Endian getEndian() const { return mEndian; }
 
+        /** Get the format in which Real values are stored.
+        @remarks
+            When reading, this is the format found in the header.
+        */
+        virtual RealStorageFormat getRealStorageFormat() const { return mRealFormat; }
+
         /** Pack a 4-character code into a 32-bit identifier.
         @remarks
             You can use this to generate id's for your chunks based on friendlier
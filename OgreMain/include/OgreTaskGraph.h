@@ -0,0 +1,137 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TaskGraph_H__
+#define __TaskGraph_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreTaskScheduler.h"
+#include "OgreTimer.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** A set of phases with dependencies between them, executed on a TaskScheduler.
+    @remarks
+        A phase starts as soon as all phases it depends on are finished, so
+        independent phases overlap on the workers. The graph is built once and
+        can be executed any number of times, e.g. once per frame.
+    @par
+        The wall time of every phase is measured and, with OGRE_PROFILING enabled,
+        reported to the Profiler on the executing thread after the graph finished.
+        Phases themselves must therefore not use the Profiler.
+    */
+    class _OgreExport TaskGraph : public UtilityAlloc
+    {
+    public:
+        typedef size_t PhaseId;
+
+        TaskGraph();
+        ~TaskGraph();
+
+        /** Add a phase, which calls func when executed.
+        @return id of the phase to declare dependencies with
+        */
+        template<typename Func>
+        PhaseId addPhase(const String& name, const Func& func)
+        {
+            return addPhaseImpl(name, OGRE_NEW_T(TaskScheduler::CallableImpl<Func>, MEMCATEGORY_GENERAL)(func));
+        }
+
+        /// Make phase wait for dependency
+        void addDependency(PhaseId phase, PhaseId dependency);
+        /// Undo addDependency
+        void removeDependency(PhaseId phase, PhaseId dependency);
+        /// Whether phase waits for dependency directly
+        bool hasDependency(PhaseId phase, PhaseId dependency) const;
+
+        /// Remove all phases
+        void clear();
+
+        size_t getNumPhases() const { return mPhases.size(); }
+        const String& getPhaseName(PhaseId phase) const;
+        /// Wall time of the phase during the last execute, in microseconds
+        uint64 getPhaseTime(PhaseId phase) const;
+
+        /** Run all phases and wait for them.
+        @remarks
+            The calling thread takes part in the work. If a phase throws, the phases
+            depending on it are skipped and the exception is rethrown here.
+        @param scheduler scheduler to run on, TaskScheduler::getDefault() if NULL
+        */
+        void execute(TaskScheduler* scheduler = 0);
+
+        /** Run all phases one after the other on the calling thread.
+        @remarks
+            Phases run in the order they were added, unless a dependency requires
+            otherwise. Useful if the phases are only safe to overlap in some setups.
+        */
+        void executeSerial();
+
+    private:
+        struct Phase
+        {
+            String name;
+            TaskScheduler::Callable* func;
+            std::vector<PhaseId> dependencies;
+            std::vector<PhaseId> dependents;
+            std::atomic<size_t> remainingDependencies;
+            TaskScheduler::Task task;
+            uint64 time;
+        };
+
+        std::vector<Phase*> mPhases;
+        /// Phases without dependencies, valid if !mDirty
+        std::vector<PhaseId> mRoots;
+        /// Order of executeSerial, valid if !mDirty
+        std::vector<PhaseId> mOrder;
+        bool mDirty;
+        /// Group of the running execute
+        TaskGroup* mGroup;
+        Timer mTimer;
+
+        PhaseId addPhaseImpl(const String& name, TaskScheduler::Callable* func);
+        Phase* getPhase(PhaseId phase) const;
+        /// Rebuild the dependents, roots and order, throws on cycles
+        void update();
+        void reportProfile();
+        static void runPhase(void* userData, size_t index);
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __TaskGraph_H__
@@ -0,0 +1,353 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TaskScheduler_H__
+#define __TaskScheduler_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreCommon.h"
+#include "Threading/OgreThreadHeaders.h"
+#include "OgreHeaderPrefix.h"
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#if OGRE_THREAD_SUPPORT
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** Work-stealing thread pool for fine grained engine tasks.
+    @remarks
+        Every worker thread owns a lock-free deque. Tasks submitted by a worker go
+        to the bottom of its own deque and are taken back in LIFO order, while idle
+        workers steal the oldest tasks from the top of the other deques. Tasks
+        submitted by any other thread go through a shared injection queue.
+    @par
+        A thread waiting for a TaskGroup keeps running pending tasks until the group is
+        finished, and only blocks once there are none left to take. This makes nested
+        parallelism safe and lets a scheduler without workers execute everything on the
+        waiting thread.
+    @par
+        Tasks should not block for long, e.g. on file IO. Use the WorkQueue for such
+        background requests.
+    */
+    class _OgreExport TaskScheduler : public UtilityAlloc
+    {
+    public:
+        /// Signature of a task function, which is called with the user data and index of the task
+        typedef void (*TaskFunc)(void* userData, size_t index);
+
+        /** A unit of work.
+        @remarks
+            The scheduler only stores pointers to tasks, so the submitter must keep the
+            Task alive until it was executed.
+        */
+        struct Task
+        {
+            TaskFunc func;
+            void* userData;
+            size_t index;
+            /// Optional group, which is notified when the task finished
+            TaskGroup* group;
+        };
+
+        /// Type erased functor, which TaskGroup and TaskGraph run as tasks
+        struct Callable
+        {
+            virtual ~Callable() {}
+            virtual void operator()() = 0;
+        };
+        template<typename Func>
+        struct CallableImpl : public Callable
+        {
+            Func func;
+            CallableImpl(const Func& f) : func(f) {}
+            void operator()() { func(); }
+        };
+
+        /// Listener for the lifetime of the worker threads
+        class _OgreExport Listener
+        {
+        public:
+            virtual ~Listener() {}
+            /// Called on the worker thread before it runs any task
+            virtual void workerStarted(TaskScheduler* scheduler) { (void)scheduler; }
+            /// Called on the worker thread after it ran its last task
+            virtual void workerStopped(TaskScheduler* scheduler) { (void)scheduler; }
+        };
+
+        TaskScheduler(const String& name = BLANKSTRING);
+        ~TaskScheduler();
+
+        /** Start the worker threads.
+        @param workerCount Number of threads to start. With 0 workers every task runs
+            on the thread waiting for it.
+        @param listener Optional listener, which is called on every worker thread
+        */
+        void startup(size_t workerCount, Listener* listener = 0);
+        /** Stop and join the worker threads.
+        @remarks
+            Tasks, which did not start yet, stay queued and are run by the threads
+            waiting for them or by the workers of the next startup.
+        */
+        void shutdown();
+
+        const String& getName() const { return mName; }
+        /// Number of running worker threads
+        size_t getWorkerCount() const { return mWorkers.size(); }
+        /// Whether the calling thread is one of the workers of this scheduler
+        bool isWorkerThread() const;
+
+        /** Queue a task for execution.
+        @remarks
+            The group of the task, if any, must already have been told about it with
+            TaskGroup::run or the task must be added with TaskGroup::submit.
+        */
+        void submit(Task* task);
+
+        /** Run one pending task on the calling thread.
+        @return false if no task was pending
+        */
+        bool runPendingTask();
+
+        /// The scheduler for engine internal parallelism, owned by Root. NULL without Root.
+        static TaskScheduler* getDefault();
+
+    private:
+        friend class TaskGroup;
+
+        /** Single producer, multiple consumer deque of task pointers.
+        @remarks
+            Chase-Lev deque with the memory orderings of "Correct and Efficient
+            Work-Stealing for Weak Memory Models" (Le et al., 2013).
+        */
+        class WorkStealingDeque
+        {
+        public:
+            WorkStealingDeque();
+            ~WorkStealingDeque();
+            /// Owner only
+            void push(Task* task);
+            /// Owner only
+            Task* pop();
+            /// Any thread
+            Task* steal();
+        private:
+            struct Buffer
+            {
+                int64 mask;
+                std::atomic<Task*>* slots;
+                Buffer* retired;
+            };
+            std::atomic<int64> mTop;
+            std::atomic<int64> mBottom;
+            std::atomic<Buffer*> mBuffer;
+
+            Buffer* grow(Buffer* buffer, int64 bottom, int64 top);
+        };
+
+        struct Worker;
+
+        String mName;
+        std::vector<Worker*> mWorkers;
+        Listener* mListener;
+        std::atomic<bool> mShuttingDown;
+
+        /// Tasks submitted from outside the workers
+        std::deque<Task*> mInjected;
+        /// Number of queued tasks, which are not taken yet (approximate)
+        std::atomic<size_t> mPendingTasks;
+#if OGRE_THREAD_SUPPORT
+        std::mutex mInjectedMutex;
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
+        std::atomic<size_t> mSleepingWorkers;
+#endif
+
+        Task* takeTask(Worker* self);
+        void execute(Task* task);
+        void wakeWorker();
+        void workerMain(Worker* self);
+    };
+
+    /** A set of tasks, which can be waited for together.
+    @remarks
+        The thread, which runs functors in a group, must also be the one waiting for it.
+        Caller owned tasks may also be submitted by the tasks of the group itself.
+        Exceptions thrown by the tasks are caught and the first one is rethrown by wait().
+    */
+    class _OgreExport TaskGroup : public UtilityAlloc
+    {
+    public:
+        /// Group executed by the given scheduler, or TaskScheduler::getDefault() if NULL
+        TaskGroup(TaskScheduler* scheduler = 0);
+        /// Waits for the remaining tasks
+        ~TaskGroup();
+
+        /** Run a callable in the group.
+        @remarks
+            The callable is copied into the group and kept until the group is destroyed.
+        */
+        template<typename Func>
+        void run(const Func& func)
+        {
+            mFunctions.push_back(OGRE_NEW_T(TaskScheduler::CallableImpl<Func>, MEMCATEGORY_GENERAL)(func));
+            TaskScheduler::Task& task = allocateTask();
+            task.func = &TaskGroup::runCallable;
+            task.userData = mFunctions.back();
+            task.index = 0;
+            submit(&task);
+        }
+
+        /** Add a caller owned task to the group.
+        @remarks
+            The group field of the task is overwritten.
+        */
+        void submit(TaskScheduler::Task* task);
+
+        /// Wait until all tasks of the group are finished, running pending tasks meanwhile
+        void wait();
+
+        /// Whether all tasks of the group are finished
+        bool isFinished() const { return mPendingTasks.load(std::memory_order_acquire) == 0; }
+
+        TaskScheduler* getScheduler() const { return mScheduler; }
+
+    private:
+        friend class TaskScheduler;
+
+        typedef TaskScheduler::Callable Callable;
+
+        TaskScheduler* mScheduler;
+        std::atomic<size_t> mPendingTasks;
+        std::deque<TaskScheduler::Task> mTasks;
+        std::vector<Callable*> mFunctions;
+        std::exception_ptr mError;
+#if OGRE_THREAD_SUPPORT
+        std::mutex mErrorMutex;
+        std::mutex mFinishedMutex;
+        std::condition_variable mFinishedCondition;
+#endif
+
+        TaskScheduler::Task& allocateTask();
+        void finishTask();
+        void setError(std::exception_ptr error);
+        static void runCallable(void* userData, size_t);
+    };
+
+    /** Call func(i) for every i in [0, count), spread over the default TaskScheduler.
+    @remarks
+        The calling thread takes part in the work and the call returns once every index
+        has been processed. Indices are handed out one at a time to at most one task per
+        worker, so uneven work balances itself. The first exception thrown by func is
+        rethrown on the calling thread. Without a TaskScheduler the indices are processed
+        in order.
+    */
+    template<typename Func>
+    void parallelFor(size_t count, const Func& func)
+    {
+        TaskScheduler* scheduler = TaskScheduler::getDefault();
+        if (count <= 1 || !scheduler || scheduler->getWorkerCount() == 0)
+        {
+            for (size_t i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+
+        struct Range
+        {
+            const Func* func;
+            size_t count;
+            std::atomic<size_t> next;
+
+            void process()
+            {
+                try
+                {
+                    for (size_t i = next++; i < count; i = next++)
+                        (*func)(i);
+                }
+                catch (...)
+                {
+                    next = count; // stop the others early
+                    throw;
+                }
+            }
+            static void run(void* userData, size_t) { static_cast<Range*>(userData)->process(); }
+        };
+        Range range;
+        range.func = &func;
+        range.count = count;
+        range.next = 0;
+
+        size_t taskCount = std::min(count - 1, scheduler->getWorkerCount());
+        std::vector<TaskScheduler::Task> tasks(taskCount);
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < taskCount; ++i)
+        {
+            tasks[i].func = &Range::run;
+            tasks[i].userData = &range;
+            tasks[i].index = i;
+            group.submit(&tasks[i]);
+        }
+
+        try
+        {
+            range.process();
+        }
+        catch (...)
+        {
+            try
+            {
+                group.wait();
+            }
+            catch (...)
+            {
+                // report the first exception of the caller
+            }
+            throw;
+        }
+        group.wait();
+    }
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __TaskScheduler_H__
@@ -35,6 +35,8 @@ THE SOFTWARE.
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
 
+#include <atomic>
+
 namespace Ogre
 {
     /** \addtogroup Core
@@ -79,11 +81,41 @@ namespace Ogre
         /// Numeric identifier for a request
         typedef unsigned long long int RequestID;
 
+        /** Priority classes of requests, higher ones are processed first.
+        @remarks
+            Any value in between may be used, e.g. to order requests by distance.
+        */
+        enum RequestPriority
+        {
+            RP_LOW = 64,
+            RP_NORMAL = 128,
+            RP_HIGH = 192,
+            RP_CRITICAL = 255
+        };
+
+        /** Cancels any number of requests at once.
+        @remarks
+            Requests added with a token report getAborted() once it is cancelled,
+            also while they are being processed, so handlers of long requests can
+            poll it and give up early.
+        */
+        class _OgreExport CancellationToken : public UtilityAlloc
+        {
+            std::atomic<bool> mCancelled;
+        public:
+            CancellationToken() : mCancelled(false) {}
+            /// Cancel all requests using this token
+            void cancel() { mCancelled.store(true, std::memory_order_relaxed); }
+            bool isCancelled() const { return mCancelled.load(std::memory_order_relaxed); }
+        };
+        typedef SharedPtr<CancellationToken> CancellationTokenPtr;
+
         /** General purpose request structure. 
         */
         class _OgreExport Request : public UtilityAlloc
         {
             friend class WorkQueue;
+            friend class DefaultWorkQueueBase;
         protected:
             /// The request channel, as an integer 
             uint16 mChannel;
@@ -97,11 +129,22 @@ namespace Ogre
             RequestID mID;
             /// Abort Flag
             mutable bool mAborted;
+            /// Priority, see RequestPriority
+            uint8 mPriority;
+            /// Root timer milliseconds, after which the request is not started anymore (0 for none)
+            unsigned long mDeadline;
+            /// Optional token to cancel the request with
+            CancellationTokenPtr mCancellation;
 
         public:
             /// Constructor 
-            Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid);
+            Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid,
+                    uint8 priority = RP_NORMAL, unsigned long deadline = 0,
+                    const CancellationTokenPtr& cancellation = CancellationTokenPtr());
             ~Request();
+            /// Requests are recycled through per thread free lists
+            static void* operator new(size_t sz);
+            static void operator delete(void* ptr, size_t sz);
             /// Set the abort flag
             void abortRequest() const { mAborted = true; }
             /// Get the request channel (top level categorisation)
@@ -114,8 +157,14 @@ namespace Ogre
             uint8 getRetryCount() const { return mRetryCount; }
             /// Get the identifier of this request
             RequestID getID() const { return mID; }
-            /// Get the abort flag
-            bool getAborted() const { return mAborted; }
+            /// Get the abort flag, which is also set by the cancellation token
+            bool getAborted() const { return mAborted || (mCancellation && mCancellation->isCancelled()); }
+            /// Get the priority of this request
+            uint8 getPriority() const { return mPriority; }
+            /// Get the deadline of this request in Root timer milliseconds (0 for none)
+            unsigned long getDeadline() const { return mDeadline; }
+            /// Get the cancellation token of this request, if any
+            const CancellationTokenPtr& getCancellationToken() const { return mCancellation; }
         };
 
         /** General purpose response structure. 
@@ -134,6 +183,9 @@ namespace Ogre
         public:
             Response(const Request* rq, bool success, const Any& data, const String& msg = BLANKSTRING);
             ~Response();
+            /// Responses are recycled through per thread free lists
+            static void* operator new(size_t sz);
+            static void operator delete(void* ptr, size_t sz);
             /// Get the request that this is a response to (NB destruction destroys this)
             const Request* getRequest() const { return mRequest; }
             /// Return whether this is a successful response
@@ -273,6 +325,34 @@ namespace Ogre
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false) = 0;
 
+        /** Add a new request, which is processed before the requests of lower priority.
+        @remarks
+            Requests of the same priority are processed by earliest deadline, then
+            in the order they were added. The default implementation ignores the
+            priority, deadline and cancellation and calls addRequest.
+        @param channel The channel this request will go into
+        @param requestType An identifier that's unique within this queue which
+            identifies the type of the request (user decides the actual value)
+        @param rData The data required by the request process. 
+        @param priority The priority, see RequestPriority
+        @param deadline Root timer milliseconds, after which the request is aborted
+            if it did not start yet (0 for none)
+        @param cancellation Optional token, which aborts the request when cancelled
+        @param retryCount The number of times the request should be retried
+            if it fails.
+        @return The ID of the request that has been added
+        */
+        virtual RequestID addPrioritisedRequest(uint16 channel, uint16 requestType, const Any& rData,
+            uint8 priority, unsigned long deadline = 0,
+            const CancellationTokenPtr& cancellation = CancellationTokenPtr(), uint8 retryCount = 0);
+
+        /** Change the priority of a request, which did not start yet.
+        @remarks
+            Use this to re-prioritise streaming requests, e.g. as the camera moves.
+        @return false if the request is not waiting anymore or priorities are unsupported
+        */
+        virtual bool setRequestPriority(RequestID id, uint8 priority);
+
         /** Abort a previously issued request.
         If the request is still waiting to be processed, it will be 
         removed from the queue.
@@ -443,6 +523,12 @@ namespace Ogre
         /// @copydoc WorkQueue::addRequest
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::addPrioritisedRequest
+        virtual RequestID addPrioritisedRequest(uint16 channel, uint16 requestType, const Any& rData,
+            uint8 priority, unsigned long deadline = 0,
+            const CancellationTokenPtr& cancellation = CancellationTokenPtr(), uint8 retryCount = 0);
+        /// @copydoc WorkQueue::setRequestPriority
+        virtual bool setRequestPriority(RequestID id, uint8 priority);
         /// @copydoc WorkQueue::abortRequest
         virtual void abortRequest(RequestID id);
         /// @copydoc WorkQueue::abortPendingRequest
@@ -551,6 +637,8 @@ namespace Ogre
         typedef std::map<uint16, ResponseHandlerList> ResponseHandlerListByChannel;
 
         RequestHandlerListByChannel mRequestHandlers;
+        /// Immutable copy of mRequestHandlers, replaced on change so requests don't copy the map
+        SharedPtr<const RequestHandlerListByChannel> mRequestHandlerSnapshot; // Guarded by mRequestHandlerMutex
         ResponseHandlerListByChannel mResponseHandlers;
         RequestID mRequestCount; // Guarded by mRequestMutex
         bool mPaused;
@@ -568,13 +656,23 @@ namespace Ogre
         OGRE_WQ_RW_MUTEX(mRequestHandlerMutex);
 
 
+        void updateRequestHandlerSnapshot();
         void processRequestResponse(Request* r, bool synchronous);
         Response* processRequest(Request* r);
         void processResponse(Response* r);
         /// Notify workers about a new request. 
         virtual void notifyWorkers() = 0;
         /// Put a Request on the queue with a specific RequestID.
-        void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
+        void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount,
+            uint8 priority = RP_NORMAL, unsigned long deadline = 0,
+            const CancellationTokenPtr& cancellation = CancellationTokenPtr());
+        RequestID addRequestImpl(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount,
+            bool forceSynchronous, bool idleThread, uint8 priority, unsigned long deadline,
+            const CancellationTokenPtr& cancellation);
+        /// Insert by priority and deadline behind its equals, caller holds mRequestMutex
+        void queueRequest(Request* req);
+        /// Whether the deadline of the request passed
+        static bool isExpired(const Request* req);
         
         RequestQueue mIdleRequestQueue; // Guarded by mIdleMutex
         bool mIdleThreadRunning; // Guarded by mIdleMutex
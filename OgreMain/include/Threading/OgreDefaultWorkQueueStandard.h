@@ -27,22 +27,29 @@ THE SOFTWARE
 #define __OgreDefaultWorkQueueStandard_H__
 
 #include "../OgreWorkQueue.h"
+#include "../OgreTaskScheduler.h"
 
 namespace Ogre
 {
     /** Implementation of a general purpose request / response style background work queue.
     @remarks
-        This default implementation of a work queue starts a thread pool and 
-        provides queues to process requests. 
+        This default implementation of a work queue runs the requests on a
+        work-stealing TaskScheduler and provides queues to process requests.
+        Every queued request submits a task, which takes the next request off the
+        queue, so idle workers pick up requests without waiting on a shared condition.
     */
-    class _OgreExport DefaultWorkQueue : public DefaultWorkQueueBase
+    class _OgreExport DefaultWorkQueue : public DefaultWorkQueueBase, public TaskScheduler::Listener
     {
     public:
 
         DefaultWorkQueue(const String& name = BLANKSTRING);
         virtual ~DefaultWorkQueue(); 
 
-        /// Main function for each thread spawned.
+        /** Main function for a thread driven by the user.
+        @remarks
+            The worker threads of the queue do not use this, it is only kept for
+            threads, which process requests of this queue on their own.
+        */
         virtual void _threadMain();
 
         /// @copydoc WorkQueue::shutdown
@@ -51,6 +58,9 @@ namespace Ogre
         /// @copydoc WorkQueue::startup
         virtual void startup(bool forceRestart = true);
 
+        /// The scheduler running the worker threads of this queue
+        TaskScheduler* getTaskScheduler() { return &mScheduler; }
+
     protected:
         /** To be called by a separate thread; will return immediately if there
             are items in the queue, or suspend the thread until new items are added
@@ -63,18 +73,25 @@ namespace Ogre
 
         virtual void notifyWorkers();
 
+        /// @copydoc TaskScheduler::Listener::workerStarted
+        virtual void workerStarted(TaskScheduler* scheduler);
+        /// @copydoc TaskScheduler::Listener::workerStopped
+        virtual void workerStopped(TaskScheduler* scheduler);
+
+        static void processNextRequestTask(void* userData, size_t);
+
         size_t mNumThreadsRegisteredWithRS;
         /// Init notification mutex (must lock before waiting on initCondition)
         OGRE_WQ_MUTEX(mInitMutex);
         /// Synchroniser token to wait / notify on thread init 
         OGRE_WQ_THREAD_SYNCHRONISER(mInitSync);
 
+        /// Only used by threads running _threadMain
         OGRE_WQ_THREAD_SYNCHRONISER(mRequestCondition);
-#if OGRE_THREAD_SUPPORT
-        typedef std::vector<OGRE_THREAD_TYPE*> WorkerThreadList;
-        WorkerThreadList mWorkers;
-#endif
 
+        TaskScheduler mScheduler;
+        /// Task processing the next request, it carries no state and is submitted once per request
+        TaskScheduler::Task mProcessTask;
     };
 
 }
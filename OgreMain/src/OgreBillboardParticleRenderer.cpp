@@ -134,6 +134,8 @@ namespace Ogre {
         Real radius = 0.0f;
         mBillboardSet->beginBillboards(currentParticles.size());
         Billboard bb;
+        size_t numBillboards = 0;
+        mBillboards.resize(currentParticles.size());
         Affine3 invWorld;
 
         bool invert = mBillboardSet->getBillboardsInWorldSpace() && mBillboardSet->getParentSceneNode();
@@ -169,9 +171,9 @@ namespace Ogre {
                 bb.mWidth = p->mWidth;
                 bb.mHeight = p->mHeight;
             }
-            mBillboardSet->injectBillboard(bb);
-
+            mBillboards[numBillboards++] = bb;
         }
+        mBillboardSet->injectBillboards(mBillboards.data(), numBillboards);
 
         // Only set bounds if there are any active particles
         if(currentParticles.size())
@@ -30,9 +30,14 @@ THE SOFTWARE.
 #include "OgreBillboardSet.h"
 #include "OgreBillboard.h"
 
+#include "OgreTaskScheduler.h"
+
 #include <algorithm>
 
 namespace Ogre {
+    /// Billboards generated per task, smaller sets are generated serially
+    static const size_t BILLBOARDS_PER_CHUNK = 4096;
+
     // Init statics
     RadixSort<BillboardSet::ActiveBillboardList, Billboard*, float> BillboardSet::mRadixSorter;
 
@@ -468,55 +473,88 @@ namespace Ogre {
         // Skip if not visible (NB always true if not bounds checking individual billboards)
         if (!billboardVisible(mCurrentCamera, bb)) return;
 
-        if (!mPointRendering &&
-            (mBillboardType == BBT_ORIENTED_SELF ||
-            mBillboardType == BBT_PERPENDICULAR_SELF ||
-            (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON)))
+        genBillboard(bb, mLockPtr);
+
+        // Increment visibles
+        mNumVisibleBillboards++;
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::injectBillboards(const Billboard* billboards, size_t count)
+    {
+        // Don't accept injections beyond pool size, skip if not visible
+        mVisibleBillboards.clear();
+        for (size_t i = 0; i < count && mNumVisibleBillboards + mVisibleBillboards.size() < mPoolSize; ++i)
         {
-            // Have to generate axes & offsets per billboard
-            genBillboardAxes(&mCamX, &mCamY, &bb);
+            if (billboardVisible(mCurrentCamera, billboards[i]))
+                mVisibleBillboards.push_back(&billboards[i]);
         }
 
-        // If they're all the same size or we're point rendering
-        if( mAllDefaultSize || mPointRendering)
-        {
-            /* No per-billboard checking, just blast through.
-            Saves us an if clause every billboard which may
-            make a difference.
-            */
+        genVisibleBillboards();
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::genVisibleBillboards(void)
+    {
+        const size_t numBillboards = mVisibleBillboards.size();
+        const size_t floatsPerBillboard = (mPointRendering ? 1 : 4) * mMainBuf->getVertexSize() / sizeof(float);
 
-            if (!mPointRendering &&
-                (mBillboardType == BBT_ORIENTED_SELF ||
-                mBillboardType == BBT_PERPENDICULAR_SELF ||
-                (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON)))
+        // Every chunk writes its own range of the locked buffer
+        const size_t numChunks = (numBillboards + BILLBOARDS_PER_CHUNK - 1) / BILLBOARDS_PER_CHUNK;
+        float* pBase = mLockPtr;
+        parallelFor(numChunks, [&](size_t chunk)
+        {
+            const size_t start = chunk * BILLBOARDS_PER_CHUNK;
+            const size_t end = std::min(start + BILLBOARDS_PER_CHUNK, numBillboards);
+            float* pDest = pBase + start * floatsPerBillboard;
+            for (size_t i = start; i < end; ++i)
             {
-                genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
-                    mDefaultWidth, mDefaultHeight, mCamX, mCamY, mVOffset);
+                genBillboard(*mVisibleBillboards[i], pDest);
             }
-            genVertices(mVOffset, bb);
+        });
+
+        mLockPtr += numBillboards * floatsPerBillboard;
+        mNumVisibleBillboards += static_cast<unsigned short>(numBillboards);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::genBillboard(const Billboard& bb, float*& pDest) const
+    {
+        // Point rendering ignores the offsets
+        if (mPointRendering)
+        {
+            genVertices(mVOffset, bb, pDest);
+            return;
         }
-        else // not all default size and not point rendering
+
+        const bool perBillboardAxes = mBillboardType == BBT_ORIENTED_SELF ||
+            mBillboardType == BBT_PERPENDICULAR_SELF ||
+            (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON);
+
+        if (!perBillboardAxes && (mAllDefaultSize || !bb.mOwnDimensions))
         {
-            Vector3 vOwnOffset[4];
-            // If it has own dimensions, or self-oriented, gen offsets
-            if (mBillboardType == BBT_ORIENTED_SELF ||
-                mBillboardType == BBT_PERPENDICULAR_SELF ||
-                bb.mOwnDimensions ||
-                (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON))
-            {
-                // Generate using own dimensions
-                genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
-                    bb.mWidth, bb.mHeight, mCamX, mCamY, vOwnOffset);
-                // Create vertex data
-                genVertices(vOwnOffset, bb);
-            }
-            else // Use default dimension, already computed before the loop, for faster creation
-            {
-                genVertices(mVOffset, bb);
-            }
+            // Use default dimension, already computed before the loop, for faster creation
+            genVertices(mVOffset, bb, pDest);
+            return;
         }
-        // Increment visibles
-        mNumVisibleBillboards++;
+
+        Vector3 camX = mCamX, camY = mCamY;
+        if (perBillboardAxes)
+        {
+            // Have to generate axes & offsets per billboard
+            genBillboardAxes(&camX, &camY, &bb);
+        }
+
+        // Generate using own dimensions unless they're all the same size
+        Vector3 vOwnOffset[4];
+        if (mAllDefaultSize)
+        {
+            genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
+                mDefaultWidth, mDefaultHeight, camX, camY, vOwnOffset);
+        }
+        else
+        {
+            genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
+                bb.mWidth, bb.mHeight, camX, camY, vOwnOffset);
+        }
+        genVertices(vOwnOffset, bb, pDest);
     }
     //-----------------------------------------------------------------------
     void BillboardSet::endBillboards(void)
@@ -596,13 +634,16 @@ namespace Ogre {
             }
 
             beginBillboards(mActiveBillboards.size());
+            mVisibleBillboards.clear();
             ActiveBillboardList::iterator it;
             for(it = mActiveBillboards.begin();
-                it != mActiveBillboards.end();
+                it != mActiveBillboards.end() && mVisibleBillboards.size() < mPoolSize;
                 ++it )
             {
-                injectBillboard(*(*it));
+                if (billboardVisible(mCurrentCamera, *(*it)))
+                    mVisibleBillboards.push_back(*it);
             }
+            genVisibleBillboards();
             endBillboards();
             mBillboardDataChanged = false;
         }
@@ -987,17 +1028,18 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
-    void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb)
+    void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb) const
     {
         // If we're using accurate facing, recalculate camera direction per BB
+        Vector3 camDir = mCamDir;
         if (mAccurateFacing && 
             (mBillboardType == BBT_POINT || 
             mBillboardType == BBT_ORIENTED_COMMON ||
             mBillboardType == BBT_ORIENTED_SELF))
         {
             // cam -> bb direction
-            mCamDir = bb->mPosition - mCamPos;
-            mCamDir.normalise();
+            camDir = bb->mPosition - mCamPos;
+            camDir.normalise();
         }
 
 
@@ -1009,9 +1051,9 @@ namespace Ogre {
                 // Point billboards will have 'up' based on but not equal to cameras
                 // Use pY temporarily to avoid allocation
                 *pY = mCamQ * Vector3::UNIT_Y;
-                *pX = mCamDir.crossProduct(*pY);
+                *pX = camDir.crossProduct(*pY);
                 pX->normalise();
-                *pY = pX->crossProduct(mCamDir); // both normalised already
+                *pY = pX->crossProduct(camDir); // both normalised already
             }
             else
             {
@@ -1025,7 +1067,7 @@ namespace Ogre {
             // Y-axis is common direction
             // X-axis is cross with camera direction
             *pY = mCommonDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -1034,7 +1076,7 @@ namespace Ogre {
             // X-axis is cross with camera direction
             // Scale direction first
             *pY = bb->mDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -1092,7 +1134,7 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void BillboardSet::genVertices(
-        const Vector3* const offsets, const Billboard& bb)
+        const Vector3* const offsets, const Billboard& bb, float*& pDest) const
     {
         RGBA colour;
         Root::getSingleton().convertColourValue(bb.mColour, &colour);
@@ -1107,78 +1149,78 @@ namespace Ogre {
         {
             // Single vertex per billboard, ignore offsets
             // position
-            *mLockPtr++ = bb.mPosition.x;
-            *mLockPtr++ = bb.mPosition.y;
-            *mLockPtr++ = bb.mPosition.z;
+            *pDest++ = bb.mPosition.x;
+            *pDest++ = bb.mPosition.y;
+            *pDest++ = bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // No texture coords in point rendering
         }
         else if (mAllDefaultRotation || bb.mRotation == Radian(0))
         {
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else if (mRotationType == BBR_VERTEX)
         {
@@ -1193,66 +1235,66 @@ namespace Ogre {
             // Left-top
             // Positions
             pt = rotation * offsets[0];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
             pt = rotation * offsets[1];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
             pt = rotation * offsets[2];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
             pt = rotation * offsets[3];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else
         {
@@ -1271,69 +1313,69 @@ namespace Ogre {
 
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w - cos_rot_h;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w - cos_rot_h;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w + cos_rot_h;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
             // Convert float* to RGBA*
-            pCol = static_cast<RGBA*>(static_cast<void*>(mLockPtr));
+            pCol = static_cast<RGBA*>(static_cast<void*>(pDest));
             *pCol++ = colour;
             // Update lock pointer
-            mLockPtr = static_cast<float*>(static_cast<void*>(pCol));
+            pDest = static_cast<float*>(static_cast<void*>(pCol));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w + cos_rot_h;
         }
 
     }
     //-----------------------------------------------------------------------
     void BillboardSet::genVertOffsets(Real inleft, Real inright, Real intop, Real inbottom,
-        Real width, Real height, const Vector3& x, const Vector3& y, Vector3* pDestVec)
+        Real width, Real height, const Vector3& x, const Vector3& y, Vector3* pDestVec) const
     {
         Vector3 vLeftOff, vRightOff, vTopOff, vBottomOff;
         /* Calculate default offsets. Scale the axes by
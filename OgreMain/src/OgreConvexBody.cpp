@@ -941,7 +941,7 @@ namespace Ogre
             // - side is clipSide: vertex will be clipped
             // - side is !clipSide: vertex will be untouched
             // - side is NOSIDE:   vertex will be untouched
-            Plane::Side *side = OGRE_ALLOC_T(Plane::Side, vertexCount, MEMCATEGORY_SCENE_CONTROL);
+            frame_vector<Plane::Side> side(vertexCount);
             for ( size_t iVertex = 0; iVertex < vertexCount; ++iVertex )
             {
                 side[ iVertex ] = pl.getSide( p.getVertex( iVertex ) );
@@ -1064,10 +1064,6 @@ namespace Ogre
             // vertices were copied (if there were any)
             freePolygon(pIntersect);
             pIntersect = 0;
-
-            // delete side info
-            OGRE_FREE(side, MEMCATEGORY_SCENE_CONTROL);
-            side = 0;
         }
 
         // if the polygon was partially clipped, close it
@@ -0,0 +1,186 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreFrameAllocator.h"
+
+namespace Ogre {
+
+    namespace
+    {
+        /// Size of the blocks of an arena
+        const size_t FRAME_BLOCK_SIZE = 64 * 1024;
+        /// Bigger allocations get a block of their own, which is freed when the arena rewinds
+        const size_t FRAME_LARGE_ALLOCATION = FRAME_BLOCK_SIZE / 2;
+
+        std::atomic<size_t> currentFrame(0);
+        std::atomic<size_t> frameAllocations(0);
+        std::atomic<size_t> lastFrameAllocations(0);
+        std::atomic<size_t> heapAllocations(0);
+
+        struct Arena
+        {
+            struct Block
+            {
+                Block* next;
+                size_t size;
+
+                uchar* begin() { return reinterpret_cast<uchar*>(this) + HEADER_SIZE; }
+                uchar* end() { return begin() + size; }
+            };
+
+            /// Block header, padded to keep the memory aligned
+            static const size_t HEADER_SIZE = (sizeof(void*) + sizeof(size_t) + OGRE_SIMD_ALIGNMENT - 1) & ~size_t(OGRE_SIMD_ALIGNMENT - 1);
+
+            /// Blocks in order of use
+            Block* blocks;
+            /// Block allocations are made from
+            Block* current;
+            uchar* top;
+            /// Blocks of large allocations
+            Block* large;
+            size_t frame;
+
+            Arena() : blocks(0), current(0), top(0), large(0), frame(0) {}
+            ~Arena()
+            {
+                freeBlocks(blocks);
+                freeBlocks(large);
+            }
+
+            static Block* createBlock(size_t size)
+            {
+                Block* block = static_cast<Block*>(AlignedMemory::allocate(HEADER_SIZE + size, OGRE_SIMD_ALIGNMENT));
+                block->next = 0;
+                block->size = size;
+                ++heapAllocations;
+                return block;
+            }
+
+            static void freeBlocks(Block* block)
+            {
+                while (block)
+                {
+                    Block* next = block->next;
+                    AlignedMemory::deallocate(block);
+                    block = next;
+                }
+            }
+
+            void rewind()
+            {
+                freeBlocks(large);
+                large = 0;
+                current = blocks;
+                top = current ? current->begin() : 0;
+                frame = currentFrame.load(std::memory_order_relaxed);
+            }
+
+            void* allocate(size_t size, size_t alignment)
+            {
+                if (frame != currentFrame.load(std::memory_order_relaxed))
+                    rewind();
+                frameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+                if (size > FRAME_LARGE_ALLOCATION)
+                {
+                    Block* block = createBlock(size);
+                    block->next = large;
+                    large = block;
+                    return block->begin();
+                }
+
+                while (true)
+                {
+                    if (current)
+                    {
+                        uchar* p = reinterpret_cast<uchar*>(
+                            (reinterpret_cast<size_t>(top) + alignment - 1) & ~(alignment - 1));
+                        if (p + size <= current->end())
+                        {
+                            top = p + size;
+                            return p;
+                        }
+                    }
+
+                    // continue in the next block, which is kept from earlier frames or new
+                    if (!current || !current->next)
+                    {
+                        Block* block = createBlock(FRAME_BLOCK_SIZE);
+                        if (current)
+                            current->next = block;
+                        else
+                            blocks = block;
+                        current = block;
+                    }
+                    else
+                        current = current->next;
+                    top = current->begin();
+                }
+            }
+
+            void deallocate(void* p, size_t size)
+            {
+                // only the most recent allocation, if the frame is still the same
+                if (p && static_cast<uchar*>(p) + size == top &&
+                    frame == currentFrame.load(std::memory_order_relaxed))
+                    top = static_cast<uchar*>(p);
+            }
+        };
+
+        /// Not a member, as exported classes can't have thread local data.
+        thread_local Arena arena;
+    }
+    //---------------------------------------------------------------------
+    void* FrameMemory::allocate(size_t size, size_t alignment)
+    {
+        assert(0 < alignment && alignment <= OGRE_SIMD_ALIGNMENT && !(alignment & (alignment - 1)));
+        return arena.allocate(size, alignment);
+    }
+    //---------------------------------------------------------------------
+    void FrameMemory::deallocate(void* p, size_t size)
+    {
+        arena.deallocate(p, size);
+    }
+    //---------------------------------------------------------------------
+    void FrameMemory::_endFrame()
+    {
+        lastFrameAllocations.store(frameAllocations.exchange(0, std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        ++currentFrame;
+    }
+    //---------------------------------------------------------------------
+    size_t FrameMemory::getLastFrameAllocationCount()
+    {
+        return lastFrameAllocations.load(std::memory_order_relaxed);
+    }
+    //---------------------------------------------------------------------
+    size_t FrameMemory::getHeapAllocationCount()
+    {
+        return heapAllocations.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,152 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreFrameCounters.h"
+
+namespace Ogre
+{
+    std::atomic<FrameCounters::ThreadCounters*> FrameCounters::msThreads(0);
+    size_t FrameCounters::msFrameStart[FC_COUNT];
+    size_t FrameCounters::msFrameStartQueued[QUEUE_GROUP_COUNT];
+    size_t FrameCounters::msLastFrame[FC_COUNT];
+    size_t FrameCounters::msLastFrameQueued[QUEUE_GROUP_COUNT];
+
+    namespace
+    {
+        /// Hands the block of a thread back when the thread exits
+        template<typename T>
+        struct ThreadRegistration
+        {
+            T* counters;
+            ThreadRegistration() : counters(0) {}
+            ~ThreadRegistration()
+            {
+                if (counters)
+                    counters->inUse.store(false, std::memory_order_release);
+            }
+        };
+    }
+    //---------------------------------------------------------------------
+    FrameCounters::ThreadCounters& FrameCounters::getThreadCounters()
+    {
+        static thread_local ThreadRegistration<ThreadCounters> registration;
+        if (registration.counters)
+            return *registration.counters;
+
+        // reuse the block of a thread, which exited, its counts are part of the sums already
+        for (ThreadCounters* block = msThreads.load(std::memory_order_acquire); block; block = block->next)
+        {
+            bool expected = false;
+            if (block->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                registration.counters = block;
+                return *block;
+            }
+        }
+
+        // blocks are never freed, as _endFrame may be reading them at any time
+        ThreadCounters* block = new ThreadCounters;
+        for (size_t i = 0; i < FC_COUNT; ++i)
+            block->counts[i].store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < QUEUE_GROUP_COUNT; ++i)
+            block->queued[i].store(0, std::memory_order_relaxed);
+        block->inUse.store(true, std::memory_order_relaxed);
+        block->next = msThreads.load(std::memory_order_relaxed);
+        while (!msThreads.compare_exchange_weak(block->next, block, std::memory_order_release))
+            ;
+        registration.counters = block;
+        return *block;
+    }
+    //---------------------------------------------------------------------
+    size_t FrameCounters::getCurrent(Counter counter)
+    {
+        size_t sum = 0;
+        for (ThreadCounters* block = msThreads.load(std::memory_order_acquire); block; block = block->next)
+            sum += block->counts[counter].load(std::memory_order_relaxed);
+        return sum - msFrameStart[counter];
+    }
+
+    //---------------------------------------------------------------------
+    const char* FrameCounters::getName(Counter counter)
+    {
+        static const char* names[FC_COUNT] = {
+            "Nodes updated",
+            "Objects visible",
+            "Objects culled",
+            "Renderables queued",
+            "Passes set",
+            "Pass cache hits",
+            "Auto params written",
+            "Lights evaluated",
+            "Software skinned vertices",
+            "Buffer locks"
+        };
+        return names[counter];
+    }
+    //---------------------------------------------------------------------
+    void FrameCounters::_endFrame()
+    {
+        size_t sums[FC_COUNT] = {};
+        size_t sumsQueued[QUEUE_GROUP_COUNT] = {};
+        for (ThreadCounters* block = msThreads.load(std::memory_order_acquire); block; block = block->next)
+        {
+            for (size_t i = 0; i < FC_COUNT; ++i)
+                sums[i] += block->counts[i].load(std::memory_order_relaxed);
+            for (size_t i = 0; i < QUEUE_GROUP_COUNT; ++i)
+                sumsQueued[i] += block->queued[i].load(std::memory_order_relaxed);
+        }
+
+        // the sums only grow, unsigned wrap around keeps the differences right
+        for (size_t i = 0; i < FC_COUNT; ++i)
+        {
+            msLastFrame[i] = sums[i] - msFrameStart[i];
+            msFrameStart[i] = sums[i];
+        }
+        for (size_t i = 0; i < QUEUE_GROUP_COUNT; ++i)
+        {
+            msLastFrameQueued[i] = sumsQueued[i] - msFrameStartQueued[i];
+            msFrameStartQueued[i] = sumsQueued[i];
+        }
+
+        Profiler* profiler = Profiler::getSingletonPtr();
+        if (!profiler || !profiler->getTraceEnabled())
+            return;
+
+        for (size_t i = 0; i < FC_COUNT; ++i)
+            profiler->addTraceCounter(getName(Counter(i)), msLastFrame[i]);
+
+        char name[32];
+        for (size_t i = 0; i < QUEUE_GROUP_COUNT; ++i)
+        {
+            if (!msLastFrameQueued[i])
+                continue;
+            snprintf(name, sizeof(name), "Queue group %u", unsigned(i));
+            profiler->addTraceCounter(name, msLastFrameQueued[i]);
+        }
+    }
+}
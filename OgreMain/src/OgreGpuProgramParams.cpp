@@ -1871,6 +1871,7 @@ namespace Ogre
         DualQuaternion dQuat;
 
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
+        size_t written = 0;
 
         // Autoconstant index is not a physical index
         for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
@@ -1878,6 +1879,7 @@ namespace Ogre
             // Only update needed slots
             if (i->variability & mask)
             {
+                ++written;
 
                 switch(i->paramType)
                 {
@@ -2511,6 +2513,7 @@ namespace Ogre
             }
         }
 
+        FrameCounters::add(FrameCounters::FC_AUTO_PARAMS_WRITTEN, written);
     }
     //---------------------------------------------------------------------------
     void GpuProgramParameters::setNamedConstant(const String& name, Real val)
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgreInstancedEntity.h"
 #include "OgreRenderQueue.h"
 #include "OgreLodListener.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre
 {
@@ -166,20 +167,91 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void InstanceBatch::updateVisibility(void)
     {
+        //Trick to force Ogre not to render us if none of our instances is visible
+        //Because we do Camera::isVisible(), it is better if the SceneNode from the
+        //InstancedEntity is not part of the scene graph (i.e. ultimate parent is root node)
+        //to avoid unnecessary wasteful calculations
+        //Only whether anything is visible matters here, so cull in small groups and
+        //stop at the first group with a visible instance
+        const size_t groupSize   = 64;
+        const size_t numEntities = mInstancedEntities.size();
+        mVisibleInstances.resize( numEntities );
+
         mVisible = false;
+        for( size_t first=0; first<numEntities && !mVisible; first += groupSize )
+        {
+            const size_t count = std::min( groupSize, numEntities - first );
+            mVisible = cullInstances( mCurrentCamera, first, count ) != 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t InstanceBatch::cullInstances( Camera *camera )
+    {
+        const size_t numEntities = mInstancedEntities.size();
+        mVisibleInstances.resize( numEntities );
 
-        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
-        InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
+        return cullInstances( camera, 0, numEntities );
+    }
+    //-----------------------------------------------------------------------
+    size_t InstanceBatch::cullInstances( Camera *camera, size_t first, size_t numEntities )
+    {
+        if( !camera || !numEntities )
+        {
+            //No culling, only entities in the scene are visible
+            size_t retVal = 0;
+            for( size_t i=first; i<first + numEntities; ++i )
+            {
+                mVisibleInstances[i] = mInstancedEntities[i]->findVisible( 0 );
+                retVal += mVisibleInstances[i];
+            }
+            return retVal;
+        }
 
-        while( itor != end && !mVisible )
+        //Gather the bounding spheres as findVisible would test them
+        mCullSpheres.resize( numEntities * 4 );
+        float *centresX = &mCullSpheres[0];
+        float *centresY = centresX + numEntities;
+        float *centresZ = centresY + numEntities;
+        float *radii    = centresZ + numEntities;
+
+        const Real boundingRadius = mMeshReference->getBoundingSphereRadius();
+        for( size_t i=0; i<numEntities; ++i )
         {
-            //Trick to force Ogre not to render us if none of our instances is visible
-            //Because we do Camera::isVisible(), it is better if the SceneNode from the
-            //InstancedEntity is not part of the scene graph (i.e. ultimate parent is root node)
-            //to avoid unnecessary wasteful calculations
-            mVisible |= (*itor)->findVisible( mCurrentCamera );
-            ++itor;
+            const InstancedEntity *entity = mInstancedEntities[first + i];
+            if( entity->isInScene() && entity->isVisible() )
+            {
+                const Vector3 &position = entity->_getDerivedPosition();
+                centresX[i] = static_cast<float>( position.x );
+                centresY[i] = static_cast<float>( position.y );
+                centresZ[i] = static_cast<float>( position.z );
+                radii[i]    = static_cast<float>( boundingRadius * entity->getMaxScaleCoef() );
+            }
+            else
+            {
+                //A negative radius this large gets culled by any plane
+                centresX[i] = centresY[i] = centresZ[i] = 0;
+                radii[i]    = -std::numeric_limits<float>::max();
+            }
+        }
+
+        //Same planes Camera::isVisible( const Sphere& ) tests against
+        const Frustum *frustum = camera->getCullingFrustum() ? camera->getCullingFrustum() : camera;
+        Plane planes[6];
+        size_t numPlanes = 0;
+        for( unsigned short i=0; i<6; ++i )
+        {
+            //Skip far plane if infinite view frustum
+            if( i == FRUSTUM_PLANE_FAR && frustum->getFarClipDistance() == 0 )
+                continue;
+            planes[numPlanes++] = frustum->getFrustumPlane( i );
         }
+
+        OptimisedUtil::getImplementation()->cullSpheres( planes, numPlanes,
+                                                         centresX, centresY, centresZ, radii,
+                                                         &mVisibleInstances[first], numEntities );
+
+        return static_cast<size_t>( std::count( mVisibleInstances.begin() + first,
+                                                mVisibleInstances.begin() + first + numEntities, 1 ) );
     }
     //-----------------------------------------------------------------------
     void InstanceBatch::createAllInstancedEntities()
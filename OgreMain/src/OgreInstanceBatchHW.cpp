@@ -29,9 +29,13 @@ THE SOFTWARE.
 #include "OgreInstanceBatchHW.h"
 #include "OgreRenderOperation.h"
 #include "OgreInstancedEntity.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
+    /// Instances written per task by updateVertexBuffer, smaller batches are written serially
+    static const size_t InstancesPerChunk = 4096;
+
     InstanceBatchHW::InstanceBatchHW( InstanceManager *creator, MeshPtr &meshReference,
                                         const MaterialPtr &material, size_t instancesPerBatch,
                                         const Mesh::IndexMap *indexToBoneMap, const String &batchName ) :
@@ -177,7 +181,9 @@ namespace Ogre
     //-----------------------------------------------------------------------
     size_t InstanceBatchHW::updateVertexBuffer( Camera *currentCamera )
     {
-        size_t retVal = 0;
+        //Cull on an individual basis, the less entities are visible, the less instances we draw.
+        //No need to use null matrices at all!
+        const size_t retVal = cullInstances( currentCamera );
 
         //Now lock the vertex buffer and copy the 4x3 matrices, only those who need it!
         VertexBufferBinding* binding = mRenderOperation.vertexData->vertexBufferBinding; 
@@ -185,40 +191,61 @@ namespace Ogre
         HardwareBufferLockGuard vertexLock(binding->getBuffer(bufferIdx), HardwareBuffer::HBL_DISCARD);
         float *pDest = static_cast<float*>(vertexLock.pData);
 
-        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
-        InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
-
         unsigned char numCustomParams           = mCreator->getNumCustomParams();
-        size_t customParamIdx                   = 0;
+        const size_t floatsPerInstance          = 12 + numCustomParams * 4;
+        const bool cameraRelative               = mManager->getCameraRelativeRendering();
 
-        while( itor != end )
+        //Split the entities in chunks, and find where each chunk starts writing. Resolve the
+        //transforms of node driven entities here, nodes update their cached transform lazily
+        const size_t numEntities = mInstancedEntities.size();
+        const size_t numChunks = (numEntities + InstancesPerChunk - 1) / InstancesPerChunk;
+        mChunkOffsets.resize( numChunks );
+        size_t visibleSoFar = 0;
+        for( size_t i=0; i<numEntities; ++i )
         {
-            //Cull on an individual basis, the less entities are visible, the less instances we draw.
-            //No need to use null matrices at all!
-            if( (*itor)->findVisible( currentCamera ) )
+            if( i % InstancesPerChunk == 0 )
+                mChunkOffsets[i / InstancesPerChunk] = visibleSoFar;
+
+            if( mVisibleInstances[i] )
             {
-                const size_t floatsWritten = (*itor)->getTransforms3x4( (Matrix3x4f*)pDest );
+                if( !mInstancedEntities[i]->mUseLocalTransform )
+                    mInstancedEntities[i]->_getParentNodeFullTransform();
+                ++visibleSoFar;
+            }
+        }
 
-                if( mManager->getCameraRelativeRendering() )
-                    makeMatrixCameraRelative3x4( (Matrix3x4f*)pDest, floatsWritten / 12 );
+        if( cameraRelative )
+            mCurrentCamera->getDerivedPosition();
 
-                pDest += floatsWritten;
+        parallelFor( numChunks, [&]( size_t chunk )
+        {
+            const size_t start = chunk * InstancesPerChunk;
+            const size_t end   = std::min( start + InstancesPerChunk, numEntities );
+            float *pChunkDest  = pDest + mChunkOffsets[chunk] * floatsPerInstance;
+
+            for( size_t i=start; i<end; ++i )
+            {
+                if( !mVisibleInstances[i] )
+                    continue;
+
+                const size_t floatsWritten = mInstancedEntities[i]->getTransforms3x4( (Matrix3x4f*)pChunkDest );
+
+                if( cameraRelative )
+                    makeMatrixCameraRelative3x4( (Matrix3x4f*)pChunkDest, floatsWritten / 12 );
+
+                pChunkDest += floatsWritten;
 
                 //Write custom parameters, if any
-                for( unsigned char i=0; i<numCustomParams; ++i )
+                const size_t customParamIdx = i * numCustomParams;
+                for( unsigned char j=0; j<numCustomParams; ++j )
                 {
-                    *pDest++ = mCustomParams[customParamIdx+i].x;
-                    *pDest++ = mCustomParams[customParamIdx+i].y;
-                    *pDest++ = mCustomParams[customParamIdx+i].z;
-                    *pDest++ = mCustomParams[customParamIdx+i].w;
+                    *pChunkDest++ = mCustomParams[customParamIdx+j].x;
+                    *pChunkDest++ = mCustomParams[customParamIdx+j].y;
+                    *pChunkDest++ = mCustomParams[customParamIdx+j].z;
+                    *pChunkDest++ = mCustomParams[customParamIdx+j].w;
                 }
-
-                ++retVal;
             }
-            ++itor;
-
-            customParamIdx += numCustomParams;
-        }
+        } );
 
         return retVal;
     }
@@ -291,7 +291,7 @@ namespace Ogre
                     (!useMatrixLookup || 
                     //Update if we are in the visible range of the camera (for look up bone matrix method
                     //and static mode).
-                    (entity->findVisible(currentCamera)))
+                    mVisibleInstances[i])
                 {
                     size_t matrixIndex = useMatrixLookup ? entity->mTransformLookupNumber : i;
                     size_t instanceIdx = matrixIndex * mMatricesPerInstance * mRowLength;
@@ -401,6 +401,10 @@ namespace Ogre
     {
         size_t renderedInstances = 0;
         bool useMatrixLookup = useBoneMatrixLookup();
+
+        //Cull on an individual basis, used by both the instance buffer and the texture update
+        cullInstances( currentCamera );
+
         if (useMatrixLookup)
         {
             //if we are using bone matrix look up we have to update the instance buffer for the 
@@ -422,7 +426,7 @@ namespace Ogre
         
         InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
         
-        std::vector<bool> writtenPositions(getMaxLookupTableInstances(), false);
+        frame_vector<bool> writtenPositions(getMaxLookupTableInstances(), false);
 
         size_t floatPerEntity = mMatricesPerInstance * mRowLength * 4;
         size_t entitiesPerPadding = (size_t)(mMaxFloatsPerLine / floatPerEntity);
@@ -450,7 +454,7 @@ namespace Ogre
             if (((!useMatrixLookup) || !writtenPositions[entity->mTransformLookupNumber]) &&
                 //Cull on an individual basis, the less entities are visible, the less instances we draw.
                 //No need to use null matrices at all!
-                (entity->findVisible( currentCamera )))
+                mVisibleInstances[i])
             {
                 float* pDest = pSource + floatPerEntity * textureLookupPosition + 
                     (size_t)(textureLookupPosition / entitiesPerPadding) * mWidthFloatsPadding;
@@ -28,6 +28,12 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 #include <iostream>
+#if OGRE_THREAD_SUPPORT
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
 #   include <windows.h>
@@ -40,14 +46,195 @@ namespace {
     const char* RED = "\x1b[31;1m";
     const char* YELLOW = "\x1b[33;1m";
     const char* RESET = "\x1b[0m";
+
+    /// Append "hh:mm:ss: " without the locale and state handling of the iostream manipulators
+    void appendTimeStamp(Ogre::String& out, time_t time)
+    {
+        struct tm* pTime = localtime(&time);
+        char buf[] = "00:00:00: ";
+        buf[0] = char('0' + pTime->tm_hour / 10);
+        buf[1] = char('0' + pTime->tm_hour % 10);
+        buf[3] = char('0' + pTime->tm_min / 10);
+        buf[4] = char('0' + pTime->tm_min % 10);
+        buf[6] = char('0' + pTime->tm_sec / 10);
+        buf[7] = char('0' + pTime->tm_sec % 10);
+        out.append(buf, sizeof(buf) - 1);
+    }
 }
 
 namespace Ogre
 {
+#if OGRE_THREAD_SUPPORT
+    /** Bounded multi-producer, single-consumer queue feeding a writer thread.
+    @remarks
+        Every slot carries a sequence number, which tells producers when the slot
+        is free and the writer when it is filled (Vyukov's bounded queue). The
+        message strings stay in their slots, so their memory is reused.
+    */
+    struct Log::AsyncWriter
+    {
+        struct Entry
+        {
+            std::atomic<size_t> sequence;
+            String message;
+            time_t time;
+            LogMessageLevel lml;
+            bool console;
+            bool timeStamp;
+        };
+
+        Log* log;
+        /// The log file, NULL if suppressed, only written by the writer thread
+        std::ofstream* file;
+        std::vector<Entry> ring;
+        size_t mask;
+        /// Next slot to be claimed by a producer
+        std::atomic<size_t> enqueuePos;
+        /// Next slot to be read by the writer, only touched by the writer thread
+        size_t dequeuePos;
+        /// Number of messages written to the file
+        std::atomic<size_t> written;
+
+        std::atomic<bool> quit;
+        std::atomic<bool> sleeping;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        std::thread thread;
+
+        AsyncWriter(Log* l, size_t size)
+            : log(l), file(l->mSuppressFile ? 0 : &l->mLog), ring(size), mask(size - 1),
+              enqueuePos(0), dequeuePos(0), written(0), quit(false), sleeping(false)
+        {
+            for (size_t i = 0; i < size; ++i)
+                ring[i].sequence.store(i, std::memory_order_relaxed);
+            thread = std::thread(&AsyncWriter::run, this);
+        }
+
+        ~AsyncWriter()
+        {
+            quit = true;
+            notify();
+            thread.join();
+        }
+
+        void push(const String& message, LogMessageLevel lml, bool console, bool timeStamp, time_t time)
+        {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Entry* entry;
+            for (;;)
+            {
+                entry = &ring[pos & mask];
+                size_t seq = entry->sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    // full, wait for the writer to catch up
+                    notify();
+                    std::this_thread::yield();
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+                else
+                {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            entry->message = message;
+            entry->time = time;
+            entry->lml = lml;
+            entry->console = console;
+            entry->timeStamp = timeStamp;
+            entry->sequence.store(pos + 1, std::memory_order_release);
+
+            if (sleeping.load())
+                notify();
+        }
+
+        bool hasPending() const
+        {
+            return ring[dequeuePos & mask].sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+        }
+
+        void notify()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wake.notify_one();
+        }
+
+        /// Block until everything claimed so far has been written
+        void flush()
+        {
+            size_t target = enqueuePos.load();
+            if (written.load(std::memory_order_acquire) >= target)
+                return;
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.notify_one();
+            drained.wait(lock, [&] { return written.load(std::memory_order_acquire) >= target; });
+        }
+
+        void run()
+        {
+            String batch;
+            for (;;)
+            {
+                batch.clear();
+                size_t count = 0;
+                while (hasPending())
+                {
+                    Entry& entry = ring[dequeuePos & mask];
+                    if (entry.console)
+                        log->writeConsole(entry.message, entry.lml);
+                    if (file)
+                    {
+                        if (entry.timeStamp)
+                            appendTimeStamp(batch, entry.time);
+                        batch += entry.message;
+                        batch += '\n';
+                    }
+                    entry.sequence.store(dequeuePos + ring.size(), std::memory_order_release);
+                    ++dequeuePos;
+                    ++count;
+                }
+
+                if (count)
+                {
+                    if (!batch.empty())
+                    {
+                        file->write(batch.data(), std::streamsize(batch.size()));
+                        file->flush();
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    written.store(dequeuePos, std::memory_order_release);
+                    drained.notify_all();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex);
+                if (quit)
+                    break;
+                sleeping = true;
+                // the timeout covers a producer, which missed the sleeping flag
+                wake.wait_for(lock, std::chrono::milliseconds(100),
+                              [&] { return quit.load() || hasPending(); });
+                sleeping = false;
+            }
+        }
+    };
+#else
+    struct Log::AsyncWriter {};
+#endif
+    //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     Log::Log( const String& name, bool debuggerOutput, bool suppressFile ) : 
         mLogLevel(LL_NORMAL), mDebugOut(debuggerOutput),
-        mSuppressFile(suppressFile), mTimeStamp(true), mLogName(name), mTermHasColours(false)
+        mSuppressFile(suppressFile), mTimeStamp(true), mLogName(name), mTermHasColours(false),
+        mAsyncWriter(0)
     {
         if (!mSuppressFile)
         {
@@ -77,6 +264,7 @@ namespace Ogre
     //-----------------------------------------------------------------------
     Log::~Log()
     {
+        setAsyncOutputEnabled(false);
         OGRE_LOCK_AUTO_MUTEX;
         if (!mSuppressFile)
         {
@@ -87,63 +275,128 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::logMessage( const String& message, LogMessageLevel lml, bool maskDebug )
     {
+        if ((mLogLevel.load() + lml) < OGRE_LOG_THRESHOLD)
+            return;
+
+        bool skipThisMessage = false;
+        if (std::atomic_load(&mListeners))
+        {
+            // one call at a time, and none to a listener once removeListener returned.
+            // The local reference keeps the list alive if a listener removes itself.
+            OGRE_LOCK_AUTO_MUTEX;
+            std::shared_ptr<const mtLogListener> listeners = std::atomic_load(&mListeners);
+            if (listeners)
+            {
+                for( mtLogListener::const_iterator i = listeners->begin(); i != listeners->end(); ++i )
+                    (*i)->messageLogged( message, lml, maskDebug, mLogName, skipThisMessage);
+            }
+        }
+
+        if (skipThisMessage)
+            return;
+
+        bool timeStamp = mTimeStamp;
+        time_t ctTime = 0;
+        if (timeStamp && !mSuppressFile)
+            time(&ctTime);
+
+#if OGRE_THREAD_SUPPORT
+        if (AsyncWriter* writer = mAsyncWriter.load(std::memory_order_acquire))
+        {
+            writer->push(message, lml, mDebugOut && !maskDebug, timeStamp, ctTime);
+            // make sure the cause of a crash ends up in the file
+            if (lml == LML_CRITICAL)
+                writer->flush();
+            return;
+        }
+#endif
+
         OGRE_LOCK_AUTO_MUTEX;
-        if ((mLogLevel + lml) >= OGRE_LOG_THRESHOLD)
+        writeMessage(message, lml, mDebugOut && !maskDebug, timeStamp, ctTime);
+    }
+    //-----------------------------------------------------------------------
+    void Log::writeMessage(const String& message, LogMessageLevel lml, bool console, bool timeStamp, time_t time)
+    {
+        if (console)
+            writeConsole(message, lml);
+
+        // Write time into log
+        if (!mSuppressFile)
         {
-            bool skipThisMessage = false;
-            for( mtLogListener::iterator i = mListeners.begin(); i != mListeners.end(); ++i )
-                (*i)->messageLogged( message, lml, maskDebug, mLogName, skipThisMessage);
-            
-            if (!skipThisMessage)
+            if (timeStamp)
             {
-                if (mDebugOut && !maskDebug)
-                {
+                String stamp;
+                appendTimeStamp(stamp, time);
+                mLog << stamp;
+            }
+            mLog << message << '\n';
+
+            // Flush stream to ensure it is written (incase of a crash, we need log to be up to date)
+            mLog.flush();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Log::writeConsole(const String& message, LogMessageLevel lml)
+    {
 #    if (OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT) && OGRE_DEBUG_MODE
-                    OutputDebugStringA("Ogre: ");
-                    OutputDebugStringA(message.c_str());
-                    OutputDebugStringA("\n");
+        OutputDebugStringA("Ogre: ");
+        OutputDebugStringA(message.c_str());
+        OutputDebugStringA("\n");
 #    endif
 
-                    std::ostream& os = int(lml) >= int(LML_WARNING) ? std::cerr : std::cout;
-
-                    if(mTermHasColours) {
-                        if(lml == LML_WARNING)
-                            os << YELLOW;
-                        if(lml == LML_CRITICAL)
-                            os << RED;
-                    }
+        std::ostream& os = int(lml) >= int(LML_WARNING) ? std::cerr : std::cout;
 
-                    os << message;
+        if(mTermHasColours) {
+            if(lml == LML_WARNING)
+                os << YELLOW;
+            if(lml == LML_CRITICAL)
+                os << RED;
+        }
 
-                    if(mTermHasColours) {
-                        os << RESET;
-                    }
+        os << message;
 
-                    os << std::endl;
-                }
+        if(mTermHasColours) {
+            os << RESET;
+        }
 
-                // Write time into log
-                if (!mSuppressFile)
-                {
-                    if (mTimeStamp)
-                    {
-                        struct tm *pTime;
-                        time_t ctTime; time(&ctTime);
-                        pTime = localtime( &ctTime );
-                        mLog << std::setw(2) << std::setfill('0') << pTime->tm_hour
-                            << ":" << std::setw(2) << std::setfill('0') << pTime->tm_min
-                            << ":" << std::setw(2) << std::setfill('0') << pTime->tm_sec
-                            << ": ";
-                    }
-                    mLog << message << std::endl;
+        os << std::endl;
+    }
+    //-----------------------------------------------------------------------
+    void Log::setAsyncOutputEnabled(bool async, size_t queueSize)
+    {
+#if OGRE_THREAD_SUPPORT
+        if (async == (mAsyncWriter.load() != 0))
+            return;
 
-                    // Flush stcmdream to ensure it is written (incase of a crash, we need log to be up to date)
-                    mLog.flush();
-                }
-            }
+        if (async)
+        {
+            size_t size = 1;
+            while (size < queueSize)
+                size <<= 1;
+            // from here on only the writer thread touches the file
+            OGRE_LOCK_AUTO_MUTEX;
+            mAsyncWriter.store(OGRE_NEW_T(AsyncWriter, MEMCATEGORY_GENERAL)(this, size));
+        }
+        else
+        {
+            // the writer drains the queue before it exits
+            AsyncWriter* writer = mAsyncWriter.exchange(0);
+            OGRE_DELETE_T(writer, AsyncWriter, MEMCATEGORY_GENERAL);
         }
+#else
+        (void)async;
+        (void)queueSize;
+#endif
     }
-    
+    //-----------------------------------------------------------------------
+    void Log::flush()
+    {
+#if OGRE_THREAD_SUPPORT
+        if (AsyncWriter* writer = mAsyncWriter.load())
+            writer->flush();
+#endif
+    }
+
     //-----------------------------------------------------------------------
     void Log::setTimeStampEnabled(bool timeStamp)
     {
@@ -168,18 +421,38 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::addListener(LogListener* listener)
     {
+        // logMessage calls the listeners under the same lock
         OGRE_LOCK_AUTO_MUTEX;
-        if (std::find(mListeners.begin(), mListeners.end(), listener) == mListeners.end())
-            mListeners.push_back(listener);
+        std::shared_ptr<const mtLogListener> current = std::atomic_load(&mListeners);
+        if (current && std::find(current->begin(), current->end(), listener) != current->end())
+            return;
+
+        std::shared_ptr<mtLogListener> listeners =
+            current ? std::make_shared<mtLogListener>(*current) : std::make_shared<mtLogListener>();
+        listeners->push_back(listener);
+        std::atomic_store(&mListeners, std::shared_ptr<const mtLogListener>(listeners));
     }
 
     //-----------------------------------------------------------------------
     void Log::removeListener(LogListener* listener)
     {
+        // taking the lock waits for listener calls on other threads to finish
         OGRE_LOCK_AUTO_MUTEX;
-        mtLogListener::iterator i = std::find(mListeners.begin(), mListeners.end(), listener);
-        if (i != mListeners.end())
-            mListeners.erase(i);
+        std::shared_ptr<const mtLogListener> current = std::atomic_load(&mListeners);
+        if (!current)
+            return;
+        mtLogListener::const_iterator i = std::find(current->begin(), current->end(), listener);
+        if (i == current->end())
+            return;
+
+        std::shared_ptr<mtLogListener> listeners;
+        // without listeners logMessage doesn't take the lock
+        if (current->size() > 1)
+        {
+            listeners = std::make_shared<mtLogListener>(*current);
+            listeners->erase(listeners->begin() + (i - current->begin()));
+        }
+        std::atomic_store(&mListeners, std::shared_ptr<const mtLogListener>(listeners));
     }
     //---------------------------------------------------------------------
     Log::Stream Log::stream(LogMessageLevel lml, bool maskDebug) 
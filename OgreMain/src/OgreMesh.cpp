@@ -1916,6 +1916,8 @@ namespace Ogre {
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
     {
+        FrameCounters::add(FrameCounters::FC_SOFTWARE_SKINNED_VERTICES, targetVertexData->vertexCount);
+
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
         float *pDestPos = 0;
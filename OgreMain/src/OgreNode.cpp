@@ -162,6 +162,7 @@ namespace Ogre {
         {
             // Update transforms from parent
             _updateFromParent();
+            FrameCounters::add(FrameCounters::FC_NODES_UPDATED);
         }
 
         if(updateChildren)
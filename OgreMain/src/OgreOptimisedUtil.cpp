@@ -315,6 +315,43 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centresX,
+            const float* centresY,
+            const float* centresZ,
+            const float* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->cullSpheres(
+                planes,
+                numPlanes,
+                centresX,
+                centresY,
+                centresZ,
+                radii,
+                visibilities,
+                numSpheres);
+            profile.end();
+
+            LogManager::getSingleton().logMessage(StringUtil::format(
+                "OptimisedUtilProfiler: %s - impl %zu = %u avg ticks\n", __FUNCTION__, index, profile.mAvgTicks));
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
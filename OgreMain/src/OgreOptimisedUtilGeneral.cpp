@@ -91,6 +91,17 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centresX,
+            const float* centresY,
+            const float* centresZ,
+            const float* radii,
+            char* visibilities,
+            size_t numSpheres);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +375,28 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::cullSpheres(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* centresX,
+        const float* centresY,
+        const float* centresZ,
+        const float* radii,
+        char* visibilities,
+        size_t numSpheres)
+    {
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            Vector3 centre(centresX[i], centresY[i], centresZ[i]);
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                visible = !(planes[p].getDistance(centre) < -radii[i]);
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
@@ -129,6 +129,17 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE cullSpheres(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centresX,
+            const float* centresY,
+            const float* centresZ,
+            const float* radii,
+            char* visibilities,
+            size_t numSpheres);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -268,6 +279,30 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::cullSpheres
+        virtual void cullSpheres(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centresX,
+            const float* centresY,
+            const float* centresZ,
+            const float* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->cullSpheres(
+                planes,
+                numPlanes,
+                centresX,
+                centresY,
+                centresZ,
+                radii,
+                visibilities,
+                numSpheres);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -2132,6 +2167,80 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilSSE::cullSpheres(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* centresX,
+        const float* centresY,
+        const float* centresZ,
+        const float* radii,
+        char* visibilities,
+        size_t numSpheres)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        __m128 x, y, z, r;
+        __m128 dist, culled;
+        int bitmask;
+
+        // Perload zero to register for negate radius
+        __m128 zero = _mm_setzero_ps();
+
+        size_t numIterations = numSpheres / 4;
+        numSpheres &= 3;
+
+        // Four spheres per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            // Load spheres, unaligned
+            x = _mm_loadu_ps(centresX);
+            y = _mm_loadu_ps(centresY);
+            z = _mm_loadu_ps(centresZ);
+            r = _mm_sub_ps(zero, _mm_loadu_ps(radii));
+            centresX += 4;
+            centresY += 4;
+            centresZ += 4;
+            radii += 4;
+
+            culled = zero;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                const Plane& plane = planes[p];
+
+                // Distance to plane, same evaluation order as Plane::getDistance
+                dist = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_add_ps(
+                            _mm_mul_ps(_mm_set_ps1(plane.normal.x), x),
+                            _mm_mul_ps(_mm_set_ps1(plane.normal.y), y)),
+                        _mm_mul_ps(_mm_set_ps1(plane.normal.z), z)),
+                    _mm_set_ps1(plane.d));
+
+                // Culled by this plane if 'more negative' than the radius
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, r));
+            }
+
+            bitmask = _mm_movemask_ps(culled);
+            visibilities[0] = (bitmask & 1) == 0;
+            visibilities[1] = (bitmask & 2) == 0;
+            visibilities[2] = (bitmask & 4) == 0;
+            visibilities[3] = (bitmask & 8) == 0;
+            visibilities += 4;
+        }
+
+        // Dealing with remaining spheres
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            Vector3 centre(centresX[i], centresY[i], centresZ[i]);
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                visible = !(planes[p].getDistance(centre) < -radii[i]);
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
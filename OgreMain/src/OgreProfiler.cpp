@@ -47,6 +47,105 @@ static Remotery* rmt;
 #endif
 
 namespace Ogre {
+    namespace
+    {
+        /// Trace events per chunk of a TraceRecorder
+        const size_t TRACE_CHUNK_SIZE = 1024;
+        /// Deeper nested trace events are not recorded
+        const size_t TRACE_MAX_DEPTH = 64;
+
+        /// Distinguishes profiler instances, which may be recreated at the same address
+        std::atomic<uint32> profilerGenerations(0);
+
+        /// Thread local data. Not members, as exported classes can't have thread local data.
+        thread_local uint32 recorderGeneration = 0;
+        thread_local void* recorder = 0;
+        thread_local uint32 mainThreadGeneration = 0;
+        thread_local String threadName;
+
+        uint64 traceClock()
+        {
+            using namespace std::chrono;
+            return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    /** Trace events of a single thread
+    @remarks
+        The owning thread appends finished events to a list of chunks and publishes them
+        with a release store, the thread flushing the profiler reads them under the
+        profiler lock. Chunks are freed by the reader once the writer moved on.
+    */
+    struct Profiler::TraceRecorder : public ProfilerAlloc
+    {
+        struct Chunk
+        {
+            ProfileTraceEvent events[TRACE_CHUNK_SIZE];
+            std::atomic<size_t> written;
+            std::atomic<Chunk*> next;
+
+            Chunk() : written(0), next(0) {}
+        };
+
+        uint32 threadId;
+        String name;
+
+        /// Writer side
+        Chunk* tail;
+        uint32 session;
+        size_t depth;
+        ProfileTraceEvent open[TRACE_MAX_DEPTH];
+
+        /// Reader side
+        Chunk* head;
+        size_t read;
+
+        TraceRecorder(uint32 id) : threadId(id), session(0), depth(0), read(0)
+        {
+            head = tail = OGRE_NEW_T(Chunk, MEMCATEGORY_GENERAL)();
+        }
+        ~TraceRecorder()
+        {
+            while (head)
+            {
+                Chunk* next = head->next.load(std::memory_order_relaxed);
+                OGRE_DELETE_T(head, Chunk, MEMCATEGORY_GENERAL);
+                head = next;
+            }
+        }
+
+        void push(const ProfileTraceEvent& event)
+        {
+            size_t written = tail->written.load(std::memory_order_relaxed);
+            if (written == TRACE_CHUNK_SIZE)
+            {
+                Chunk* chunk = OGRE_NEW_T(Chunk, MEMCATEGORY_GENERAL)();
+                tail->next.store(chunk, std::memory_order_release);
+                tail = chunk;
+                written = 0;
+            }
+            tail->events[written] = event;
+            tail->written.store(written + 1, std::memory_order_release);
+        }
+
+        void collect(ProfileTraceEventList& events)
+        {
+            while (true)
+            {
+                size_t written = head->written.load(std::memory_order_acquire);
+                events.insert(events.end(), head->events + read, head->events + written);
+                read = written;
+
+                Chunk* next = written == TRACE_CHUNK_SIZE ? head->next.load(std::memory_order_acquire) : 0;
+                if (!next)
+                    break;
+                OGRE_DELETE_T(head, Chunk, MEMCATEGORY_GENERAL);
+                head = next;
+                read = 0;
+            }
+        }
+    };
+
     //-----------------------------------------------------------------------
     // PROFILE DEFINITIONS
     //-----------------------------------------------------------------------
@@ -78,8 +177,15 @@ namespace Ogre {
         , mMaxTotalFrameTime(0)
         , mAverageFrameTime(0)
         , mResetExtents(false)
+        , mTraceEnabled(false)
+        , mTraceSession(0)
+        , mGeneration(++profilerGenerations)
+        , mTraceEpoch(traceClock())
     {
         mRoot.hierarchicalLvl = 0 - 1;
+        mainThreadGeneration = mGeneration;
+        if (threadName.empty())
+            setCurrentThreadName("Ogre Main");
 
 #ifdef USE_REMOTERY
         rmt_Settings()->reuse_open_port = true;
@@ -136,6 +242,10 @@ namespace Ogre {
         // clear all our lists
         mDisabledProfiles.clear();
 #endif
+
+        for (size_t i = 0; i < mTraceRecorders.size(); ++i)
+            OGRE_DELETE mTraceRecorders[i];
+        mTraceRecorders.clear();
     }
     //-----------------------------------------------------------------------
     void Profiler::setTimer(Timer* t)
@@ -160,6 +270,10 @@ namespace Ogre {
         }
         else if (mInitialized)
         {
+            // hand out the remaining events, before the listeners close their sessions
+            if (getTraceEnabled())
+                flushTraceEvents();
+
             for( TProfileSessionListener::iterator i = mListeners.begin(); i != mListeners.end(); ++i )
                 (*i)->finializeSession();
 
@@ -204,14 +318,25 @@ namespace Ogre {
 
         rmt_BeginCPUSampleDynamic(profileName.c_str(), RMTSF_Aggregate);
 #else
-        // if the profiler is enabled
-        if (!mEnabled)
-            return;
-
         // mask groups
         if ((groupID & mProfileMask) == 0)
             return;
 
+        if (getTraceEnabled())
+            beginTraceEvent(profileName.c_str());
+
+        // the hierarchy is only built by the thread, which created the profiler
+        if (isMainThread())
+            beginProfileInstance(profileName);
+#endif
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::beginProfileInstance(const String& profileName)
+    {
+        // if the profiler is enabled
+        if (!mEnabled)
+            return;
+
         // empty string is reserved for the root
         // not really fatal anymore, however one shouldn't name one's profile as an empty string anyway.
         assert ((profileName != "") && ("Profile name can't be an empty string"));
@@ -259,7 +384,6 @@ namespace Ogre {
         // we do this at the very end of the function to get the most
         // accurate timing results
         mCurrent->currTime = mTimer->getMicroseconds();
-#endif
     }
     //-----------------------------------------------------------------------
     void Profiler::endProfile(const String& profileName, uint32 groupID) 
@@ -271,6 +395,16 @@ namespace Ogre {
 
         rmt_EndCPUSample();
 #else
+        if ((groupID & mProfileMask) != 0 && getTraceEnabled())
+            endTraceEvent();
+
+        if (isMainThread())
+            endProfileInstance(profileName, groupID);
+#endif
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::endProfileInstance(const String& profileName, uint32 groupID)
+    {
         if(!mEnabled) 
         {
             // if the profiler received a request to be enabled or disabled
@@ -369,9 +503,167 @@ namespace Ogre {
             // we display everything to the screen
             displayResults();
         }
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::addProfileSample(const String& profileName, uint64 microseconds, uint32 groupID)
+    {
+#ifndef USE_REMOTERY
+        // ends the frame otherwise
+        if (!mEnabled || &mRoot == mCurrent || !isMainThread())
+            return;
+
+        // mask groups
+        if ((groupID & mProfileMask) == 0)
+            return;
+
+        // no trace event, the sample was timed elsewhere
+        ProfileInstance* parent = mCurrent;
+        beginProfileInstance(profileName);
+        if (mCurrent == parent)
+            return; // disabled
+
+        // backdate the start, so endProfile accounts the measured time
+        mCurrent->currTime = mTimer->getMicroseconds() - microseconds;
+        endProfileInstance(profileName, groupID);
 #endif
     }
     //-----------------------------------------------------------------------
+    bool Profiler::isMainThread() const
+    {
+        return mainThreadGeneration == mGeneration;
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::setTraceEnabled(bool enabled)
+    {
+        if (enabled && !getTraceEnabled())
+            ++mTraceSession;
+        mTraceEnabled.store(enabled);
+    }
+    //-----------------------------------------------------------------------
+    Profiler::TraceRecorder* Profiler::getTraceRecorder()
+    {
+        if (recorderGeneration == mGeneration)
+            return static_cast<TraceRecorder*>(recorder);
+
+        OGRE_WQ_LOCK_MUTEX(mTraceMutex);
+        TraceRecorder* r = OGRE_NEW TraceRecorder(static_cast<uint32>(mTraceRecorders.size() + 1));
+        if (!threadName.empty())
+            r->name = threadName;
+        else
+            r->name = "Thread " + StringConverter::toString(r->threadId);
+        mTraceRecorders.push_back(r);
+
+        recorderGeneration = mGeneration;
+        recorder = r;
+        return r;
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::beginTraceEvent(const char* name)
+    {
+        if (!getTraceEnabled())
+            return;
+
+        uint64 start = traceClock();
+        TraceRecorder* r = getTraceRecorder();
+
+        uint32 session = mTraceSession.load(std::memory_order_relaxed);
+        if (r->session != session)
+        {
+            // drop the events, which began before tracing was enabled again
+            r->session = session;
+            r->depth = 0;
+        }
+
+        if (r->depth < TRACE_MAX_DEPTH)
+        {
+            ProfileTraceEvent& event = r->open[r->depth];
+            strncpy(event.name, name, sizeof(event.name) - 1);
+            event.name[sizeof(event.name) - 1] = 0;
+            event.start = start - mTraceEpoch;
+            event.threadId = r->threadId;
+            event.depth = static_cast<uint32>(r->depth);
+            event.value = 0;
+            event.isCounter = false;
+        }
+        ++r->depth;
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::addTraceCounter(const char* name, uint64 value)
+    {
+        if (!getTraceEnabled())
+            return;
+
+        TraceRecorder* r = getTraceRecorder();
+
+        ProfileTraceEvent event;
+        strncpy(event.name, name, sizeof(event.name) - 1);
+        event.name[sizeof(event.name) - 1] = 0;
+        event.start = traceClock() - mTraceEpoch;
+        event.duration = 0;
+        event.value = value;
+        event.isCounter = true;
+        event.threadId = r->threadId;
+        event.depth = static_cast<uint32>(r->depth);
+        r->push(event);
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::endTraceEvent()
+    {
+        uint64 end = traceClock();
+        TraceRecorder* r = getTraceRecorder();
+
+        if (r->session != mTraceSession.load(std::memory_order_relaxed) || r->depth == 0)
+            return; // began before tracing was enabled
+
+        --r->depth;
+        if (r->depth < TRACE_MAX_DEPTH)
+        {
+            ProfileTraceEvent& event = r->open[r->depth];
+            event.duration = end - mTraceEpoch - event.start;
+            r->push(event);
+        }
+
+        if (r->depth == 0 && isMainThread())
+            flushTraceEvents();
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::flushTraceEvents()
+    {
+        ProfileTraceEventList events;
+        {
+            OGRE_WQ_LOCK_MUTEX(mTraceMutex);
+            for (size_t i = 0; i < mTraceRecorders.size(); ++i)
+                mTraceRecorders[i]->collect(events);
+        }
+
+        if (events.empty())
+            return;
+
+        for (TProfileSessionListener::iterator i = mListeners.begin(); i != mListeners.end(); ++i)
+            (*i)->traceEventsRecorded(events);
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::setCurrentThreadName(const String& name)
+    {
+        threadName = name;
+
+        // rename an already registered recorder
+        Profiler* profiler = getSingletonPtr();
+        if (profiler && recorderGeneration == profiler->mGeneration)
+        {
+            OGRE_WQ_LOCK_MUTEX(profiler->mTraceMutex);
+            static_cast<TraceRecorder*>(recorder)->name = name;
+        }
+    }
+    //-----------------------------------------------------------------------
+    String Profiler::getTraceThreadName(uint32 threadId) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mTraceMutex);
+        if (threadId == 0 || threadId > mTraceRecorders.size())
+            return BLANKSTRING;
+        return mTraceRecorders[threadId - 1]->name;
+    }
+    //-----------------------------------------------------------------------
     void Profiler::beginGPUEvent(const String& event)
     {
         Root::getSingleton().getRenderSystem()->beginProfileEvent(event);
@@ -622,4 +914,103 @@ namespace Ogre {
             mListeners.erase(i);
     }
     //-----------------------------------------------------------------------
+    // CHROME TRACE DEFINITIONS
+    //-----------------------------------------------------------------------
+    namespace
+    {
+        void writeJsonString(std::ostream& out, const char* str)
+        {
+            out << '"';
+            for (; *str; ++str)
+            {
+                char c = *str;
+                if (c == '"' || c == '\\')
+                    out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    out << ' ';
+                else
+                    out << c;
+            }
+            out << '"';
+        }
+    }
+    //-----------------------------------------------------------------------
+    ChromeTraceSessionListener::ChromeTraceSessionListener(const String& fileName)
+        : mFileName(fileName), mFirstEvent(true)
+    {
+    }
+    //-----------------------------------------------------------------------
+    ChromeTraceSessionListener::~ChromeTraceSessionListener()
+    {
+        if (mStream.is_open())
+            finializeSession();
+    }
+    //-----------------------------------------------------------------------
+    void ChromeTraceSessionListener::initializeSession()
+    {
+        mStream.open(mFileName.c_str());
+        if (!mStream)
+        {
+            LogManager::getSingleton().logError("ChromeTraceSessionListener - could not open '" + mFileName + "'");
+            return;
+        }
+
+        mStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        mStream << std::fixed << std::setprecision(3);
+        mThreads.clear();
+        mFirstEvent = true;
+    }
+    //-----------------------------------------------------------------------
+    void ChromeTraceSessionListener::beginEvent()
+    {
+        if (!mFirstEvent)
+            mStream << ',';
+        mStream << '\n';
+        mFirstEvent = false;
+    }
+    //-----------------------------------------------------------------------
+    void ChromeTraceSessionListener::traceEventsRecorded(const ProfileTraceEventList& events)
+    {
+        if (!mStream.is_open())
+            return;
+
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const ProfileTraceEvent& e = events[i];
+            mThreads.insert(e.threadId);
+
+            // complete and counter events, timestamps in microseconds
+            beginEvent();
+            mStream << "{\"name\":";
+            writeJsonString(mStream, e.name);
+            if (e.isCounter)
+                mStream << ",\"ph\":\"C\",\"pid\":1,\"tid\":" << e.threadId
+                        << ",\"ts\":" << e.start / 1000.0 << ",\"args\":{\"value\":" << e.value << "}}";
+            else
+                mStream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+                        << ",\"ts\":" << e.start / 1000.0 << ",\"dur\":" << e.duration / 1000.0 << '}';
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ChromeTraceSessionListener::finializeSession()
+    {
+        if (!mStream.is_open())
+            return;
+
+        if (Profiler* profiler = Profiler::getSingletonPtr())
+        {
+            for (std::set<uint32>::iterator i = mThreads.begin(); i != mThreads.end(); ++i)
+            {
+                beginEvent();
+                mStream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << *i
+                        << ",\"args\":{\"name\":";
+                writeJsonString(mStream, profiler->getTraceThreadName(*i).c_str());
+                mStream << "}}";
+            }
+        }
+
+        mStream << "\n]}\n";
+        mStream.close();
+    }
+    //-----------------------------------------------------------------------
 }
@@ -97,6 +97,7 @@ namespace Ogre {
         }
         
         pGroup->addRenderable(pRend, pTech, priority);
+        FrameCounters::addQueuedRenderable(groupID);
 
     }
     //-----------------------------------------------------------------------
@@ -245,6 +246,8 @@ namespace Ogre {
         mo->_notifyCurrentCamera(cam);
         if (mo->isVisible())
         {
+            FrameCounters::add(FrameCounters::FC_OBJECTS_VISIBLE);
+
             bool receiveShadows = getQueueGroup(mo->getRenderQueueGroup())->getShadowsEnabled()
                 && mo->getReceivesShadows();
 
@@ -266,6 +269,10 @@ namespace Ogre {
                     mo->getWorldBoundingSphere(true), cam);
             }
         }
+        else
+        {
+            FrameCounters::add(FrameCounters::FC_OBJECTS_CULLED);
+        }
 
     }
 
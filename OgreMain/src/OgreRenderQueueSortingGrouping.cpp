@@ -355,7 +355,10 @@ namespace Ogre {
             // Note that this pass and list are never destroyed until the
             // engine shuts down, or a pass is destroyed or has it's hash
             // recalculated, although the lists will be cleared
-            PassGroupRenderableMap::iterator i = mGrouped.emplace(pass, RenderableList()).first;
+            // Look up first, emplace would allocate a map node for every renderable
+            PassGroupRenderableMap::iterator i = mGrouped.lower_bound(pass);
+            if (i == mGrouped.end() || mGrouped.key_comp()(pass, i->first))
+                i = mGrouped.emplace_hint(i, pass, RenderableList());
 
             // Insert renderable
             i->second.push_back(rend);
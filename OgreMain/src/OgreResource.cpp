@@ -76,6 +76,8 @@ namespace Ogre
             return;
         }
 
+        OgreProfileTrace(mName);
+
         // Scope lock for actual loading
         try
         {
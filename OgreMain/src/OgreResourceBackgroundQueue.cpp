@@ -274,6 +274,11 @@ namespace Ogre {
         queue->abortRequest( ticket );
     }
     //------------------------------------------------------------------------
+    bool ResourceBackgroundQueue::setPriority(BackgroundProcessTicket ticket, uint8 priority)
+    {
+        return Root::getSingleton().getWorkQueue()->setRequestPriority(ticket, priority);
+    }
+    //------------------------------------------------------------------------
     BackgroundProcessTicket ResourceBackgroundQueue::addRequest(ResourceRequest& req)
     {
         WorkQueue* queue = Root::getSingleton().getWorkQueue();
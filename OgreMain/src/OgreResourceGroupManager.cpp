@@ -28,6 +28,9 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
 
+#include <atomic>
+#include <thread>
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -57,6 +60,8 @@ namespace Ogre {
     ResourceGroupManager::ResourceGroupManager()
         : mLoadingListener(0), mCurrentGroup(0)
     {
+        mResourceGroupSnapshot = std::make_shared<ResourceGroupMap>();
+
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
         // Create the 'Internal' group
@@ -96,6 +101,7 @@ namespace Ogre {
 
         OGRE_LOCK_AUTO_MUTEX;
         mResourceGroupMap.emplace(name, grp);
+        updateResourceGroupSnapshot();
     }
     //-----------------------------------------------------------------------
     void ResourceGroupManager::initialiseResourceGroup(const String& name)
@@ -469,8 +475,16 @@ namespace Ogre {
         mCurrentGroup = grp;
         unloadResourceGroup(name, false); // will throw an exception if name not valid
         dropGroupContents(grp);
-        deleteGroup(grp);
+        // unpublish the group before deleting it, lockless readers of the old snapshot
+        // may still use it until they release the snapshot
+        std::shared_ptr<const ResourceGroupMap> oldGroups = std::atomic_load(&mResourceGroupSnapshot);
         mResourceGroupMap.erase(mResourceGroupMap.find(name));
+        updateResourceGroupSnapshot();
+        while (oldGroups.use_count() > 1)
+            std::this_thread::yield();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        oldGroups.reset();
+        deleteGroup(grp);
         // reset current group
         mCurrentGroup = 0;
     }
@@ -1197,10 +1211,17 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroup* ResourceGroupManager::getResourceGroup(const String& name) const
+    {
+        std::shared_ptr<const ResourceGroupMap> groups = std::atomic_load(&mResourceGroupSnapshot);
+        ResourceGroupMap::const_iterator i = groups->find(name);
+        return i != groups->end() ? i->second : NULL;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::updateResourceGroupSnapshot()
     {
         OGRE_LOCK_AUTO_MUTEX;
-        ResourceGroupMap::const_iterator i = mResourceGroupMap.find(name);
-        return i != mResourceGroupMap.end() ? i->second : NULL;
+        std::atomic_store(&mResourceGroupSnapshot,
+            std::shared_ptr<const ResourceGroupMap>(std::make_shared<ResourceGroupMap>(mResourceGroupMap)));
     }
     //-----------------------------------------------------------------------
     ResourceManager* ResourceGroupManager::_getResourceManager(const String& resourceType) const
@@ -1762,14 +1783,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     bool ResourceGroupManager::isResourceGroupInGlobalPool(const String& name) const
     {
-        ResourceGroup* grp = getResourceGroup(name);
-        if (!grp)
+        // keep the snapshot while reading the group, so destroyResourceGroup waits for us
+        std::shared_ptr<const ResourceGroupMap> groups = std::atomic_load(&mResourceGroupSnapshot);
+        ResourceGroupMap::const_iterator i = groups->find(name);
+        if (i == groups->end())
         {
             OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
                 "Cannot find a group named " + name, 
                 "ResourceGroupManager::isResourceGroupInitialised");
         }
-        return grp->inGlobalPool;
+        return i->second->inGlobalPool;
     }
     //-----------------------------------------------------------------------
     StringVector ResourceGroupManager::getResourceGroups(void) const
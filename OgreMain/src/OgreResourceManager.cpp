@@ -69,10 +69,15 @@ namespace Ogre {
         bool isManual, ManualResourceLoader* loader, 
         const NameValuePairList* params)
     {
+        // Most calls find an existing resource, which needs no manager lock
+        ResourcePtr res = getResourceByName(name, group);
+        if (res)
+            return ResourceCreateOrRetrieveResult(res, false);
+
         // Lock for the whole get / insert
             OGRE_LOCK_AUTO_MUTEX;
 
-        ResourcePtr res = getResourceByName(name, group);
+        res = getResourceByName(name, group);
         bool created = false;
         if (!res)
         {
@@ -109,7 +114,8 @@ namespace Ogre {
             OGRE_LOCK_AUTO_MUTEX;
 
             std::pair<ResourceMap::iterator, bool> result;
-        if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+        bool isGlobal = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup());
+        if(isGlobal)
         {
             result = mResources.emplace(res->getName(), res);
         }
@@ -132,7 +138,7 @@ namespace Ogre {
             }
 
             // Try to do the addition again, no seconds attempts to resolve collisions are allowed
-            if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+            if(isGlobal)
             {
                 result = mResources.emplace(res->getName(), res);
             }
@@ -148,6 +154,7 @@ namespace Ogre {
             OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM, getResourceType()+" with the name " + res->getName() +
                 " already exists.", "ResourceManager::add");
         }
+        indexName(isGlobal ? BLANKSTRING : res->getGroup(), result.first->second);
 
         // Insert the handle
         std::pair<ResourceHandleMap::iterator, bool> resultHandle = mResourcesByHandle.emplace(res->getHandle(), res);
@@ -157,6 +164,10 @@ namespace Ogre {
                 StringConverter::toString((long) (res->getHandle())) +
                 " already exists.", "ResourceManager::add");
         }
+
+        LookupStripe& stripe = getLookupStripe(res->getHandle());
+        OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+        stripe.byHandle[res->getHandle()] = &resultHandle.first->second;
     }
     //-----------------------------------------------------------------------
     void ResourceManager::removeImpl(const ResourcePtr& res )
@@ -170,6 +181,7 @@ namespace Ogre {
             ResourceMap::iterator nameIt = mResources.find(res->getName());
             if (nameIt != mResources.end())
             {
+                unindexName(BLANKSTRING, nameIt->second);
                 mResources.erase(nameIt);
             }
         }
@@ -181,6 +193,7 @@ namespace Ogre {
                 ResourceMap::iterator nameIt = groupIt->second.find(res->getName());
                 if (nameIt != groupIt->second.end())
                 {
+                    unindexName(groupIt->first, nameIt->second);
                     groupIt->second.erase(nameIt);
                 }
 
@@ -194,6 +207,11 @@ namespace Ogre {
         ResourceHandleMap::iterator handleIt = mResourcesByHandle.find(res->getHandle());
         if (handleIt != mResourcesByHandle.end())
         {
+            LookupStripe& stripe = getLookupStripe(handleIt->first);
+            {
+                OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+                stripe.byHandle.erase(handleIt->first);
+            }
             mResourcesByHandle.erase(handleIt);
         }
         // Tell resource group manager
@@ -325,6 +343,12 @@ namespace Ogre {
     {
             OGRE_LOCK_AUTO_MUTEX;
 
+        for (size_t i = 0; i < LOOKUP_STRIPE_COUNT; ++i)
+        {
+            OGRE_WQ_LOCK_MUTEX(mLookupStripes[i].mutex);
+            mLookupStripes[i].byName.clear();
+            mLookupStripes[i].byHandle.clear();
+        }
         mResources.clear();
         mResourcesWithGroup.clear();
         mResourcesByHandle.clear();
@@ -359,55 +383,46 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getResourceByName(const String& name, const String& groupName /* = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME */)
     {
-        OGRE_LOCK_AUTO_MUTEX;
-
         // resource should be in global pool
         bool isGlobal = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(groupName);
 
-        if(isGlobal)
+        LookupStripe& stripe = getLookupStripe(name);
+        OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+
+        auto it = stripe.byName.find(name);
+        if (it == stripe.byName.end())
+            return ResourcePtr();
+
+        const LookupStripe::NameEntry& entry = it->second;
+        if (isGlobal && entry.global)
         {
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
-            {
-                return it->second;
-            }
+            return *entry.global;
         }
 
-        // look in all grouped pools
+        // look in all grouped pools, the first group by name wins
         if (groupName == ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)
         {
-            ResourceWithGroupMap::iterator iter = mResourcesWithGroup.begin();
-            ResourceWithGroupMap::iterator iterE = mResourcesWithGroup.end();
-            for ( ; iter != iterE ; ++iter )
+            if (!entry.grouped.empty())
             {
-                ResourceMap::iterator resMapIt = iter->second.find(name);
-
-                if( resMapIt != iter->second.end())
-                {
-                    return resMapIt->second;
-                }
+                return *entry.grouped.front().second;
             }
         }
         else if (!isGlobal)
         {
             // look in the grouped pool
-            ResourceWithGroupMap::iterator itGroup = mResourcesWithGroup.find(groupName);
-            if( itGroup != mResourcesWithGroup.end())
+            for (size_t i = 0; i < entry.grouped.size(); ++i)
             {
-                ResourceMap::iterator it = itGroup->second.find(name);
-
-                if( it != itGroup->second.end())
+                if (entry.grouped[i].first == groupName)
                 {
-                    return it->second;
+                    return *entry.grouped[i].second;
                 }
             }
 
 #if !OGRE_RESOURCEMANAGER_STRICT
             // fall back to global
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
+            if (entry.global)
             {
-                return it->second;
+                return *entry.global;
             }
 #endif
         }
@@ -417,9 +432,63 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getByHandle(ResourceHandle handle)
     {
-        OGRE_LOCK_AUTO_MUTEX;
-        ResourceHandleMap::iterator it = mResourcesByHandle.find(handle);
-        return it == mResourcesByHandle.end() ? ResourcePtr() : it->second;
+        LookupStripe& stripe = getLookupStripe(handle);
+        OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+        auto it = stripe.byHandle.find(handle);
+        return it == stripe.byHandle.end() ? ResourcePtr() : *it->second;
+    }
+    //-----------------------------------------------------------------------
+    ResourceManager::LookupStripe& ResourceManager::getLookupStripe(const String& name)
+    {
+        return mLookupStripes[std::hash<String>()(name) % LOOKUP_STRIPE_COUNT];
+    }
+    //-----------------------------------------------------------------------
+    ResourceManager::LookupStripe& ResourceManager::getLookupStripe(ResourceHandle handle)
+    {
+        return mLookupStripes[handle % LOOKUP_STRIPE_COUNT];
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::indexName(const String& group, const ResourcePtr& entry)
+    {
+        LookupStripe& stripe = getLookupStripe(entry->getName());
+        OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+
+        LookupStripe::NameEntry& nameEntry = stripe.byName[entry->getName()];
+        if (group.empty())
+            nameEntry.global = &entry;
+        else
+        {
+            // keep the groups sorted, so autodetect finds the same group as iterating
+            // mResourcesWithGroup does
+            auto pos = std::upper_bound(nameEntry.grouped.begin(), nameEntry.grouped.end(), group,
+                [](const String& g, const std::pair<String, const ResourcePtr*>& e) { return g < e.first; });
+            nameEntry.grouped.insert(pos, std::make_pair(group, &entry));
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::unindexName(const String& group, const ResourcePtr& entry)
+    {
+        LookupStripe& stripe = getLookupStripe(entry->getName());
+        OGRE_WQ_LOCK_MUTEX(stripe.mutex);
+
+        auto it = stripe.byName.find(entry->getName());
+        if (it == stripe.byName.end())
+            return;
+
+        LookupStripe::NameEntry& nameEntry = it->second;
+        if (nameEntry.global == &entry)
+            nameEntry.global = 0;
+        for (size_t i = 0; i < nameEntry.grouped.size(); ++i)
+        {
+            if (nameEntry.grouped[i].second == &entry)
+            {
+                nameEntry.grouped.erase(nameEntry.grouped.begin() + i);
+                break;
+            }
+        }
+
+        if (!nameEntry.global && nameEntry.grouped.empty())
+            stripe.byName.erase(it);
     }
     //-----------------------------------------------------------------------
     ResourceHandle ResourceManager::getNextHandle(void)
@@ -51,6 +51,7 @@ THE SOFTWARE.
 #include "OgreLodStrategyManager.h"
 #include "OgreFileSystemLayer.h"
 #include "OgreSceneLoaderManager.h"
+#include "OgreTaskScheduler.h"
 
 #if OGRE_NO_DDS_CODEC == 0
 #include "OgreDDSCodec.h"
@@ -155,6 +156,10 @@ namespace Ogre {
         defaultQ->setWorkersCanAccessRenderSystem(OGRE_THREAD_SUPPORT == 1);
         mWorkQueue.reset(defaultQ);
 
+        // TaskScheduler, the calling thread joins the workers while waiting
+        mTaskScheduler.reset(new TaskScheduler("Root"));
+        startTaskScheduler();
+
         // ResourceBackgroundQueue
         mResourceBackgroundQueue.reset(new ResourceBackgroundQueue());
 
@@ -771,6 +776,11 @@ namespace Ogre {
         // Tell the queue to process responses
         mWorkQueue->processResponses();
 
+        // Publish the counters while the frame is still traced
+        FrameCounters::_endFrame();
+        // Release the transient memory of the frame
+        FrameMemory::_endFrame();
+
         OgreProfileEndGroup("Frame", OGREPROF_GENERAL);
 
         return ret;
@@ -1292,6 +1302,7 @@ namespace Ogre {
         {
             // Background loader
             mResourceBackgroundQueue->initialise();
+            startTaskScheduler();
             mWorkQueue->startup();
             // Initialise material manager
             mMaterialManager->initialise();
@@ -1506,13 +1517,29 @@ namespace Ogre {
 
     }
     //---------------------------------------------------------------------
+    void Root::startTaskScheduler(void)
+    {
+        // the WorkQueue threads run on the same cores, leave them their share
+        int workers = std::max(int(OGRE_THREAD_HARDWARE_CONCURRENCY), 1) - 1;
+        if (DefaultWorkQueueBase* queue = dynamic_cast<DefaultWorkQueueBase*>(mWorkQueue.get()))
+            workers -= int(queue->getWorkerThreadCount());
+        // they sleep most of the time, so keep at least one worker on a multi-core machine
+        workers = std::max(workers, std::min(int(OGRE_THREAD_HARDWARE_CONCURRENCY) - 1, 1));
+
+        if (mTaskScheduler->getWorkerCount() != size_t(workers))
+            mTaskScheduler->startup(workers);
+    }
+    //---------------------------------------------------------------------
     void Root::setWorkQueue(WorkQueue* queue)
     {
         if (mWorkQueue.get() != queue)
         {
             mWorkQueue.reset(queue);
             if (mIsInitialised)
+            {
+                startTaskScheduler();
                 mWorkQueue->startup();
+            }
 
         }
     }
@@ -46,6 +46,7 @@ THE SOFTWARE.
 #include "OgreRenderTexture.h"
 #include "OgreLodListener.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
+#include "OgreTaskGraph.h"
 
 // This class implements the most basic scene manager
 
@@ -67,6 +68,7 @@ mFogDensity(0),
 mSpecialCaseQueueMode(SCRQM_EXCLUDE),
 mWorldGeometryRenderQueue(RENDER_QUEUE_WORLD_GEOMETRY_1),
 mLastFrameNumber(0),
+mConcurrentFrameUpdates(false),
 mResetIdentityView(false),
 mResetIdentityProj(false),
 mNormaliseNormalsOnScale(true),
@@ -103,6 +105,23 @@ mGpuParamsDirty((uint16)GPV_ALL)
     // create the auto param data source instance
     mAutoParamDataSource.reset(createAutoParamDataSource());
 
+    mFrameUpdateGraph.reset(new TaskGraph());
+    TaskGraph::PhaseId controllers = mFrameUpdateGraph->addPhase("updateAllControllers", []() {
+        ControllerManager::getSingleton().updateAllControllers();
+    });
+    TaskGraph::PhaseId animations = mFrameUpdateGraph->addPhase("_applySceneAnimations", [this]() {
+        // only once per frame
+        unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
+        if (thisFrameNumber != mLastFrameNumber)
+        {
+            _applySceneAnimations();
+            updateDirtyInstanceManagers();
+            mLastFrameNumber = thisFrameNumber;
+        }
+    });
+    // both request updates of the parents of the nodes they move, e.g. particle systems
+    // through _updateBounds, which is not thread safe
+    mFrameUpdateGraph->addDependency(animations, controllers);
 }
 //-----------------------------------------------------------------------
 SceneManager::~SceneManager()
@@ -350,6 +369,7 @@ void SceneManager::_populateLightList(const Vector3& position, Real radius,
     // Pre-allocate memory
     destList.clear();
     destList.reserve(candidateLights.size());
+    FrameCounters::add(FrameCounters::FC_LIGHTS_EVALUATED, candidateLights.size());
 
     LightList::const_iterator it;
     for (it = candidateLights.begin(); it != candidateLights.end(); ++it)
@@ -880,6 +900,10 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
         pass = mShadowRenderer.deriveShadowReceiverPass(pass);
     }
 
+    FrameCounters::add(FrameCounters::FC_PASSES_SET);
+    if (mAutoParamDataSource->getCurrentPass() == pass)
+        FrameCounters::add(FrameCounters::FC_PASS_CACHE_HITS);
+
     // Tell params about current pass
     mAutoParamDataSource->setCurrentPass(pass);
 
@@ -1274,18 +1298,11 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
     mCameraInProgress = camera;
 
 
-    // Update controllers 
-    ControllerManager::getSingleton().updateAllControllers();
-
-    // Update the scene, only do this once per frame
-    unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
-    if (thisFrameNumber != mLastFrameNumber)
-    {
-        // Update animations
-        _applySceneAnimations();
-        updateDirtyInstanceManagers();
-        mLastFrameNumber = thisFrameNumber;
-    }
+    // Update controllers and animations
+    if (mConcurrentFrameUpdates)
+        mFrameUpdateGraph->execute();
+    else
+        mFrameUpdateGraph->executeSerial();
 
     {
         // Lock scene graph mutex, no more changes until we're ready to render
@@ -2708,8 +2725,8 @@ void SceneManager::fireRenderSingleObject(Renderable* rend, const Pass* pass,
 //---------------------------------------------------------------------
 void SceneManager::fireShadowTexturesUpdated(size_t numberOfShadowTextures)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2720,8 +2737,8 @@ void SceneManager::fireShadowTexturesUpdated(size_t numberOfShadowTextures)
 //---------------------------------------------------------------------
 void SceneManager::fireShadowTexturesPreCaster(Light* light, Camera* camera, size_t iteration)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2732,8 +2749,8 @@ void SceneManager::fireShadowTexturesPreCaster(Light* light, Camera* camera, siz
 //---------------------------------------------------------------------
 void SceneManager::fireShadowTexturesPreReceiver(Light* light, Frustum* f)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2744,8 +2761,8 @@ void SceneManager::fireShadowTexturesPreReceiver(Light* light, Frustum* f)
 //---------------------------------------------------------------------
 void SceneManager::firePreUpdateSceneGraph(Camera* camera)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2756,8 +2773,8 @@ void SceneManager::firePreUpdateSceneGraph(Camera* camera)
 //---------------------------------------------------------------------
 void SceneManager::firePostUpdateSceneGraph(Camera* camera)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2769,8 +2786,8 @@ void SceneManager::firePostUpdateSceneGraph(Camera* camera)
 //---------------------------------------------------------------------
 void SceneManager::firePreFindVisibleObjects(Viewport* v)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -2782,8 +2799,8 @@ void SceneManager::firePreFindVisibleObjects(Viewport* v)
 //---------------------------------------------------------------------
 void SceneManager::firePostFindVisibleObjects(Viewport* v)
 {
-    ListenerList listenersCopy = mListeners;
-    ListenerList::iterator i, iend;
+    frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+    frame_vector<Listener*>::iterator i, iend;
 
     iend = listenersCopy.end();
     for (i = listenersCopy.begin(); i != iend; ++i)
@@ -3028,8 +3045,8 @@ void SceneManager::findLightsAffectingFrustum(const Camera* camera)
             // Allow a Listener to override light sorting
             // Reverse iterate so last takes precedence
             bool overridden = false;
-            ListenerList listenersCopy = mListeners;
-            for (ListenerList::reverse_iterator ri = listenersCopy.rbegin();
+            frame_vector<Listener*> listenersCopy(mListeners.begin(), mListeners.end());
+            for (frame_vector<Listener*>::reverse_iterator ri = listenersCopy.rbegin();
                 ri != listenersCopy.rend(); ++ri)
             {
                 overridden = (*ri)->sortLightsAffectingFrustum(mLightsAffectingFrustum);
@@ -261,7 +261,10 @@ namespace Ogre {
     {
         // Check self visible
         if (!cam->isVisible(mWorldAABB))
+        {
+            FrameCounters::add(FrameCounters::FC_OBJECTS_CULLED, mObjectsByName.size());
             return;
+        }
 
         // Add all entities
         ObjectMap::iterator iobj;
@@ -64,19 +64,14 @@ namespace Ogre
             return Matrix4::IDENTITY;
         }
 
-        // allocate memory
-        double **mat = NULL;
-        double **backmat = NULL;
+        // allocate memory, it only lives for this call
+        frame_vector<double> matMemory(incrPrecision ? 2 * 11 * 11 : 11 * 11);
+        double *mat[11];
+        double *backmat[11];
+        for(i=0; i<11; i++) 
         {
-            mat = OGRE_ALLOC_T(double*, 11, MEMCATEGORY_SCENE_CONTROL);
-            if(incrPrecision)
-                backmat = OGRE_ALLOC_T(double*, 11, MEMCATEGORY_SCENE_CONTROL);
-            for(i=0; i<11; i++) 
-            {
-                mat[i] = OGRE_ALLOC_T(double, 11, MEMCATEGORY_SCENE_CONTROL);
-                if(incrPrecision)
-                    backmat[i] = OGRE_ALLOC_T(double, 11, MEMCATEGORY_SCENE_CONTROL);
-            }
+            mat[i] = &matMemory[i * 11];
+            backmat[i] = incrPrecision ? &matMemory[(11 + i) * 11] : NULL;
         }
 
         // set up linear system to solve for all rows of projective matrix
@@ -264,18 +259,6 @@ namespace Ogre
         if(testCoord.w < 0.0) 
             ret = ret *  (-1.0);
 
-        // free memory
-        for (i=0; i<11; i++)
-        {
-            if (mat[i])
-                OGRE_FREE(mat[i], MEMCATEGORY_SCENE_CONTROL);
-            if (incrPrecision)
-                OGRE_FREE(backmat[i], MEMCATEGORY_SCENE_CONTROL);
-        }
-        OGRE_FREE(mat, MEMCATEGORY_SCENE_CONTROL);
-        if(incrPrecision)
-            OGRE_FREE(backmat, MEMCATEGORY_SCENE_CONTROL);
-
         return ret;
 
     }
@@ -134,7 +134,7 @@ void SceneManager::ShadowRenderer::renderAdditiveStencilShadowedQueueGroupObject
     QueuedRenderableCollection::OrganisationMode om)
 {
     RenderQueueGroup::PriorityMapIterator groupIt = pGroup->getIterator();
-    LightList lightList;
+    LightList& lightList = mAdditiveLightList;
 
     while (groupIt.hasMoreElements())
     {
@@ -498,7 +498,7 @@ void SceneManager::ShadowRenderer::renderAdditiveTextureShadowedQueueGroupObject
     QueuedRenderableCollection::OrganisationMode om)
 {
     RenderQueueGroup::PriorityMapIterator groupIt = pGroup->getIterator();
-    LightList lightList;
+    LightList& lightList = mAdditiveLightList;
 
     while (groupIt.hasMoreElements())
     {
@@ -907,7 +907,8 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
     }
 
     // Add light to internal list for use in render call
-    LightList lightList;
+    LightList& lightList = mShadowVolumeLightList;
+    lightList.clear();
     // const_cast is forgiveable here since we pass this const
     lightList.push_back(const_cast<Light*>(light));
 
@@ -32,6 +32,9 @@ THE SOFTWARE.
 #include "OgreLodStrategy.h"
 #include "OgreIteratorWrappers.h"
 #include "OgreSubEntity.h"
+#include "OgreLodStrategyManager.h"
+#include "OgreStreamSerialiser.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre {
 
@@ -40,6 +43,35 @@ namespace Ogre {
     #define REGION_MAX_INDEX 511
     #define REGION_MIN_INDEX -512
 
+    namespace {
+        typedef std::map<const HardwareBuffer*, uint32> BufferHashMap;
+
+        /// Hash of the contents of a buffer, each buffer is read only once
+        uint32 getContentHash(HardwareBuffer* buffer, BufferHashMap& hashes)
+        {
+            BufferHashMap::iterator it = hashes.find(buffer);
+            if (it == hashes.end())
+            {
+                std::vector<uchar> data(buffer->getSizeInBytes());
+                buffer->readData(0, data.size(), data.data());
+                it = hashes.emplace(buffer,
+                    FastHash(reinterpret_cast<const char*>(data.data()), data.size())).first;
+            }
+            return it->second;
+        }
+    }
+
+    const uint32 StaticGeometry::STATICGEOMETRY_CHUNK_ID = StreamSerialiser::makeIdentifier("SGEO");
+    const uint16 StaticGeometry::STATICGEOMETRY_CHUNK_VERSION = 1;
+    const uint32 StaticGeometry::STATICGEOMETRYREGION_CHUNK_ID = StreamSerialiser::makeIdentifier("SGRG");
+    const uint16 StaticGeometry::STATICGEOMETRYREGION_CHUNK_VERSION = 1;
+    const uint32 StaticGeometry::STATICGEOMETRYLOD_CHUNK_ID = StreamSerialiser::makeIdentifier("SGLD");
+    const uint16 StaticGeometry::STATICGEOMETRYLOD_CHUNK_VERSION = 1;
+    const uint32 StaticGeometry::STATICGEOMETRYMATERIAL_CHUNK_ID = StreamSerialiser::makeIdentifier("SGMT");
+    const uint16 StaticGeometry::STATICGEOMETRYMATERIAL_CHUNK_VERSION = 1;
+    const uint32 StaticGeometry::STATICGEOMETRYGEOMETRY_CHUNK_ID = StreamSerialiser::makeIdentifier("SGGB");
+    const uint16 StaticGeometry::STATICGEOMETRYGEOMETRY_CHUNK_VERSION = 1;
+
     //--------------------------------------------------------------------------
     StaticGeometry::StaticGeometry(SceneManager* owner, const String& name):
         mOwner(owner),
@@ -48,6 +80,7 @@ namespace Ogre {
         mUpperDistance(0.0f),
         mSquaredUpperDistance(0.0f),
         mCastShadows(false),
+        mRetainBuildData(false),
         mRegionDimensions(Vector3(1000,1000,1000)),
         mHalfRegionDimensions(Vector3(500,500,500)),
         mOrigin(Vector3(0,0,0)),
@@ -154,24 +187,29 @@ namespace Ogre {
         Region* ret = getRegion(index);
         if (!ret && autoCreate)
         {
-            // Make a name
-            StringStream str;
-            str << mName << ":" << index;
             // Calculate the region centre
-            Vector3 centre = getRegionCentre(x, y, z);
-            ret = OGRE_NEW Region(this, str.str(), mOwner, index, centre);
-            mOwner->injectMovableObject(ret);
-            ret->setVisible(mVisible);
-            ret->setCastShadows(mCastShadows);
-            if (mRenderQueueIDSet)
-            {
-                ret->setRenderQueueGroup(mRenderQueueID);
-            }
-            mRegionMap[index] = ret;
+            ret = createRegion(index, getRegionCentre(x, y, z));
         }
         return ret;
     }
     //--------------------------------------------------------------------------
+    StaticGeometry::Region* StaticGeometry::createRegion(uint32 index, const Vector3& centre)
+    {
+        // Make a name
+        StringStream str;
+        str << mName << ":" << index;
+        Region* ret = OGRE_NEW Region(this, str.str(), mOwner, index, centre);
+        mOwner->injectMovableObject(ret);
+        ret->setVisible(mVisible);
+        ret->setCastShadows(mCastShadows);
+        if (mRenderQueueIDSet)
+        {
+            ret->setRenderQueueGroup(mRenderQueueID);
+        }
+        mRegionMap[index] = ret;
+        return ret;
+    }
+    //--------------------------------------------------------------------------
     StaticGeometry::Region* StaticGeometry::getRegion(uint32 index)
     {
         RegionMap::iterator i = mRegionMap.find(index);
@@ -529,7 +567,40 @@ namespace Ogre {
             stencilShadows = true;
         }
 
-        // Now tell each region to build itself
+        // Distribute the geometry into buckets and collect the leaf buckets
+        std::vector<GeometryBucket*> geomBuckets;
+        for (RegionMap::iterator ri = mRegionMap.begin();
+            ri != mRegionMap.end(); ++ri)
+        {
+            ri->second->createLodBuckets();
+
+            Region::LODIterator lodIt = ri->second->getLODIterator();
+            while (lodIt.hasMoreElements())
+            {
+                LODBucket::MaterialIterator matIt = lodIt.getNext()->getMaterialIterator();
+                while (matIt.hasMoreElements())
+                {
+                    MaterialBucket::GeometryIterator geomIt = matIt.getNext()->getGeometryIterator();
+                    while (geomIt.hasMoreElements())
+                        geomBuckets.push_back(geomIt.getNext());
+                }
+            }
+        }
+
+        // Read the source buffers once, workers must not touch hardware buffers
+        SourceDataCache sourceData;
+        for (size_t i = 0; i < geomBuckets.size(); ++i)
+        {
+            geomBuckets[i]->_cacheSourceData(sourceData);
+        }
+
+        // Transforming & packing the vertices is independent per bucket
+        parallelFor(geomBuckets.size(), [&](size_t i) {
+            geomBuckets[i]->prepare(stencilShadows, sourceData);
+        });
+        sourceData.clear();
+
+        // Now tell each region to build itself, creating the hardware buffers
         for (RegionMap::iterator ri = mRegionMap.begin();
             ri != mRegionMap.end(); ++ri)
         {
@@ -658,6 +729,151 @@ namespace Ogre {
         }
         of << "-------------------------------------------------" << std::endl;
     }
+    //--------------------------------------------------------------------------
+    uint32 StaticGeometry::getBuildKey(void) const
+    {
+        uint32 key = HashCombine(0, mRegionDimensions);
+        key = HashCombine(key, mOrigin);
+        bool stencilShadows = mCastShadows && mOwner->isShadowTechniqueStencilBased();
+        key = HashCombine(key, stencilShadows);
+
+        // A mesh may have been changed without changing its size, so the
+        // geometry is identified by its contents
+        BufferHashMap bufferHashes;
+        for (QueuedSubMeshList::const_iterator qi = mQueuedSubMeshes.begin();
+            qi != mQueuedSubMeshes.end(); ++qi)
+        {
+            const QueuedSubMesh* qsm = *qi;
+            // Identify the source geometry by mesh, submesh and size per LOD
+            const Mesh* mesh = qsm->submesh->parent;
+            key = FastHash(mesh->getName().c_str(), mesh->getName().size(), key);
+            const Mesh::SubMeshList& subMeshes = mesh->getSubMeshes();
+            uint32 subMeshIndex = static_cast<uint32>(
+                std::find(subMeshes.begin(), subMeshes.end(), qsm->submesh) - subMeshes.begin());
+            key = HashCombine(key, subMeshIndex);
+            for (SubMeshLodGeometryLinkList::const_iterator li = qsm->geometryLodList->begin();
+                li != qsm->geometryLodList->end(); ++li)
+            {
+                key = HashCombine(key, li->vertexData->vertexCount);
+                key = HashCombine(key, li->indexData->indexCount);
+
+                const VertexDeclaration::VertexElementList& elems =
+                    li->vertexData->vertexDeclaration->getElements();
+                for (VertexDeclaration::VertexElementList::const_iterator ei = elems.begin();
+                    ei != elems.end(); ++ei)
+                {
+                    key = HashCombine(key, ei->getSource());
+                    key = HashCombine(key, ei->getOffset());
+                    key = HashCombine(key, ei->getType());
+                    key = HashCombine(key, ei->getSemantic());
+                    key = HashCombine(key, ei->getIndex());
+                }
+                const VertexBufferBinding* binds = li->vertexData->vertexBufferBinding;
+                for (ushort b = 0; b < binds->getBufferCount(); ++b)
+                {
+                    key = HashCombine(key, getContentHash(binds->getBuffer(b).get(), bufferHashes));
+                }
+                key = HashCombine(key, getContentHash(li->indexData->indexBuffer.get(), bufferHashes));
+                key = HashCombine(key, li->vertexData->vertexStart);
+                key = HashCombine(key, li->indexData->indexStart);
+            }
+            key = FastHash(qsm->materialName.c_str(), qsm->materialName.size(), key);
+            // and the placement
+            key = HashCombine(key, qsm->position);
+            key = HashCombine(key, qsm->orientation);
+            key = HashCombine(key, qsm->scale);
+        }
+        return key;
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::save(StreamSerialiser& stream)
+    {
+        if (!mRetainBuildData)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "The built geometry of '" + mName + "' was not retained, "
+                "call setRetainBuildData before building it",
+                "StaticGeometry::save");
+        }
+        stream.writeChunkBegin(STATICGEOMETRY_CHUNK_ID, STATICGEOMETRY_CHUNK_VERSION);
+        uint32 key = getBuildKey();
+        stream.write(&key);
+        uint32 numRegions = static_cast<uint32>(mRegionMap.size());
+        stream.write(&numRegions);
+        for (RegionMap::const_iterator ri = mRegionMap.begin(); ri != mRegionMap.end(); ++ri)
+        {
+            ri->second->save(stream);
+        }
+        stream.writeChunkEnd(STATICGEOMETRY_CHUNK_ID);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::save(const String& filename)
+    {
+        DataStreamPtr stream = Root::createFileStream(filename,
+            ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+        StreamSerialiser ser(stream);
+        save(ser);
+    }
+    //--------------------------------------------------------------------------
+    bool StaticGeometry::load(StreamSerialiser& stream)
+    {
+        if (!stream.readChunkBegin(STATICGEOMETRY_CHUNK_ID, STATICGEOMETRY_CHUNK_VERSION,
+            "StaticGeometry::load"))
+            return false;
+
+        uint32 key;
+        stream.read(&key);
+        if (key != getBuildKey())
+        {
+            LogManager::getSingleton().logMessage("StaticGeometry '" + mName +
+                "': saved geometry does not match the queued input, it needs to be rebuilt");
+            stream.readChunkEnd(STATICGEOMETRY_CHUNK_ID);
+            return false;
+        }
+
+        // Make sure there's nothing from previous builds
+        destroy();
+
+        uint32 numRegions;
+        stream.read(&numRegions);
+        for (uint32 i = 0; i < numRegions; ++i)
+        {
+            if (!stream.readChunkBegin(STATICGEOMETRYREGION_CHUNK_ID, STATICGEOMETRYREGION_CHUNK_VERSION))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Missing region data",
+                    "StaticGeometry::load");
+            }
+            uint32 index;
+            Vector3 centre;
+            stream.read(&index);
+            stream.read(&centre);
+            createRegion(index, centre)->load(stream);
+            stream.readChunkEnd(STATICGEOMETRYREGION_CHUNK_ID);
+        }
+        stream.readChunkEnd(STATICGEOMETRY_CHUNK_ID);
+
+        bool stencilShadows = false;
+        if (mCastShadows && mOwner->isShadowTechniqueStencilBased())
+        {
+            stencilShadows = true;
+        }
+
+        // The geometry buckets upload the restored data as they are built
+        for (RegionMap::iterator ri = mRegionMap.begin();
+            ri != mRegionMap.end(); ++ri)
+        {
+            ri->second->build(stencilShadows);
+            ri->second->setVisibilityFlags(mVisibilityFlags);
+        }
+        return true;
+    }
+    //--------------------------------------------------------------------------
+    bool StaticGeometry::load(const String& filename, const String& groupName)
+    {
+        DataStreamPtr stream = Root::openFileStream(filename, groupName);
+        StreamSerialiser ser(stream);
+        return load(ser);
+    }
     //---------------------------------------------------------------------
     void StaticGeometry::visitRenderables(Renderable::Visitor* visitor, 
         bool debugRenderables)
@@ -769,15 +985,11 @@ namespace Ogre {
 
     }
     //--------------------------------------------------------------------------
-    void StaticGeometry::Region::build(bool stencilShadows)
+    void StaticGeometry::Region::createLodBuckets(void)
     {
-        // Create a node
-        mNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(mName,
-            mCentre);
-        mNode->attachObject(this);
         // We need to create enough LOD buckets to deal with the highest LOD
         // we encountered in all the meshes queued
-        for (ushort lod = 0; lod < mLodValues.size(); ++lod)
+        for (ushort lod = static_cast<ushort>(mLodBucketList.size()); lod < mLodValues.size(); ++lod)
         {
             LODBucket* lodBucket =
                 OGRE_NEW LODBucket(this, lod, mLodValues[lod]);
@@ -790,12 +1002,21 @@ namespace Ogre {
             {
                 lodBucket->assign(*qi, lod);
             }
-            // now build
-            lodBucket->build(stencilShadows);
         }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::Region::build(bool stencilShadows)
+    {
+        // Create a node
+        mNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(mName,
+            mCentre);
+        mNode->attachObject(this);
 
-
-
+        createLodBuckets();
+        for (LODBucketList::iterator i = mLodBucketList.begin(); i != mLodBucketList.end(); ++i)
+        {
+            (*i)->build(stencilShadows);
+        }
     }
     //--------------------------------------------------------------------------
     const String& StaticGeometry::Region::getMovableType(void) const
@@ -932,6 +1153,54 @@ namespace Ogre {
         of << "--------------------------" << std::endl;
     }
     //--------------------------------------------------------------------------
+    void StaticGeometry::Region::save(StreamSerialiser& stream) const
+    {
+        stream.writeChunkBegin(STATICGEOMETRYREGION_CHUNK_ID, STATICGEOMETRYREGION_CHUNK_VERSION);
+        stream.write(&mRegionID);
+        stream.write(&mCentre);
+        String lodStrategy = mLodStrategy ? mLodStrategy->getName() : BLANKSTRING;
+        stream.write(&lodStrategy);
+        uint16 numLods = static_cast<uint16>(mLodValues.size());
+        stream.write(&numLods);
+        if (numLods)
+            stream.write(&mLodValues[0], numLods);
+        stream.write(&mAABB);
+        stream.write(&mBoundingRadius);
+        for (LODBucketList::const_iterator i = mLodBucketList.begin(); i != mLodBucketList.end(); ++i)
+        {
+            (*i)->save(stream);
+        }
+        stream.writeChunkEnd(STATICGEOMETRYREGION_CHUNK_ID);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::Region::load(StreamSerialiser& stream)
+    {
+        String lodStrategy;
+        stream.read(&lodStrategy);
+        mLodStrategy = lodStrategy.empty() ? 0 :
+            LodStrategyManager::getSingleton().getStrategy(lodStrategy);
+        uint16 numLods;
+        stream.read(&numLods);
+        mLodValues.resize(numLods);
+        if (numLods)
+            stream.read(&mLodValues[0], numLods);
+        stream.read(&mAABB);
+        stream.read(&mBoundingRadius);
+
+        for (ushort lod = 0; lod < numLods; ++lod)
+        {
+            if (!stream.readChunkBegin(STATICGEOMETRYLOD_CHUNK_ID, STATICGEOMETRYLOD_CHUNK_VERSION))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Missing LOD data",
+                    "StaticGeometry::Region::load");
+            }
+            LODBucket* lodBucket = OGRE_NEW LODBucket(this, lod, mLodValues[lod]);
+            mLodBucketList.push_back(lodBucket);
+            lodBucket->load(stream);
+            stream.readChunkEnd(STATICGEOMETRYLOD_CHUNK_ID);
+        }
+    }
+    //--------------------------------------------------------------------------
     //--------------------------------------------------------------------------
     StaticGeometry::LODBucket::LODShadowRenderable::LODShadowRenderable(
         LODBucket* parent, HardwareIndexBufferSharedPtr* indexBuffer,
@@ -1154,6 +1423,39 @@ namespace Ogre {
         of << "------------------" << std::endl;
 
     }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::LODBucket::save(StreamSerialiser& stream) const
+    {
+        stream.writeChunkBegin(STATICGEOMETRYLOD_CHUNK_ID, STATICGEOMETRYLOD_CHUNK_VERSION);
+        uint32 numMaterials = static_cast<uint32>(mMaterialBucketMap.size());
+        stream.write(&numMaterials);
+        for (MaterialBucketMap::const_iterator i = mMaterialBucketMap.begin();
+            i != mMaterialBucketMap.end(); ++i)
+        {
+            i->second->save(stream);
+        }
+        stream.writeChunkEnd(STATICGEOMETRYLOD_CHUNK_ID);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::LODBucket::load(StreamSerialiser& stream)
+    {
+        uint32 numMaterials;
+        stream.read(&numMaterials);
+        for (uint32 m = 0; m < numMaterials; ++m)
+        {
+            if (!stream.readChunkBegin(STATICGEOMETRYMATERIAL_CHUNK_ID, STATICGEOMETRYMATERIAL_CHUNK_VERSION))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Missing material data",
+                    "StaticGeometry::LODBucket::load");
+            }
+            String materialName;
+            stream.read(&materialName);
+            MaterialBucket* mbucket = OGRE_NEW MaterialBucket(this, materialName);
+            mMaterialBucketMap[materialName] = mbucket;
+            mbucket->load(stream);
+            stream.readChunkEnd(STATICGEOMETRYMATERIAL_CHUNK_ID);
+        }
+    }
     //---------------------------------------------------------------------
     void StaticGeometry::LODBucket::visitRenderables(Renderable::Visitor* visitor, 
         bool debugRenderables)
@@ -1372,6 +1674,43 @@ namespace Ogre {
         of << "--------------------------------------------------" << std::endl;
 
     }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::save(StreamSerialiser& stream) const
+    {
+        stream.writeChunkBegin(STATICGEOMETRYMATERIAL_CHUNK_ID, STATICGEOMETRYMATERIAL_CHUNK_VERSION);
+        stream.write(&mMaterialName);
+        uint32 numGeometry = static_cast<uint32>(mGeometryBucketList.size());
+        stream.write(&numGeometry);
+        for (GeometryBucketList::const_iterator i = mGeometryBucketList.begin();
+            i != mGeometryBucketList.end(); ++i)
+        {
+            (*i)->save(stream);
+        }
+        stream.writeChunkEnd(STATICGEOMETRYMATERIAL_CHUNK_ID);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::load(StreamSerialiser& stream)
+    {
+        uint32 numGeometry;
+        stream.read(&numGeometry);
+        for (uint32 g = 0; g < numGeometry; ++g)
+        {
+            if (!stream.readChunkBegin(STATICGEOMETRYGEOMETRY_CHUNK_ID, STATICGEOMETRYGEOMETRY_CHUNK_VERSION))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Missing geometry data",
+                    "StaticGeometry::MaterialBucket::load");
+            }
+            String formatString;
+            uint16 indexType;
+            stream.read(&formatString);
+            stream.read(&indexType);
+            GeometryBucket* gbucket = OGRE_NEW GeometryBucket(this, formatString,
+                static_cast<HardwareIndexBuffer::IndexType>(indexType));
+            mGeometryBucketList.push_back(gbucket);
+            gbucket->load(stream);
+            stream.readChunkEnd(STATICGEOMETRYGEOMETRY_CHUNK_ID);
+        }
+    }
     //---------------------------------------------------------------------
     void StaticGeometry::MaterialBucket::visitRenderables(Renderable::Visitor* visitor, 
         bool debugRenderables)
@@ -1433,6 +1772,23 @@ namespace Ogre {
         }
 
 
+    }
+    //--------------------------------------------------------------------------
+    StaticGeometry::GeometryBucket::GeometryBucket(MaterialBucket* parent,
+        const String& formatString, HardwareIndexBuffer::IndexType indexType)
+        : Renderable(), mParent(parent), mFormatString(formatString), mIndexType(indexType)
+    {
+        mVertexData = OGRE_NEW VertexData();
+        mIndexData = OGRE_NEW IndexData();
+        // Derive the max vertices
+        if (mIndexType == HardwareIndexBuffer::IT_32BIT)
+        {
+            mMaxVertexIndex = 0xFFFFFFFF;
+        }
+        else
+        {
+            mMaxVertexIndex = 0xFFFF;
+        }
     }
     //--------------------------------------------------------------------------
     StaticGeometry::GeometryBucket::~GeometryBucket()
@@ -1504,27 +1860,51 @@ namespace Ogre {
         return true;
     }
     //--------------------------------------------------------------------------
-    void StaticGeometry::GeometryBucket::build(bool stencilShadows)
+    void StaticGeometry::GeometryBucket::_cacheSourceData(SourceDataCache& cache) const
+    {
+        QueuedGeometryList::const_iterator gi, giend;
+        giend = mQueuedGeometry.end();
+        for (gi = mQueuedGeometry.begin(); gi != giend; ++gi)
+        {
+            const SubMeshLodGeometryLink* geom = (*gi)->geometry;
+            std::vector<HardwareBuffer*> buffers(1, geom->indexData->indexBuffer.get());
+            for (ushort b = 0; b < mVertexData->vertexBufferBinding->getBufferCount(); ++b)
+            {
+                buffers.push_back(geom->vertexData->vertexBufferBinding->getBuffer(b).get());
+            }
+
+            for (size_t i = 0; i < buffers.size(); ++i)
+            {
+                std::vector<uchar>& data = cache[buffers[i]];
+                if (data.empty())
+                {
+                    data.resize(buffers[i]->getSizeInBytes());
+                    buffers[i]->readData(0, data.size(), data.data());
+                }
+            }
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::prepare(bool stencilShadows, const SourceDataCache& cache)
     {
-        // Ok, here's where we transfer the vertices and indexes to the shared
-        // buffers
+        // Ok, here's where we transfer the vertices and indexes to the packed
+        // system memory copies of the shared buffers
         // Shortcuts
         VertexDeclaration* dcl = mVertexData->vertexDeclaration;
         VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
 
-        // create index buffer, and lock
-        mIndexData->indexBuffer = HardwareBufferManager::getSingleton()
-            .createIndexBuffer(mIndexType, mIndexData->indexCount,
-                HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-        HardwareBufferLockGuard dstIndexLock(mIndexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
-        uint32* p32Dest = static_cast<uint32*>(dstIndexLock.pData);
-        uint16* p16Dest = static_cast<uint16*>(dstIndexLock.pData);
-        // create all vertex buffers, and lock
+        mIndexStaging.resize(mIndexData->indexCount *
+            (mIndexType == HardwareIndexBuffer::IT_32BIT ? sizeof(uint32) : sizeof(uint16)));
+        uint32* p32Dest = reinterpret_cast<uint32*>(mIndexStaging.data());
+        uint16* p16Dest = reinterpret_cast<uint16*>(mIndexStaging.data());
+
         ushort b;
         ushort posBufferIdx = dcl->findElementBySemantic(VES_POSITION)->getSource();
 
-        std::vector<uchar*> destBufferLocks;
+        std::vector<uchar*> destBufferPtrs;
         std::vector<VertexDeclaration::VertexElementList> bufferElements;
+        std::vector<bool> bufferTransformed;
+        mVertexStaging.resize(binds->getBufferCount());
         for (b = 0; b < binds->getBufferCount(); ++b)
         {
             size_t vertexCount = mVertexData->vertexCount;
@@ -1537,20 +1917,22 @@ namespace Ogre {
                     "Index range exceeded when using stencil shadows, consider "
                     "reducing your region size or reducing poly count");
             }
-            HardwareVertexBufferSharedPtr vbuf =
-                HardwareBufferManager::getSingleton().createVertexBuffer(
-                    dcl->getVertexSize(b),
-                    vertexCount,
-                    HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-            binds->setBinding(b, vbuf);
-            uchar* pLock = static_cast<uchar*>(
-                vbuf->lock(HardwareBuffer::HBL_DISCARD));
-            destBufferLocks.push_back(pLock);
+            mVertexStaging[b].resize(dcl->getVertexSize(b) * vertexCount);
+            destBufferPtrs.push_back(mVertexStaging[b].data());
             // Pre-cache vertex elements per buffer
             bufferElements.push_back(dcl->findElementsBySource(b));
+            // Buffers without spatial elements can be copied wholesale
+            bool transformed = false;
+            VertexDeclaration::VertexElementList::iterator ei;
+            for (ei = bufferElements.back().begin(); ei != bufferElements.back().end(); ++ei)
+            {
+                VertexElementSemantic sem = ei->getSemantic();
+                transformed |= sem == VES_POSITION || sem == VES_NORMAL ||
+                               sem == VES_TANGENT || sem == VES_BINORMAL;
+            }
+            bufferTransformed.push_back(transformed);
         }
 
-
         // Iterate over the geometry items
         size_t indexOffset = 0;
         QueuedGeometryList::iterator gi, giend;
@@ -1561,24 +1943,20 @@ namespace Ogre {
             QueuedGeometry* geom = *gi;
             // Copy indexes across with offset
             IndexData* srcIdxData = geom->geometry->indexData;
-            HardwareBufferLockGuard srcIdxLock(srcIdxData->indexBuffer,
-                                               srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize(), 
-                                               srcIdxData->indexCount * srcIdxData->indexBuffer->getIndexSize(),
-                                               HardwareBuffer::HBL_READ_ONLY);
+            const uchar* pSrcIdx = cache.find(srcIdxData->indexBuffer.get())->second.data() +
+                srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize();
             if (mIndexType == HardwareIndexBuffer::IT_32BIT)
             {
-                uint32* pSrc = static_cast<uint32*>(srcIdxLock.pData);
+                const uint32* pSrc = reinterpret_cast<const uint32*>(pSrcIdx);
                 copyIndexes(pSrc, p32Dest, srcIdxData->indexCount, indexOffset);
                 p32Dest += srcIdxData->indexCount;
             }
             else
             {
-                // Lock source indexes
-                uint16* pSrc = static_cast<uint16*>(srcIdxLock.pData);
+                const uint16* pSrc = reinterpret_cast<const uint16*>(pSrcIdx);
                 copyIndexes(pSrc, p16Dest, srcIdxData->indexCount, indexOffset);
                 p16Dest += srcIdxData->indexCount;
             }
-            srcIdxLock.unlock();
 
             // Now deal with vertex buffers
             // we can rely on buffer counts / formats being the same
@@ -1586,112 +1964,145 @@ namespace Ogre {
             VertexBufferBinding* srcBinds = srcVData->vertexBufferBinding;
             for (b = 0; b < binds->getBufferCount(); ++b)
             {
-                // lock source
-                HardwareVertexBufferSharedPtr srcBuf = srcBinds->getBuffer(b);
-                HardwareBufferLockGuard srcBufLock(srcBuf, HardwareBuffer::HBL_READ_ONLY);
-                uchar* pSrcBase = static_cast<uchar*>(srcBufLock.pData);
-                // Get buffer lock pointer, we'll update this later
-                uchar* pDstBase = destBufferLocks[b];
+                const HardwareVertexBufferSharedPtr& srcBuf = srcBinds->getBuffer(b);
+                const uchar* pSrcBase = cache.find(srcBuf.get())->second.data();
+                uchar* pDstBase = destBufferPtrs[b];
                 size_t bufInc = srcBuf->getVertexSize();
+                size_t vertexCount = srcVData->vertexCount;
 
-                // Iterate over vertices
-                float *pSrcReal, *pDstReal;
-                Vector3 tmp;
-                for (size_t v = 0; v < srcVData->vertexCount; ++v)
+                if (!bufferTransformed[b])
+                {
+                    // just raw copy
+                    memcpy(pDstBase, pSrcBase, bufInc * vertexCount);
+                }
+                else
                 {
-                    // Iterate over vertex elements
-                    VertexDeclaration::VertexElementList& elems =
-                        bufferElements[b];
+                    // Iterate over vertex elements, then vertices, so the
+                    // inner loops are uniform
+                    VertexDeclaration::VertexElementList& elems = bufferElements[b];
                     VertexDeclaration::VertexElementList::iterator ei;
                     for (ei = elems.begin(); ei != elems.end(); ++ei)
                     {
-                        VertexElement& elem = *ei;
-                        elem.baseVertexPointerToElement(pSrcBase, &pSrcReal);
-                        elem.baseVertexPointerToElement(pDstBase, &pDstReal);
+                        const VertexElement& elem = *ei;
+                        const uchar* pSrc = pSrcBase + elem.getOffset();
+                        uchar* pDst = pDstBase + elem.getOffset();
                         switch (elem.getSemantic())
                         {
                         case VES_POSITION:
-                            tmp.x = *pSrcReal++;
-                            tmp.y = *pSrcReal++;
-                            tmp.z = *pSrcReal++;
-                            // transform
-                            tmp = (geom->orientation * (tmp * geom->scale)) +
-                                geom->position;
-                            // Adjust for region centre
-                            tmp -= regionCentre;
-                            *pDstReal++ = tmp.x;
-                            *pDstReal++ = tmp.y;
-                            *pDstReal++ = tmp.z;
+                            for (size_t v = 0; v < vertexCount; ++v, pSrc += bufInc, pDst += bufInc)
+                            {
+                                const float* pSrcReal = reinterpret_cast<const float*>(pSrc);
+                                float* pDstReal = reinterpret_cast<float*>(pDst);
+                                Vector3 tmp(pSrcReal[0], pSrcReal[1], pSrcReal[2]);
+                                // transform
+                                tmp = (geom->orientation * (tmp * geom->scale)) +
+                                    geom->position;
+                                // Adjust for region centre
+                                tmp -= regionCentre;
+                                pDstReal[0] = tmp.x;
+                                pDstReal[1] = tmp.y;
+                                pDstReal[2] = tmp.z;
+                            }
                             break;
                         case VES_NORMAL:
                         case VES_TANGENT:
                         case VES_BINORMAL:
-                            tmp.x = *pSrcReal++;
-                            tmp.y = *pSrcReal++;
-                            tmp.z = *pSrcReal++;
-                            // scale (invert)
-                            tmp = tmp / geom->scale;
-                            tmp.normalise();
-                            // rotation
-                            tmp = geom->orientation * tmp;
-                            *pDstReal++ = tmp.x;
-                            *pDstReal++ = tmp.y;
-                            *pDstReal++ = tmp.z;
-                            // copy parity for tangent.
-                            if (elem.getType() == Ogre::VET_FLOAT4)
-                                *pDstReal = *pSrcReal;
+                            for (size_t v = 0; v < vertexCount; ++v, pSrc += bufInc, pDst += bufInc)
+                            {
+                                const float* pSrcReal = reinterpret_cast<const float*>(pSrc);
+                                float* pDstReal = reinterpret_cast<float*>(pDst);
+                                Vector3 tmp(pSrcReal[0], pSrcReal[1], pSrcReal[2]);
+                                // scale (invert)
+                                tmp = tmp / geom->scale;
+                                tmp.normalise();
+                                // rotation
+                                tmp = geom->orientation * tmp;
+                                pDstReal[0] = tmp.x;
+                                pDstReal[1] = tmp.y;
+                                pDstReal[2] = tmp.z;
+                                // copy parity for tangent.
+                                if (elem.getType() == Ogre::VET_FLOAT4)
+                                    pDstReal[3] = pSrcReal[3];
+                            }
                             break;
                         default:
-                            // just raw copy
-                            memcpy(pDstReal, pSrcReal,
-                                    VertexElement::getTypeSize(elem.getType()));
+                            {
+                                // just raw copy
+                                size_t typeSize = VertexElement::getTypeSize(elem.getType());
+                                for (size_t v = 0; v < vertexCount; ++v, pSrc += bufInc, pDst += bufInc)
+                                    memcpy(pDst, pSrc, typeSize);
+                            }
                             break;
                         };
-
                     }
-
-                    // Increment both pointers
-                    pDstBase += bufInc;
-                    pSrcBase += bufInc;
-
                 }
 
                 // Update pointer
-                destBufferLocks[b] = pDstBase;
+                destBufferPtrs[b] = pDstBase + bufInc * vertexCount;
             }
 
             indexOffset += geom->geometry->vertexData->vertexCount;
         }
 
-        // Unlock everything
-        dstIndexLock.unlock();
-        for (b = 0; b < binds->getBufferCount(); ++b)
-        {
-            binds->getBuffer(b)->unlock();
-        }
-
         // If we're dealing with stencil shadows, copy the position data from
         // the early half of the buffer to the latter part
         if (stencilShadows)
         {
-            HardwareVertexBufferSharedPtr buf = binds->getBuffer(posBufferIdx);
-            HardwareBufferLockGuard bufLock(buf, HardwareBuffer::HBL_NORMAL);
-            void* pSrc = bufLock.pData;
-            // Point dest at second half (remember vertexcount is original count)
-            void* pDest = static_cast<uchar*>(pSrc) +
-                buf->getVertexSize() * mVertexData->vertexCount;
-            memcpy(pDest, pSrc, buf->getVertexSize() * mVertexData->vertexCount);
-            bufLock.unlock();
+            std::vector<uchar>& posData = mVertexStaging[posBufferIdx];
+            size_t halfSize = posData.size() / 2;
+            memcpy(posData.data() + halfSize, posData.data(), halfSize);
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::build(bool stencilShadows)
+    {
+        if (mVertexStaging.empty())
+        {
+            // Not prepared by StaticGeometry::build, do it in place
+            SourceDataCache cache;
+            _cacheSourceData(cache);
+            prepare(stencilShadows, cache);
+        }
+
+        VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
+
+        // create index buffer and upload the packed indexes
+        mIndexData->indexBuffer = HardwareBufferManager::getSingleton()
+            .createIndexBuffer(mIndexType, mIndexData->indexCount,
+                HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+        mIndexData->indexBuffer->writeData(0, mIndexStaging.size(), mIndexStaging.data(), true);
+
+        // create all vertex buffers and upload the packed vertices
+        for (ushort b = 0; b < mVertexStaging.size(); ++b)
+        {
+            size_t vertexSize = mVertexData->vertexDeclaration->getVertexSize(b);
+            HardwareVertexBufferSharedPtr vbuf =
+                HardwareBufferManager::getSingleton().createVertexBuffer(
+                    vertexSize,
+                    mVertexStaging[b].size() / vertexSize,
+                    HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            vbuf->writeData(0, mVertexStaging[b].size(), mVertexStaging[b].data(), true);
+            binds->setBinding(b, vbuf);
+        }
+
+        // The system memory copies are no longer needed, unless they are to be saved
+        if (!mParent->getParent()->getParent()->getParent()->getRetainBuildData())
+        {
+            mVertexStaging.clear();
+            std::vector<uchar>().swap(mIndexStaging);
+        }
 
+        if (stencilShadows)
+        {
             // Also set up hardware W buffer if appropriate
             RenderSystem* rend = Root::getSingleton().getRenderSystem();
             if (rend && rend->getCapabilities()->hasCapability(RSC_VERTEX_PROGRAM))
             {
-                buf = HardwareBufferManager::getSingleton().createVertexBuffer(
+                HardwareVertexBufferSharedPtr buf = HardwareBufferManager::getSingleton().createVertexBuffer(
                     sizeof(float), mVertexData->vertexCount * 2,
                     HardwareBuffer::HBU_STATIC_WRITE_ONLY, false);
                 // Fill the first half with 1.0, second half with 0.0
-                bufLock.lock(buf, HardwareBuffer::HBL_DISCARD);
+                HardwareBufferLockGuard bufLock(buf, HardwareBuffer::HBL_DISCARD);
                 float *pW = static_cast<float*>(bufLock.pData);
                 size_t v;
                 for (v = 0; v < mVertexData->vertexCount; ++v)
@@ -1721,6 +2132,94 @@ namespace Ogre {
 
     }
     //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::save(StreamSerialiser& stream) const
+    {
+        stream.writeChunkBegin(STATICGEOMETRYGEOMETRY_CHUNK_ID, STATICGEOMETRYGEOMETRY_CHUNK_VERSION);
+        stream.write(&mFormatString);
+        uint16 indexType = static_cast<uint16>(mIndexType);
+        stream.write(&indexType);
+        uint32 vertexCount = static_cast<uint32>(mVertexData->vertexCount);
+        uint32 indexCount = static_cast<uint32>(mIndexData->indexCount);
+        stream.write(&vertexCount);
+        stream.write(&indexCount);
+
+        // Vertex declaration
+        const VertexDeclaration::VertexElementList& elems =
+            mVertexData->vertexDeclaration->getElements();
+        uint16 numElements = static_cast<uint16>(elems.size());
+        stream.write(&numElements);
+        for (VertexDeclaration::VertexElementList::const_iterator ei = elems.begin();
+            ei != elems.end(); ++ei)
+        {
+            uint16 source = ei->getSource();
+            uint32 offset = static_cast<uint32>(ei->getOffset());
+            uint16 type = static_cast<uint16>(ei->getType());
+            uint16 semantic = static_cast<uint16>(ei->getSemantic());
+            uint16 index = ei->getIndex();
+            stream.write(&source);
+            stream.write(&offset);
+            stream.write(&type);
+            stream.write(&semantic);
+            stream.write(&index);
+        }
+
+        // Packed buffer contents, the hardware buffers are write only
+        uint16 numBuffers = static_cast<uint16>(mVertexStaging.size());
+        stream.write(&numBuffers);
+        for (ushort b = 0; b < numBuffers; ++b)
+        {
+            uint32 size = static_cast<uint32>(mVertexStaging[b].size());
+            stream.write(&size);
+            stream.writeData(mVertexStaging[b].data(), 1, size);
+        }
+        uint32 size = static_cast<uint32>(mIndexStaging.size());
+        stream.write(&size);
+        stream.writeData(mIndexStaging.data(), 1, size);
+
+        stream.writeChunkEnd(STATICGEOMETRYGEOMETRY_CHUNK_ID);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::load(StreamSerialiser& stream)
+    {
+        uint32 vertexCount, indexCount;
+        stream.read(&vertexCount);
+        stream.read(&indexCount);
+        mVertexData->vertexCount = vertexCount;
+        mIndexData->indexCount = indexCount;
+
+        uint16 numElements;
+        stream.read(&numElements);
+        for (uint16 e = 0; e < numElements; ++e)
+        {
+            uint16 source, type, semantic, index;
+            uint32 offset;
+            stream.read(&source);
+            stream.read(&offset);
+            stream.read(&type);
+            stream.read(&semantic);
+            stream.read(&index);
+            mVertexData->vertexDeclaration->addElement(source, offset,
+                static_cast<VertexElementType>(type),
+                static_cast<VertexElementSemantic>(semantic), index);
+        }
+
+        // Staged exactly as prepare would have left it, build uploads it
+        uint16 numBuffers;
+        stream.read(&numBuffers);
+        mVertexStaging.resize(numBuffers);
+        for (ushort b = 0; b < numBuffers; ++b)
+        {
+            uint32 size;
+            stream.read(&size);
+            mVertexStaging[b].resize(size);
+            stream.readData(mVertexStaging[b].data(), 1, size);
+        }
+        uint32 size;
+        stream.read(&size);
+        mIndexStaging.resize(size);
+        stream.readData(mIndexStaging.data(), 1, size);
+    }
+    //--------------------------------------------------------------------------
 
 }
 
@@ -0,0 +1,243 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreTaskGraph.h"
+
+namespace Ogre
+{
+    //---------------------------------------------------------------------
+    TaskGraph::TaskGraph()
+        : mDirty(false), mGroup(0)
+    {
+    }
+    //---------------------------------------------------------------------
+    TaskGraph::~TaskGraph()
+    {
+        clear();
+    }
+    //---------------------------------------------------------------------
+    TaskGraph::PhaseId TaskGraph::addPhaseImpl(const String& name, TaskScheduler::Callable* func)
+    {
+        Phase* phase = OGRE_NEW_T(Phase, MEMCATEGORY_GENERAL)();
+        phase->name = name;
+        phase->func = func;
+        phase->time = 0;
+        phase->task.func = &TaskGraph::runPhase;
+        phase->task.userData = this;
+        phase->task.index = mPhases.size();
+        phase->task.group = 0;
+        mPhases.push_back(phase);
+        mDirty = true;
+        return phase->task.index;
+    }
+    //---------------------------------------------------------------------
+    TaskGraph::Phase* TaskGraph::getPhase(PhaseId phase) const
+    {
+        if (phase >= mPhases.size())
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "Invalid phase " + StringConverter::toString(phase),
+                        "TaskGraph::getPhase");
+        }
+        return mPhases[phase];
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::addDependency(PhaseId phase, PhaseId dependency)
+    {
+        getPhase(dependency);
+        if (hasDependency(phase, dependency))
+            return;
+        getPhase(phase)->dependencies.push_back(dependency);
+        mDirty = true;
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::removeDependency(PhaseId phase, PhaseId dependency)
+    {
+        std::vector<PhaseId>& dependencies = getPhase(phase)->dependencies;
+        std::vector<PhaseId>::iterator i = std::find(dependencies.begin(), dependencies.end(), dependency);
+        if (i != dependencies.end())
+        {
+            dependencies.erase(i);
+            mDirty = true;
+        }
+    }
+    //---------------------------------------------------------------------
+    bool TaskGraph::hasDependency(PhaseId phase, PhaseId dependency) const
+    {
+        const std::vector<PhaseId>& dependencies = getPhase(phase)->dependencies;
+        return std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end();
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::clear()
+    {
+        for (size_t i = 0; i < mPhases.size(); ++i)
+        {
+            OGRE_DELETE_T(mPhases[i]->func, TaskScheduler::Callable, MEMCATEGORY_GENERAL);
+            OGRE_DELETE_T(mPhases[i], Phase, MEMCATEGORY_GENERAL);
+        }
+        mPhases.clear();
+        mRoots.clear();
+        mOrder.clear();
+        mDirty = false;
+    }
+    //---------------------------------------------------------------------
+    const String& TaskGraph::getPhaseName(PhaseId phase) const
+    {
+        return getPhase(phase)->name;
+    }
+    //---------------------------------------------------------------------
+    uint64 TaskGraph::getPhaseTime(PhaseId phase) const
+    {
+        return getPhase(phase)->time;
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::update()
+    {
+        std::vector<size_t> inDegree(mPhases.size());
+        for (size_t i = 0; i < mPhases.size(); ++i)
+            mPhases[i]->dependents.clear();
+        for (size_t i = 0; i < mPhases.size(); ++i)
+        {
+            const std::vector<PhaseId>& dependencies = mPhases[i]->dependencies;
+            for (size_t d = 0; d < dependencies.size(); ++d)
+                mPhases[dependencies[d]]->dependents.push_back(i);
+            inDegree[i] = dependencies.size();
+        }
+
+        mRoots.clear();
+        for (size_t i = 0; i < mPhases.size(); ++i)
+        {
+            if (inDegree[i] == 0)
+                mRoots.push_back(i);
+        }
+
+        // Kahn's algorithm, every phase must be reachable from the roots
+        mOrder = mRoots;
+        for (size_t next = 0; next < mOrder.size(); ++next)
+        {
+            const std::vector<PhaseId>& dependents = mPhases[mOrder[next]]->dependents;
+            for (size_t d = 0; d < dependents.size(); ++d)
+            {
+                if (--inDegree[dependents[d]] == 0)
+                    mOrder.push_back(dependents[d]);
+            }
+        }
+        if (mOrder.size() != mPhases.size())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "The phase dependencies contain a cycle",
+                        "TaskGraph::update");
+        }
+
+        mDirty = false;
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::execute(TaskScheduler* scheduler)
+    {
+        OgreAssert(!mGroup, "TaskGraph is already executing");
+        if (mDirty)
+            update();
+
+        for (size_t i = 0; i < mPhases.size(); ++i)
+        {
+            mPhases[i]->remainingDependencies.store(mPhases[i]->dependencies.size(), std::memory_order_relaxed);
+            mPhases[i]->time = 0;
+        }
+
+        TaskGroup group(scheduler);
+        mGroup = &group;
+        for (size_t i = 0; i < mRoots.size(); ++i)
+            group.submit(&mPhases[mRoots[i]]->task);
+
+        try
+        {
+            group.wait();
+        }
+        catch (...)
+        {
+            mGroup = 0;
+            throw;
+        }
+        mGroup = 0;
+
+        reportProfile();
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::executeSerial()
+    {
+        OgreAssert(!mGroup, "TaskGraph is already executing");
+        if (mDirty)
+            update();
+
+        for (size_t i = 0; i < mPhases.size(); ++i)
+            mPhases[i]->time = 0;
+
+        for (size_t i = 0; i < mOrder.size(); ++i)
+        {
+            Phase* phase = mPhases[mOrder[i]];
+            uint64 start = mTimer.getMicroseconds();
+            {
+                OgreProfileTrace(phase->name);
+                (*phase->func)();
+            }
+            phase->time = mTimer.getMicroseconds() - start;
+        }
+
+        reportProfile();
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::reportProfile()
+    {
+#if OGRE_PROFILING == 1
+        if (Profiler* profiler = Profiler::getSingletonPtr())
+        {
+            for (size_t i = 0; i < mPhases.size(); ++i)
+                profiler->addProfileSample(mPhases[i]->name, mPhases[i]->time, OGREPROF_GENERAL);
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    void TaskGraph::runPhase(void* userData, size_t index)
+    {
+        TaskGraph* graph = static_cast<TaskGraph*>(userData);
+        Phase* phase = graph->mPhases[index];
+
+        uint64 start = graph->mTimer.getMicroseconds();
+        {
+            OgreProfileTrace(phase->name);
+            (*phase->func)();
+        }
+        phase->time = graph->mTimer.getMicroseconds() - start;
+
+        // the last finished dependency starts a phase; the group still counts us, so it can't finish early
+        for (size_t d = 0; d < phase->dependents.size(); ++d)
+        {
+            Phase* dependent = graph->mPhases[phase->dependents[d]];
+            if (dependent->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                graph->mGroup->submit(&dependent->task);
+        }
+    }
+}
@@ -0,0 +1,460 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreTaskScheduler.h"
+
+namespace Ogre
+{
+    struct TaskScheduler::Worker
+    {
+        TaskScheduler* scheduler;
+        WorkStealingDeque deque;
+        /// State of the random victim selection
+        uint32 random;
+#if OGRE_THREAD_SUPPORT
+        std::thread thread;
+#endif
+    };
+
+    namespace
+    {
+        /// Worker running on the calling thread, if any. Not a member, as exported classes can't have thread local data.
+        thread_local void* currentWorker = 0;
+
+        const int64 INITIAL_DEQUE_SIZE = 256;
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::WorkStealingDeque::WorkStealingDeque()
+        : mTop(0), mBottom(0)
+    {
+        Buffer* buffer = OGRE_NEW_T(Buffer, MEMCATEGORY_GENERAL);
+        buffer->mask = INITIAL_DEQUE_SIZE - 1;
+        buffer->slots = OGRE_NEW_ARRAY_T(std::atomic<Task*>, INITIAL_DEQUE_SIZE, MEMCATEGORY_GENERAL);
+        buffer->retired = 0;
+        mBuffer.store(buffer, std::memory_order_relaxed);
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::WorkStealingDeque::~WorkStealingDeque()
+    {
+        Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+        while (buffer)
+        {
+            Buffer* retired = buffer->retired;
+            OGRE_DELETE_ARRAY_T(buffer->slots, std::atomic<Task*>, buffer->mask + 1, MEMCATEGORY_GENERAL);
+            OGRE_DELETE_T(buffer, Buffer, MEMCATEGORY_GENERAL);
+            buffer = retired;
+        }
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::WorkStealingDeque::push(Task* task)
+    {
+        int64 bottom = mBottom.load(std::memory_order_relaxed);
+        int64 top = mTop.load(std::memory_order_acquire);
+        Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->mask)
+            buffer = grow(buffer, bottom, top);
+        buffer->slots[bottom & buffer->mask].store(task, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::Task* TaskScheduler::WorkStealingDeque::pop()
+    {
+        int64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 top = mTop.load(std::memory_order_relaxed);
+
+        Task* task = 0;
+        if (top <= bottom)
+        {
+            task = buffer->slots[bottom & buffer->mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // last task, race against the thieves
+                if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    task = 0;
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::Task* TaskScheduler::WorkStealingDeque::steal()
+    {
+        int64 top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 bottom = mBottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return 0;
+
+        Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+        Task* task = buffer->slots[top & buffer->mask].load(std::memory_order_relaxed);
+        if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return 0; // lost the race, the caller will look again
+        return task;
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::WorkStealingDeque::Buffer* TaskScheduler::WorkStealingDeque::grow(Buffer* buffer, int64 bottom, int64 top)
+    {
+        Buffer* grown = OGRE_NEW_T(Buffer, MEMCATEGORY_GENERAL);
+        grown->mask = buffer->mask * 2 + 1;
+        grown->slots = OGRE_NEW_ARRAY_T(std::atomic<Task*>, grown->mask + 1, MEMCATEGORY_GENERAL);
+        for (int64 i = top; i < bottom; ++i)
+            grown->slots[i & grown->mask].store(buffer->slots[i & buffer->mask].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // thieves may still read the old buffer, so it lives as long as the deque
+        grown->retired = buffer;
+        mBuffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    TaskScheduler::TaskScheduler(const String& name)
+        : mName(name)
+        , mListener(0)
+        , mShuttingDown(false)
+        , mPendingTasks(0)
+#if OGRE_THREAD_SUPPORT
+        , mSleepingWorkers(0)
+#endif
+    {
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::~TaskScheduler()
+    {
+        shutdown();
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler* TaskScheduler::getDefault()
+    {
+        Root* root = Root::getSingletonPtr();
+        return root ? root->getTaskScheduler() : 0;
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::startup(size_t workerCount, Listener* listener)
+    {
+        shutdown();
+
+        mListener = listener;
+        mShuttingDown.store(false);
+#if OGRE_THREAD_SUPPORT
+        // create all workers before starting any, so they can steal from each other right away
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            Worker* worker = OGRE_NEW_T(Worker, MEMCATEGORY_GENERAL)();
+            worker->scheduler = this;
+            worker->random = static_cast<uint32>(i * 2654435761u + 1);
+            mWorkers.push_back(worker);
+        }
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+            mWorkers[i]->thread = std::thread(&TaskScheduler::workerMain, this, mWorkers[i]);
+#else
+        (void)workerCount;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::shutdown()
+    {
+#if OGRE_THREAD_SUPPORT
+        if (mWorkers.empty())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mShuttingDown.store(true);
+            mSleepCondition.notify_all();
+        }
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+            mWorkers[i]->thread.join();
+
+        // keep the tasks, which didn't start yet, so whoever waits for them can still run them
+        std::lock_guard<std::mutex> lock(mInjectedMutex);
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+        {
+            while (Task* task = mWorkers[i]->deque.pop())
+                mInjected.push_back(task);
+            OGRE_DELETE_T(mWorkers[i], Worker, MEMCATEGORY_GENERAL);
+        }
+        mWorkers.clear();
+#endif
+    }
+    //---------------------------------------------------------------------
+    bool TaskScheduler::isWorkerThread() const
+    {
+        Worker* worker = static_cast<Worker*>(currentWorker);
+        return worker && worker->scheduler == this;
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::submit(Task* task)
+    {
+        if (isWorkerThread())
+        {
+            static_cast<Worker*>(currentWorker)->deque.push(task);
+        }
+        else
+        {
+#if OGRE_THREAD_SUPPORT
+            std::lock_guard<std::mutex> lock(mInjectedMutex);
+#endif
+            mInjected.push_back(task);
+        }
+        // count after the task is visible, a worker seeing the count must be able to find it
+        mPendingTasks.fetch_add(1);
+        wakeWorker();
+    }
+    //---------------------------------------------------------------------
+    bool TaskScheduler::runPendingTask()
+    {
+        Task* task = takeTask(isWorkerThread() ? static_cast<Worker*>(currentWorker) : 0);
+        if (!task)
+            return false;
+        execute(task);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::Task* TaskScheduler::takeTask(Worker* self)
+    {
+        if (mPendingTasks.load(std::memory_order_relaxed) == 0)
+            return 0;
+
+        Task* task = self ? self->deque.pop() : 0;
+        if (!task)
+        {
+#if OGRE_THREAD_SUPPORT
+            std::lock_guard<std::mutex> lock(mInjectedMutex);
+#endif
+            if (!mInjected.empty())
+            {
+                task = mInjected.front();
+                mInjected.pop_front();
+            }
+        }
+        if (!task && !mWorkers.empty())
+        {
+            // start at a random victim, so the thieves spread over the workers
+            uint32 start = 0;
+            if (self)
+            {
+                self->random ^= self->random << 13;
+                self->random ^= self->random >> 17;
+                self->random ^= self->random << 5;
+                start = self->random;
+            }
+            for (size_t i = 0; i < mWorkers.size() && !task; ++i)
+            {
+                Worker* victim = mWorkers[(start + i) % mWorkers.size()];
+                if (victim != self)
+                    task = victim->deque.steal();
+            }
+        }
+        if (task)
+            mPendingTasks.fetch_sub(1);
+        return task;
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::execute(Task* task)
+    {
+        // the task may be gone once its group is notified
+        TaskGroup* group = task->group;
+        try
+        {
+            OgreProfileTrace("Task");
+            task->func(task->userData, task->index);
+        }
+        catch (...)
+        {
+            if (group)
+                group->setError(std::current_exception());
+            else if (LogManager::getSingletonPtr())
+                LogManager::getSingleton().stream(LML_CRITICAL)
+                    << "TaskScheduler('" << mName << "') - exception in a task without group";
+        }
+        if (group)
+            group->finishTask();
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::wakeWorker()
+    {
+#if OGRE_THREAD_SUPPORT
+        if (mSleepingWorkers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mSleepCondition.notify_one();
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::workerMain(Worker* self)
+    {
+#if OGRE_THREAD_SUPPORT
+        currentWorker = self;
+#if OGRE_PROFILING == 1
+        Profiler::setCurrentThreadName(mName + " worker " +
+            StringConverter::toString(std::find(mWorkers.begin(), mWorkers.end(), self) - mWorkers.begin()));
+#endif
+        if (mListener)
+            mListener->workerStarted(this);
+
+        while (!mShuttingDown.load())
+        {
+            if (Task* task = takeTask(self))
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            // announce the sleep before the last check, so submit either sees us or we see its task
+            mSleepingWorkers.fetch_add(1);
+            while (mPendingTasks.load() == 0 && !mShuttingDown.load())
+                mSleepCondition.wait(lock);
+            mSleepingWorkers.fetch_sub(1);
+        }
+
+        if (mListener)
+            mListener->workerStopped(this);
+        currentWorker = 0;
+#else
+        (void)self;
+#endif
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    TaskGroup::TaskGroup(TaskScheduler* scheduler)
+        : mScheduler(scheduler ? scheduler : TaskScheduler::getDefault())
+        , mPendingTasks(0)
+    {
+    }
+    //---------------------------------------------------------------------
+    TaskGroup::~TaskGroup()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+            // nobody asked for the result
+        }
+        for (size_t i = 0; i < mFunctions.size(); ++i)
+            OGRE_DELETE_T(mFunctions[i], Callable, MEMCATEGORY_GENERAL);
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::Task& TaskGroup::allocateTask()
+    {
+        // deque keeps the references valid while growing
+        mTasks.push_back(TaskScheduler::Task());
+        return mTasks.back();
+    }
+    //---------------------------------------------------------------------
+    void TaskGroup::submit(TaskScheduler::Task* task)
+    {
+        task->group = this;
+        mPendingTasks.fetch_add(1, std::memory_order_relaxed);
+        if (mScheduler)
+        {
+            mScheduler->submit(task);
+            return;
+        }
+
+        // no scheduler, run in place
+        try
+        {
+            task->func(task->userData, task->index);
+        }
+        catch (...)
+        {
+            setError(std::current_exception());
+        }
+        finishTask();
+    }
+    //---------------------------------------------------------------------
+    void TaskGroup::wait()
+    {
+        while (mPendingTasks.load(std::memory_order_acquire) != 0)
+        {
+            // help instead of blocking, the tasks we wait for may be queued behind us
+            if (mScheduler->runPendingTask())
+                continue;
+#if OGRE_THREAD_SUPPORT
+            // nothing left to take, the rest of the group runs on other threads
+            std::unique_lock<std::mutex> lock(mFinishedMutex);
+            mFinishedCondition.wait(lock, [this] { return mPendingTasks.load(std::memory_order_acquire) == 0; });
+#endif
+        }
+#if OGRE_THREAD_SUPPORT
+        // the last finishTask may still be notifying, don't let the caller destroy the group under it
+        { std::lock_guard<std::mutex> lock(mFinishedMutex); }
+#endif
+
+        if (mError)
+        {
+            std::exception_ptr error = mError;
+            mError = std::exception_ptr();
+            std::rethrow_exception(error);
+        }
+    }
+    //---------------------------------------------------------------------
+    void TaskGroup::finishTask()
+    {
+#if OGRE_THREAD_SUPPORT
+        size_t pending = mPendingTasks.load(std::memory_order_relaxed);
+        while (pending > 1)
+        {
+            if (mPendingTasks.compare_exchange_weak(pending, pending - 1, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+                return;
+        }
+        // the last task finishes under the lock, so a sleeping wait() can't miss it
+        std::lock_guard<std::mutex> lock(mFinishedMutex);
+        mPendingTasks.fetch_sub(1, std::memory_order_release);
+        mFinishedCondition.notify_all();
+#else
+        mPendingTasks.fetch_sub(1, std::memory_order_release);
+#endif
+    }
+    //---------------------------------------------------------------------
+    void TaskGroup::setError(std::exception_ptr error)
+    {
+#if OGRE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(mErrorMutex);
+#endif
+        if (!mError)
+            mError = error;
+    }
+    //---------------------------------------------------------------------
+    void TaskGroup::runCallable(void* userData, size_t)
+    {
+        (*static_cast<Callable*>(userData))();
+    }
+}
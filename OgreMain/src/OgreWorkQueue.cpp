@@ -43,8 +43,129 @@ namespace Ogre {
         return i->second;
     }
     //---------------------------------------------------------------------
-    WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
+    WorkQueue::RequestID WorkQueue::addPrioritisedRequest(uint16 channel, uint16 requestType, const Any& rData,
+        uint8 priority, unsigned long deadline, const CancellationTokenPtr& cancellation, uint8 retryCount)
+    {
+        (void)priority;
+        (void)deadline;
+        (void)cancellation;
+        return addRequest(channel, requestType, rData, retryCount);
+    }
+    //---------------------------------------------------------------------
+    bool WorkQueue::setRequestPriority(RequestID id, uint8 priority)
+    {
+        (void)id;
+        (void)priority;
+        return false;
+    }
+    //---------------------------------------------------------------------
+    namespace
+    {
+        /// Order of the request queue, by priority, then earliest deadline
+        bool isProcessedBefore(const WorkQueue::Request* a, const WorkQueue::Request* b)
+        {
+            if (a->getPriority() != b->getPriority())
+                return a->getPriority() > b->getPriority();
+            // no deadline is the latest one
+            return a->getDeadline() - 1 < b->getDeadline() - 1;
+        }
+
+        /** Recycles the memory of requests and responses.
+        @remarks
+            Every thread keeps a small list of free blocks. A full list hands a batch
+            to a shared depot and an empty one takes a batch back, so the lock is only
+            taken once per batch. Requests are usually created and destroyed on the main
+            thread, responses are created by the workers and destroyed on the main thread.
+        */
+        template<size_t BlockSize>
+        class BlockPool
+        {
+        public:
+            static void* allocate()
+            {
+                std::vector<void*>& blocks = getCache().blocks;
+                if (blocks.empty())
+                    getDepot().take(blocks);
+                if (blocks.empty())
+                    return OGRE_MALLOC(BlockSize, MEMCATEGORY_GENERAL);
+                void* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+
+            static void deallocate(void* block)
+            {
+                std::vector<void*>& blocks = getCache().blocks;
+                blocks.push_back(block);
+                if (blocks.size() >= 2 * BATCH_SIZE)
+                    getDepot().give(blocks);
+            }
+
+        private:
+            static const size_t BATCH_SIZE = 32;
+            static const size_t MAX_DEPOT_SIZE = 64 * BATCH_SIZE;
+
+            static void free(void* block) { OGRE_FREE(block, MEMCATEGORY_GENERAL); }
+
+            struct Cache
+            {
+                std::vector<void*> blocks;
+                ~Cache() { std::for_each(blocks.begin(), blocks.end(), &BlockPool::free); }
+            };
+
+            struct Depot
+            {
+                OGRE_WQ_MUTEX(mutex);
+                std::vector<void*> blocks;
+
+                ~Depot() { std::for_each(blocks.begin(), blocks.end(), &BlockPool::free); }
+
+                void take(std::vector<void*>& cache)
+                {
+                        OGRE_WQ_LOCK_MUTEX(mutex);
+                    size_t count = std::min(BATCH_SIZE, blocks.size());
+                    cache.insert(cache.end(), blocks.end() - count, blocks.end());
+                    blocks.resize(blocks.size() - count);
+                }
+
+                void give(std::vector<void*>& cache)
+                {
+                    {
+                            OGRE_WQ_LOCK_MUTEX(mutex);
+                        if (blocks.size() < MAX_DEPOT_SIZE)
+                        {
+                            blocks.insert(blocks.end(), cache.end() - BATCH_SIZE, cache.end());
+                            cache.resize(cache.size() - BATCH_SIZE);
+                            return;
+                        }
+                    }
+                    // depot full, the queue must have had a burst
+                    std::for_each(cache.end() - BATCH_SIZE, cache.end(), &BlockPool::free);
+                    cache.resize(cache.size() - BATCH_SIZE);
+                }
+            };
+
+            static Cache& getCache()
+            {
+                static thread_local Cache cache;
+                return cache;
+            }
+
+            static Depot& getDepot()
+            {
+                static Depot depot;
+                return depot;
+            }
+        };
+
+        typedef BlockPool<sizeof(WorkQueue::Request)> RequestPool;
+        typedef BlockPool<sizeof(WorkQueue::Response)> ResponsePool;
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid,
+                                uint8 priority, unsigned long deadline, const CancellationTokenPtr& cancellation)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
+        , mPriority(priority), mDeadline(deadline), mCancellation(cancellation)
     {
 
     }
@@ -52,6 +173,24 @@ namespace Ogre {
     WorkQueue::Request::~Request()
     {
 
+    }
+    //---------------------------------------------------------------------
+    void* WorkQueue::Request::operator new(size_t sz)
+    {
+        // derived classes are bigger than the pooled blocks
+        if (sz != sizeof(Request))
+            return OGRE_MALLOC(sz, MEMCATEGORY_GENERAL);
+        return RequestPool::allocate();
+    }
+    //---------------------------------------------------------------------
+    void WorkQueue::Request::operator delete(void* ptr, size_t sz)
+    {
+        if (!ptr)
+            return;
+        if (sz != sizeof(Request))
+            OGRE_FREE(ptr, MEMCATEGORY_GENERAL);
+        else
+            RequestPool::deallocate(ptr);
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -66,6 +205,23 @@ namespace Ogre {
         OGRE_DELETE mRequest;
     }
     //---------------------------------------------------------------------
+    void* WorkQueue::Response::operator new(size_t sz)
+    {
+        if (sz != sizeof(Response))
+            return OGRE_MALLOC(sz, MEMCATEGORY_GENERAL);
+        return ResponsePool::allocate();
+    }
+    //---------------------------------------------------------------------
+    void WorkQueue::Response::operator delete(void* ptr, size_t sz)
+    {
+        if (!ptr)
+            return;
+        if (sz != sizeof(Response))
+            OGRE_FREE(ptr, MEMCATEGORY_GENERAL);
+        else
+            ResponsePool::deallocate(ptr);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     DefaultWorkQueueBase::DefaultWorkQueueBase(const String& name)
         : mName(name)
@@ -142,7 +298,10 @@ namespace Ogre {
             }
         }
         if (!duplicate)
+        {
             handlers.push_back(RequestHandlerHolderPtr(OGRE_NEW RequestHandlerHolder(rh)));
+            updateRequestHandlerSnapshot();
+        }
 
     }
     //---------------------------------------------------------------------
@@ -162,6 +321,7 @@ namespace Ogre {
                     // this is threadsafe and will wait for existing processes to finish
                     (*j)->disconnectHandler();
                     handlers.erase(j);  
+                    updateRequestHandlerSnapshot();
                     break;
                 }
             }
@@ -195,6 +355,22 @@ namespace Ogre {
     //---------------------------------------------------------------------
     WorkQueue::RequestID DefaultWorkQueueBase::addRequest(uint16 channel, uint16 requestType, 
         const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+    {
+        return addRequestImpl(channel, requestType, rData, retryCount, forceSynchronous, idleThread,
+                              RP_NORMAL, 0, CancellationTokenPtr());
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID DefaultWorkQueueBase::addPrioritisedRequest(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 priority, unsigned long deadline, const CancellationTokenPtr& cancellation,
+        uint8 retryCount)
+    {
+        return addRequestImpl(channel, requestType, rData, retryCount, false, false,
+                              priority, deadline, cancellation);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID DefaultWorkQueueBase::addRequestImpl(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread,
+        uint8 priority, unsigned long deadline, const CancellationTokenPtr& cancellation)
     {
         Request* req = 0;
         RequestID rid = 0;
@@ -207,7 +383,7 @@ namespace Ogre {
                 return 0;
 
             rid = ++mRequestCount;
-            req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+            req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, priority, deadline, cancellation);
 
             LogManager::getSingleton().stream(LML_TRIVIAL) << 
                 "DefaultWorkQueueBase('" << mName << "') - QUEUED(thread:" <<
@@ -217,7 +393,7 @@ namespace Ogre {
 #if OGRE_THREAD_SUPPORT
             if (!forceSynchronous&& !idleThread)
             {
-                mRequestQueue.push_back(req);
+                queueRequest(req);
                 notifyWorkers();
                 return rid;
             }
@@ -238,7 +414,8 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestWithRID(WorkQueue::RequestID rid, uint16 channel, 
-        uint16 requestType, const Any& rData, uint8 retryCount)
+        uint16 requestType, const Any& rData, uint8 retryCount,
+        uint8 priority, unsigned long deadline, const CancellationTokenPtr& cancellation)
     {
         // lock to push request to the queue
             OGRE_WQ_LOCK_MUTEX(mRequestMutex);
@@ -246,7 +423,7 @@ namespace Ogre {
         if (mShuttingDown)
             return;
 
-        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, priority, deadline, cancellation);
 
         LogManager::getSingleton().stream(LML_TRIVIAL) << 
             "DefaultWorkQueueBase('" << mName << "') - REQUEUED(thread:" <<
@@ -254,13 +431,46 @@ namespace Ogre {
             << "): ID=" << rid
                    << " channel=" << channel << " requestType=" << requestType;
 #if OGRE_THREAD_SUPPORT
-        mRequestQueue.push_back(req);
+        queueRequest(req);
         notifyWorkers();
 #else
         processRequestResponse(req, true);
 #endif
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::queueRequest(Request* req)
+    {
+        // behind all requests, which are not processed after it, so equal ones stay in order
+        mRequestQueue.insert(std::upper_bound(mRequestQueue.begin(), mRequestQueue.end(), req, isProcessedBefore), req);
+    }
+    //---------------------------------------------------------------------
+    bool DefaultWorkQueueBase::isExpired(const Request* req)
+    {
+        Root* root = Root::getSingletonPtr();
+        return req->getDeadline() && root && root->getTimer()->getMilliseconds() > req->getDeadline();
+    }
+    //---------------------------------------------------------------------
+    bool DefaultWorkQueueBase::setRequestPriority(RequestID id, uint8 priority)
+    {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+
+        for (RequestQueue::iterator i = mRequestQueue.begin(); i != mRequestQueue.end(); ++i)
+        {
+            if ((*i)->getID() == id)
+            {
+                Request* req = *i;
+                if (req->mPriority != priority)
+                {
+                    mRequestQueue.erase(i);
+                    req->mPriority = priority;
+                    queueRequest(req);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::abortRequest(RequestID id)
     {
             OGRE_WQ_LOCK_MUTEX(mProcessMutex);
@@ -518,6 +728,9 @@ namespace Ogre {
 
         if (request)
         {
+            // too late to be of use, the handlers will skip it
+            if (isExpired(request))
+                request->abortRequest();
             processRequestResponse(request, false);
         }
 
@@ -549,10 +762,11 @@ namespace Ogre {
             {
                 // Failed, should we retry?
                 const Request* req = response->getRequest();
-                if (req->getRetryCount())
+                if (req->getRetryCount() && !req->getAborted())
                 {
                     addRequestWithRID(req->getID(), req->getChannel(), req->getType(), req->getData(), 
-                        req->getRetryCount() - 1);
+                        req->getRetryCount() - 1, req->getPriority(), req->getDeadline(),
+                        req->getCancellationToken());
                     // discard response (this also deletes request)
                     OGRE_DELETE response;
                     return;
@@ -570,9 +784,13 @@ namespace Ogre {
                     // destroy response user data
                     response->abortRequest();
                 }
-                // Queue response
+                // Queue response, results of important requests are handled first
                 OGRE_WQ_LOCK_MUTEX(mResponseMutex);
-                mResponseQueue.push_back(response);
+                ResponseQueue::iterator pos = mResponseQueue.end();
+                while (pos != mResponseQueue.begin() &&
+                       (*(pos - 1))->getRequest()->getPriority() < response->getRequest()->getPriority())
+                    --pos;
+                mResponseQueue.insert(pos, response);
                 // no need to wake thread, this is processed by the main thread
             }
 
@@ -631,17 +849,26 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::updateRequestHandlerSnapshot()
+    {
+        // caller holds the write lock; requests in flight keep the previous copy alive
+        mRequestHandlerSnapshot.reset(OGRE_NEW_T(RequestHandlerListByChannel, MEMCATEGORY_GENERAL)(mRequestHandlers));
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Response* DefaultWorkQueueBase::processRequest(Request* r)
     {
-        RequestHandlerListByChannel handlerListCopy;
+        SharedPtr<const RequestHandlerListByChannel> handlerListCopy;
         {
-            // lock the list only to make a copy of it, to maximise parallelism
+            // lock the list only to take the current copy of it, to maximise parallelism
                     OGRE_WQ_LOCK_RW_MUTEX_READ(mRequestHandlerMutex);
             
-            handlerListCopy = mRequestHandlers;
+            handlerListCopy = mRequestHandlerSnapshot;
             
         }
+        if (!handlerListCopy)
+            return 0;
 
+        OgreProfileTrace("WorkQueue request");
         Response* response = 0;
 
         StringStream dbgMsg;
@@ -653,11 +880,11 @@ namespace Ogre {
         LogManager::getSingleton().stream(LML_TRIVIAL) << 
             "DefaultWorkQueueBase('" << mName << "') - PROCESS_REQUEST_START(" << dbgMsg.str();
 
-        RequestHandlerListByChannel::iterator i = handlerListCopy.find(r->getChannel());
-        if (i != handlerListCopy.end())
+        RequestHandlerListByChannel::const_iterator i = handlerListCopy->find(r->getChannel());
+        if (i != handlerListCopy->end())
         {
-            RequestHandlerList& handlers = i->second;
-            for (RequestHandlerList::reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
+            const RequestHandlerList& handlers = i->second;
+            for (RequestHandlerList::const_reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
             {
                 // threadsafe call which tests canHandleRequest and calls it if so 
                 response = (*j)->handleRequest(r, this);
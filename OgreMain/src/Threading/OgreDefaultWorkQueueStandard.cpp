@@ -31,8 +31,12 @@ namespace Ogre
 {
     //---------------------------------------------------------------------
     DefaultWorkQueue::DefaultWorkQueue(const String& name)
-    : DefaultWorkQueueBase(name), mNumThreadsRegisteredWithRS(0)
+    : DefaultWorkQueueBase(name), mNumThreadsRegisteredWithRS(0), mScheduler(name)
     {
+        mProcessTask.func = &DefaultWorkQueue::processNextRequestTask;
+        mProcessTask.userData = this;
+        mProcessTask.index = 0;
+        mProcessTask.group = 0;
     }
     //---------------------------------------------------------------------
     DefaultWorkQueue::~DefaultWorkQueue()
@@ -52,8 +56,6 @@ namespace Ogre
 
         mShuttingDown = false;
 
-        mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
-
         LogManager::getSingleton().stream() <<
             "DefaultWorkQueue('" << mName << "') initialising on thread " <<
             OGRE_THREAD_CURRENT_ID
@@ -64,11 +66,7 @@ namespace Ogre
             Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
 
         mNumThreadsRegisteredWithRS = 0;
-        for (size_t i = 0; i < mWorkerThreadCount; ++i)
-        {
-            OGRE_THREAD_CREATE(t, *mWorkerFunc);
-            mWorkers.push_back(t);
-        }
+        mScheduler.startup(mWorkerThreadCount, this);
 
         if (mWorkerRenderSystemAccess)
         {
@@ -80,6 +78,13 @@ namespace Ogre
             Root::getSingleton().getRenderSystem()->postExtraThreadsStarted();
 
         }
+
+        // requests added while we were stopped have no task yet
+        {
+                OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            for (size_t i = 0; i < mRequestQueue.size(); ++i)
+                mScheduler.submit(&mProcessTask);
+        }
 #endif
 
         mIsRunning = true;
@@ -109,30 +114,50 @@ namespace Ogre
         mShuttingDown = true;
         abortAllRequests();
 #if OGRE_THREAD_SUPPORT
-        // wake all threads (they should check shutting down as first thing after wait)
+        // wake threads running _threadMain (they should check shutting down as first thing after wait)
         OGRE_THREAD_NOTIFY_ALL(mRequestCondition);
 
-        // all our threads should have been woken now, so join
-        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
-        {
-            (*i)->join();
-            OGRE_THREAD_DESTROY(*i);
-        }
-        mWorkers.clear();
+        // tasks left over find an empty queue, so the scheduler can keep them
+        mScheduler.shutdown();
 #endif
 
-        OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
-        mWorkerFunc = 0;
-
         mIsRunning = false;
     }
     //---------------------------------------------------------------------
     void DefaultWorkQueue::notifyWorkers()
     {
+        // one task per request, the workers of a stopped queue get theirs on startup
+        if (mScheduler.getWorkerCount() > 0)
+            mScheduler.submit(&mProcessTask);
         // wake up waiting thread
             OGRE_THREAD_NOTIFY_ONE(mRequestCondition);
     }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueue::processNextRequestTask(void* userData, size_t)
+    {
+        static_cast<DefaultWorkQueue*>(userData)->_processNextRequest();
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueue::workerStarted(TaskScheduler*)
+    {
+        LogManager::getSingleton().stream() << 
+            "DefaultWorkQueue('" << getName() << "')::WorkerFunc - thread " 
+            << OGRE_THREAD_CURRENT_ID << " starting.";
 
+        // Initialise the thread for RS if necessary
+        if (mWorkerRenderSystemAccess)
+        {
+            Root::getSingleton().getRenderSystem()->registerThread();
+            notifyThreadRegistered();
+        }
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueue::workerStopped(TaskScheduler*)
+    {
+        LogManager::getSingleton().stream() << 
+            "DefaultWorkQueue('" << getName() << "')::WorkerFunc - thread " 
+            << OGRE_THREAD_CURRENT_ID << " stopped.";
+    }
     //---------------------------------------------------------------------
     void DefaultWorkQueue::waitForNextRequest()
     {
@@ -154,29 +179,14 @@ namespace Ogre
     //---------------------------------------------------------------------
     void DefaultWorkQueue::_threadMain()
     {
-        // default worker thread
+        // thread driven by the user
 #if OGRE_THREAD_SUPPORT
-        LogManager::getSingleton().stream() << 
-            "DefaultWorkQueue('" << getName() << "')::WorkerFunc - thread " 
-            << OGRE_THREAD_CURRENT_ID << " starting.";
-
-        // Initialise the thread for RS if necessary
-        if (mWorkerRenderSystemAccess)
-        {
-            Root::getSingleton().getRenderSystem()->registerThread();
-            notifyThreadRegistered();
-        }
-
         // Spin forever until we're told to shut down
         while (!isShuttingDown())
         {
             waitForNextRequest();
             _processNextRequest();
         }
-
-        LogManager::getSingleton().stream() << 
-            "DefaultWorkQueue('" << getName() << "')::WorkerFunc - thread " 
-            << OGRE_THREAD_CURRENT_ID << " stopped.";
 #endif
     }
 
@@ -130,6 +130,12 @@ namespace Ogre {
         */
         int getFaceGroupStart(void) const;
 
+        /** Returns the cluster of the Potentially Visible Set this leaf is in, -1 if none.
+            Leaves in the same cluster see the same other leaves.
+            Should only be called on a leaf node.
+        */
+        int getVisCluster(void) const { return mVisCluster; }
+
         /** Determines if the passed in node (must also be a leaf) is visible from this leaf.
             Must only be called on a leaf node, and the parameter must also be a leaf node. If
             this method returns true, then the leaf passed in is visible from this leaf.
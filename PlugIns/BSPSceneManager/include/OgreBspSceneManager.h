@@ -74,15 +74,35 @@ namespace Ogre {
         BspLevelPtr mLevel;
 
         // State variables for rendering WIP
-        // Set of face groups (by index) already included
-        typedef std::set<int> FaceGroupSet;
-        FaceGroupSet mFaceGroupSet;
+        // Flags of the face groups (by index) already included
+        std::vector<bool> mFaceGroupIncluded;
         // Material -> face group hashmap
         typedef std::map<Material*, std::vector<StaticFaceGroup*>, materialLess > MaterialFaceGroupMap;
         MaterialFaceGroupMap mMatFaceGroupMap;
 
+        // Leaves in the PVS of mPvsCluster, which only change when the camera enters another cluster
+        std::vector<BspNode*> mPvsLeaves;
+        int mPvsCluster;
+        bool mPvsLeavesValid;
+
+        // Frustum visible leaves and their face groups gathered from a batch of mPvsLeaves
+        static const size_t GATHER_BATCH_SIZE = 64;
+        struct LeafBatch
+        {
+            std::vector<BspNode*> visibleLeaves;
+            std::vector<std::pair<int, Material*> > faceGroups;
+        };
+        std::vector<LeafBatch> mLeafBatches;
+
         RenderOperation mRenderOp;
 
+        // Face groups the index buffer holds, in rendering order
+        std::vector<StaticFaceGroup*> mCachedFaceGroups;
+        // Face groups to render this time, in rendering order
+        std::vector<StaticFaceGroup*> mFrameFaceGroups;
+        // Start and count of the indexes of each material of mMatFaceGroupMap in the index buffer
+        std::vector<std::pair<size_t, size_t> > mMaterialIndexRanges;
+
         // Debugging features
         bool mShowNodeAABs;
         RenderOperation mAABGeometry;
@@ -94,13 +114,22 @@ namespace Ogre {
             @return The BSP node the camera was found in, for info.
         */
         BspNode* walkTree(Camera* camera, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
-        /** Tags geometry in the leaf specified for later rendering. */
+        /** Checks a batch of mPvsLeaves against the frustum and collects the face groups of
+            the visible ones. Only reads shared state, so batches are gathered in parallel.
+        */
+        void gatherLeafBatch(size_t batch, const Camera* cam, bool onlyShadowCasters);
+        /** Adds the movables of a visible leaf to the render queue.
+            Its face groups are tagged by walkTree.
+        */
         void processVisibleLeaf(BspNode* leaf, Camera* cam, 
             VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
 
         /** Caches a face group for imminent rendering. */
         unsigned int cacheGeometry(unsigned int* pIndexes, const StaticFaceGroup* faceGroup);
 
+        /** Writes the indexes of the tagged face groups into the index buffer. */
+        void cacheIndexes(void);
+
         /** Frees up allocated memory for geometry caches. */
         void freeMemory(void);
 
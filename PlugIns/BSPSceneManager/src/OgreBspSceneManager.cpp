@@ -44,14 +44,27 @@ THE SOFTWARE.
 #include "OgrePass.h"
 #include "OgreMaterialManager.h"
 #include "OgreSceneLoaderManager.h"
+#include "OgreTaskScheduler.h"
 
 #include <fstream>
 
 namespace Ogre {
-
+    namespace {
+        /// Most indexes a face group can take in the index buffer
+        size_t getMaxIndexCount(const StaticFaceGroup& faceGroup)
+        {
+            if (faceGroup.isSky)
+                return 0;
+            if (faceGroup.fType == FGT_FACE_LIST)
+                return faceGroup.numElements;
+            if (faceGroup.fType == FGT_PATCH)
+                return faceGroup.patchSurf->getRequiredIndexCount();
+            return 0;
+        }
+    }
     //-----------------------------------------------------------------------
     BspSceneManager::BspSceneManager(const String& name)
-        : SceneManager(name)
+        : SceneManager(name), mPvsCluster(-1), mPvsLeavesValid(false)
     {
         // Set features for debugging render
         mShowNodeAABs = false;
@@ -126,12 +139,19 @@ namespace Ogre {
         mRenderOp.indexData = OGRE_NEW IndexData();
         mRenderOp.indexData->indexStart = 0;
         mRenderOp.indexData->indexCount = 0;
-        // Create enough index space to render whole level
+        // Create enough index space to render whole level, each face group
+        // is rendered at most once
+        size_t maxIndexes = 1;
+        for (int i = 0; i < mLevel->mNumFaceGroups; ++i)
+            maxIndexes += getMaxIndexCount(mLevel->mFaceGroups[i]);
         mRenderOp.indexData->indexBuffer = HardwareBufferManager::getSingleton()
             .createIndexBuffer(
                 HardwareIndexBuffer::IT_32BIT, // always 32-bit
-                mLevel->mNumIndexes, 
-                HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, false);
+                maxIndexes, 
+                HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY, false);
+        mCachedFaceGroups.clear();
+        mMaterialIndexRanges.clear();
+        mPvsLeavesValid = false;
 
         mRenderOp.operationType = RenderOperation::OT_TRIANGLE_LIST;
         mRenderOp.useIndexes = true;
@@ -173,37 +193,35 @@ namespace Ogre {
         if (!isRenderQueueToBeProcessed(mWorldGeometryRenderQueue))
             return;
 
-        // Cache vertex/face data first
-        std::vector<StaticFaceGroup*>::const_iterator faceGrpi;
-        static RenderOperation patchOp;
-        
         mAutoParamDataSource->setCurrentRenderable(0);
         // no world transform required
         mAutoParamDataSource->setWorldMatrices(&Affine3::IDENTITY, 1);
 
-        // For each material in turn, cache rendering data & render
         MaterialFaceGroupMap::const_iterator mati;
 
+        // The index data only changes with the tagged faces, which mostly stay the same
+        // from frame to frame, so only write it if they differ from the cached ones
+        mFrameFaceGroups.clear();
         for (mati = mMatFaceGroupMap.begin(); mati != mMatFaceGroupMap.end(); ++mati)
+        {
+            mFrameFaceGroups.insert(mFrameFaceGroups.end(), mati->second.begin(), mati->second.end());
+        }
+        if (mFrameFaceGroups != mCachedFaceGroups ||
+            mMaterialIndexRanges.size() != mMatFaceGroupMap.size())
+        {
+            cacheIndexes();
+            mCachedFaceGroups.swap(mFrameFaceGroups);
+        }
+
+        // For each material in turn, render the cached data
+        size_t materialIndex = 0;
+        for (mati = mMatFaceGroupMap.begin(); mati != mMatFaceGroupMap.end(); ++mati, ++materialIndex)
         {
             // Get Material
             Material* thisMaterial = mati->first;
             thisMaterial->touch();
-            // Empty existing cache
-            mRenderOp.indexData->indexCount = 0;
-            // lock index buffer ready to receive data
-            unsigned int* pIdx = static_cast<unsigned int*>(
-                mRenderOp.indexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
-
-            for (faceGrpi = mati->second.begin(); faceGrpi != mati->second.end(); ++faceGrpi)
-            {
-                // Cache each
-                unsigned int numelems = cacheGeometry(pIdx, *faceGrpi);
-                mRenderOp.indexData->indexCount += numelems;
-                pIdx += numelems;
-            }
-            // Unlock the buffer
-            mRenderOp.indexData->indexBuffer->unlock();
+            mRenderOp.indexData->indexStart = mMaterialIndexRanges[materialIndex].first;
+            mRenderOp.indexData->indexCount = mMaterialIndexRanges[materialIndex].second;
 
             // Skip if no faces to process (we're not doing flare types yet)
             if (mRenderOp.indexData->indexCount == 0)
@@ -230,6 +248,31 @@ namespace Ogre {
         */
     }
     //-----------------------------------------------------------------------
+    void BspSceneManager::cacheIndexes(void)
+    {
+        // Discard the whole buffer, the GPU may still read the previous indexes
+        unsigned int* pStart = static_cast<unsigned int*>(
+            mRenderOp.indexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+        unsigned int* pIdx = pStart;
+
+        mMaterialIndexRanges.clear();
+        MaterialFaceGroupMap::const_iterator mati;
+        for (mati = mMatFaceGroupMap.begin(); mati != mMatFaceGroupMap.end(); ++mati)
+        {
+            size_t start = pIdx - pStart;
+            std::vector<StaticFaceGroup*>::const_iterator faceGrpi;
+            for (faceGrpi = mati->second.begin(); faceGrpi != mati->second.end(); ++faceGrpi)
+            {
+                // Cache each
+                pIdx += cacheGeometry(pIdx, *faceGrpi);
+            }
+            mMaterialIndexRanges.push_back(std::make_pair(start, size_t(pIdx - pStart) - start));
+        }
+
+        // Unlock the buffer
+        mRenderOp.indexData->indexBuffer->unlock();
+    }
+    //-----------------------------------------------------------------------
     // REMOVE THIS CRAP
     //-----------------------------------------------------------------------
     // Temp debug lines
@@ -247,59 +290,65 @@ namespace Ogre {
         BspNode* cameraNode = mLevel->findLeaf(camera->getDerivedPosition());
 
         mMatFaceGroupMap.clear();
-        mFaceGroupSet.clear();
-
-        // Scan through all the other leaf nodes looking for visibles
-        int i = mLevel->mNumNodes - mLevel->mLeafStart;
-        BspNode* nd = mLevel->mRootNode + mLevel->mLeafStart;
+        mFaceGroupIncluded.assign(mLevel->mNumFaceGroups, false);
 
-        /*
-        if (firstTime)
+        // The PVS is the same for every leaf in a cluster, so only scan all the other
+        // leaf nodes when the camera enters another one
+        if (!mPvsLeavesValid || cameraNode->getVisCluster() != mPvsCluster)
         {
-            camera->getViewMatrix(); // Force update view before report
-            of.open("BspSceneManager.log");
-            of << *camera << std::endl;
-            of << "Camera Node: " << *cameraNode << std::endl;
-            of << "Vertex Data: " << std::endl;
-            for (int testi = 0; testi < mLevel->mNumVertices; ++testi)
+            mPvsLeaves.clear();
+            int i = mLevel->mNumNodes - mLevel->mLeafStart;
+            BspNode* nd = mLevel->mRootNode + mLevel->mLeafStart;
+            while (i--)
             {
-                of << " " << testi << ": pos(" <<
-                  mLevel->mVertices[testi].position[0] << ", " <<
-                    mLevel->mVertices[testi].position[1] << ", " << mLevel->mVertices[testi].position[2] << ")" <<
-                    " uv(" << mLevel->mVertices[testi].texcoords[0] << ", " << mLevel->mVertices[testi].texcoords[1] << ")" <<
-                    " lm(" << mLevel->mVertices[testi].lightmap[0] << ", " << mLevel->mVertices[testi].lightmap[1] << ")" << std::endl;
-            }
-            of << "Element data:" << std::endl;
-            for (testi = 0; testi < mLevel->mNumElements; ++testi)
-            {
-                of << " " << testi << ": " << mLevel->mElements[testi] << std::endl;
-
+                if (mLevel->isLeafVisible(cameraNode, nd))
+                    mPvsLeaves.push_back(nd);
+                nd++;
             }
+            mPvsCluster = cameraNode->getVisCluster();
+            mPvsLeavesValid = true;
         }
-        */
 
-        while (i--)
+        // make sure the frustum planes are up to date before they are read concurrently
+        camera->getFrustumPlanes();
+
+        // Check the leaves against the frustum and gather their faces in parallel
+        size_t batchCount = (mPvsLeaves.size() + GATHER_BATCH_SIZE - 1) / GATHER_BATCH_SIZE;
+        if (mLeafBatches.size() < batchCount)
+            mLeafBatches.resize(batchCount);
+        parallelFor(batchCount, [this, camera, onlyShadowCasters](size_t batch)
         {
-            if (mLevel->isLeafVisible(cameraNode, nd))
+            gatherLeafBatch(batch, camera, onlyShadowCasters);
+        });
+
+        // Merge the batches in order, which keeps the result independent of the threads
+        for (size_t batch = 0; batch < batchCount; ++batch)
+        {
+            const LeafBatch& leafBatch = mLeafBatches[batch];
+            for (size_t f = 0; f < leafBatch.faceGroups.size(); ++f)
             {
+                int realIndex = leafBatch.faceGroups[f].first;
+                // Check not already included
+                if (mFaceGroupIncluded[realIndex])
+                    continue;
+                mFaceGroupIncluded[realIndex] = true;
+                // Try to insert, will find existing if already there
+                std::pair<MaterialFaceGroupMap::iterator, bool> matgrpi;
+                matgrpi = mMatFaceGroupMap.emplace(leafBatch.faceGroups[f].second, std::vector<StaticFaceGroup*>());
+                // Whatever happened, matgrpi.first is map iterator
+                // Need to get second part of that to get vector
+                matgrpi.first->second.push_back(mLevel->mFaceGroups + realIndex);
+            }
 
-                // Visible according to PVS, check bounding box against frustum
-                FrustumPlane plane;
-                if (camera->isVisible(nd->getBoundingBox(), &plane))
-                {
-                    //if (firstTime)
-                    //{
-                    //    of << "Visible Node: " << *nd << std::endl;
-                    //}
-                    processVisibleLeaf(nd, camera, visibleBounds, onlyShadowCasters);
-                    if (mShowNodeAABs)
-                        addBoundingBox(nd->getBoundingBox(), true);
-                }
+            for (size_t l = 0; l < leafBatch.visibleLeaves.size(); ++l)
+            {
+                BspNode* nd = leafBatch.visibleLeaves[l];
+                processVisibleLeaf(nd, camera, visibleBounds, onlyShadowCasters);
+                if (mShowNodeAABs)
+                    addBoundingBox(nd->getBoundingBox(), true);
             }
-            nd++;
         }
 
-
         // TEST
         //if (firstTime)
         //{
@@ -310,27 +359,39 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
-    void BspSceneManager::processVisibleLeaf(BspNode* leaf, Camera* cam, 
-        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+    void BspSceneManager::gatherLeafBatch(size_t batch, const Camera* cam, bool onlyShadowCasters)
     {
-        MaterialPtr pMat;
-        // Skip world geometry if we're only supposed to process shadow casters
-        // World is pre-lit
-        if (!onlyShadowCasters)
+        LeafBatch& leafBatch = mLeafBatches[batch];
+        leafBatch.visibleLeaves.clear();
+        leafBatch.faceGroups.clear();
+
+        size_t end = std::min(mPvsLeaves.size(), (batch + 1) * GATHER_BATCH_SIZE);
+        for (size_t l = batch * GATHER_BATCH_SIZE; l < end; ++l)
         {
-            // Parse the leaf node's faces, add face groups to material map
+            BspNode* leaf = mPvsLeaves[l];
+
+            // Visible according to PVS, check bounding box against frustum
+            FrustumPlane plane;
+            if (!cam->isVisible(leaf->getBoundingBox(), &plane))
+                continue;
+
+            leafBatch.visibleLeaves.push_back(leaf);
+
+            // Skip world geometry if we're only supposed to process shadow casters
+            // World is pre-lit
+            if (onlyShadowCasters)
+                continue;
+
+            // Parse the leaf node's faces, duplicates are removed when the batches are merged
             int numGroups = leaf->getNumFaceGroups();
             int idx = leaf->getFaceGroupStart();
 
             while (numGroups--)
             {
                 int realIndex = mLevel->mLeafFaceGroups[idx++];
-                // Check not already included
-                if (mFaceGroupSet.find(realIndex) != mFaceGroupSet.end())
-                    continue;
                 StaticFaceGroup* faceGroup = mLevel->mFaceGroups + realIndex;
                 // Get Material pointer by handle
-                pMat = static_pointer_cast<Material>(MaterialManager::getSingleton().getByHandle(faceGroup->materialHandle));
+                MaterialPtr pMat = static_pointer_cast<Material>(MaterialManager::getSingleton().getByHandle(faceGroup->materialHandle));
                 assert (pMat);
                 // Check normal (manual culling)
                 ManualCullingMode cullMode = pMat->getTechnique(0)->getPass(0)->getManualCullingMode();
@@ -341,21 +402,14 @@ namespace Ogre {
                         (dist > 0 && cullMode == MANUAL_CULL_FRONT) )
                         continue; // skip
                 }
-                mFaceGroupSet.insert(realIndex);
-                // Try to insert, will find existing if already there
-                std::pair<MaterialFaceGroupMap::iterator, bool> matgrpi;
-                matgrpi = mMatFaceGroupMap.emplace(pMat.get(), std::vector<StaticFaceGroup*>());
-                // Whatever happened, matgrpi.first is map iterator
-                // Need to get second part of that to get vector
-                matgrpi.first->second.push_back(faceGroup);
-
-                //if (firstTime)
-                //{
-                //    of << "  Emitting faceGroup: index=" << realIndex << ", " << *faceGroup << std::endl;
-                //}
+                leafBatch.faceGroups.push_back(std::make_pair(realIndex, pMat.get()));
             }
         }
-
+    }
+    //-----------------------------------------------------------------------
+    void BspSceneManager::processVisibleLeaf(BspNode* leaf, Camera* cam, 
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+    {
         // Add movables to render queue, provided it hasn't been seen already
         const BspNode::IntersectingObjectSet& objects = leaf->getObjects();
         BspNode::IntersectingObjectSet::const_iterator oi, oiend;
@@ -125,6 +125,14 @@ namespace Ogre
                                       bool displayNodes,
                                       bool showBoundingBoxes);
 
+        /// @copydoc PCZone::supportsParallelUpdates
+        bool supportsParallelUpdates(void) const { return true; }
+
+        /// @copydoc PCZone::_findVisibleZoneNodes
+        void _findVisibleZoneNodes(const PCZCamera * camera,
+                                   const PCZFrustum & extraCullingFrustum,
+                                   PCZSceneNodeVector & visibleNodes) const;
+
         /** Functions for finding Nodes that intersect various shapes */
         virtual void _findNodes(const AxisAlignedBox &t, 
                                 PCZSceneNodeList &list,
@@ -208,6 +216,14 @@ namespace Ogre
                          bool displayNodes,
                          bool showBoundingBoxes);
 
+        /** Walks through the octree like walkOctree, but only collects the visible nodes.
+        */
+        void walkOctree( const PCZCamera *,
+                         const PCZFrustum &,
+                         Octree *,
+                         bool foundvisible,
+                         PCZSceneNodeVector & ) const;
+
     protected:
         /// The root octree
         Octree *mOctree;
@@ -105,6 +105,9 @@ namespace Ogre
                               bool displayNodes,
                               bool showBoundingBoxes);
 
+        /// @copydoc PCZone::supportsParallelUpdates
+        bool supportsParallelUpdates(void) const { return true; }
+
         /* Functions for finding Nodes that intersect various shapes */
         void _findNodes( const AxisAlignedBox &t, 
                          PCZSceneNodeList &list, 
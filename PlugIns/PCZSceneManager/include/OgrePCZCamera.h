@@ -86,6 +86,32 @@ namespace Ogre
         */
         PCZCamera::Visibility getVisibility( const AxisAlignedBox &bound );
 
+        /** isVisible() function for aabb, which uses the given extra culling frustum
+            instead of the one of the camera
+        */
+        bool isVisible( const AxisAlignedBox &bound, const PCZFrustum& extraCullingFrustum ) const;
+
+        /** Test a batch of boxes against the camera and the given extra culling frustum.
+        @remarks
+            Gives the same results as calling isVisible(*bounds[i], extraCullingFrustum) for
+            every box, but runs plane by plane over the whole batch in loops, which the
+            compiler can vectorise.
+        @param visible Receives 1 for every visible box and 0 otherwise
+        */
+        void isVisible( const AxisAlignedBox* const* bounds, size_t count,
+                        const PCZFrustum& extraCullingFrustum, uchar* visible ) const;
+
+        /** Returns the detailed visibility of the box, using the given extra culling frustum
+            instead of the one of the camera
+        */
+        PCZCamera::Visibility getVisibility( const AxisAlignedBox &bound,
+                                             const PCZFrustum& extraCullingFrustum ) const;
+
+        /** Get the extra culling frustum, which holds the culling planes of the
+            portals the camera currently looks through
+        */
+        const PCZFrustum& getExtraCullingFrustum(void) const { return mExtraCullingFrustum; }
+
         /// Sets the type of projection to use (orthographic or perspective).
         void setProjectionType(ProjectionType pt);
 
@@ -79,8 +79,16 @@ namespace Ogre
 
         /** Standard constructor */
         PCZFrustum();
+        /** Copy constructor, the culling planes are copied */
+        PCZFrustum(const PCZFrustum& other);
         /** Standard destructor */
         ~PCZFrustum();
+        /** Copy the origin and the active culling planes of another frustum.
+        @remarks
+            Planes of the culling plane reservoir are reused, so keeping a PCZFrustum
+            around as a snapshot of another one does not allocate once it is warm.
+        */
+        PCZFrustum& operator=(const PCZFrustum& other);
 
         /* isVisible function for aabb */
         bool isVisible( const AxisAlignedBox &bound) const;
@@ -95,7 +103,7 @@ namespace Ogre
         /* special function that returns true only when portal fully fits inside the frustum. */
         bool isFullyVisible(const PortalBase* portal) const;
         /* more detailed check for visibility of an AABB */
-        PCZFrustum::Visibility getVisibility(const AxisAlignedBox & bound);
+        PCZFrustum::Visibility getVisibility(const AxisAlignedBox & bound) const;
 
         /** Calculate  culling planes from portal and Frustum
             origin and add to list of culling planes */
@@ -108,8 +116,14 @@ namespace Ogre
         void setOrigin(const Vector3 & newOrigin) {mOrigin = newOrigin;}
         /// Set the origin plane
         void setOriginPlane(const Vector3 &rkNormal, const Vector3 &rkPoint);
+        /// Get the origin plane
+        const Plane& getOriginPlane(void) const {return mOriginPlane;}
         /// Tell the frustum whether or not to use the originplane
         void setUseOriginPlane(bool yesno) {mUseOriginPlane = yesno;}
+        /// Whether the origin plane is used
+        bool getUseOriginPlane(void) const {return mUseOriginPlane;}
+        /// The culling planes in use
+        const PCPlaneList& getActiveCullingPlanes(void) const {return mActiveCullingPlanes;}
         /// Get an unused PCPlane from the CullingPlane Reservoir
         PCPlane * getUnusedCullingPlane(void);
 
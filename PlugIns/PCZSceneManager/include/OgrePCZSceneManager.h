@@ -40,6 +40,7 @@ Code Style Update    :
 #include "OgrePCZPrerequisites.h"
 #include "OgreSceneManager.h"
 #include "OgrePCZone.h"
+#include "OgrePCZFrustum.h"
 
 namespace Ogre
 {
@@ -219,6 +220,11 @@ namespace Ogre
         */
         void _updatePCZSceneNode( PCZSceneNode * );
 
+        /** Like _updatePCZSceneNode, but moves the node to the given home zone, which
+            PCZone::findNodeHomeZone found for it
+        */
+        void _updatePCZSceneNode( PCZSceneNode *, PCZone * newHomeZone );
+
         /** Removes the given PCZSceneNode */
         void removeSceneNode( SceneNode * );
 
@@ -302,6 +308,10 @@ namespace Ogre
             Options are:
             "ShowPortals", bool *;
             "ShowBoundingBoxes", bool *;
+            "ParallelUpdates", bool *; Whether the visible nodes may be culled and moved
+            nodes re-zoned in parallel, if all zones support it (see
+            PCZone::supportsParallelUpdates). The results are the same as without.
+            Enabled by default.
         */
         virtual bool setOption( const String &, const void * );
         /** Gets the given option for the Scene Manager.
@@ -367,6 +377,41 @@ namespace Ogre
         /// The zone of the active camera (for shadow texture casting use);
         PCZone* mActiveCameraZone;
 
+        /// Whether culling and re-zoning may run in parallel
+        bool mParallelUpdates;
+
+        /// A zone reached by the camera, with the extra culling planes it is seen through
+        struct ZoneVisit
+        {
+            PCZone* zone;
+            PCZFrustum extraCullingFrustum;
+            PCZSceneNodeVector visibleNodes;
+        };
+        typedef std::vector<ZoneVisit> ZoneVisitList;
+        /// Zones found by findVisibleZones, in the order they were reached
+        ZoneVisitList mZoneVisits;
+        /// Number of valid entries of mZoneVisits, which is kept around to reuse its memory
+        size_t mZoneVisitCount;
+
+        /// Moved nodes found by _updatePCZSceneNodes
+        PCZSceneNodeVector mMovedNodes;
+        /// The home zones of mMovedNodes found in parallel
+        std::vector<PCZone*> mNewHomeZones;
+
+        /// Whether every zone supports the parallel updates
+        bool allZonesSupportParallelUpdates(void);
+
+        /** Walk the zones visible to the camera like PCZone::findVisibleNodes, but only
+            record them in mZoneVisits instead of looking for visible nodes
+        */
+        void findVisibleZones(PCZone * zone, PCZCamera * camera);
+
+        /** Find the visible nodes in two passes: first walk the portals to find the visible
+            zones, then cull the nodes of all these zones in parallel
+        */
+        void findVisibleNodesInParallel(PCZCamera * camera, PCZone * cameraHomeZone,
+            VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
+
         /** Internal method for locating a list of lights which could be affecting the frustum. 
         @remarks
             Custom scene managers are encouraged to override this method to make use of their
@@ -73,6 +73,7 @@ namespace Ogre
     typedef std::vector<PortalBase*> PortalBaseList;
     typedef std::vector<SceneNode*> NodeList;
     typedef std::set< PCZSceneNode * > PCZSceneNodeList;
+    typedef std::vector< PCZSceneNode * > PCZSceneNodeVector;
     typedef std::map<String, SceneNode*> SceneNodeList;
 
     /** Portal-Connected Zone datastructure for managing scene nodes.
@@ -187,6 +188,18 @@ namespace Ogre
         /** Update a node's home zone */
         virtual PCZone * updateNodeHomeZone(PCZSceneNode * pczsn, bool allowBackTouces) = 0;
 
+        /** Find a node's new home zone without changing anything.
+        @remarks
+            Follows the portal crossings of the node like updateNodeHomeZone, but returns
+            the zone the node ends up in instead of moving the node there. The node and
+            the zones are left untouched, so this can run for many nodes at once on
+            different threads.
+        @param pczsn The node, whose home zone is this zone
+        @param homeZone The zone the node is currently assumed to be in, i.e. this zone
+        @param allowBackTouches See updateNodeHomeZone
+        */
+        virtual PCZone * findNodeHomeZone(PCZSceneNode * pczsn, PCZone * homeZone, bool allowBackTouches);
+
         /** Find and add visible objects to the render queue.
         @remarks
         Starts with objects in the zone and proceeds through visible portals   
@@ -200,6 +213,38 @@ namespace Ogre
                                       bool displayNodes,
                                       bool showBoundingBoxes) = 0;
 
+        /** Whether the zone supports the parallel updates of the PCZSceneManager.
+        @remarks
+            This requires that findVisibleNodes adds nothing but the nodes found by
+            _findVisibleZoneNodes and recurses through the portals of _findVisiblePortals,
+            and that updateNodeHomeZone moves nodes to the zone findNodeHomeZone returns.
+        */
+        virtual bool supportsParallelUpdates(void) const { return false; }
+
+        /** Find the nodes of the zone, which are visible through the given extra culling frustum.
+        @remarks
+            This is the node culling part of findVisibleNodes. It does not recurse through
+            portals and changes neither the zone, the nodes nor the camera, so several zones
+            can be culled at once on different threads. Nodes are appended in the order
+            findVisibleNodes visits them, even if they are already visible through another
+            zone. The default implementation tests the home and visitor nodes.
+        */
+        virtual void _findVisibleZoneNodes(const PCZCamera * camera,
+                                           const PCZFrustum & extraCullingFrustum,
+                                           PCZSceneNodeVector & visibleNodes) const;
+
+        /** Find the portals of the zone, which the camera can see through.
+        @remarks
+            Anti portals and the portals hidden by them are left out, so every entry is a
+            Portal. The portals are sorted from nearest to furthest from the camera, which
+            is the order findVisibleNodes recurses into their target zones.
+        */
+        void _findVisiblePortals(PCZCamera * camera, PortalBaseList & visiblePortals);
+
+        /// Whether the zone has neither nodes nor portals
+        bool isEmpty(void) const
+        { return mHomeNodeList.empty() && mVisitorNodeList.empty() && mPortals.empty(); }
+
         /* Functions for finding Nodes that intersect various shapes */
         virtual void _findNodes( const AxisAlignedBox &t, 
                                  PCZSceneNodeList &list, 
@@ -253,6 +298,12 @@ namespace Ogre
         PCZSceneManager * mPCZSM;
 
     protected:
+        /// Append the nodes of the list, whose world bounds are visible, to visibleNodes
+        static void cullNodes(const PCZCamera * camera,
+                              const PCZFrustum & extraCullingFrustum,
+                              const PCZSceneNodeList & nodes,
+                              PCZSceneNodeVector & visibleNodes);
+
         /** Binary predicate for portal <-> camera distance sorting. */
         struct PortalSortDistance
         {
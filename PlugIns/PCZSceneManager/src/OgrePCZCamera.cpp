@@ -35,6 +35,7 @@ email                : ericc@xenopi.com
 #include "OgreAxisAlignedBox.h"
 #include "OgrePCZCamera.h"
 #include "OgrePCZFrustum.h"
+#include "OgrePCPlane.h"
 #include "OgrePortal.h"
 
 namespace Ogre
@@ -89,6 +90,115 @@ namespace Ogre
       none, partial, or full for visibility of the box.  This is useful for 
       stuff like Octree leaf culling */
     PCZCamera::Visibility PCZCamera::getVisibility( const AxisAlignedBox &bound )
+    {
+        return getVisibility(bound, mExtraCullingFrustum);
+    }
+
+    bool PCZCamera::isVisible( const AxisAlignedBox &bound, const PCZFrustum& extraCullingFrustum ) const
+    {
+        // Null boxes always invisible
+        if ( bound.isNull() )
+            return false;
+
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        // check extra culling planes
+        if (!extraCullingFrustum.isVisible(bound))
+        {
+            return false;
+        }
+
+        // check "regular" camera frustum
+        return Camera::isVisible(bound);
+    }
+
+    void PCZCamera::isVisible( const AxisAlignedBox* const* bounds, size_t count,
+                               const PCZFrustum& extraCullingFrustum, uchar* visible ) const
+    {
+        const PCPlaneList& extraPlanes = extraCullingFrustum.getActiveCullingPlanes();
+        // a custom culling frustum may do its own tests
+        if (mCullFrustum || extraPlanes.size() > MAX_EXTRA_CULLING_PLANES)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                visible[i] = isVisible(*bounds[i], extraCullingFrustum);
+            }
+            return;
+        }
+
+        // A box is visible if it is not fully on the negative side of any plane, so the
+        // planes of the extra culling frustum and the camera can be tested in any order.
+        Plane planes[MAX_EXTRA_CULLING_PLANES + 7];
+        size_t planeCount = 0;
+        if (extraCullingFrustum.getUseOriginPlane())
+        {
+            planes[planeCount++] = extraCullingFrustum.getOriginPlane();
+        }
+        for (PCPlaneList::const_iterator pit = extraPlanes.begin(); pit != extraPlanes.end(); ++pit)
+        {
+            planes[planeCount++] = **pit;
+        }
+        const Plane* frustumPlanes = getFrustumPlanes();
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            // Skip far plane if infinite view frustum
+            if (plane == FRUSTUM_PLANE_FAR && mFarDist == 0)
+                continue;
+            planes[planeCount++] = frustumPlanes[plane];
+        }
+
+        const size_t BATCH_SIZE = 64;
+        Real cx[BATCH_SIZE], cy[BATCH_SIZE], cz[BATCH_SIZE];
+        Real hx[BATCH_SIZE], hy[BATCH_SIZE], hz[BATCH_SIZE];
+        uchar inside[BATCH_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_SIZE)
+        {
+            size_t batchCount = std::min(BATCH_SIZE, count - start);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[start + i];
+                if (bound.isFinite())
+                {
+                    Vector3 centre = bound.getCenter();
+                    Vector3 halfSize = bound.getHalfSize();
+                    cx[i] = centre.x; cy[i] = centre.y; cz[i] = centre.z;
+                    hx[i] = halfSize.x; hy[i] = halfSize.y; hz[i] = halfSize.z;
+                }
+                else
+                {
+                    // fixed up below
+                    cx[i] = cy[i] = cz[i] = hx[i] = hy[i] = hz[i] = 0;
+                }
+                inside[i] = 1;
+            }
+
+            for (size_t p = 0; p < planeCount; ++p)
+            {
+                const Real nx = planes[p].normal.x;
+                const Real ny = planes[p].normal.y;
+                const Real nz = planes[p].normal.z;
+                const Real d = planes[p].d;
+                for (size_t i = 0; i < batchCount; ++i)
+                {
+                    // Plane::getSide(centre, halfSize) != Plane::NEGATIVE_SIDE
+                    Real dist = nx * cx[i] + ny * cy[i] + nz * cz[i] + d;
+                    Real maxAbsDist = Math::Abs(nx * hx[i]) + Math::Abs(ny * hy[i]) + Math::Abs(nz * hz[i]);
+                    inside[i] &= (uchar)!(dist < -maxAbsDist);
+                }
+            }
+
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[start + i];
+                // Null boxes are always invisible, infinite boxes always visible
+                visible[start + i] = bound.isFinite() ? inside[i] : bound.isInfinite();
+            }
+        }
+    }
+
+    PCZCamera::Visibility PCZCamera::getVisibility( const AxisAlignedBox &bound,
+                                                   const PCZFrustum& extraCullingFrustum ) const
     {
 
         // Null boxes always invisible
@@ -117,7 +227,7 @@ namespace Ogre
                     all_inside = false;
         }
         
-        switch(mExtraCullingFrustum.getVisibility(bound))
+        switch(extraCullingFrustum.getVisibility(bound))
         {
         case PCZFrustum::NONE:
             return NONE;
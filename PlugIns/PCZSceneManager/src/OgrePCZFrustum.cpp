@@ -61,6 +61,12 @@ namespace Ogre
     mUseOriginPlane(false), mProjType(PT_PERSPECTIVE)
     { }
 
+    PCZFrustum::PCZFrustum(const PCZFrustum& other) :
+    mUseOriginPlane(false), mProjType(PT_PERSPECTIVE)
+    {
+        *this = other;
+    }
+
     PCZFrustum::~PCZFrustum()
     {
         removeAllCullingPlanes();
@@ -77,6 +83,29 @@ namespace Ogre
         mCullingPlaneReservoir.clear();
     }
 
+    PCZFrustum& PCZFrustum::operator=(const PCZFrustum& other)
+    {
+        if (this == &other)
+            return *this;
+
+        mOrigin = other.mOrigin;
+        mOriginPlane = other.mOriginPlane;
+        mUseOriginPlane = other.mUseOriginPlane;
+        mProjType = other.mProjType;
+
+        // keep the order of the planes, getVisibility depends on it
+        removeAllCullingPlanes();
+        PCPlaneList::const_iterator pit = other.mActiveCullingPlanes.begin();
+        while ( pit != other.mActiveCullingPlanes.end() )
+        {
+            PCPlane * plane = getUnusedCullingPlane();
+            *plane = **pit;
+            mActiveCullingPlanes.push_back(plane);
+            pit++;
+        }
+        return *this;
+    }
+
     bool PCZFrustum::isVisible( const AxisAlignedBox & bound) const
     {
         // Null boxes are always invisible
@@ -415,7 +444,7 @@ namespace Ogre
     /* A 'more detailed' check for visibility of an AAB.  This function returns
       none, partial, or full for visibility of the box.  This is useful for 
       stuff like Octree leaf culling */
-    PCZFrustum::Visibility PCZFrustum::getVisibility( const AxisAlignedBox &bound )
+    PCZFrustum::Visibility PCZFrustum::getVisibility( const AxisAlignedBox &bound ) const
     {
 
         // Null boxes always invisible
@@ -446,7 +475,7 @@ namespace Ogre
 
         // For each active culling plane, see if the entire aabb is on the negative side
         // If so, object is not visible
-        PCPlaneList::iterator pit = mActiveCullingPlanes.begin();
+        PCPlaneList::const_iterator pit = mActiveCullingPlanes.begin();
         while ( pit != mActiveCullingPlanes.end() )
         {
             PCPlane * plane = *pit;
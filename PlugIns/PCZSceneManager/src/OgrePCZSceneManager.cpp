@@ -43,6 +43,7 @@ email                : ericc@xenopi.com
 #include "OgrePortal.h"
 #include "OgreLogManager.h"
 #include "OgreRoot.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre
 {
@@ -54,7 +55,9 @@ namespace Ogre
     mDefaultZone(0),
     mShowPortals(false),
     mZoneFactoryManager(0),
-    mActiveCameraZone(0)
+    mActiveCameraZone(0),
+    mParallelUpdates(true),
+    mZoneVisitCount(0)
     { }
 
     PCZSceneManager::~PCZSceneManager()
@@ -594,6 +597,7 @@ namespace Ogre
     */
     void PCZSceneManager::_updatePCZSceneNodes(void)
     {
+        mMovedNodes.clear();
         SceneNodeList::iterator it = mSceneNodes.begin();
         PCZSceneNode * pczsn;
 
@@ -602,15 +606,64 @@ namespace Ogre
             pczsn = (PCZSceneNode*)*it;
             if (pczsn->isMoved() && pczsn->isEnabled())
             {
-                // Update a single entry 
-                _updatePCZSceneNode(pczsn);
-
-                // reset moved state.
-                pczsn->setMoved(false);
+                mMovedNodes.push_back(pczsn);
             }
             // proceed to next entry in the list
             ++it;
         }
+
+        // Finding the new home zones only reads the nodes and portals, so the moved
+        // nodes can be re-zoned in parallel batches. Moving portals update their
+        // capsules while nodes are tested against them though, so this is only
+        // done in frames without moving portals.
+        static const size_t REZONE_BATCH_SIZE = 64;
+        size_t batchCount = (mMovedNodes.size() + REZONE_BATCH_SIZE - 1) / REZONE_BATCH_SIZE;
+        TaskScheduler* scheduler = TaskScheduler::getDefault();
+        bool parallel = mParallelUpdates && mDefaultZone && batchCount > 1 &&
+            scheduler && scheduler->getWorkerCount() > 0 && allZonesSupportParallelUpdates();
+        for (ZoneMap::iterator zit = mZones.begin(); parallel && zit != mZones.end(); ++zit)
+        {
+            parallel = !zit->second->getPortalsUpdated();
+        }
+
+        if (parallel)
+        {
+            // update the capsules of portals, which stopped moving, before they are shared
+            for (PortalList::iterator pit = mPortals.begin(); pit != mPortals.end(); ++pit)
+            {
+                (*pit)->getCapsule();
+            }
+
+            SceneNode* rootNode = getRootSceneNode();
+            mNewHomeZones.resize(mMovedNodes.size());
+            parallelFor(batchCount, [this, rootNode](size_t batch)
+            {
+                size_t end = std::min(mMovedNodes.size(), (batch + 1) * REZONE_BATCH_SIZE);
+                for (size_t i = batch * REZONE_BATCH_SIZE; i < end; ++i)
+                {
+                    PCZSceneNode* node = mMovedNodes[i];
+                    PCZone* homeZone = node->getHomeZone();
+                    if (homeZone && !node->isAnchored() && node != rootNode)
+                    {
+                        homeZone = homeZone->findNodeHomeZone(node, homeZone, false);
+                    }
+                    mNewHomeZones[i] = homeZone;
+                }
+            });
+        }
+
+        for (size_t i = 0; i < mMovedNodes.size(); ++i)
+        {
+            pczsn = mMovedNodes[i];
+            // Update a single entry 
+            if (parallel)
+                _updatePCZSceneNode(pczsn, mNewHomeZones[i]);
+            else
+                _updatePCZSceneNode(pczsn);
+
+            // reset moved state.
+            pczsn->setMoved(false);
+        }
     }
 
     /*
@@ -676,6 +729,43 @@ namespace Ogre
         pczsn->updateZoneData();
     }
 
+    void PCZSceneManager::_updatePCZSceneNode( PCZSceneNode * pczsn, PCZone * newHomeZone )
+    {
+        // Skip if root Zone has been destroyed (shutdown conditions)
+        if (!mDefaultZone)
+            return;
+
+        // Skip if the node is the sceneroot node 
+        if (pczsn == getRootSceneNode())
+            return;
+
+        // clear all references to visiting zones
+        pczsn->clearNodeFromVisitedZones();
+
+        PCZone* startzone = pczsn->getHomeZone();
+        if (!startzone)
+        {
+            // the node hasn't had it's home zone set yet
+            _updateHomeZone( pczsn, false );
+        }
+        else if (newHomeZone != startzone)
+        {
+            // move the node to its new home zone
+            pczsn->setHomeZone(newHomeZone);
+            newHomeZone->_addNode(pczsn);
+        }
+
+        // (recursively) check each portal of home zone to see if the node is touching 
+        if (pczsn->getHomeZone() &&
+            pczsn->allowedToVisit() == true)
+        {
+            pczsn->getHomeZone()->_checkNodeAgainstPortals(pczsn, 0);
+        }
+
+        // update zone-specific data for the node for any zones that require it
+        pczsn->updateZoneData();
+    }
+
     /** Removes all references to the node from every zone in the scene.  
     */
     void PCZSceneManager::removeSceneNode( SceneNode * sn )
@@ -1230,6 +1320,11 @@ namespace Ogre
         // walk the zones, starting from the camera home zone,
         // adding all visible scene nodes to the mVisibles list
         cameraHomeZone->setLastVisibleFrame(mFrameCount);
+        if (mParallelUpdates && allZonesSupportParallelUpdates())
+        {
+            findVisibleNodesInParallel((PCZCamera*)cam, cameraHomeZone, visibleBounds, onlyShadowCasters);
+            return;
+        }
         cameraHomeZone->findVisibleNodes((PCZCamera*)cam, 
                                           mVisible, 
                                           getRenderQueue(),
@@ -1239,6 +1334,110 @@ namespace Ogre
                                           mShowBoundingBoxes);
     }
 
+    bool PCZSceneManager::allZonesSupportParallelUpdates(void)
+    {
+        for (ZoneMap::iterator i = mZones.begin(); i != mZones.end(); ++i)
+        {
+            if (!i->second->supportsParallelUpdates())
+                return false;
+        }
+        return true;
+    }
+
+    void PCZSceneManager::findVisibleZones(PCZone * zone, PCZCamera * camera)
+    {
+        //return immediately if nothing is in the zone.
+        if (zone->isEmpty())
+            return;
+
+        // enable sky if called to do so for this zone
+        if (zone->hasSky())
+        {
+            enableSky(true);
+        }
+
+        // remember the zone with the culling planes it is seen through
+        if (mZoneVisitCount == mZoneVisits.size())
+        {
+            mZoneVisits.push_back(ZoneVisit());
+        }
+        ZoneVisit& visit = mZoneVisits[mZoneVisitCount++];
+        visit.zone = zone;
+        visit.extraCullingFrustum = camera->getExtraCullingFrustum();
+
+        // recurse into the zones behind the visible portals, nearest first
+        PortalBaseList visiblePortals;
+        zone->_findVisiblePortals(camera, visiblePortals);
+        for (size_t i = 0; i < visiblePortals.size(); ++i)
+        {
+            Portal* portal = static_cast<Portal*>(visiblePortals[i]);
+            // portal is visible. Add the portal as extra culling planes to camera
+            int planes_added = camera->addPortalCullingPlanes(portal);
+            // tell target zone it's visible this frame
+            portal->getTargetZone()->setLastVisibleFrame(mFrameCount);
+            portal->getTargetZone()->setLastVisibleFromCamera(camera);
+            // recurse into the connected zone 
+            findVisibleZones(portal->getTargetZone(), camera);
+            if (planes_added > 0)
+            {
+                // Then remove the extra culling planes added before going to the next portal in the list.
+                camera->removePortalCullingPlanes(portal);
+            }
+        }
+    }
+
+    void PCZSceneManager::findVisibleNodesInParallel(PCZCamera * camera, PCZone * cameraHomeZone,
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+    {
+        // walk the portals first
+        mZoneVisitCount = 0;
+        findVisibleZones(cameraHomeZone, camera);
+
+        // make sure the frustum planes are up to date before they are read concurrently
+        camera->getFrustumPlanes();
+
+        // cull the nodes of every visible zone through the planes it was seen through
+        parallelFor(mZoneVisitCount, [this, camera](size_t i)
+        {
+            ZoneVisit& visit = mZoneVisits[i];
+            visit.visibleNodes.clear();
+            visit.zone->_findVisibleZoneNodes(camera, visit.extraCullingFrustum, visit.visibleNodes);
+        });
+
+        // add the nodes in the order the recursive walk finds them
+        RenderQueue* queue = getRenderQueue();
+        for (size_t i = 0; i < mZoneVisitCount; ++i)
+        {
+            const PCZSceneNodeVector& nodes = mZoneVisits[i].visibleNodes;
+            for (PCZSceneNodeVector::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+            {
+                PCZSceneNode * pczsn = *it;
+                // if the scene node is already visible, then we can skip it
+                if (pczsn->getLastVisibleFrame() == mFrameCount &&
+                    pczsn->getLastVisibleFromCamera() == camera)
+                    continue;
+
+                // add it to the list of visible nodes
+                mVisible.push_back( pczsn );
+                // add the node to the render queue
+                pczsn->_addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
+                // if we are displaying nodes, add the node renderable to the queue
+                if ( mDisplayNodes )
+                {
+                    queue -> addRenderable( pczsn->getDebugRenderable() );
+                }
+                // if the scene manager or the node wants the bounding box shown, add it to the queue
+                if (pczsn->getShowBoundingBox() || mShowBoundingBoxes)
+                {
+                    pczsn->_addBoundingBoxToQueue(queue);
+                }
+                // flag the node as being visible this frame
+                pczsn->setLastVisibleFrame(mFrameCount);
+                pczsn->setLastVisibleFromCamera(camera);
+            }
+        }
+    }
+
     void PCZSceneManager::findNodesIn( const AxisAlignedBox &box, 
                                        PCZSceneNodeList &list, 
                                        PCZone * startZone, 
@@ -1346,6 +1545,7 @@ namespace Ogre
         SceneManager::getOptionKeys( refKeys );
         refKeys.push_back( "ShowBoundingBoxes" );
         refKeys.push_back( "ShowPortals" );
+        refKeys.push_back( "ParallelUpdates" );
 
         return true;
     }
@@ -1363,6 +1563,12 @@ namespace Ogre
             mShowPortals = * static_cast < const bool * > ( val );
             return true;
         }
+
+        else if ( key == "ParallelUpdates" )
+        {
+            mParallelUpdates = * static_cast < const bool * > ( val );
+            return true;
+        }
         // send option to each zone
         ZoneMap::iterator i;
         PCZone * zone;
@@ -1395,6 +1601,11 @@ namespace Ogre
             * static_cast < bool * > ( val ) = mShowPortals;
             return true;
         }
+        if ( key == "ParallelUpdates" )
+        {
+            * static_cast < bool * > ( val ) = mParallelUpdates;
+            return true;
+        }
         return SceneManager::getOption( key, val );
 
     }
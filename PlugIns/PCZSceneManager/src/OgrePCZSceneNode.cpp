@@ -49,9 +49,11 @@ namespace Ogre
 {
     PCZSceneNode::PCZSceneNode( SceneManager* creator )
         : SceneNode( creator ),
+        mNewPosition(Vector3::ZERO),
         mHomeZone(0),
         mAnchored(false),
         mAllowedToVisit(true),
+        mPrevPosition(Vector3::ZERO),
         mLastVisibleFrame(0),
         mLastVisibleFromCamera(0),
         mEnabled(true),
@@ -61,9 +63,11 @@ namespace Ogre
 
     PCZSceneNode::PCZSceneNode( SceneManager* creator, const String& name )
         : SceneNode( creator, name ),
+        mNewPosition(Vector3::ZERO),
         mHomeZone(0),
         mAnchored(false),
         mAllowedToVisit(true),
+        mPrevPosition(Vector3::ZERO),
         mLastVisibleFrame(0),
         mLastVisibleFromCamera(0),
         mEnabled(true),
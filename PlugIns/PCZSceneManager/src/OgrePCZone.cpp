@@ -36,6 +36,9 @@ email                : ericc@xenopi.com
 #include "OgreSceneNode.h"
 #include "OgreAntiPortal.h"
 #include "OgrePortal.h"
+#include "OgrePCZCamera.h"
+#include "OgrePCZFrustum.h"
+#include "OgrePCZSceneNode.h"
 
 namespace Ogre
 {
@@ -165,6 +168,169 @@ namespace Ogre
     {
     }
 
+    /* Find the new home zone of a node without changing anything. The node is
+       assumed to be in homeZone, which is where updateNodeHomeZone would have
+       moved it to at this point.
+    */
+    PCZone * PCZone::findNodeHomeZone(PCZSceneNode * pczsn, PCZone * homeZone, bool allowBackTouches)
+    {
+        // Check all portals of the start zone for crossings!
+        Portal* portal;
+        PortalList::iterator pi, piend;
+        piend = mPortals.end();
+        for (pi = mPortals.begin(); pi != piend; pi++)
+        {
+            portal = *pi;
+
+            Portal::PortalIntersectResult pir = portal->intersects(pczsn);
+            switch (pir)
+            {
+            default:
+            case Portal::NO_INTERSECT: // node does not intersect portal - do nothing
+            case Portal::INTERSECT_NO_CROSS:// node intersects but does not cross portal - do nothing
+                break;
+            case Portal::INTERSECT_BACK_NO_CROSS:// node intersects but on the back of the portal
+                if (allowBackTouches)
+                {
+                    // node is on wrong side of the portal - fix if we're allowing backside touches
+                    if (portal->getTargetZone() != this &&
+                        portal->getTargetZone() != homeZone)
+                    {
+                        // continue checking for portal crossings in the new zone
+                        homeZone = portal->getTargetZone()->findNodeHomeZone(
+                            pczsn, portal->getTargetZone(), false);
+                    }
+                }
+                break;
+            case Portal::INTERSECT_CROSS:
+                // node intersects and crosses the portal - recurse into that zone as new home zone
+                if (portal->getTargetZone() != this &&
+                    portal->getTargetZone() != homeZone)
+                {
+                    // continue checking for portal crossings in the new zone
+                    homeZone = portal->getTargetZone()->findNodeHomeZone(
+                        pczsn, portal->getTargetZone(), true);
+                }
+                break;
+            }
+        }
+
+        return homeZone;
+    }
+
+    void PCZone::_findVisibleZoneNodes(const PCZCamera * camera,
+                                       const PCZFrustum & extraCullingFrustum,
+                                       PCZSceneNodeVector & visibleNodes) const
+    {
+        cullNodes(camera, extraCullingFrustum, mHomeNodeList, visibleNodes);
+        cullNodes(camera, extraCullingFrustum, mVisitorNodeList, visibleNodes);
+    }
+
+    void PCZone::cullNodes(const PCZCamera * camera,
+                           const PCZFrustum & extraCullingFrustum,
+                           const PCZSceneNodeList & nodes,
+                           PCZSceneNodeVector & visibleNodes)
+    {
+        // test the nodes in batches, so the plane tests can be vectorised
+        const size_t BATCH_SIZE = 64;
+        PCZSceneNode * batch[BATCH_SIZE];
+        const AxisAlignedBox * bounds[BATCH_SIZE];
+        uchar visible[BATCH_SIZE];
+        size_t count = 0;
+
+        PCZSceneNodeList::const_iterator it = nodes.begin();
+        while (it != nodes.end())
+        {
+            batch[count] = *it;
+            bounds[count] = &(*it)->_getWorldAABB();
+            ++count;
+            ++it;
+            if (count == BATCH_SIZE || it == nodes.end())
+            {
+                camera->isVisible(bounds, count, extraCullingFrustum, visible);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (visible[i])
+                        visibleNodes.push_back(batch[i]);
+                }
+                count = 0;
+            }
+        }
+    }
+
+    void PCZone::_findVisiblePortals(PCZCamera * camera, PortalBaseList & visiblePortals)
+    {
+        visiblePortals.clear();
+
+        // Here we merge both portal and antiportal visible to the camera into one list.
+        // Then we sort them in the order from nearest to furthest from camera.
+        for (AntiPortalList::iterator iter = mAntiPortals.begin(); iter != mAntiPortals.end(); ++iter)
+        {
+            AntiPortal* portal = *iter;
+            if (camera->isVisible(portal))
+            {
+                visiblePortals.push_back(portal);
+            }
+        }
+        for (PortalList::iterator iter = mPortals.begin(); iter != mPortals.end(); ++iter)
+        {
+            Portal* portal = *iter;
+            if (camera->isVisible(portal))
+            {
+                visiblePortals.push_back(portal);
+            }
+        }
+        const Vector3& cameraOrigin(camera->getDerivedPosition());
+        std::sort(visiblePortals.begin(), visiblePortals.end(),
+            PortalSortDistance(cameraOrigin));
+
+        // create a standalone frustum for anti portal use.
+        // we're doing this instead of using camera because we don't need
+        // to do camera frustum check again.
+        PCZFrustum antiPortalFrustum;
+        antiPortalFrustum.setOrigin(cameraOrigin);
+        antiPortalFrustum.setProjectionType(camera->getProjectionType());
+
+        // now we do culling check and remove hidden portals.
+        // since the list is sorted, an anti portal can only hide the portals after it.
+        size_t sortedPortalListCount = visiblePortals.size();
+        for (size_t i = 0; i < sortedPortalListCount; ++i)
+        {
+            PortalBase* portalBase = visiblePortals[i];
+            if (!portalBase || portalBase->getTypeFlags() == PortalFactory::FACTORY_TYPE_FLAG)
+                continue; // skip removed portals and portals
+
+            // this is an anti portal. So we use it to test the following portals in the list.
+            AntiPortal* antiPortal = static_cast<AntiPortal*>(portalBase);
+            int planes_added = antiPortalFrustum.addPortalCullingPlanes(antiPortal);
+
+            for (size_t j = i + 1; j < sortedPortalListCount; ++j)
+            {
+                PortalBase* otherPortal = visiblePortals[j];
+                // Since this is an antiportal, we are doing the inverse of the test.
+                // Here if the portal is fully visible in the anti portal fustrum, it means it's hidden.
+                if (otherPortal && antiPortalFrustum.isFullyVisible(otherPortal))
+                    visiblePortals[j] = NULL;
+            }
+
+            if (planes_added > 0)
+            {
+                // Then remove the extra culling planes added before going to the next portal in the list.
+                antiPortalFrustum.removePortalCullingPlanes(antiPortal);
+            }
+        }
+
+        // only the portals lead to other zones
+        size_t count = 0;
+        for (size_t i = 0; i < sortedPortalListCount; ++i)
+        {
+            PortalBase* portalBase = visiblePortals[i];
+            if (portalBase && portalBase->getTypeFlags() == PortalFactory::FACTORY_TYPE_FLAG)
+                visiblePortals[count++] = portalBase;
+        }
+        visiblePortals.resize(count);
+    }
+
     /* get the aabb of the zone - default implementation
        uses the enclosure node, but there are other perhaps
        better ways
@@ -0,0 +1,242 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullRenderSystemExports.h"
+#include "OgreRenderSystem.h"
+
+namespace Ogre
+{
+    class HardwareBufferManager;
+
+    /** \addtogroup RenderSystems RenderSystems
+    *  @{
+    */
+    /** \defgroup Null Null
+    * Headless RenderSystem, which records the commands it receives instead of drawing
+    *  @{
+    */
+
+    /** RenderSystem without a GPU.
+    @remarks
+        Buffers live in system memory (DefaultHardwareBufferManager) and windows and
+        textures are plain memory surfaces. Nothing is rasterised; instead every draw
+        call, state change, texture bind and constant upload is counted and, if enabled,
+        appended to a command log. This makes the CPU side of the rendering pipeline
+        measurable and testable on machines without a graphics driver.
+    @par
+        Only the fixed function pipeline is supported, as there is no shading language
+        to compile GPU programs with.
+    */
+    class _OgreNullExport NullRenderSystem : public RenderSystem
+    {
+    public:
+        /// Kinds of recorded commands
+        enum CommandType
+        {
+            CMD_BEGIN_FRAME,
+            CMD_END_FRAME,
+            CMD_SET_RENDER_TARGET,
+            CMD_SET_VIEWPORT,
+            CMD_CLEAR,
+            /// arg is the RenderOperation::OperationType, count the number of vertices or indices
+            CMD_DRAW,
+            /// arg is the RenderState, which changed, setting a state to its value is not recorded
+            CMD_SET_STATE,
+            /// arg is the texture unit, count 1 if a texture was bound and 0 if it was disabled
+            CMD_SET_TEXTURE,
+            /// arg is the texture unit
+            CMD_SET_SAMPLER,
+            /// arg is the GpuProgramVariability mask, count the number of floats uploaded
+            CMD_UPLOAD_CONSTANTS
+        };
+
+        /// States reported by CMD_SET_STATE
+        enum RenderState
+        {
+            RS_BLEND,
+            RS_ALPHA_REJECT,
+            RS_CULLING,
+            RS_DEPTH,
+            RS_DEPTH_BIAS,
+            RS_COLOUR_WRITE,
+            RS_POLYGON_MODE,
+            RS_STENCIL,
+            RS_SCISSOR,
+            RS_LIGHTING,
+            RS_SHADING,
+            RS_POINT,
+            RS_TEXTURE_STAGE
+        };
+
+        struct Command
+        {
+            CommandType type;
+            uint32 arg;
+            size_t count;
+        };
+        typedef std::vector<Command> CommandList;
+
+        /// Counters, which are always updated
+        struct Statistics
+        {
+            size_t frames;
+            size_t drawCalls;
+            /// Vertices or indices submitted, instances included
+            size_t elements;
+            /// Setter calls, which changed a state, compared with the state set before
+            size_t stateChanges;
+            size_t textureBinds;
+            size_t samplerChanges;
+            size_t constantUploads;
+            size_t constantFloats;
+            size_t renderTargetChanges;
+            size_t viewportChanges;
+            size_t clears;
+
+            Statistics() { reset(); }
+            void reset() { memset(this, 0, sizeof(Statistics)); }
+        };
+
+        NullRenderSystem();
+        ~NullRenderSystem();
+
+        /** Enable or disable the command log.
+        @remarks
+            The statistics are always kept up to date, the log is off by default since it
+            grows with every command.
+        */
+        void setCommandRecordingEnabled(bool enabled) { mRecordCommands = enabled; }
+        bool isCommandRecordingEnabled() const { return mRecordCommands; }
+        /// Commands recorded since the last clearCommandLog
+        const CommandList& getCommandLog() const { return mCommands; }
+        void clearCommandLog() { mCommands.clear(); }
+
+        /// Counters accumulated since the last resetStatistics
+        const Statistics& getStatistics() const { return mStats; }
+        void resetStatistics() { mStats.reset(); }
+
+        const String& getName(void) const;
+        void setConfigOption(const String &name, const String &value);
+        String validateConfigOptions(void) { return BLANKSTRING; }
+        RenderSystemCapabilities* createRenderSystemCapabilities() const;
+        void reinitialise(void);
+        void shutdown(void);
+
+        RenderWindow* _createRenderWindow(const String &name, unsigned int width, unsigned int height,
+            bool fullScreen, const NameValuePairList *miscParams = 0);
+        MultiRenderTarget* createMultiRenderTarget(const String& name);
+        DepthBuffer* _createDepthBufferFor(RenderTarget* renderTarget);
+        HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+
+        void _beginFrame(void);
+        void _endFrame(void);
+        void _setRenderTarget(RenderTarget* target);
+        void _setViewport(Viewport* vp);
+        void clearFrameBuffer(unsigned int buffers, const ColourValue& colour = ColourValue::Black,
+            Real depth = 1.0f, unsigned short stencil = 0);
+        void _render(const RenderOperation& op);
+
+        void _setTexture(size_t unit, bool enabled, const TexturePtr& texPtr);
+        void _setSampler(size_t texUnit, Sampler& s);
+        void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter);
+        void _setTextureAddressingMode(size_t unit, const Sampler::UVWAddressingMode& uvw);
+        void _setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm);
+        void _setTextureMatrix(size_t unit, const Matrix4& xform);
+        void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+            SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+            SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD);
+        void _setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage);
+        void _setCullingMode(CullingMode mode);
+        void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true,
+            CompareFunction depthFunction = CMPF_LESS_EQUAL);
+        void _setDepthBufferCheckEnabled(bool enabled = true);
+        void _setDepthBufferWriteEnabled(bool enabled = true);
+        void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL);
+        void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+        void _setDepthBias(float constantBias, float slopeScaleBias = 0.0f);
+        void _setPolygonMode(PolygonMode level);
+        void setStencilCheckEnabled(bool enabled);
+        void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS, uint32 refValue = 0,
+            uint32 compareMask = 0xFFFFFFFF, uint32 writeMask = 0xFFFFFFFF,
+            StencilOperation stencilFailOp = SOP_KEEP, StencilOperation depthFailOp = SOP_KEEP,
+            StencilOperation passOp = SOP_KEEP, bool twoSidedOperation = false,
+            bool readBackAsTexture = false);
+        void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+            size_t right = 800, size_t bottom = 600);
+        void setLightingEnabled(bool enabled);
+        void setShadingType(ShadeOptions so);
+        void _setPointParameters(bool attenuationEnabled, Real minSize, Real maxSize);
+        void _setPointSpritesEnabled(bool enabled);
+
+        void applyFixedFunctionParams(const GpuProgramParametersPtr& params, uint16 variabilityMask);
+        void bindGpuProgramParameters(GpuProgramType gptype,
+            const GpuProgramParametersPtr& params, uint16 variabilityMask);
+        void bindGpuProgramPassIterationParameters(GpuProgramType gptype);
+
+        VertexElementType getColourVertexElementType(void) const { return VET_COLOUR_ABGR; }
+        void _convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram = false);
+        Real getHorizontalTexelOffset(void) { return 0; }
+        Real getVerticalTexelOffset(void) { return 0; }
+        Real getMinimumDepthInputValue(void) { return -1; }
+        Real getMaximumDepthInputValue(void) { return 1; }
+
+        void preExtraThreadsStarted() {}
+        void postExtraThreadsStarted() {}
+        void registerThread() {}
+        void unregisterThread() {}
+        unsigned int getDisplayMonitorCount() const { return 1; }
+        void beginProfileEvent(const String& eventName) {}
+        void endProfileEvent(void) {}
+        void markProfileEvent(const String& event) {}
+
+    protected:
+        void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+
+    private:
+        HardwareBufferManager* mHardwareBufferManager;
+        GpuProgramManager* mGpuProgramManager;
+        bool mInitialised;
+        bool mRecordCommands;
+        CommandList mCommands;
+        Statistics mStats;
+        /// Values set so far, by RenderState, part of it and texture unit
+        std::map<uint32, std::vector<uchar> > mStateCache;
+
+        void record(CommandType type, uint32 arg = 0, size_t count = 0);
+        /// Store a part of a state, returns whether it differs from the value set before
+        bool updateState(RenderState state, const void* value, size_t size, uint32 part = 0,
+                         size_t unit = 0);
+        void stateChanged(RenderState state);
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullTexture_H__
+#define __NullTexture_H__
+
+#include "OgreNullRenderSystemExports.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreRenderTexture.h"
+#include "OgreTexture.h"
+#include "OgreTextureManager.h"
+
+namespace Ogre
+{
+    /** \addtogroup RenderSystems
+    *  @{
+    */
+    /** \addtogroup Null
+    *  @{
+    */
+
+    /// Pixel buffer in system memory
+    class _OgreNullExport NullHardwarePixelBuffer : public HardwarePixelBuffer
+    {
+    public:
+        /// Creates a RenderTexture per slice if the usage contains TU_RENDERTARGET
+        NullHardwarePixelBuffer(const String& name, uint32 width, uint32 height, uint32 depth,
+                                PixelFormat format, int usage);
+        ~NullHardwarePixelBuffer();
+
+        void blitFromMemory(const PixelBox& src, const Box& dstBox);
+        void blitToMemory(const Box& srcBox, const PixelBox& dst);
+
+        RenderTexture* getRenderTarget(size_t slice);
+        void _clearSliceRTT(size_t zoffset) { mSliceTRT[zoffset] = 0; }
+
+    protected:
+        PixelBox lockImpl(const Box& lockBox, LockOptions options);
+        void unlockImpl(void) {}
+
+    private:
+        std::vector<uchar> mData;
+        std::vector<RenderTexture*> mSliceTRT;
+
+        PixelBox getPixelBox() { return PixelBox(mWidth, mHeight, mDepth, mFormat, mData.data()); }
+    };
+
+    /// Render target writing to a NullHardwarePixelBuffer
+    class _OgreNullExport NullRenderTexture : public RenderTexture
+    {
+    public:
+        NullRenderTexture(const String& name, HardwarePixelBuffer* buffer, uint32 zoffset);
+        bool requiresTextureFlipping() const { return false; }
+    };
+
+    /// Texture, which keeps its surfaces in system memory
+    class _OgreNullExport NullTexture : public Texture
+    {
+    public:
+        NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                    const String& group, bool isManual, ManualResourceLoader* loader);
+        ~NullTexture();
+
+    protected:
+        void createInternalResourcesImpl(void);
+        void freeInternalResourcesImpl(void) {}
+    };
+
+    /// TextureManager of the NullRenderSystem, which supports every pixel format
+    class _OgreNullExport NullTextureManager : public TextureManager
+    {
+    public:
+        NullTextureManager();
+        ~NullTextureManager();
+
+        PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage);
+        bool isHardwareFilteringSupported(TextureType ttype, PixelFormat format, int usage,
+                                          bool preciseFormatOnly = false)
+        {
+            return true;
+        }
+
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, const String& group,
+                             bool isManual, ManualResourceLoader* loader,
+                             const NameValuePairList* createParams);
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -0,0 +1,562 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderSystem.h"
+#include "OgreNullTexture.h"
+#include "OgreNullWindow.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreDepthBuffer.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreHardwareOcclusionQuery.h"
+#include "OgreLogManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreViewport.h"
+
+namespace Ogre
+{
+    namespace
+    {
+        /// Nothing is rasterised, so nothing is ever visible
+        class NullOcclusionQuery : public HardwareOcclusionQuery
+        {
+        public:
+            void beginOcclusionQuery() {}
+            void endOcclusionQuery() {}
+            bool pullOcclusionQuery(unsigned int* NumOfFragments)
+            {
+                *NumOfFragments = mPixelCount = 0;
+                return true;
+            }
+            bool isStillOutstanding(void) { return false; }
+        };
+    }
+    //---------------------------------------------------------------------
+    NullRenderSystem::NullRenderSystem()
+        : mHardwareBufferManager(0), mGpuProgramManager(0), mInitialised(false),
+          mRecordCommands(false)
+    {
+        initConfigOptions();
+
+        ConfigOption optVideoMode;
+        optVideoMode.name = "Video Mode";
+        optVideoMode.possibleValues.push_back("800 x 600");
+        optVideoMode.currentValue = optVideoMode.possibleValues[0];
+        optVideoMode.immutable = false;
+        mOptions[optVideoMode.name] = optVideoMode;
+    }
+    //---------------------------------------------------------------------
+    NullRenderSystem::~NullRenderSystem()
+    {
+        shutdown();
+    }
+    //---------------------------------------------------------------------
+    const String& NullRenderSystem::getName(void) const
+    {
+        static String strName("Null Rendering Subsystem");
+        return strName;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setConfigOption(const String& name, const String& value)
+    {
+        ConfigOptionMap::iterator it = mOptions.find(name);
+        if (it == mOptions.end())
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Option named '" + name + "' does not exist.",
+                        "NullRenderSystem::setConfigOption");
+
+        // accept any resolution, there is no display to validate it against
+        if (name == "Video Mode" &&
+            std::find(it->second.possibleValues.begin(), it->second.possibleValues.end(), value) ==
+                it->second.possibleValues.end())
+        {
+            it->second.possibleValues.push_back(value);
+        }
+        it->second.currentValue = value;
+    }
+    //---------------------------------------------------------------------
+    RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+    {
+        RenderSystemCapabilities* rsc = OGRE_NEW RenderSystemCapabilities();
+
+        rsc->setRenderSystemName(getName());
+        rsc->setDeviceName("Null Device");
+        rsc->setDriverVersion(mDriverVersion);
+
+        rsc->setNumTextureUnits(OGRE_MAX_TEXTURE_LAYERS);
+        rsc->setNumMultiRenderTargets(1);
+        rsc->setNumVertexAttributes(16);
+        rsc->setStencilBufferBitDepth(8);
+        rsc->setMaxPointSize(256);
+        rsc->setMaxSupportedAnisotropy(16);
+
+        rsc->setCapability(RSC_FIXED_FUNCTION);
+        rsc->setCapability(RSC_AUTOMIPMAP_COMPRESSED);
+        rsc->setCapability(RSC_ANISOTROPY);
+        rsc->setCapability(RSC_DOT3);
+        rsc->setCapability(RSC_HWSTENCIL);
+        rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+        rsc->setCapability(RSC_STENCIL_WRAP);
+        rsc->setCapability(RSC_32BIT_INDEX);
+        rsc->setCapability(RSC_SCISSOR_TEST);
+        rsc->setCapability(RSC_HWOCCLUSION);
+        rsc->setCapability(RSC_USER_CLIP_PLANES);
+        rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+        rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+        rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+        rsc->setCapability(RSC_TEXTURE_FLOAT);
+        rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+        rsc->setCapability(RSC_TEXTURE_1D);
+        rsc->setCapability(RSC_TEXTURE_3D);
+        rsc->setCapability(RSC_POINT_SPRITES);
+        rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+        rsc->setCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA);
+        rsc->setCapability(RSC_RTT_DEPTHBUFFER_RESOLUTION_LESSEQUAL);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+
+        return rsc;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps,
+                                                                  RenderTarget* primary)
+    {
+        if (caps->getRenderSystemName() != getName())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Trying to initialize NullRenderSystem from RenderSystemCapabilities that do "
+                        "not support it",
+                        "NullRenderSystem::initialiseFromRenderSystemCapabilities");
+        }
+
+        mGpuProgramManager = new GpuProgramManager();
+        ResourceGroupManager::getSingleton()._registerResourceManager(
+            mGpuProgramManager->getResourceType(), mGpuProgramManager);
+
+        mHardwareBufferManager = new DefaultHardwareBufferManager();
+        mTextureManager = new NullTextureManager();
+
+        Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+        if (defaultLog)
+        {
+            caps->log(defaultLog);
+        }
+
+        mInitialised = true;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::reinitialise(void)
+    {
+        shutdown();
+        _initialise();
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::shutdown(void)
+    {
+        RenderSystem::shutdown();
+
+        if (mGpuProgramManager)
+        {
+            ResourceGroupManager::getSingleton()._unregisterResourceManager(
+                mGpuProgramManager->getResourceType());
+            OGRE_DELETE mGpuProgramManager;
+            mGpuProgramManager = 0;
+        }
+
+        OGRE_DELETE mHardwareBufferManager;
+        mHardwareBufferManager = 0;
+
+        OGRE_DELETE mTextureManager;
+        mTextureManager = 0;
+
+        mStateCache.clear();
+        mInitialised = false;
+    }
+    //---------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_createRenderWindow(const String& name, unsigned int width,
+                                                        unsigned int height, bool fullScreen,
+                                                        const NameValuePairList* miscParams)
+    {
+        if (mRenderTargets.find(name) != mRenderTargets.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Window with name '" + name + "' already exists",
+                        "NullRenderSystem::_createRenderWindow");
+        }
+
+        RenderWindow* win = new NullWindow();
+        win->create(name, width, height, fullScreen, miscParams);
+        attachRenderTarget(*win);
+
+        if (!mInitialised)
+        {
+            mRealCapabilities = createRenderSystemCapabilities();
+            initFixedFunctionParams(); // create params
+
+            // use real capabilities if custom capabilities are not available
+            if (!mUseCustomCapabilities)
+                mCurrentCapabilities = mRealCapabilities;
+
+            fireEvent("RenderSystemCapabilitiesCreated");
+
+            initialiseFromRenderSystemCapabilities(mCurrentCapabilities, win);
+        }
+
+        return win;
+    }
+    //---------------------------------------------------------------------
+    MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String& name)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "MRT is not supported",
+                    "NullRenderSystem::createMultiRenderTarget");
+    }
+    //---------------------------------------------------------------------
+    DepthBuffer* NullRenderSystem::_createDepthBufferFor(RenderTarget* renderTarget)
+    {
+        return new DepthBuffer(renderTarget->getDepthBufferPool(), 32, renderTarget->getWidth(),
+                               renderTarget->getHeight(), renderTarget->getFSAA(),
+                               renderTarget->getFSAAHint(), false);
+    }
+    //---------------------------------------------------------------------
+    HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+    {
+        NullOcclusionQuery* ret = new NullOcclusionQuery();
+        mHwOcclusionQueries.push_back(ret);
+        return ret;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::record(CommandType type, uint32 arg, size_t count)
+    {
+        if (!mRecordCommands)
+            return;
+
+        Command cmd = {type, arg, count};
+        mCommands.push_back(cmd);
+    }
+    //---------------------------------------------------------------------
+    bool NullRenderSystem::updateState(RenderState state, const void* value, size_t size,
+                                       uint32 part, size_t unit)
+    {
+        uint32 key = uint32(state) | (part << 8) | (uint32(unit) << 12);
+        const uchar* bytes = static_cast<const uchar*>(value);
+
+        std::vector<uchar>& cached = mStateCache[key];
+        if (cached.size() == size && std::equal(bytes, bytes + size, cached.begin()))
+            return false;
+
+        cached.assign(bytes, bytes + size);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::stateChanged(RenderState state)
+    {
+        mStats.stateChanges++;
+        record(CMD_SET_STATE, state);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_beginFrame(void)
+    {
+        mStats.frames++;
+        record(CMD_BEGIN_FRAME);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_endFrame(void)
+    {
+        record(CMD_END_FRAME);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setRenderTarget(RenderTarget* target)
+    {
+        mActiveRenderTarget = target;
+        mStats.renderTargetChanges++;
+        record(CMD_SET_RENDER_TARGET);
+
+        if (target && target->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH &&
+            !target->getDepthBuffer())
+        {
+            // Depth is automatically managed and there is no depth buffer attached to this RT
+            setDepthBufferFor(target);
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setViewport(Viewport* vp)
+    {
+        if (!vp)
+        {
+            mActiveViewport = NULL;
+            _setRenderTarget(NULL);
+        }
+        else if (vp != mActiveViewport || vp->_isUpdated())
+        {
+            _setRenderTarget(vp->getTarget());
+            mActiveViewport = vp;
+            vp->_clearUpdatedFlag();
+
+            mStats.viewportChanges++;
+            record(CMD_SET_VIEWPORT);
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::clearFrameBuffer(unsigned int buffers, const ColourValue& colour,
+                                            Real depth, unsigned short stencil)
+    {
+        mStats.clears++;
+        record(CMD_CLEAR, buffers);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_render(const RenderOperation& op)
+    {
+        // Call super class
+        RenderSystem::_render(op);
+
+        size_t count = op.useIndexes ? op.indexData->indexCount : op.vertexData->vertexCount;
+        count *= std::max<size_t>(op.numberOfInstances, 1);
+
+        mStats.drawCalls++;
+        mStats.elements += count;
+        record(CMD_DRAW, op.operationType, count);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setTexture(size_t unit, bool enabled, const TexturePtr& texPtr)
+    {
+        bool bound = enabled && texPtr;
+        if (bound)
+            mStats.textureBinds++;
+        record(CMD_SET_TEXTURE, uint32(unit), bound ? 1 : 0);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setSampler(size_t unit, Sampler& s)
+    {
+        mStats.samplerChanges++;
+        record(CMD_SET_SAMPLER, uint32(unit));
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setTextureUnitFiltering(size_t unit, FilterType ftype,
+                                                    FilterOptions filter)
+    {
+        mStats.samplerChanges++;
+        record(CMD_SET_SAMPLER, uint32(unit));
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setTextureAddressingMode(size_t unit,
+                                                     const Sampler::UVWAddressingMode& uvw)
+    {
+        mStats.samplerChanges++;
+        record(CMD_SET_SAMPLER, uint32(unit));
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm)
+    {
+        Real value[] = {Real(bm.blendType), Real(bm.operation), Real(bm.source1), Real(bm.source2),
+                        bm.colourArg1.r, bm.colourArg1.g, bm.colourArg1.b, bm.colourArg1.a,
+                        bm.colourArg2.r, bm.colourArg2.g, bm.colourArg2.b, bm.colourArg2.a,
+                        bm.alphaArg1, bm.alphaArg2, bm.factor};
+        if (updateState(RS_TEXTURE_STAGE, value, sizeof(value), 0, unit))
+            stateChanged(RS_TEXTURE_STAGE);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setTextureMatrix(size_t unit, const Matrix4& xform)
+    {
+        if (updateState(RS_TEXTURE_STAGE, xform[0], sizeof(Matrix4), 1, unit))
+            stateChanged(RS_TEXTURE_STAGE);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setSeparateSceneBlending(SceneBlendFactor sourceFactor,
+                                                     SceneBlendFactor destFactor,
+                                                     SceneBlendFactor sourceFactorAlpha,
+                                                     SceneBlendFactor destFactorAlpha,
+                                                     SceneBlendOperation op,
+                                                     SceneBlendOperation alphaOp)
+    {
+        int value[] = {sourceFactor, destFactor, sourceFactorAlpha, destFactorAlpha, op, alphaOp};
+        if (updateState(RS_BLEND, value, sizeof(value)))
+            stateChanged(RS_BLEND);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value,
+                                                   bool alphaToCoverage)
+    {
+        int state[] = {func, value, alphaToCoverage};
+        if (updateState(RS_ALPHA_REJECT, state, sizeof(state)))
+            stateChanged(RS_ALPHA_REJECT);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setCullingMode(CullingMode mode)
+    {
+        mCullingMode = mode;
+        int value = mode;
+        if (updateState(RS_CULLING, &value, sizeof(value)))
+            stateChanged(RS_CULLING);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferParams(bool depthTest, bool depthWrite,
+                                                 CompareFunction depthFunction)
+    {
+        int test = depthTest, write = depthWrite, func = depthFunction;
+        // evaluate all parts, so that the cache is up to date
+        bool changed = updateState(RS_DEPTH, &test, sizeof(test), 0);
+        changed = updateState(RS_DEPTH, &write, sizeof(write), 1) || changed;
+        changed = updateState(RS_DEPTH, &func, sizeof(func), 2) || changed;
+        if (changed)
+            stateChanged(RS_DEPTH);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
+    {
+        int value = enabled;
+        if (updateState(RS_DEPTH, &value, sizeof(value), 0))
+            stateChanged(RS_DEPTH);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
+    {
+        int value = enabled;
+        if (updateState(RS_DEPTH, &value, sizeof(value), 1))
+            stateChanged(RS_DEPTH);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferFunction(CompareFunction func)
+    {
+        int value = func;
+        if (updateState(RS_DEPTH, &value, sizeof(value), 2))
+            stateChanged(RS_DEPTH);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
+    {
+        int value[] = {red, green, blue, alpha};
+        if (updateState(RS_COLOUR_WRITE, value, sizeof(value)))
+            stateChanged(RS_COLOUR_WRITE);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
+    {
+        float value[] = {constantBias, slopeScaleBias};
+        if (updateState(RS_DEPTH_BIAS, value, sizeof(value)))
+            stateChanged(RS_DEPTH_BIAS);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setPolygonMode(PolygonMode level)
+    {
+        int value = level;
+        if (updateState(RS_POLYGON_MODE, &value, sizeof(value)))
+            stateChanged(RS_POLYGON_MODE);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setStencilCheckEnabled(bool enabled)
+    {
+        int value = enabled;
+        if (updateState(RS_STENCIL, &value, sizeof(value), 0))
+            stateChanged(RS_STENCIL);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setStencilBufferParams(CompareFunction func, uint32 refValue,
+                                                  uint32 compareMask, uint32 writeMask,
+                                                  StencilOperation stencilFailOp,
+                                                  StencilOperation depthFailOp,
+                                                  StencilOperation passOp, bool twoSidedOperation,
+                                                  bool readBackAsTexture)
+    {
+        uint32 value[] = {uint32(func), refValue, compareMask, writeMask, uint32(stencilFailOp),
+                          uint32(depthFailOp), uint32(passOp), twoSidedOperation};
+        if (updateState(RS_STENCIL, value, sizeof(value), 1))
+            stateChanged(RS_STENCIL);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setScissorTest(bool enabled, size_t left, size_t top, size_t right,
+                                          size_t bottom)
+    {
+        size_t value[] = {enabled, left, top, right, bottom};
+        if (updateState(RS_SCISSOR, value, sizeof(value)))
+            stateChanged(RS_SCISSOR);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setLightingEnabled(bool enabled)
+    {
+        int value = enabled;
+        if (updateState(RS_LIGHTING, &value, sizeof(value)))
+            stateChanged(RS_LIGHTING);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setShadingType(ShadeOptions so)
+    {
+        int value = so;
+        if (updateState(RS_SHADING, &value, sizeof(value)))
+            stateChanged(RS_SHADING);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setPointParameters(bool attenuationEnabled, Real minSize, Real maxSize)
+    {
+        Real value[] = {Real(attenuationEnabled), minSize, maxSize};
+        if (updateState(RS_POINT, value, sizeof(value), 0))
+            stateChanged(RS_POINT);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setPointSpritesEnabled(bool enabled)
+    {
+        int value = enabled;
+        if (updateState(RS_POINT, &value, sizeof(value), 1))
+            stateChanged(RS_POINT);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::applyFixedFunctionParams(const GpuProgramParametersPtr& params,
+                                                    uint16 variabilityMask)
+    {
+        // Autoconstant index is not a physical index
+        size_t floats = 0;
+        for (const auto& ac : params->getAutoConstants())
+        {
+            // Only count updated slots
+            if (ac.variability & variabilityMask)
+                floats += ac.elementCount;
+        }
+
+        mStats.constantUploads++;
+        mStats.constantFloats += floats;
+        record(CMD_UPLOAD_CONSTANTS, variabilityMask, floats);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+                                                    const GpuProgramParametersPtr& params,
+                                                    uint16 variabilityMask)
+    {
+        // no GPU programs are ever bound, but count what the caller sends anyway
+        size_t floats = params->getFloatConstantList().size();
+
+        mStats.constantUploads++;
+        mStats.constantFloats += floats;
+        record(CMD_UPLOAD_CONSTANTS, variabilityMask, floats);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
+    {
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest,
+                                                    bool forGpuProgram)
+    {
+        // same conventions as OpenGL
+        dest = matrix;
+    }
+}
@@ -0,0 +1,197 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullTexture.h"
+#include "OgreBitwise.h"
+#include "OgreImage.h"
+#include "OgreRenderSystem.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreRoot.h"
+
+namespace Ogre
+{
+    NullHardwarePixelBuffer::NullHardwarePixelBuffer(const String& name, uint32 width,
+                                                     uint32 height, uint32 depth,
+                                                     PixelFormat format, int usage)
+        : HardwarePixelBuffer(width, height, depth, format, (HardwareBuffer::Usage)usage, true,
+                              false)
+    {
+        mSizeInBytes = PixelUtil::getMemorySize(width, height, depth, format);
+        mData.resize(mSizeInBytes);
+
+        if (!(mUsage & TU_RENDERTARGET) || mSizeInBytes == 0)
+            return;
+
+        // Create render target for each slice
+        mSliceTRT.reserve(mDepth);
+        for (uint32 zoffset = 0; zoffset < mDepth; ++zoffset)
+        {
+            String rttName = "rtt/" + StringConverter::toString((size_t)this) + "/" + name;
+            RenderTexture* trt = new NullRenderTexture(rttName, this, zoffset);
+            mSliceTRT.push_back(trt);
+            Root::getSingleton().getRenderSystem()->attachRenderTarget(*trt);
+        }
+    }
+    //---------------------------------------------------------------------
+    NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+    {
+        // Delete all render targets that are not yet deleted via _clearSliceRTT because the
+        // rendertarget was deleted by the user.
+        for (size_t i = 0; i < mSliceTRT.size(); ++i)
+        {
+            if (mSliceTRT[i])
+                Root::getSingleton().getRenderSystem()->destroyRenderTarget(mSliceTRT[i]->getName());
+        }
+    }
+    //---------------------------------------------------------------------
+    PixelBox NullHardwarePixelBuffer::lockImpl(const Box& lockBox, LockOptions options)
+    {
+        return getPixelBox().getSubVolume(lockBox);
+    }
+    //---------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitFromMemory(const PixelBox& src, const Box& dstBox)
+    {
+        if (!getPixelBox().contains(dstBox))
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Destination box out of range",
+                        "NullHardwarePixelBuffer::blitFromMemory");
+
+        PixelBox dst = getPixelBox().getSubVolume(dstBox);
+        if (src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+            src.getDepth() == dst.getDepth())
+            PixelUtil::bulkPixelConversion(src, dst);
+        else
+            Image::scale(src, dst);
+    }
+    //---------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitToMemory(const Box& srcBox, const PixelBox& dst)
+    {
+        if (!getPixelBox().contains(srcBox))
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Source box out of range",
+                        "NullHardwarePixelBuffer::blitToMemory");
+
+        PixelBox src = getPixelBox().getSubVolume(srcBox);
+        if (src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+            src.getDepth() == dst.getDepth())
+            PixelUtil::bulkPixelConversion(src, dst);
+        else
+            Image::scale(src, dst);
+    }
+    //---------------------------------------------------------------------
+    RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+    {
+        assert(mUsage & TU_RENDERTARGET);
+        assert(zoffset < mDepth);
+        return mSliceTRT[zoffset];
+    }
+    //---------------------------------------------------------------------
+    NullRenderTexture::NullRenderTexture(const String& name, HardwarePixelBuffer* buffer,
+                                         uint32 zoffset)
+        : RenderTexture(buffer, zoffset)
+    {
+        mName = name;
+    }
+    //---------------------------------------------------------------------
+    NullTexture::NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                             const String& group, bool isManual, ManualResourceLoader* loader)
+        : Texture(creator, name, handle, group, isManual, loader)
+    {
+    }
+    //---------------------------------------------------------------------
+    NullTexture::~NullTexture()
+    {
+        // have to call this here rather than in Resource destructor
+        // since calling virtual methods in base destructors causes crash
+        if (isLoaded())
+        {
+            unload();
+        }
+        else
+        {
+            freeInternalResources();
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullTexture::createInternalResourcesImpl(void)
+    {
+        mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+        // Check requested number of mipmaps.
+        if (PixelUtil::isCompressed(mFormat) && (mNumMipmaps == 0))
+            mNumRequestedMipmaps = 0;
+        // see ARB_texture_non_power_of_two
+        uint32 maxMips = Bitwise::mostSignificantBitSet(std::max(mWidth, std::max(mHeight, mDepth)));
+        mNumMipmaps = std::min(mNumRequestedMipmaps, maxMips);
+
+        mSurfaceList.clear();
+        for (uint32 face = 0; face < getNumFaces(); face++)
+        {
+            uint32 width = mWidth;
+            uint32 height = mHeight;
+            uint32 depth = mDepth;
+            for (uint32 mip = 0; mip <= mNumMipmaps; mip++)
+            {
+                mSurfaceList.push_back(HardwarePixelBufferSharedPtr(new NullHardwarePixelBuffer(
+                    mName, width, height, depth, mFormat, mUsage)));
+
+                if (width > 1)
+                    width = width / 2;
+                if (height > 1)
+                    height = height / 2;
+                if (depth > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+                    depth = depth / 2;
+            }
+        }
+
+        mSize = getNumFaces() * PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
+    }
+    //---------------------------------------------------------------------
+    NullTextureManager::NullTextureManager()
+    {
+        // Register with group manager
+        ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+    }
+    //---------------------------------------------------------------------
+    NullTextureManager::~NullTextureManager()
+    {
+        // Unregister with group manager
+        ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+    }
+    //---------------------------------------------------------------------
+    PixelFormat NullTextureManager::getNativeFormat(TextureType ttype, PixelFormat format, int usage)
+    {
+        // memory surfaces can hold any format, only pick one if the caller did not
+        return format == PF_UNKNOWN ? PF_BYTE_RGBA : format;
+    }
+    //---------------------------------------------------------------------
+    Resource* NullTextureManager::createImpl(const String& name, ResourceHandle handle,
+                                             const String& group, bool isManual,
+                                             ManualResourceLoader* loader,
+                                             const NameValuePairList* createParams)
+    {
+        return new NullTexture(this, name, handle, group, isManual, loader);
+    }
+}
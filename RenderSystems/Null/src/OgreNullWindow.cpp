@@ -0,0 +1,111 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullWindow.h"
+#include "OgreStringConverter.h"
+#include "OgreViewport.h"
+
+namespace Ogre
+{
+    NullWindow::NullWindow() : mClosed(false), mHidden(false)
+    {
+        mIsFullScreen = false;
+        mActive = false;
+    }
+    //---------------------------------------------------------------------
+    NullWindow::~NullWindow()
+    {
+        destroy();
+    }
+    //---------------------------------------------------------------------
+    void NullWindow::create(const String& name, unsigned int width, unsigned int height,
+                            bool fullScreen, const NameValuePairList* miscParams)
+    {
+        mName = name;
+        mWidth = width;
+        mHeight = height;
+        mIsFullScreen = fullScreen;
+        mColourDepth = 32;
+        mClosed = false;
+        mActive = true;
+
+        if (miscParams)
+        {
+            NameValuePairList::const_iterator opt;
+            if ((opt = miscParams->find("hidden")) != miscParams->end())
+                mHidden = StringConverter::parseBool(opt->second);
+            if ((opt = miscParams->find("FSAA")) != miscParams->end())
+                mFSAA = StringConverter::parseUnsignedInt(opt->second);
+            if ((opt = miscParams->find("gamma")) != miscParams->end())
+                mHwGamma = StringConverter::parseBool(opt->second);
+            if ((opt = miscParams->find("left")) != miscParams->end())
+                mLeft = StringConverter::parseInt(opt->second);
+            if ((opt = miscParams->find("top")) != miscParams->end())
+                mTop = StringConverter::parseInt(opt->second);
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullWindow::destroy(void)
+    {
+        mClosed = true;
+        mActive = false;
+    }
+    //---------------------------------------------------------------------
+    void NullWindow::resize(unsigned int width, unsigned int height)
+    {
+        if (mClosed || (mWidth == width && mHeight == height))
+            return;
+
+        mWidth = width;
+        mHeight = height;
+
+        for (ViewportList::iterator it = mViewportList.begin(); it != mViewportList.end(); ++it)
+            (*it).second->_updateDimensions();
+    }
+    //---------------------------------------------------------------------
+    void NullWindow::reposition(int left, int top)
+    {
+        mLeft = left;
+        mTop = top;
+    }
+    //---------------------------------------------------------------------
+    void NullWindow::copyContentsToMemory(const Box& src, const PixelBox& dst, FrameBuffer buffer)
+    {
+        if (src.right > mWidth || src.bottom > mHeight || src.front != 0 || src.back != 1 ||
+            dst.getWidth() != src.getWidth() || dst.getHeight() != src.getHeight() ||
+            dst.getDepth() != 1)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid box", "NullWindow::copyContentsToMemory");
+        }
+
+        // nothing is rasterised, so the window is always black
+        PixelBox box = dst;
+        for (uint32 y = 0; y < box.getHeight(); ++y)
+            for (uint32 x = 0; x < box.getWidth(); ++x)
+                box.setColourAt(ColourValue::Black, x, y, 0);
+    }
+}
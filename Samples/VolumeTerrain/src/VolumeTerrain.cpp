@@ -157,11 +157,17 @@ void Sample_VolumeTerrain::shootRay(Ray ray, bool doUnion)
         Real radius = (Real)2.5;
         CSGSphereSource sphere(radius, intersection);
         CSGOperationSource *operation = doUnion ? static_cast<CSGOperationSource*>(new CSGUnionSource()) : new CSGDifferenceSource();
-        static_cast<TextureSource*>(mVolumeRoot->getChunkParameters()->src)->combineWithSource(operation, &sphere, intersection, radius * (Real)1.5);
+        TextureSource *src = static_cast<TextureSource*>(mVolumeRoot->getChunkParameters()->src);
+        src->combineWithSource(operation, &sphere, intersection, radius * (Real)1.5);
         
-        mVolumeRoot->getChunkParameters()->updateFrom = intersection - radius * (Real)1.5;
-        mVolumeRoot->getChunkParameters()->updateTo = intersection + radius * (Real)1.5;
-        mVolumeRoot->load(mVolumeRootNode, Vector3::ZERO, Vector3(384), 5, mVolumeRoot->getChunkParameters());
+        // Remesh just what the edit changed.
+        if (!src->getDirtyRegion().isNull())
+        {
+            mVolumeRoot->getChunkParameters()->updateFrom = src->getDirtyRegion().getMinimum();
+            mVolumeRoot->getChunkParameters()->updateTo = src->getDirtyRegion().getMaximum();
+            mVolumeRoot->load(mVolumeRootNode, Vector3::ZERO, Vector3(384), 5, mVolumeRoot->getChunkParameters());
+            src->clearDirtyRegion();
+        }
         delete operation;
     }
 }
@@ -0,0 +1,382 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Ogre.h"
+#include "OgreFrameCounters.h"
+#include "OgreNullPlugin.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreTaskGraph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+/* CPU cost per frame of the reference scenes, rendered on the Null RenderSystem.
+
+    Usage: Benchmark_Ogre [-f frames] [-t trace.json] [scene...]
+
+    Every scene is rendered for a number of frames after a short warm up. The time of
+    each subsystem is averaged over the frames and printed together with the
+    FrameCounters and the commands the Null RenderSystem received. With OGRE_PROFILING
+    the frames are also written as a Chrome trace.
+*/
+
+using namespace Ogre;
+
+namespace
+{
+    /// Times the scene graph update and the visibility search of every rendered viewport
+    class SubsystemTimer : public SceneManager::Listener
+    {
+    public:
+        uint64 sceneGraph;
+        uint64 visibility;
+
+        SubsystemTimer() : sceneGraph(0), visibility(0), mStart(0) {}
+
+        void preUpdateSceneGraph(SceneManager*, Camera*) { mStart = mTimer.getMicroseconds(); }
+        void postUpdateSceneGraph(SceneManager*, Camera*) { sceneGraph += mTimer.getMicroseconds() - mStart; }
+        void preFindVisibleObjects(SceneManager*, SceneManager::IlluminationRenderStage, Viewport*)
+        {
+            mStart = mTimer.getMicroseconds();
+        }
+        void postFindVisibleObjects(SceneManager*, SceneManager::IlluminationRenderStage, Viewport*)
+        {
+            visibility += mTimer.getMicroseconds() - mStart;
+        }
+
+    private:
+        Timer mTimer;
+        uint64 mStart;
+    };
+
+    struct ReferenceScene
+    {
+        const char* name;
+        const char* description;
+        void (*create)(SceneManager* sceneMgr);
+    };
+
+    MaterialPtr createMaterial(const String& name, const ColourValue& colour, bool lighting)
+    {
+        // kept for the following scenes
+        MaterialPtr mat = MaterialManager::getSingleton().getByName(name, RGN_DEFAULT);
+        if (mat)
+            return mat;
+        mat = MaterialManager::getSingleton().create(name, RGN_DEFAULT);
+        Pass* pass = mat->getTechnique(0)->getPass(0);
+        pass->setLightingEnabled(lighting);
+        pass->setDiffuse(colour);
+        pass->setAmbient(colour * 0.2f);
+        return mat;
+    }
+
+    /// A grid of small cubes in view
+    void createGrid(SceneManager* sceneMgr, int rows, int columns, size_t materials, bool lighting)
+    {
+        std::vector<MaterialPtr> mats;
+        for (size_t i = 0; i < materials; i++)
+        {
+            mats.push_back(createMaterial("Benchmark/Grid" + StringConverter::toString(i),
+                ColourValue(Real(i % 4) / 3, Real(i % 5) / 4, Real(i % 7) / 6), lighting));
+        }
+
+        SceneManager::PrefabType mesh = lighting ? SceneManager::PT_SPHERE : SceneManager::PT_CUBE;
+        for (int y = 0; y < rows; y++)
+        {
+            for (int x = 0; x < columns; x++)
+            {
+                SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode();
+                node->setPosition(Real(x - columns / 2) * 12, Real(y - rows / 2) * 12, 0);
+                node->setScale(Vector3(0.1f));
+                Entity* ent = sceneMgr->createEntity(mesh);
+                ent->setMaterial(mats[(y * columns + x) % mats.size()]);
+                node->attachObject(ent);
+            }
+        }
+    }
+
+    /// Many batches sharing one material
+    void createBatches(SceneManager* sceneMgr)
+    {
+        createGrid(sceneMgr, 25, 40, 1, false);
+    }
+
+    /// Many batches cycling through materials, so passes and state change between them
+    void createMaterials(SceneManager* sceneMgr)
+    {
+        createGrid(sceneMgr, 25, 40, 50, false);
+    }
+
+    /// Lit spheres among many point lights
+    void createLights(SceneManager* sceneMgr)
+    {
+        createGrid(sceneMgr, 20, 25, 4, true);
+        sceneMgr->setAmbientLight(ColourValue(0.2f, 0.2f, 0.2f));
+        for (int i = 0; i < 32; i++)
+        {
+            Light* light = sceneMgr->createLight();
+            light->setType(Light::LT_POINT);
+            light->setAttenuation(60, 1, 0.05f, 0);
+            light->setDiffuseColour(ColourValue(Real(i % 2), Real(i % 3) / 2, 1));
+            SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode();
+            node->setPosition(Real(i % 8 - 4) * 40, Real(i / 8 - 2) * 40, 20);
+            node->attachObject(light);
+        }
+    }
+
+    /// A deep node hierarchy moved by a node animation every frame
+    void createHierarchy(SceneManager* sceneMgr)
+    {
+        Animation* anim = sceneMgr->createAnimation("Benchmark/Spin", 4);
+        anim->setInterpolationMode(Animation::IM_LINEAR);
+        unsigned short track = 0;
+        for (int arm = 0; arm < 64; arm++)
+        {
+            SceneNode* parent = sceneMgr->getRootSceneNode()->createChildSceneNode();
+            parent->setPosition(Real(arm % 8 - 4) * 30, Real(arm / 8 - 4) * 30, 0);
+            NodeAnimationTrack* spin = anim->createNodeTrack(track++, parent);
+            for (int k = 0; k <= 4; k++)
+                spin->createNodeKeyFrame(Real(k))->setRotation(Quaternion(Degree(Real(k) * 90), Vector3::UNIT_Z));
+
+            // each link is rotated by its parent
+            for (int link = 0; link < 32; link++)
+            {
+                parent = parent->createChildSceneNode(Vector3(2, 0, 0), Quaternion(Degree(10), Vector3::UNIT_Y));
+                if (link % 4 == 3)
+                {
+                    SceneNode* leaf = parent->createChildSceneNode();
+                    leaf->setScale(Vector3(0.02f));
+                    leaf->attachObject(sceneMgr->createEntity(SceneManager::PT_CUBE));
+                }
+            }
+        }
+        AnimationState* state = sceneMgr->createAnimationState("Benchmark/Spin");
+        state->setEnabled(true);
+        state->setLoop(true);
+    }
+
+    /// A large billboard set, regenerated every frame
+    void createBillboards(SceneManager* sceneMgr)
+    {
+        const int count = 20000;
+        BillboardSet* set = sceneMgr->createBillboardSet(count);
+        set->setDefaultDimensions(2, 2);
+        for (int i = 0; i < count; i++)
+        {
+            set->createBillboard(Vector3(Real(i % 200 - 100) * 2, Real(i / 200 - 50) * 2, Real(i % 7) * -5),
+                                 ColourValue(Real(i % 3) / 2, Real(i % 5) / 4, 1));
+        }
+        sceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(set);
+    }
+
+    const ReferenceScene SCENES[] = {
+        { "batches", "1000 cubes, one material", &createBatches },
+        { "materials", "1000 cubes, 50 materials", &createMaterials },
+        { "lights", "500 lit spheres, 32 point lights", &createLights },
+        { "hierarchy", "64 animated chains of 32 nodes, 512 cubes", &createHierarchy },
+        { "billboards", "20000 billboards in one set", &createBillboards },
+    };
+
+    const FrameCounters::Counter REPORTED_COUNTERS[] = {
+        FrameCounters::FC_NODES_UPDATED,
+        FrameCounters::FC_OBJECTS_VISIBLE,
+        FrameCounters::FC_OBJECTS_CULLED,
+        FrameCounters::FC_RENDERABLES_QUEUED,
+        FrameCounters::FC_PASSES_SET,
+        FrameCounters::FC_PASS_CACHE_HITS,
+        FrameCounters::FC_AUTO_PARAMS_WRITTEN,
+        FrameCounters::FC_LIGHTS_EVALUATED,
+        FrameCounters::FC_BUFFER_LOCKS,
+    };
+    const size_t NUM_REPORTED_COUNTERS = sizeof(REPORTED_COUNTERS) / sizeof(REPORTED_COUNTERS[0]);
+
+    void printTime(const char* subsystem, uint64 total, int frames)
+    {
+        std::cout << "    " << std::left << std::setw(24) << subsystem << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << double(total) / frames << " us\n";
+    }
+
+    void printCount(const char* name, size_t total, int frames)
+    {
+        std::cout << "    " << std::left << std::setw(24) << name << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << double(total) / frames << "\n";
+    }
+
+    void runScene(Root* root, NullRenderSystem* renderSystem, RenderWindow* window,
+                  const ReferenceScene& scene, int frames)
+    {
+        SceneManager* sceneMgr = root->createSceneManager();
+        Camera* camera = sceneMgr->createCamera("Camera");
+        camera->setNearClipDistance(1);
+        SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+        camNode->attachObject(camera);
+        camNode->setPosition(0, 0, 400);
+        window->removeAllViewports();
+        window->addViewport(camera);
+
+        scene.create(sceneMgr);
+        AnimationState* anim =
+            sceneMgr->hasAnimationState("Benchmark/Spin") ? sceneMgr->getAnimationState("Benchmark/Spin") : 0;
+
+        SubsystemTimer subsystems;
+        sceneMgr->addListener(&subsystems);
+        TaskGraph* frameUpdate = sceneMgr->getFrameUpdateGraph();
+
+        // the first frames build the vertex data and fill the caches
+        const int warmUp = 5;
+        uint64 total = 0;
+        std::vector<uint64> phases(frameUpdate->getNumPhases());
+        std::vector<size_t> counters(NUM_REPORTED_COUNTERS);
+        NullRenderSystem::Statistics commands;
+        Timer timer;
+        for (int i = -warmUp; i < frames; i++)
+        {
+            if (i == 0)
+            {
+                subsystems.sceneGraph = subsystems.visibility = 0;
+                renderSystem->resetStatistics();
+            }
+            if (anim)
+                anim->addTime(1 / 60.0f);
+
+            timer.reset();
+            root->renderOneFrame();
+            uint64 frame = timer.getMicroseconds();
+            if (i < 0)
+                continue;
+
+            total += frame;
+            for (size_t p = 0; p < phases.size(); p++)
+                phases[p] += frameUpdate->getPhaseTime(p);
+            for (size_t c = 0; c < NUM_REPORTED_COUNTERS; c++)
+                counters[c] += FrameCounters::getLastFrame(REPORTED_COUNTERS[c]);
+        }
+        commands = renderSystem->getStatistics();
+        sceneMgr->removeListener(&subsystems);
+
+        std::cout << scene.name << ": " << scene.description << "\n";
+        printTime("frame", total, frames);
+        uint64 rest = total - std::min(total, subsystems.sceneGraph + subsystems.visibility);
+        for (size_t p = 0; p < phases.size(); p++)
+        {
+            printTime(frameUpdate->getPhaseName(p).c_str(), phases[p], frames);
+            rest -= std::min(rest, phases[p]);
+        }
+        printTime("_updateSceneGraph", subsystems.sceneGraph, frames);
+        printTime("_findVisibleObjects", subsystems.visibility, frames);
+        printTime("rendering", rest, frames);
+        for (size_t c = 0; c < NUM_REPORTED_COUNTERS; c++)
+            printCount(FrameCounters::getName(REPORTED_COUNTERS[c]), counters[c], frames);
+        printCount("draw calls", commands.drawCalls, frames);
+        printCount("state changes", commands.stateChanges, frames);
+        printCount("constant uploads", commands.constantUploads, frames);
+        std::cout << std::endl;
+
+        window->removeAllViewports();
+        root->destroySceneManager(sceneMgr);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int frames = 200;
+    String traceFile;
+    std::vector<String> selected;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc)
+            frames = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            traceFile = argv[++i];
+        else
+            selected.push_back(argv[i]);
+    }
+
+    LogManager* logMgr = new LogManager();
+    logMgr->createLog("OgreBenchmark.log", true, false, false);
+
+    Root* root = new Root("");
+    NullPlugin* plugin = new NullPlugin();
+    root->installPlugin(plugin);
+    NullRenderSystem* renderSystem =
+        static_cast<NullRenderSystem*>(root->getRenderSystemByName("Null Rendering Subsystem"));
+    root->setRenderSystem(renderSystem);
+    root->initialise(false);
+    RenderWindow* window = root->createRenderWindow("Benchmark", 1280, 720, false);
+
+#if OGRE_PROFILING
+    ChromeTraceSessionListener* trace = 0;
+    if (!traceFile.empty())
+    {
+        trace = new ChromeTraceSessionListener(traceFile);
+        Profiler::getSingleton().addListener(trace);
+        Profiler::getSingleton().setEnabled(true);
+        Profiler::getSingleton().setTraceEnabled(true);
+    }
+#else
+    if (!traceFile.empty())
+        std::cerr << "Traces need a build with OGRE_PROFILING" << std::endl;
+#endif
+
+    int result = 0;
+    std::vector<String>::iterator s;
+    for (s = selected.begin(); s != selected.end(); ++s)
+    {
+        bool found = false;
+        for (size_t i = 0; i < sizeof(SCENES) / sizeof(SCENES[0]); i++)
+            found = found || *s == SCENES[i].name;
+        if (!found)
+        {
+            std::cerr << "Unknown scene " << *s << std::endl;
+            result = 1;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(SCENES) / sizeof(SCENES[0]) && result == 0; i++)
+    {
+        if (selected.empty() || std::find(selected.begin(), selected.end(), SCENES[i].name) != selected.end())
+            runScene(root, renderSystem, window, SCENES[i], frames);
+    }
+
+#if OGRE_PROFILING
+    if (trace)
+    {
+        Profiler::getSingleton().setTraceEnabled(false);
+        Profiler::getSingleton().setEnabled(false);
+        Profiler::getSingleton().removeListener(trace);
+        delete trace;
+    }
+#endif
+
+    delete root;
+    delete plugin;
+    delete logMgr;
+    return result;
+}
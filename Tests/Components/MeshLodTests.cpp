@@ -188,6 +188,30 @@ TEST_F(MeshLodTests,QuadricError)
     gen.generateLodLevels(config, LodCollapseCostPtr(new LodCollapseCostQuadric()));
 }
 //--------------------------------------------------------------------------
+TEST_F(MeshLodTests,BatchGeneration)
+{
+    LodConfig config;
+    setTestLodConfig(config);
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    gen.generateLodLevels(config);
+    mMesh->removeLodLevels();
+
+    MeshPtr head = MeshManager::getSingleton().load("ogrehead.mesh", ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+    std::vector<LodConfig> configs(2, config);
+    configs[1].mesh = head;
+    gen.generateLodLevels(configs);
+
+    EXPECT_GT(mMesh->getNumLodLevels(), 1);
+    EXPECT_GT(head->getNumLodLevels(), 1);
+    ASSERT_EQ(config.levels.size(), configs[0].levels.size());
+    for (size_t i = 0; i < config.levels.size(); i++)
+    {
+        EXPECT_EQ(config.levels[i].outSkipped, configs[0].levels[i].outSkipped);
+        EXPECT_EQ(config.levels[i].outUniqueVertexCount, configs[0].levels[i].outUniqueVertexCount);
+    }
+    head->unload();
+}
+//--------------------------------------------------------------------------
 void MeshLodTests::setTestLodConfig(LodConfig& config)
 {
     config.mesh = mMesh;
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreShaderFFPColour.h"
 
 #include "OgreShaderFunctionAtom.h"
+#include "OgreTaskScheduler.h"
 
 using namespace Ogre;
 
@@ -131,3 +132,98 @@ TEST_F(RTShaderSystem, FunctionInvocationOrder)
     EXPECT_TRUE(c == a);
     EXPECT_FALSE(c < a);
 }
+
+TEST_F(RTShaderSystem, ProgramReuse)
+{
+    using namespace RTShader;
+    auto& shaderGen = ShaderGenerator::getSingleton();
+
+    std::vector<Pass*> passes;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto mat = MaterialManager::getSingleton().create("TestMat" + StringConverter::toString(i), RGN_DEFAULT);
+        passes.push_back(mat->getTechniques()[0]->getPasses()[0]);
+    }
+
+    TargetRenderState first, second, other;
+    for (auto targetRenderState : {&first, &second, &other})
+        targetRenderState->addSubRenderStateInstance(shaderGen.createSubRenderState<FFPTransform>());
+    first.addSubRenderStateInstance(shaderGen.createSubRenderState<FFPColour>());
+    second.addSubRenderStateInstance(shaderGen.createSubRenderState<FFPColour>());
+
+    first.acquirePrograms(passes[0]);
+    second.acquirePrograms(passes[1]);
+    other.acquirePrograms(passes[2]);
+
+    // equal render states share their programs, which are found by their structure
+    EXPECT_EQ(passes[0]->getVertexProgram(), passes[1]->getVertexProgram());
+    EXPECT_EQ(passes[0]->getFragmentProgram(), passes[1]->getFragmentProgram());
+    EXPECT_NE(passes[0]->getFragmentProgram(), passes[2]->getFragmentProgram());
+}
+
+struct ValidationCounter : public RTShader::ShaderGenerator::ValidationListener
+{
+    std::vector<size_t> validated;
+    size_t total = 0;
+
+    void techniqueValidated(const String& schemeName, size_t count, size_t totalCount)
+    {
+        validated.push_back(count);
+        total = totalCount;
+    }
+};
+
+TEST_F(RTShaderSystem, ParallelValidation)
+{
+    using namespace RTShader;
+    auto& shaderGen = ShaderGenerator::getSingleton();
+
+    mRoot->getTaskScheduler()->shutdown();
+    mRoot->getTaskScheduler()->startup(3);
+
+    // more than one chunk of techniques with a few different render states
+    const size_t count = 100;
+    std::vector<MaterialPtr> materials;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto mat = MaterialManager::getSingleton().create("TestMat" + StringConverter::toString(i), RGN_DEFAULT);
+        Pass* pass = mat->getTechniques()[0]->getPasses()[0];
+        pass->setLightingEnabled(i % 2 == 0);
+        pass->setVertexColourTracking(i % 3 == 0 ? TVC_DIFFUSE : TVC_NONE);
+        pass->setFog(i % 5 == 0, FOG_LINEAR);
+        materials.push_back(mat);
+    }
+
+    ValidationCounter counter;
+    shaderGen.setValidationListener(&counter);
+
+    std::vector<String> programNames[2];
+    for (bool parallel : {false, true})
+    {
+        shaderGen.setParallelValidation(parallel);
+        for (auto& mat : materials)
+            shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+
+        counter.validated.clear();
+        shaderGen.validateScheme("MyScheme");
+
+        ASSERT_EQ(counter.validated.size(), count);
+        EXPECT_EQ(counter.total, count);
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(counter.validated[i], i + 1);
+
+        for (auto& mat : materials)
+        {
+            Pass* pass = mat->getTechniques()[1]->getPasses()[0];
+            programNames[parallel].push_back(pass->getVertexProgramName());
+            programNames[parallel].push_back(pass->getFragmentProgramName());
+        }
+
+        // generate the programs again from scratch
+        shaderGen.removeAllShaderBasedTechniques();
+        ProgramManager::getSingleton().flushGpuProgramsCache();
+    }
+
+    EXPECT_EQ(programNames[0], programNames[1]);
+    shaderGen.setValidationListener(NULL);
+}
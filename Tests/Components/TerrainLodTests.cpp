@@ -0,0 +1,317 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "Ogre.h"
+#include "OgreNullPlugin.h"
+#include "OgreTerrain.h"
+#include "OgreTerrainGroup.h"
+#include "OgreTerrainQuadTreeNode.h"
+#include "OgreTerrainMaterialGenerator.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Plain materials with two LOD techniques, all the Null RenderSystem needs
+    class LodMaterialGenerator : public TerrainMaterialGenerator
+    {
+    public:
+        class LodProfile : public Profile
+        {
+        public:
+            LodProfile(TerrainMaterialGenerator* parent) : Profile(parent, "LOD", "Two LOD techniques") {}
+            bool isVertexCompressionSupported() const { return false; }
+            MaterialPtr generate(const Terrain* terrain)
+            {
+                String name = "TerrainLodTests/" + StringConverter::toString(terrain->getPosition());
+                MaterialPtr mat = MaterialManager::getSingleton().getByName(name);
+                if (!mat)
+                    mat = MaterialManager::getSingleton().create(name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+                mat->removeAllTechniques();
+                mat->createTechnique()->createPass();
+                Technique* far = mat->createTechnique();
+                far->createPass();
+                far->setLodIndex(1);
+                Material::LodValueList lodValues;
+                lodValues.push_back(static_cast<LodMaterialGenerator*>(mParent)->lodDistance);
+                mat->setLodLevels(lodValues);
+                return mat;
+            }
+            MaterialPtr generateForCompositeMap(const Terrain* terrain) { return MaterialPtr(); }
+            void setLightmapEnabled(bool enabled) {}
+            uint8 getMaxLayers(const Terrain* terrain) const { return 1; }
+            void updateParams(const MaterialPtr& mat, const Terrain* terrain) {}
+            void updateParamsForCompositeMap(const MaterialPtr& mat, const Terrain* terrain) {}
+            void requestOptions(Terrain* terrain)
+            {
+                terrain->_setMorphRequired(false);
+                terrain->_setNormalMapRequired(false);
+                terrain->_setLightMapRequired(false);
+                terrain->_setCompositeMapRequired(false);
+            }
+        };
+
+        Real lodDistance;
+
+        LodMaterialGenerator() : lodDistance(600)
+        {
+            mProfiles.push_back(OGRE_NEW LodProfile(this));
+        }
+    };
+
+    struct TechniqueLods : public Renderable::Visitor
+    {
+        std::vector<int>* lods;
+        void visit(Renderable* rend, ushort lodIndex, bool isDebug, Any* pAny)
+        {
+            lods->push_back(rend->getTechnique()->getLodIndex());
+        }
+    };
+
+    /// The LOD, transition and material LOD of all nodes of a terrain
+    void collectLods(TerrainQuadTreeNode* node, std::vector<float>& lods)
+    {
+        lods.push_back(float(node->getCurrentLod()));
+        lods.push_back(node->getLodTransition());
+        if (!node->isLeaf())
+        {
+            for (unsigned short i = 0; i < 4; ++i)
+                collectLods(node->getChild(i), lods);
+        }
+    }
+    std::vector<float> collectLods(Terrain* t)
+    {
+        std::vector<float> lods;
+        collectLods(t->getQuadTree(), lods);
+
+        std::vector<int> techniqueLods;
+        TechniqueLods visitor;
+        visitor.lods = &techniqueLods;
+        const Node::ChildNodeMap& nodes = t->_getRootSceneNode()->getChildren();
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            SceneNode* node = static_cast<SceneNode*>(nodes[i]);
+            if (node->numAttachedObjects())
+                node->getAttachedObject(0)->visitRenderables(&visitor);
+        }
+        lods.insert(lods.end(), techniqueLods.begin(), techniqueLods.end());
+        return lods;
+    }
+}
+
+class TerrainLodTests : public ::testing::Test
+{
+public:
+    NullPlugin* mPlugin;
+    Root* mRoot;
+    SceneManager* mSceneMgr;
+    Camera* mCamera;
+    Viewport* mViewport;
+    TerrainGlobalOptions* mTerrainOpts;
+    LodMaterialGenerator* mMaterialGenerator;
+    TerrainGroup* mGroup;
+    std::vector<Terrain*> mTerrains;
+
+    void SetUp()
+    {
+        mRoot = new Root("");
+        mPlugin = new NullPlugin();
+        mRoot->installPlugin(mPlugin);
+        mRoot->setRenderSystem(mRoot->getRenderSystemByName("Null Rendering Subsystem"));
+        mRoot->initialise(false);
+        RenderWindow* window = mRoot->createRenderWindow("NullWindow", 320, 240, false);
+
+        mSceneMgr = mRoot->createSceneManager();
+        mCamera = mSceneMgr->createCamera("Camera");
+        mCamera->setNearClipDistance(1);
+        mCamera->setFarClipDistance(5000);
+        SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+        camNode->attachObject(mCamera);
+        camNode->setPosition(-400, 150, 0);
+        camNode->lookAt(Vector3(1500, 0, 0), Node::TS_WORLD);
+        mViewport = window->addViewport(mCamera);
+
+        mTerrainOpts = OGRE_NEW TerrainGlobalOptions();
+        mMaterialGenerator = OGRE_NEW LodMaterialGenerator();
+        mTerrainOpts->setDefaultMaterialGenerator(TerrainMaterialGeneratorPtr(mMaterialGenerator));
+        mGroup = 0;
+    }
+
+    void TearDown()
+    {
+        if (mGroup)
+            OGRE_DELETE mGroup;
+        else if (!mTerrains.empty())
+            OGRE_DELETE mTerrains[0];
+        OGRE_DELETE mTerrainOpts;
+        delete mRoot;
+        delete mPlugin;
+    }
+
+    /// Rolling hills, every LOD level has its own height error
+    std::vector<float> createHeights(uint16 size)
+    {
+        std::vector<float> heights(size * size);
+        for (uint16 y = 0; y < size; ++y)
+            for (uint16 x = 0; x < size; ++x)
+                heights[y * size + x] = 40 * Math::Sin(Radian(x * 0.31f)) * Math::Cos(Radian(y * 0.17f)) +
+                    15 * Math::Sin(Radian((x + y) * 1.3f));
+        return heights;
+    }
+
+    /// Terrains updated in parallel by their TerrainGroup
+    void createGroup(long count)
+    {
+        mGroup = OGRE_NEW TerrainGroup(mSceneMgr, Terrain::ALIGN_X_Z, 129, 1000);
+        mGroup->getDefaultImportSettings().minBatchSize = 17;
+        mGroup->getDefaultImportSettings().maxBatchSize = 33;
+        std::vector<float> heights = createHeights(129);
+        for (long x = 0; x < count; ++x)
+            mGroup->defineTerrain(x, 0, &heights[0]);
+        mGroup->loadAllTerrains(true);
+        for (long x = 0; x < count; ++x)
+            mTerrains.push_back(mGroup->getTerrain(x, 0));
+    }
+
+    /// A terrain updated by its own scene manager listener
+    void createTerrain()
+    {
+        std::vector<float> heights = createHeights(129);
+        Terrain::ImportData imp;
+        imp.inputFloat = &heights[0];
+        imp.terrainSize = 129;
+        imp.worldSize = 1000;
+        imp.minBatchSize = 17;
+        imp.maxBatchSize = 33;
+        Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+        ASSERT_TRUE(t->prepare(imp));
+        t->load();
+        mTerrains.push_back(t);
+    }
+
+    /** Render a frame, which updates the LOD through the skip cache, and compare
+        the result with calculating the LOD of all nodes again. */
+    void expectUncachedLods(const char* change, std::vector<float>* lodsOut)
+    {
+        mRoot->renderOneFrame();
+
+        const Camera* cam = mCamera->getLodCamera();
+        Real A = 1.0f / Math::Tan(cam->getFOVy() * 0.5f);
+        Real T = 2.0f * mTerrainOpts->getMaxPixelError() * cam->_getLodBiasInverse() /
+            (Real)mViewport->getActualHeight();
+        std::vector<float> allLods;
+        for (size_t i = 0; i < mTerrains.size(); ++i)
+        {
+            std::vector<float> cached = collectLods(mTerrains[i]);
+            mTerrains[i]->getQuadTree()->calculateCurrentLod(cam, A / T);
+            std::vector<float> uncached = collectLods(mTerrains[i]);
+            EXPECT_EQ(cached, uncached) << change << ", terrain " << i;
+            allLods.insert(allLods.end(), uncached.begin(), uncached.end());
+        }
+        *lodsOut = allLods;
+    }
+
+    /// Every change that leads to other LODs must reach them through the cache
+    void checkInvalidation()
+    {
+        std::vector<float> lods, previous;
+        expectUncachedLods("initial", &previous);
+
+        // a still camera
+        expectUncachedLods("still camera", &lods);
+        EXPECT_EQ(previous, lods);
+
+        // camera moves
+        mCamera->getParentSceneNode()->translate(300, 0, 0);
+        expectUncachedLods("camera moves", &lods);
+        EXPECT_NE(previous, lods);
+        previous = lods;
+        mCamera->getParentSceneNode()->yaw(Degree(30));
+        expectUncachedLods("camera turns", &lods);
+        EXPECT_NE(previous, lods);
+
+        // height edits
+        previous = lods;
+        Terrain* t = mTerrains[0];
+        for (long y = 20; y < 110; ++y)
+            for (long x = 20; x < 110; ++x)
+                t->setHeightAtPoint(x, y, *t->getHeightData(x, y) + 80 * Math::Sin(Radian(x * 2.1f)));
+        t->update(true);
+        expectUncachedLods("height edits", &lods);
+        EXPECT_NE(previous, lods);
+
+        // nodes unloaded and loaded again
+        previous = lods;
+        for (unsigned short i = 0; i < 4; ++i)
+            t->getQuadTree()->getChild(i)->unload();
+        expectUncachedLods("node unload", &lods);
+        EXPECT_NE(previous, lods);
+        t->getQuadTree()->load();
+        expectUncachedLods("node load", &lods);
+
+        // materials with other LOD distances
+        previous = lods;
+        mMaterialGenerator->lodDistance = 100;
+        mMaterialGenerator->_markChanged();
+        expectUncachedLods("material change", &lods);
+        EXPECT_NE(previous, lods);
+
+        // a culling frustum, which moves independently of the LOD camera
+        Camera* cullCamera = mSceneMgr->createCamera("Cull");
+        cullCamera->setNearClipDistance(1);
+        cullCamera->setFarClipDistance(5000);
+        SceneNode* cullNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+        cullNode->attachObject(cullCamera);
+        cullNode->setPosition(mCamera->getDerivedPosition());
+        cullNode->setOrientation(mCamera->getDerivedOrientation());
+        mCamera->setCullingFrustum(cullCamera);
+        expectUncachedLods("culling frustum", &lods);
+        previous = lods;
+        mCamera->getParentSceneNode()->translate(-600, 0, 0);
+        expectUncachedLods("camera moves behind the culling frustum", &lods);
+        EXPECT_NE(previous, lods);
+        previous = lods;
+        cullNode->yaw(Degree(90));
+        expectUncachedLods("culling frustum turns", &lods);
+        EXPECT_NE(previous, lods);
+        mCamera->setCullingFrustum(0);
+    }
+};
+
+TEST_F(TerrainLodTests, GroupInvalidation)
+{
+    createGroup(2);
+    checkInvalidation();
+}
+
+TEST_F(TerrainLodTests, TerrainInvalidation)
+{
+    createTerrain();
+    checkInvalidation();
+}
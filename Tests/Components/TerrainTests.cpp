@@ -29,6 +29,9 @@ THE SOFTWARE.
 
 #include "OgreRoot.h"
 #include "OgreTerrain.h"
+#include "OgreTerrainLodManager.h"
+#include "OgreStreamSerialiser.h"
+#include "OgreDefaultHardwareBufferManager.h"
 #include "OgreFileSystemLayer.h"
 
 #include "OgreBuildSettings.h"
@@ -122,3 +125,246 @@ TEST_F(TerrainTests, create)
     OGRE_DELETE t;
 }
 //--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, DerivedData)
+{
+    mTerrainOpts->setLightMapSize(256);
+
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 600;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+
+    long size = t->getSize();
+    Rect all(0, 0, size, size);
+
+    // normals, against evaluating the 8 surrounding faces of every point
+    Rect normalRect;
+    PixelBox* normals = t->calculateNormals(all, normalRect);
+    EXPECT_TRUE(normalRect.left == 0 && normalRect.top == 0 && normalRect.right == size && normalRect.bottom == size);
+    int normalMismatches = 0;
+    for (long y = 0; y < size; ++y)
+    {
+        for (long x = 0; x < size; ++x)
+        {
+            static const long offsets[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+            Vector3 centre, adjacent[8];
+            t->getPoint(x, y, &centre);
+            for (int i = 0; i < 8; ++i)
+                t->getPoint(Math::Clamp(x + offsets[i][0], 0L, size - 1),
+                            Math::Clamp(y + offsets[i][1], 0L, size - 1), &adjacent[i]);
+            Vector3 normal = Vector3::ZERO;
+            for (int i = 0; i < 8; ++i)
+                normal += Math::calculateBasicFaceNormal(centre, adjacent[i], adjacent[(i + 1) % 8]);
+            normal.normalise();
+
+            const uint8* stored = normals->data + ((size - y - 1) * size + x) * 3;
+            if (stored[0] != static_cast<uint8>((normal.x + 1.0f) * 0.5f * 255.0f) ||
+                stored[1] != static_cast<uint8>((normal.y + 1.0f) * 0.5f * 255.0f) ||
+                stored[2] != static_cast<uint8>((normal.z + 1.0f) * 0.5f * 255.0f))
+                ++normalMismatches;
+        }
+    }
+    EXPECT_EQ(normalMismatches, 0);
+    OGRE_FREE(normals->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE normals;
+
+    // lightmap, against casting an unaccelerated ray for every texel
+    Rect lightmapRect;
+    PixelBox* lightmap = t->calculateLightmap(all, Rect(), lightmapRect);
+    long lightmapSize = t->getLightmapSize();
+    EXPECT_TRUE(lightmapRect.left == 0 && lightmapRect.top == 0 &&
+                lightmapRect.right == lightmapSize && lightmapRect.bottom == lightmapSize);
+    const Vector3& lightVec = mTerrainOpts->getLightMapDirection();
+    Real heightPad = (t->getMaxHeight() - t->getMinHeight()) * 1.0e-3f;
+    int shadowed = 0, lightmapMismatches = 0;
+    for (long y = 0; y < lightmapSize; ++y)
+    {
+        for (long x = 0; x < lightmapSize; ++x)
+        {
+            float tx = (float)x / (float)(lightmapSize - 1);
+            float ty = (float)y / (float)(lightmapSize - 1);
+            Vector3 wpos;
+            t->getPosition(tx, ty, t->getHeightAtTerrainPosition(tx, ty) + heightPad, &wpos);
+            wpos += t->getPosition();
+            bool hit = t->rayIntersects(Ray(wpos, -lightVec), true, t->getWorldSize()).first;
+
+            uint8 stored = lightmap->data[(lightmapSize - y - 1) * lightmapSize + x];
+            shadowed += hit;
+            lightmapMismatches += stored != (hit ? 0 : 255);
+        }
+    }
+    EXPECT_GT(shadowed, 0);
+    EXPECT_EQ(lightmapMismatches, 0);
+    OGRE_FREE(lightmap->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE lightmap;
+
+    // height deltas, the removed vertices of LOD 1 move half way to their neighbours
+    // (the last row of vertices is not part of any LOD 1 quad row)
+    t->calculateHeightDeltas(all);
+    int deltaMismatches = 0;
+    for (long y = 0; y < size - 1; y += 2)
+    {
+        for (long x = 1; x < size; x += 2)
+        {
+            float interpolated = (*t->getHeightData(x - 1, y) + *t->getHeightData(x + 1, y)) * 0.5f;
+            float delta = t->getDeltaData(x, y)[0];
+            deltaMismatches += !Math::RealEqual(delta, interpolated - *t->getHeightData(x, y), 0.05f);
+        }
+    }
+    EXPECT_EQ(deltaMismatches, 0);
+
+    OGRE_DELETE t;
+}
+
+TEST_F(TerrainTests, BatchQueries)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 257;
+    imp.worldSize = 1000;
+    imp.inputScale = 600;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+    long size = t->getSize();
+
+    // heights and normals, at points well inside a triangle of every quad
+    std::vector<Vector3> positions;
+    for (long y = 0; y < size - 1; ++y)
+    {
+        for (long x = 0; x < size - 1; ++x)
+        {
+            Vector3 pos;
+            t->getPosition((x + 0.2f) / (size - 1), (y + 0.45f) / (size - 1), 0, &pos);
+            positions.push_back(pos + t->getPosition());
+        }
+    }
+    std::vector<float> heights(positions.size());
+    std::vector<Vector3> normals(positions.size());
+    t->getHeightsAtWorldPositions(&positions[0], positions.size(), &heights[0], &normals[0]);
+
+    int heightMismatches = 0, normalMismatches = 0;
+    Real step = t->getWorldSize() / (size - 1) * 0.1f;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        Vector3 p0 = positions[i], p1 = p0 + Vector3(step, 0, 0), p2 = p0 + Vector3(0, 0, step);
+        heightMismatches += !Math::RealEqual(heights[i], t->getHeightAtWorldPosition(p0), 1e-3f);
+        p0.y = t->getHeightAtWorldPosition(p0);
+        p1.y = t->getHeightAtWorldPosition(p1);
+        p2.y = t->getHeightAtWorldPosition(p2);
+        // the normal is perpendicular to the triangle
+        normalMismatches += !Math::RealEqual(normals[i].length(), 1, 1e-4f) || normals[i].y <= 0 ||
+            Math::Abs(normals[i].dotProduct((p1 - p0).normalisedCopy())) > 1e-3f ||
+            Math::Abs(normals[i].dotProduct((p2 - p0).normalisedCopy())) > 1e-3f;
+    }
+    EXPECT_EQ(heightMismatches, 0);
+    EXPECT_EQ(normalMismatches, 0);
+
+    // rays, against the unaccelerated single ray test
+    const Vector3& lightVec = mTerrainOpts->getLightMapDirection();
+    std::vector<Ray> rays;
+    for (size_t i = 0; i < positions.size(); i += 7)
+    {
+        Vector3 pos = positions[i];
+        pos.y = heights[i] + 1;
+        rays.push_back(Ray(pos, -lightVec));
+        pos.y = t->getMaxHeight() + 100;
+        rays.push_back(Ray(pos, Vector3(0.3f, -1, 0.2f).normalisedCopy()));
+    }
+    std::vector<std::pair<bool, Vector3> > results(rays.size());
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        t->rayIntersects(&rays[0], rays.size(), &results[0]);
+        int hits = 0, rayMismatches = 0;
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            std::pair<bool, Vector3> expected = t->rayIntersects(rays[i]);
+            hits += expected.first;
+            rayMismatches += expected.first != results[i].first ||
+                !expected.second.positionEquals(results[i].second, 1e-3f);
+        }
+        EXPECT_GT(hits, 0);
+        EXPECT_LT(hits, (int)rays.size());
+        EXPECT_EQ(rayMismatches, 0);
+
+        // raise a wall through the middle, the cached bounds must follow the change
+        Rect wall(size / 2 - 2, 0, size / 2 + 2, size);
+        for (long y = wall.top; y < wall.bottom; ++y)
+            for (long x = wall.left; x < wall.right; ++x)
+                *t->getHeightData(x, y) += 200;
+        t->dirtyRect(wall);
+    }
+
+    OGRE_DELETE t;
+}
+
+TEST_F(TerrainTests, SaveLoadTiles)
+{
+    // saving finalises the height deltas, which updates the vertex buffers
+    DefaultHardwareBufferManager bufferManager;
+
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 129;
+    imp.worldSize = 1000;
+    imp.inputScale = 600;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 65;
+    imp.layerList.resize(3);
+    imp.layerList[0].worldSize = 100;
+    imp.layerList[1].worldSize = 30;
+    imp.layerList[2].worldSize = 200;
+    ASSERT_TRUE(t->prepare(imp));
+
+    MemoryDataStream* memStream = OGRE_NEW MemoryDataStream(16 * 1024 * 1024);
+    DataStreamPtr written(memStream);
+    {
+        StreamSerialiser ser(written);
+        t->save(ser);
+    }
+    DataStreamPtr stored(OGRE_NEW MemoryDataStream(memStream->getPtr(), written->tell(), false, true));
+
+    Terrain* t2 = OGRE_NEW Terrain(mSceneMgr);
+    ASSERT_TRUE(t2->prepare(stored));
+    EXPECT_EQ(t2->getSize(), t->getSize());
+    EXPECT_EQ(t2->getNumLodLevels(), t->getNumLodLevels());
+    EXPECT_EQ(t2->getLayerCount(), t->getLayerCount());
+    EXPECT_EQ(t2->getLayerBlendMapSize(), t->getLayerBlendMapSize());
+    for (uint8 i = 0; i < t->getLayerCount(); ++i)
+        EXPECT_EQ(t2->getLayerWorldSize(i), t->getLayerWorldSize(i));
+
+    // height and delta data are loaded on demand, all levels at once here
+    stored->seek(0);
+    TerrainLodManager lodManager(t2, stored);
+    lodManager.readLodData(t2->getNumLodLevels() - 1, 0);
+
+    size_t numVertices = t->getSize() * t->getSize();
+    int heightMismatches = 0, deltaMismatches = 0;
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        heightMismatches += t2->getHeightData()[i] != t->getHeightData()[i];
+        deltaMismatches += t2->getDeltaData()[i] != t->getDeltaData()[i];
+    }
+    EXPECT_EQ(heightMismatches, 0);
+    EXPECT_EQ(deltaMismatches, 0);
+
+    OGRE_DELETE t2;
+    OGRE_DELETE t;
+}
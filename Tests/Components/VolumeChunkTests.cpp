@@ -0,0 +1,224 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "Ogre.h"
+#include "OgreNullPlugin.h"
+#include "OgreVolumeChunk.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeGridSource.h"
+#include "OgreVolumeMeshBuilder.h"
+
+#include <thread>
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+namespace
+{
+    struct MeshCapture : public MeshBuilderCallback
+    {
+        VecVertex vertices;
+        VecIndices indices;
+        void ready(const SimpleRenderable*, const VecVertex& v, const VecIndices& i, size_t, int)
+        {
+            vertices = v;
+            indices = i;
+        }
+    };
+
+    /// A grid in memory, one cell per world unit
+    class MemoryGridSource : public GridSource
+    {
+        std::vector<float> mData;
+    public:
+        MemoryGridSource(size_t size, const Source& initial) : GridSource(true, false, false), mData(size * size * size)
+        {
+            mWidth = mHeight = mDepth = size;
+            mPosXScale = mPosYScale = mPosZScale = 1;
+            mVolumeSpaceToWorldSpaceFactor = 1;
+            for (size_t z = 0; z < size; ++z)
+                for (size_t y = 0; y < size; ++y)
+                    for (size_t x = 0; x < size; ++x)
+                        setVolumeGridValue(int(x), int(y), int(z), float(initial.getValue(Vector3(Real(x), Real(y), Real(z)))));
+        }
+        float getVolumeGridValue(size_t x, size_t y, size_t z) const
+        {
+            x = x >= mWidth ? mWidth - 1 : x;
+            y = y >= mHeight ? mHeight - 1 : y;
+            z = z >= mDepth ? mDepth - 1 : z;
+            return mData[(z * mHeight + y) * mWidth + x];
+        }
+        void setVolumeGridValue(int x, int y, int z, float value)
+        {
+            mData[(z * mHeight + y) * mWidth + x] = value;
+        }
+    };
+
+    /// Fails in the worker threads while failing is set, like a source whose data went away
+    class FailingSource : public Source
+    {
+        const Source& mSource;
+        std::thread::id mMainThread;
+        void check() const
+        {
+            if (failing && std::this_thread::get_id() != mMainThread)
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "the volume data went away", "FailingSource");
+        }
+    public:
+        bool failing;
+        FailingSource(const Source& source) : mSource(source), mMainThread(std::this_thread::get_id()), failing(false) {}
+        Vector4 getValueAndGradient(const Vector3& position) const
+        {
+            check();
+            return mSource.getValueAndGradient(position);
+        }
+        Real getValue(const Vector3& position) const
+        {
+            check();
+            return mSource.getValue(position);
+        }
+    };
+
+    void dig(MemoryGridSource& grid, const Vector3& center)
+    {
+        CSGSphereSource crater(2, center);
+        CSGDifferenceSource difference;
+        grid.combineWithSource(&difference, &crater, center, 3);
+    }
+}
+
+class VolumeChunkTests : public ::testing::Test
+{
+public:
+    NullPlugin* mPlugin;
+    Root* mRoot;
+    SceneManager* mSceneMgr;
+
+    void SetUp()
+    {
+        mRoot = new Root("");
+        mPlugin = new NullPlugin();
+        mRoot->installPlugin(mPlugin);
+        mRoot->setRenderSystem(mRoot->getRenderSystemByName("Null Rendering Subsystem"));
+        mRoot->initialise(false);
+        mRoot->createRenderWindow("NullWindow", 320, 240, false);
+        mSceneMgr = mRoot->createSceneManager();
+    }
+
+    void TearDown()
+    {
+        delete mRoot;
+        delete mPlugin;
+    }
+};
+
+TEST_F(VolumeChunkTests, OverlappingIncrementalUpdates)
+{
+    CSGSphereSource sphere(10, Vector3(16, 16, 16));
+    MemoryGridSource grid(33, sphere);
+
+    MeshCapture updated;
+    ChunkParameters parameters;
+    parameters.sceneManager = mSceneMgr;
+    parameters.src = &grid;
+    parameters.baseError = 0.25;
+    parameters.lodCallback = &updated;
+    parameters.incrementalUpdate = true;
+
+    Chunk* chunk = OGRE_NEW Chunk();
+    SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    chunk->load(node, Vector3::ZERO, Vector3(32), 1, &parameters);
+    ASSERT_FALSE(updated.indices.empty());
+
+    // the second edit comes while the octree is still with the worker of the first one
+    ChunkParameters* chunkParameters = chunk->getChunkParameters();
+    dig(grid, Vector3(16, 26, 16));
+    chunkParameters->updateFrom = grid.getDirtyRegion().getMinimum();
+    chunkParameters->updateTo = grid.getDirtyRegion().getMaximum();
+    chunkParameters->async = true;
+    grid.clearDirtyRegion();
+    chunk->load(node, Vector3::ZERO, Vector3(32), 1, chunkParameters);
+
+    dig(grid, Vector3(16, 6, 16));
+    chunkParameters->updateFrom = grid.getDirtyRegion().getMinimum();
+    chunkParameters->updateTo = grid.getDirtyRegion().getMaximum();
+    chunkParameters->async = false;
+    grid.clearDirtyRegion();
+    chunk->load(node, Vector3::ZERO, Vector3(32), 1, chunkParameters);
+
+    MeshCapture expected;
+    parameters.lodCallback = &expected;
+    parameters.incrementalUpdate = false;
+    Chunk* fresh = OGRE_NEW Chunk();
+    fresh->load(mSceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, Vector3(32), 1, &parameters);
+
+    ASSERT_FALSE(expected.indices.empty());
+    EXPECT_EQ(updated.indices, expected.indices);
+    ASSERT_EQ(updated.vertices.size(), expected.vertices.size());
+    for (size_t i = 0; i < expected.vertices.size(); ++i)
+    {
+        EXPECT_EQ(updated.vertices[i].x, expected.vertices[i].x);
+        EXPECT_EQ(updated.vertices[i].y, expected.vertices[i].y);
+        EXPECT_EQ(updated.vertices[i].z, expected.vertices[i].z);
+    }
+
+    OGRE_DELETE fresh;
+    OGRE_DELETE chunk;
+}
+
+TEST_F(VolumeChunkTests, FailedRequests)
+{
+    CSGSphereSource sphere(10, Vector3(16, 16, 16));
+    FailingSource source(sphere);
+
+    MeshCapture mesh;
+    ChunkParameters parameters;
+    parameters.sceneManager = mSceneMgr;
+    parameters.src = &source;
+    parameters.baseError = 0.25;
+    parameters.lodCallback = &mesh;
+    parameters.incrementalUpdate = true;
+
+    // a synchronous load returns although the worker fails
+    source.failing = true;
+    Chunk* chunk = OGRE_NEW Chunk();
+    SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    chunk->load(node, Vector3::ZERO, Vector3(32), 1, &parameters);
+    EXPECT_TRUE(mesh.indices.empty());
+
+    // and the failed request does not hold back the next update
+    source.failing = false;
+    ChunkParameters* chunkParameters = chunk->getChunkParameters();
+    chunkParameters->updateFrom = Vector3(8);
+    chunkParameters->updateTo = Vector3(24);
+    chunk->load(node, Vector3::ZERO, Vector3(32), 1, chunkParameters);
+    EXPECT_FALSE(mesh.indices.empty());
+
+    OGRE_DELETE chunk;
+}
@@ -0,0 +1,322 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRoot.h"
+#include "OgreTimer.h"
+#include "OgreTaskScheduler.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeDualGridGenerator.h"
+#include "OgreVolumeGridSource.h"
+#include "OgreVolumeIsoSurfaceMC.h"
+#include "OgreVolumeMeshBuilder.h"
+#include "OgreVolumeOctreeNode.h"
+#include "OgreVolumeOctreeNodeSplitPolicy.h"
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+namespace
+{
+    struct MeshCapture : public MeshBuilderCallback
+    {
+        VecVertex vertices;
+        VecIndices indices;
+        void ready(const SimpleRenderable*, const VecVertex& v, const VecIndices& i, size_t, int)
+        {
+            vertices = v;
+            indices = i;
+        }
+    };
+
+    /// A sphere with a plane cut out of it, which touches every CSG batch override
+    struct TestScene
+    {
+        CSGSphereSource sphere;
+        CSGPlaneSource plane;
+        CSGNegateSource negated;
+        CSGScaleSource scaled;
+        CSGDifferenceSource difference;
+        CSGSphereSource sphere2;
+        CSGIntersectionSource intersection;
+        CSGUnionSource root;
+
+        TestScene()
+            : sphere(10, Vector3(16, 16, 16))
+            , plane(18, Vector3::UNIT_Y)
+            , negated(&plane)
+            , scaled(&negated, 1)
+            , difference(&sphere, &scaled)
+            , sphere2(6, Vector3(20, 12, 20))
+            , intersection(&sphere, &sphere2)
+            , root(&difference, &intersection)
+        {
+        }
+    };
+
+    void contour(const Source* src, OctreeNode& root, MeshCapture& mesh)
+    {
+        IsoSurfaceMC is(src);
+        MeshBuilder mb;
+        DualGridGenerator dualGridGenerator;
+        dualGridGenerator.generateDualGrid(&root, &is, &mb, 1, root.getFrom(), root.getTo(), false);
+        mb.executeCallback(&mesh, 0, 0, 0);
+    }
+
+    void generate(const Source* src, MeshCapture& mesh)
+    {
+        OctreeNode root(Vector3::ZERO, Vector3(32, 32, 32));
+        OctreeNodeSplitPolicy policy(src, 1);
+        root.split(&policy, src, 0.2);
+        contour(src, root, mesh);
+    }
+
+    void expectSameMesh(const MeshCapture& a, const MeshCapture& b)
+    {
+        ASSERT_EQ(a.vertices.size(), b.vertices.size());
+        ASSERT_EQ(a.indices, b.indices);
+        for (size_t i = 0; i < a.vertices.size(); ++i)
+        {
+            ASSERT_EQ(a.vertices[i].x, b.vertices[i].x);
+            ASSERT_EQ(a.vertices[i].y, b.vertices[i].y);
+            ASSERT_EQ(a.vertices[i].z, b.vertices[i].z);
+            ASSERT_EQ(a.vertices[i].nX, b.vertices[i].nX);
+            ASSERT_EQ(a.vertices[i].nY, b.vertices[i].nY);
+            ASSERT_EQ(a.vertices[i].nZ, b.vertices[i].nZ);
+        }
+    }
+
+    /// A grid in memory, one cell per world unit
+    class MemoryGridSource : public GridSource
+    {
+        std::vector<float> mData;
+    public:
+        MemoryGridSource(size_t size, const Source& initial) : GridSource(true, false, false), mData(size * size * size)
+        {
+            mWidth = mHeight = mDepth = size;
+            mPosXScale = mPosYScale = mPosZScale = 1;
+            mVolumeSpaceToWorldSpaceFactor = 1;
+            for (size_t z = 0; z < size; ++z)
+                for (size_t y = 0; y < size; ++y)
+                    for (size_t x = 0; x < size; ++x)
+                        setVolumeGridValue(int(x), int(y), int(z), float(initial.getValue(Vector3(Real(x), Real(y), Real(z)))));
+        }
+        float getVolumeGridValue(size_t x, size_t y, size_t z) const
+        {
+            x = x >= mWidth ? mWidth - 1 : x;
+            y = y >= mHeight ? mHeight - 1 : y;
+            z = z >= mDepth ? mDepth - 1 : z;
+            return mData[(z * mHeight + y) * mWidth + x];
+        }
+        void setVolumeGridValue(int x, int y, int z, float value)
+        {
+            mData[(z * mHeight + y) * mWidth + x] = value;
+        }
+    };
+}
+
+TEST(VolumeTests, BatchSourceQueries)
+{
+    TestScene scene;
+    const Source* sources[] = {&scene.sphere, &scene.plane, &scene.negated, &scene.scaled,
+                               &scene.difference, &scene.intersection, &scene.root};
+
+    // more positions than fit in one batch
+    std::vector<Vector3> positions;
+    for (int i = 0; i < 300; ++i)
+        positions.push_back(Vector3(Real(i % 7) * 4.5f, Real(i % 11) * 3, Real(i % 13) * 2.5f));
+
+    std::vector<Vector4> gradients(positions.size());
+    std::vector<Real> values(positions.size());
+    for (size_t s = 0; s < sizeof(sources) / sizeof(sources[0]); ++s)
+    {
+        sources[s]->getValuesAndGradients(&positions[0], positions.size(), &gradients[0]);
+        sources[s]->getValues(&positions[0], positions.size(), &values[0]);
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            ASSERT_EQ(sources[s]->getValueAndGradient(positions[i]), gradients[i]);
+            ASSERT_EQ(sources[s]->getValue(positions[i]), values[i]);
+        }
+    }
+}
+
+TEST(VolumeTests, ParallelMeshMatchesSerial)
+{
+    TestScene scene;
+
+    // no Root, so everything runs on this thread
+    MeshCapture serial;
+    generate(&scene.root, serial);
+    ASSERT_FALSE(serial.indices.empty());
+
+    Root root("");
+    root.getTaskScheduler()->startup(3);
+    MeshCapture parallel;
+    generate(&scene.root, parallel);
+
+    expectSameMesh(serial, parallel);
+}
+
+TEST(VolumeTests, CacheSource)
+{
+    TestScene scene;
+    CacheSource cache(&scene.root);
+
+    std::vector<Vector3> positions;
+    for (int i = 0; i < 1000; ++i)
+        positions.push_back(Vector3(Real(i % 10), Real(i / 10 % 10), Real(i / 100)));
+
+    for (size_t i = 0; i < positions.size(); ++i)
+        ASSERT_EQ(scene.root.getValueAndGradient(positions[i]), cache.getValueAndGradient(positions[i]));
+    EXPECT_EQ(cache.getMisses(), positions.size());
+    EXPECT_EQ(cache.getHits(), 0u);
+    EXPECT_EQ(cache.getCachedCount(), positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+        ASSERT_EQ(scene.root.getValue(positions[i]), cache.getValue(positions[i]));
+    EXPECT_EQ(cache.getMisses(), positions.size());
+    EXPECT_EQ(cache.getHits(), positions.size());
+
+    // a budget smaller than the working set evicts, but the values stay right
+    cache.setMemoryBudget(4096);
+    EXPECT_EQ(cache.getHits(), 0u);
+    EXPECT_GT(cache.getCapacity(), 0u);
+    EXPECT_LT(cache.getCapacity(), positions.size());
+    for (int pass = 0; pass < 2; ++pass)
+        for (size_t i = 0; i < positions.size(); ++i)
+            ASSERT_EQ(scene.root.getValueAndGradient(positions[i]), cache.getValueAndGradient(positions[i]));
+    EXPECT_LE(cache.getCachedCount(), cache.getCapacity());
+    EXPECT_EQ(cache.getEvictions(), cache.getMisses() - cache.getCachedCount());
+
+    // snapped positions share one entry
+    CacheSource snapped(&scene.root, CacheSource::DEFAULT_MEMORY_BUDGET, 0.5);
+    EXPECT_EQ(snapped.getValueAndGradient(Vector3(1.49f, 2, 3)), scene.root.getValueAndGradient(Vector3(1.5f, 2, 3)));
+    snapped.getValueAndGradient(Vector3(1.51f, 2, 3));
+    EXPECT_EQ(snapped.getHits(), 1u);
+    EXPECT_EQ(snapped.getCachedCount(), 1u);
+}
+
+TEST(VolumeTests, CacheSourceConcurrent)
+{
+    Root root("");
+    root.getTaskScheduler()->startup(3);
+
+    TestScene scene;
+    CacheSource cache(&scene.root, 64 * 1024);
+    std::atomic<int> mismatches(0);
+    parallelFor(64, [&](size_t task) {
+        for (int i = 0; i < 2000; ++i)
+        {
+            Vector3 position(Real((i + task) % 17), Real(i / 17 % 17), Real(i % 5));
+            if (cache.getValueAndGradient(position) != scene.root.getValueAndGradient(position))
+                ++mismatches;
+        }
+    });
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_EQ(cache.getHits() + cache.getMisses(), 64u * 2000u);
+    EXPECT_LE(cache.getCachedCount(), cache.getCapacity());
+}
+
+TEST(VolumeTests, IncrementalResplit)
+{
+    TestScene scene;
+    MemoryGridSource grid(33, scene.root);
+    OctreeNodeSplitPolicy policy(&grid, 1);
+
+    OctreeNode incremental(Vector3::ZERO, Vector3(32, 32, 32));
+    incremental.split(&policy, &grid, 0.2);
+    EXPECT_TRUE(grid.getDirtyRegion().isNull());
+
+    // dig a small crater
+    Vector3 center(16, 26, 16);
+    CSGSphereSource crater(2, center);
+    CSGDifferenceSource difference;
+    grid.combineWithSource(&difference, &crater, center, 3);
+    AxisAlignedBox dirty = grid.getDirtyRegion();
+    ASSERT_FALSE(dirty.isNull());
+    EXPECT_TRUE(dirty.contains(AxisAlignedBox(Vector3(13, 23, 13), Vector3(18, 28, 18))));
+
+    Timer timer;
+    incremental.resplit(&policy, &grid, 0.2, dirty);
+    unsigned long resplitTime = timer.getMicroseconds();
+    grid.clearDirtyRegion();
+    EXPECT_TRUE(grid.getDirtyRegion().isNull());
+
+    timer.reset();
+    OctreeNode full(Vector3::ZERO, Vector3(32, 32, 32));
+    full.split(&policy, &grid, 0.2);
+    unsigned long splitTime = timer.getMicroseconds();
+    RecordProperty("splitMicroseconds", int(splitTime));
+    RecordProperty("resplitMicroseconds", int(resplitTime));
+
+    MeshCapture expected, updated;
+    contour(&grid, full, expected);
+    contour(&grid, incremental, updated);
+    ASSERT_FALSE(expected.indices.empty());
+    expectSameMesh(expected, updated);
+}
+
+TEST(VolumeTests, SmallEditLatency)
+{
+    TestScene scene;
+    MemoryGridSource grid(33, scene.root);
+    OctreeNodeSplitPolicy policy(&grid, 1);
+
+    OctreeNode incremental(Vector3::ZERO, Vector3(32, 32, 32));
+    incremental.split(&policy, &grid, 0.2);
+
+    // remesh after each small edit, once incrementally and once from scratch
+    const int edits = 8;
+    unsigned long incrementalTime = 0, fullTime = 0;
+    Timer timer;
+    for (int i = 0; i < edits; ++i)
+    {
+        Vector3 center(Real(14 + i % 4), 25, Real(14 + i / 4 * 3));
+        CSGSphereSource crater(1.5, center);
+        CSGDifferenceSource difference;
+        grid.combineWithSource(&difference, &crater, center, 2);
+
+        MeshCapture updated, expected;
+        timer.reset();
+        incremental.resplit(&policy, &grid, 0.2, grid.getDirtyRegion());
+        contour(&grid, incremental, updated);
+        incrementalTime += timer.getMicroseconds();
+        grid.clearDirtyRegion();
+
+        timer.reset();
+        OctreeNode full(Vector3::ZERO, Vector3(32, 32, 32));
+        full.split(&policy, &grid, 0.2);
+        contour(&grid, full, expected);
+        fullTime += timer.getMicroseconds();
+
+        expectSameMesh(expected, updated);
+    }
+    RecordProperty("incrementalMicrosecondsPerEdit", int(incrementalTime / edits));
+    RecordProperty("fullMicrosecondsPerEdit", int(fullTime / edits));
+}
@@ -0,0 +1,129 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgrePrerequisites.h"
+#include "OgreFrameAllocator.h"
+
+#include <cstring>
+#include <thread>
+
+using namespace Ogre;
+
+TEST(FrameMemory, Alignment)
+{
+    FrameMemory::_endFrame();
+    for (size_t alignment = 1; alignment <= OGRE_SIMD_ALIGNMENT; alignment *= 2)
+    {
+        FrameMemory::allocate(3, 1); // misalign the top
+        void* p = FrameMemory::allocate(24, alignment);
+        EXPECT_EQ(reinterpret_cast<size_t>(p) % alignment, 0u);
+    }
+    FrameMemory::_endFrame();
+}
+
+TEST(FrameMemory, ReuseAfterFrameEnd)
+{
+    FrameMemory::_endFrame();
+    std::vector<void*> firstFrame;
+    for (int i = 0; i < 100; ++i)
+        firstFrame.push_back(FrameMemory::allocate(1000));
+    void* large = FrameMemory::allocate(100 * 1024);
+    memset(large, 0, 100 * 1024);
+    FrameMemory::_endFrame();
+    EXPECT_EQ(FrameMemory::getLastFrameAllocationCount(), 101u);
+
+    // the blocks of the last frame are reused, only the large allocation needs a new one
+    size_t heapAllocations = FrameMemory::getHeapAllocationCount();
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(FrameMemory::allocate(1000), firstFrame[i]);
+    FrameMemory::allocate(100 * 1024);
+    EXPECT_EQ(FrameMemory::getHeapAllocationCount(), heapAllocations + 1);
+    FrameMemory::_endFrame();
+}
+
+TEST(FrameMemory, DeallocateMostRecent)
+{
+    FrameMemory::_endFrame();
+    void* a = FrameMemory::allocate(64);
+    void* b = FrameMemory::allocate(64);
+    // not the most recent allocation, kept until the frame ends
+    FrameMemory::deallocate(a, 64);
+    EXPECT_NE(FrameMemory::allocate(64), a);
+    FrameMemory::_endFrame();
+
+    a = FrameMemory::allocate(64);
+    FrameMemory::deallocate(a, 64);
+    EXPECT_EQ(FrameMemory::allocate(64), a);
+    (void)b;
+    FrameMemory::_endFrame();
+}
+
+TEST(FrameMemory, FrameVector)
+{
+    FrameMemory::_endFrame();
+    size_t heapAllocations = FrameMemory::getHeapAllocationCount();
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        {
+            frame_vector<int> values;
+            for (int i = 0; i < 1000; ++i)
+                values.push_back(i);
+            frame_vector<bool> flags(1000, false);
+            flags[999] = true;
+
+            int sum = 0;
+            for (size_t i = 0; i < values.size(); ++i)
+                sum += values[i];
+            EXPECT_EQ(sum, 999 * 1000 / 2);
+            EXPECT_TRUE(flags[999]);
+        }
+        FrameMemory::_endFrame();
+    }
+    // the blocks are kept, so one block serves every frame
+    EXPECT_LE(FrameMemory::getHeapAllocationCount(), heapAllocations + 1);
+}
+
+TEST(FrameMemory, PerThreadArenas)
+{
+    FrameMemory::_endFrame();
+    int* mine = static_cast<int*>(FrameMemory::allocate(sizeof(int) * 256));
+    for (int i = 0; i < 256; ++i)
+        mine[i] = i;
+
+    std::thread worker([]() {
+        int* theirs = static_cast<int*>(FrameMemory::allocate(sizeof(int) * 256));
+        for (int i = 0; i < 256; ++i)
+            theirs[i] = -1;
+    });
+    worker.join();
+
+    for (int i = 0; i < 256; ++i)
+        ASSERT_EQ(mine[i], i);
+    FrameMemory::_endFrame();
+}
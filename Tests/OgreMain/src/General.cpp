@@ -46,8 +46,15 @@ THE SOFTWARE.
 #include "OgreSkeletonManager.h"
 #include "OgreCompositorManager.h"
 #include "OgreTextureManager.h"
+#include "OgreLog.h"
+#include "OgreLogManager.h"
+#include "OgreTimer.h"
 
 #include <random>
+#include <fstream>
+#if OGRE_THREAD_SUPPORT
+#include <thread>
+#endif
 using std::minstd_rand;
 
 using namespace Ogre;
@@ -260,6 +267,123 @@ TEST_F(ResourceLoading, CollsionUseExisting)
         "Collision", "Tests", "null", GPT_VERTEX_PROGRAM));
 }
 
+TEST_F(ResourceLoading, Lookup)
+{
+    ResourceGroupManager::getSingleton().createResourceGroup("LookupPool", false);
+    MaterialManager& mgr = MaterialManager::getSingleton();
+
+    MaterialPtr global = mgr.create("Lookup", RGN_DEFAULT);
+    MaterialPtr grouped = mgr.create("Lookup", "LookupPool");
+    MaterialPtr groupedOnly = mgr.create("LookupGrouped", "LookupPool");
+
+    EXPECT_EQ(mgr.getByName("Lookup", RGN_DEFAULT), global);
+    EXPECT_EQ(mgr.getByName("Lookup", RGN_AUTODETECT), global);
+    EXPECT_EQ(mgr.getByName("Lookup", "LookupPool"), grouped);
+    EXPECT_EQ(mgr.getByName("LookupGrouped", RGN_AUTODETECT), groupedOnly);
+    EXPECT_FALSE(mgr.getByName("LookupGrouped", RGN_DEFAULT));
+    EXPECT_EQ(mgr.getByHandle(grouped->getHandle()), grouped);
+
+    // the lookup index must not hold references of its own
+    EXPECT_EQ(global.use_count(), ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1);
+
+    mgr.remove(grouped);
+    EXPECT_FALSE(mgr.getByHandle(grouped->getHandle()));
+#if !OGRE_RESOURCEMANAGER_STRICT
+    EXPECT_EQ(mgr.getByName("Lookup", "LookupPool"), global); // falls back to the global pool
+#else
+    EXPECT_FALSE(mgr.getByName("Lookup", "LookupPool"));
+#endif
+    EXPECT_EQ(mgr.getByName("Lookup", RGN_AUTODETECT), global);
+
+    mgr.remove(global);
+    EXPECT_FALSE(mgr.getByName("Lookup", RGN_AUTODETECT));
+
+    ResourceGroupManager::getSingleton().destroyResourceGroup("LookupPool");
+    EXPECT_FALSE(ResourceGroupManager::getSingleton().resourceGroupExists("LookupPool"));
+    EXPECT_FALSE(mgr.getByName("LookupGrouped", RGN_AUTODETECT));
+}
+
+TEST_F(ResourceLoading, LookupAutodetectFirstGroupByName)
+{
+    ResourceGroupManager::getSingleton().createResourceGroup("LookupPoolB", false);
+    ResourceGroupManager::getSingleton().createResourceGroup("LookupPoolA", false);
+    MaterialManager& mgr = MaterialManager::getSingleton();
+
+    // the name is filed under both groups, autodetect picks the first group by name
+    mgr.create("LookupBoth", "LookupPoolB");
+    MaterialPtr first = mgr.create("LookupBoth", "LookupPoolA");
+    EXPECT_EQ(mgr.getByName("LookupBoth", RGN_AUTODETECT), first);
+
+    ResourceGroupManager::getSingleton().destroyResourceGroup("LookupPoolA");
+    ResourceGroupManager::getSingleton().destroyResourceGroup("LookupPoolB");
+}
+
+#if OGRE_THREAD_SUPPORT
+TEST_F(ResourceLoading, ConcurrentLookup)
+{
+    ResourceGroupManager::getSingleton().createResourceGroup("LookupPool", false);
+    MaterialManager& mgr = MaterialManager::getSingleton();
+
+    const int resourceCount = 512;
+    const int lookupsPerThread = 100000;
+    std::vector<ResourceHandle> handles;
+    for (int i = 0; i < resourceCount; ++i)
+    {
+        String name = "Lookup" + StringConverter::toString(i);
+        handles.push_back(mgr.create(name, RGN_DEFAULT)->getHandle());
+        mgr.create(name, "LookupPool");
+    }
+
+    std::atomic<bool> churn(true);
+    std::atomic<int> failures(0);
+    auto lookup = [&](unsigned seed) {
+        minstd_rand rng(seed);
+        for (int i = 0; i < lookupsPerThread; ++i)
+        {
+            int idx = rng() % resourceCount;
+            String name = "Lookup" + StringConverter::toString(idx);
+            MaterialPtr mat = mgr.getByName(name, (i & 1) ? RGN_DEFAULT : "LookupPool");
+            ResourcePtr res = mgr.getByHandle(handles[idx]);
+            MaterialPtr churned = mgr.getByName("LookupChurn", "LookupPool");
+            if (!mat || mat->getGroup() != ((i & 1) ? RGN_DEFAULT : "LookupPool") || !res ||
+                res->getName() != name || (churned && churned->getName() != "LookupChurn"))
+                ++failures;
+        }
+    };
+
+    unsigned threadCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+
+    // mutations stay consistent while the lookups run
+    std::thread writer([&]() {
+        while (churn)
+            mgr.remove(mgr.create("LookupChurn", "LookupPool"));
+    });
+
+    Timer timer;
+    lookup(0);
+    uint64 single = timer.getMicroseconds();
+
+    timer.reset();
+    std::vector<std::thread> readers;
+    for (unsigned t = 0; t < threadCount; ++t)
+        readers.push_back(std::thread(lookup, t + 1));
+    for (auto& t : readers)
+        t.join();
+    uint64 multi = timer.getMicroseconds();
+
+    churn = false;
+    writer.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    LogManager::getSingleton().stream()
+        << "ResourceManager lookups, 1 thread: " << lookupsPerThread * 3 * 1000 / std::max<uint64>(single, 1)
+        << "/ms, " << threadCount << " threads: "
+        << lookupsPerThread * 3 * threadCount * 1000 / std::max<uint64>(multi, 1) << "/ms";
+
+    ResourceGroupManager::getSingleton().destroyResourceGroup("LookupPool");
+}
+#endif
+
 typedef RootWithoutRenderSystemFixture TextureTests;
 TEST_F(TextureTests, Blank)
 {
@@ -275,4 +399,152 @@ TEST_F(TextureTests, Blank)
     EXPECT_EQ(tus->getIsAlpha(), false);
     EXPECT_EQ(tus->getGamma(), 1.0f);
     EXPECT_EQ(tus->isHardwareGammaEnabled(), false);
-}
\ No newline at end of file
+}
+TEST(Log, AsyncOutput)
+{
+    struct CountingListener : public LogListener
+    {
+        std::atomic<int> count;
+        CountingListener() : count(0) {}
+        void messageLogged(const String&, LogMessageLevel, bool, const String&, bool& skip)
+        {
+            ++count;
+        }
+    } listener;
+
+    const char* filename = "AsyncOutputTest.log";
+    {
+        Log log(filename, false);
+        log.setTimeStampEnabled(false);
+        // small queue, so the loggers have to wait for the writer
+        log.setAsyncOutputEnabled(true, 16);
+        EXPECT_TRUE(log.isAsyncOutputEnabled() || !OGRE_THREAD_SUPPORT);
+        log.addListener(&listener);
+
+        auto logLines = [&log]() {
+            for (int i = 0; i < 500; ++i)
+                log.logMessage("line");
+        };
+#if OGRE_THREAD_SUPPORT
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.push_back(std::thread(logLines));
+        for (auto& t : threads)
+            t.join();
+#else
+        for (int i = 0; i < 4; ++i)
+            logLines();
+#endif
+        log.flush();
+        EXPECT_EQ(listener.count.load(), 2000);
+
+        std::ifstream file(filename);
+        String line;
+        int lines = 0;
+        while (std::getline(file, line))
+        {
+            EXPECT_EQ(line, "line");
+            ++lines;
+        }
+        EXPECT_EQ(lines, 2000);
+
+        log.removeListener(&listener);
+    }
+    std::remove(filename);
+}
+
+TEST(Log, ListenerRemovesItself)
+{
+    struct OneShotListener : public LogListener
+    {
+        Log* log;
+        int count;
+        OneShotListener(Log* l) : log(l), count(0) {}
+        void messageLogged(const String&, LogMessageLevel, bool, const String&, bool&)
+        {
+            ++count;
+            log->removeListener(this);
+        }
+    };
+
+    Log log("ListenerRemovesItself.log", false, true);
+    OneShotListener listener(&log);
+    log.addListener(&listener);
+    log.logMessage("first");
+    log.logMessage("second");
+    EXPECT_EQ(listener.count, 1);
+}
+
+TEST(Log, ListenersCalledOneAtATime)
+{
+    struct CheckingListener : public LogListener
+    {
+        std::atomic<int> active;
+        std::atomic<int> overlaps;
+        CheckingListener() : active(0), overlaps(0) {}
+        void messageLogged(const String&, LogMessageLevel, bool, const String&, bool&)
+        {
+            if (++active > 1)
+                ++overlaps;
+            volatile int spin = 0;
+            for (int i = 0; i < 100; ++i)
+                spin = spin + i;
+            --active;
+        }
+    } listener;
+
+    Log log("ListenersCalledOneAtATime.log", false, true);
+    log.addListener(&listener);
+    auto logLines = [&log]() {
+        for (int i = 0; i < 500; ++i)
+            log.logMessage("line");
+    };
+#if OGRE_THREAD_SUPPORT
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.push_back(std::thread(logLines));
+    for (auto& t : threads)
+        t.join();
+#else
+    logLines();
+#endif
+    log.removeListener(&listener);
+    EXPECT_EQ(listener.overlaps.load(), 0);
+}
+
+#if OGRE_THREAD_SUPPORT && GTEST_HAS_DEATH_TEST
+namespace
+{
+    Log* gTerminateLog = 0;
+    void flushLogAndAbort()
+    {
+        gTerminateLog->flush();
+        std::abort();
+    }
+}
+
+TEST(Log, AsyncOutputFlushedByApplicationHandler)
+{
+    const char* filename = "AsyncTerminateTest.log";
+    EXPECT_DEATH(
+        {
+            gTerminateLog = new Log(filename, false);
+            gTerminateLog->setTimeStampEnabled(false);
+            gTerminateLog->setAsyncOutputEnabled(true, 16);
+            std::set_terminate(&flushLogAndAbort);
+            for (int i = 0; i < 100; ++i)
+                gTerminateLog->logMessage("line");
+            std::terminate();
+        },
+        "");
+
+    std::ifstream file(filename);
+    String line;
+    int lines = 0;
+    while (std::getline(file, line))
+        ++lines;
+    EXPECT_EQ(lines, 100);
+    file.close();
+    std::remove(filename);
+}
+#endif
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "Ogre.h"
 #include "OgreInstancedEntity.h"
 #include "OgreInstanceBatchShader.h"
+#include "OgreOptimisedUtil.h"
 #include "RootWithoutRenderSystemFixture.h"
 
 using namespace Ogre;
@@ -53,5 +54,39 @@ TEST_F(Instancing, Bounds) {
     EXPECT_EQ(instanced_entity.getBoundingRadius(), entity->getBoundingRadius());
 }
 
+TEST_F(Instancing, CullSpheres) {
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("cam");
+    cam->setNearClipDistance(1);
+    cam->setFarClipDistance(1000);
+    sceneMgr->getRootSceneNode()->attachObject(cam);
+
+    // Spread around the frustum, so some are inside, some outside and some across a plane
+    const size_t numSpheres = 1023;
+    std::vector<float> spheres(numSpheres * 4);
+    for (size_t i = 0; i < numSpheres; ++i)
+    {
+        spheres[i] = Math::RangeRandom(-1000, 1000);
+        spheres[i + numSpheres] = Math::RangeRandom(-1000, 1000);
+        spheres[i + numSpheres * 2] = Math::RangeRandom(-1100, 100);
+        spheres[i + numSpheres * 3] = Math::RangeRandom(0, 100);
+    }
+
+    Plane planes[6];
+    for (unsigned short i = 0; i < 6; ++i)
+        planes[i] = cam->getFrustumPlane(i);
+
+    std::vector<char> visible(numSpheres);
+    OptimisedUtil::getImplementation()->cullSpheres(planes, 6, &spheres[0], &spheres[numSpheres],
+                                                    &spheres[numSpheres * 2], &spheres[numSpheres * 3],
+                                                    &visible[0], numSpheres);
+
+    for (size_t i = 0; i < numSpheres; ++i)
+    {
+        Sphere sphere(Vector3(spheres[i], spheres[i + numSpheres], spheres[i + numSpheres * 2]),
+                      spheres[i + numSpheres * 3]);
+        EXPECT_EQ(cam->isVisible(sphere), visible[i] != 0);
+    }
+}
 
 
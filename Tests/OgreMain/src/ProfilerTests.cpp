@@ -0,0 +1,216 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreProfiler.h"
+#include "OgreTimer.h"
+#include "OgreFrameCounters.h"
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Ogre;
+
+namespace
+{
+    struct TraceCollector : public ProfileSessionListener
+    {
+        ProfileTraceEventList events;
+        int flushes;
+
+        TraceCollector() : flushes(0) {}
+        void initializeSession() {}
+        void finializeSession() {}
+        void traceEventsRecorded(const ProfileTraceEventList& recorded)
+        {
+            events.insert(events.end(), recorded.begin(), recorded.end());
+            ++flushes;
+        }
+        const ProfileTraceEvent* find(const String& name) const
+        {
+            for (size_t i = 0; i < events.size(); ++i)
+                if (name == events[i].name)
+                    return &events[i];
+            return 0;
+        }
+    };
+}
+
+TEST(Profiler, TraceEvents)
+{
+    Timer timer;
+    Profiler profiler;
+    profiler.setTimer(&timer);
+    TraceCollector collector;
+    profiler.addListener(&collector);
+
+    // nothing is recorded while tracing is disabled
+    profiler.beginTraceEvent("ignored");
+    profiler.endTraceEvent();
+    EXPECT_TRUE(collector.events.empty());
+
+    profiler.setTraceEnabled(true);
+    profiler.beginTraceEvent("outer");
+    profiler.beginTraceEvent("inner");
+    profiler.endTraceEvent();
+
+    std::thread worker([&profiler]() {
+        Profiler::setCurrentThreadName("Worker");
+        // only recorded as trace event on other threads
+        profiler.beginProfile("work");
+        profiler.endProfile("work");
+    });
+    worker.join();
+
+    EXPECT_EQ(collector.flushes, 0);
+    // ending the outermost event of the main thread flushes
+    profiler.endTraceEvent();
+    EXPECT_EQ(collector.flushes, 1);
+    ASSERT_EQ(collector.events.size(), 3u);
+
+    const ProfileTraceEvent* outer = collector.find("outer");
+    const ProfileTraceEvent* inner = collector.find("inner");
+    const ProfileTraceEvent* work = collector.find("work");
+    ASSERT_TRUE(outer && inner && work);
+
+    EXPECT_EQ(outer->depth, 0u);
+    EXPECT_EQ(inner->depth, 1u);
+    EXPECT_EQ(outer->threadId, inner->threadId);
+    EXPECT_NE(outer->threadId, work->threadId);
+    EXPECT_LE(outer->start, inner->start);
+    EXPECT_GE(outer->start + outer->duration, inner->start + inner->duration);
+    EXPECT_LE(outer->start, work->start);
+
+    EXPECT_EQ(profiler.getTraceThreadName(outer->threadId), "Ogre Main");
+    EXPECT_EQ(profiler.getTraceThreadName(work->threadId), "Worker");
+
+    profiler.removeListener(&collector);
+}
+
+TEST(Profiler, ChromeTrace)
+{
+    Timer timer;
+    Profiler profiler;
+    profiler.setTimer(&timer);
+    ChromeTraceSessionListener listener("ProfilerChromeTrace.json");
+    profiler.addListener(&listener);
+
+    profiler.setEnabled(true);
+    profiler.setTraceEnabled(true);
+    {
+        ProfileTraceScope frame("Frame \"1\"");
+        ProfileTraceScope update("update");
+    }
+    profiler.setEnabled(false);
+    profiler.removeListener(&listener);
+
+    std::ifstream file("ProfilerChromeTrace.json");
+    ASSERT_TRUE(file.is_open());
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+    remove("ProfilerChromeTrace.json");
+
+    String json = content.str();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"Frame \\\"1\\\"\",\"ph\":\"X\""), String::npos);
+    EXPECT_NE(json.find("\"name\":\"update\",\"ph\":\"X\""), String::npos);
+    EXPECT_NE(json.find("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Ogre Main\"}"), String::npos);
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST(FrameCounters, PublishAndTrace)
+{
+    Root root("");
+    SceneManager* sm = root.createSceneManager();
+    for (int i = 0; i < 10; ++i)
+        sm->getRootSceneNode()->createChildSceneNode(Vector3(Real(i), 0, 0));
+
+    FrameCounters::_endFrame();
+    EXPECT_EQ(FrameCounters::getCurrent(FrameCounters::FC_NODES_UPDATED), 0u);
+
+    sm->getRootSceneNode()->_update(true, false);
+    size_t updated = FrameCounters::getCurrent(FrameCounters::FC_NODES_UPDATED);
+    EXPECT_GE(updated, 10u);
+
+    // Root only owns a Profiler with OGRE_PROFILING
+    Timer timer;
+    std::unique_ptr<Profiler> ownProfiler;
+    if (!Profiler::getSingletonPtr())
+    {
+        ownProfiler.reset(new Profiler());
+        ownProfiler->setTimer(&timer);
+    }
+    Profiler& profiler = Profiler::getSingleton();
+    TraceCollector collector;
+    profiler.addListener(&collector);
+    profiler.setTraceEnabled(true);
+
+    FrameCounters::_endFrame();
+    profiler.flushTraceEvents();
+    profiler.setTraceEnabled(false);
+    profiler.removeListener(&collector);
+
+    EXPECT_EQ(FrameCounters::getLastFrame(FrameCounters::FC_NODES_UPDATED), updated);
+    EXPECT_EQ(FrameCounters::getCurrent(FrameCounters::FC_NODES_UPDATED), 0u);
+
+    const ProfileTraceEvent* nodes = collector.find(FrameCounters::getName(FrameCounters::FC_NODES_UPDATED));
+    ASSERT_TRUE(nodes);
+    EXPECT_TRUE(nodes->isCounter);
+    EXPECT_EQ(nodes->value, updated);
+}
+
+TEST(FrameCounters, SumsThreads)
+{
+    FrameCounters::_endFrame();
+
+    // exited threads hand their counters on, their counts must neither be lost nor repeated
+    for (int round = 0; round < 2; ++round)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([]() {
+                for (int i = 0; i < 1000; ++i)
+                    FrameCounters::addQueuedRenderable(RENDER_QUEUE_MAIN);
+            });
+        for (auto& t : threads)
+            t.join();
+
+        FrameCounters::add(FrameCounters::FC_RENDERABLES_QUEUED, 5);
+        EXPECT_EQ(FrameCounters::getCurrent(FrameCounters::FC_RENDERABLES_QUEUED), 4005u);
+
+        FrameCounters::_endFrame();
+        EXPECT_EQ(FrameCounters::getLastFrame(FrameCounters::FC_RENDERABLES_QUEUED), 4005u);
+        EXPECT_EQ(FrameCounters::getLastFrameQueued(RENDER_QUEUE_MAIN), 4000u);
+        EXPECT_EQ(FrameCounters::getCurrent(FrameCounters::FC_RENDERABLES_QUEUED), 0u);
+    }
+}
@@ -0,0 +1,166 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Ogre.h"
+#include "OgreStaticGeometry.h"
+#include "OgreTaskScheduler.h"
+#include "OgreFileSystem.h"
+#include "OgreStreamSerialiser.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture StaticGeometryTests;
+
+namespace
+{
+    /// Queue a bunch of entities spread over several regions
+    void addEntities(SceneManager* sceneMgr, StaticGeometry* geom)
+    {
+        const char* meshes[] = {"robot.mesh", "knot.mesh"};
+        for (int i = 0; i < 20; ++i)
+        {
+            Entity* ent = sceneMgr->createEntity(meshes[i % 2]);
+            Vector3 position(i * 73 % 500, i * 31 % 200, i * 47 % 400);
+            Quaternion orientation(Degree(i * 37), Vector3::UNIT_Y);
+            geom->addEntity(ent, position, orientation, Vector3(1 + (i % 3) * 0.5f));
+        }
+        geom->setRegionDimensions(Vector3(200));
+    }
+
+    /// Contents of all vertex and index buffers of the built geometry, in region order
+    std::vector<std::vector<uchar> > getBuiltData(StaticGeometry* geom)
+    {
+        std::vector<std::vector<uchar> > data;
+        StaticGeometry::RegionIterator regions = geom->getRegionIterator();
+        while (regions.hasMoreElements())
+        {
+            StaticGeometry::Region::LODIterator lods = regions.getNext()->getLODIterator();
+            while (lods.hasMoreElements())
+            {
+                StaticGeometry::LODBucket::MaterialIterator mats = lods.getNext()->getMaterialIterator();
+                while (mats.hasMoreElements())
+                {
+                    StaticGeometry::MaterialBucket::GeometryIterator geoms =
+                        mats.getNext()->getGeometryIterator();
+                    while (geoms.hasMoreElements())
+                    {
+                        StaticGeometry::GeometryBucket* bucket = geoms.getNext();
+                        const VertexBufferBinding* binds = bucket->getVertexData()->vertexBufferBinding;
+                        std::vector<HardwareBuffer*> buffers(1, bucket->getIndexData()->indexBuffer.get());
+                        for (ushort b = 0; b < binds->getBufferCount(); ++b)
+                            buffers.push_back(binds->getBuffer(b).get());
+                        for (size_t b = 0; b < buffers.size(); ++b)
+                        {
+                            data.push_back(std::vector<uchar>(buffers[b]->getSizeInBytes()));
+                            buffers[b]->readData(0, data.back().size(), data.back().data());
+                        }
+                    }
+                }
+            }
+        }
+        return data;
+    }
+}
+
+TEST_F(StaticGeometryTests, ParallelBuildMatchesSerial)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    StaticGeometry* geom = sceneMgr->createStaticGeometry("Geometry");
+    addEntities(sceneMgr, geom);
+
+    mRoot->getTaskScheduler()->shutdown();
+    geom->build();
+    std::vector<std::vector<uchar> > serial = getBuiltData(geom);
+
+    mRoot->getTaskScheduler()->startup(3);
+    geom->build();
+    std::vector<std::vector<uchar> > parallel = getBuiltData(geom);
+
+    size_t regionCount = 0;
+    for (StaticGeometry::RegionIterator it = geom->getRegionIterator(); it.hasMoreElements(); it.moveNext())
+        ++regionCount;
+    EXPECT_GT(regionCount, 1u);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+        EXPECT_TRUE(serial[i] == parallel[i]) << "buffer " << i << " differs";
+}
+
+TEST_F(StaticGeometryTests, SaveLoad)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    StaticGeometry* geom = sceneMgr->createStaticGeometry("Geometry");
+    addEntities(sceneMgr, geom);
+    geom->build();
+    // the hardware buffers are write only, there is nothing to save from
+    StreamSerialiser discard(DataStreamPtr(new MemoryDataStream(16)));
+    EXPECT_THROW(geom->save(discard), Exception);
+
+    geom->setRetainBuildData(true);
+    geom->build();
+    std::vector<std::vector<uchar> > built = getBuiltData(geom);
+
+    FileSystemArchiveFactory factory;
+    Archive* arch = factory.createInstance("./", false);
+    arch->load();
+    String fileName = "testStaticGeometry.dat";
+    {
+        StreamSerialiser serialiser(arch->create(fileName));
+        geom->save(serialiser);
+    }
+
+    // the same input restores the same geometry
+    StaticGeometry* loaded = sceneMgr->createStaticGeometry("Loaded");
+    addEntities(sceneMgr, loaded);
+    {
+        StreamSerialiser serialiser(arch->open(fileName));
+        ASSERT_TRUE(loaded->load(serialiser));
+    }
+    EXPECT_TRUE(getBuiltData(loaded) == built);
+
+    // changing the contents of a mesh, but not its size, invalidates the saved geometry
+    StaticGeometry* changed = sceneMgr->createStaticGeometry("Changed");
+    addEntities(sceneMgr, changed);
+    MeshPtr mesh = MeshManager::getSingleton().getByName("knot.mesh", RGN_DEFAULT);
+    ASSERT_TRUE(mesh);
+    const VertexData* vertexData = mesh->getSubMesh(0)->useSharedVertices ?
+        mesh->sharedVertexData : mesh->getSubMesh(0)->vertexData;
+    const VertexElement* posElem =
+        vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+    float position[3];
+    vbuf->readData(posElem->getOffset(), sizeof(position), position);
+    position[0] += 1;
+    vbuf->writeData(posElem->getOffset(), sizeof(position), position);
+    {
+        StreamSerialiser serialiser(arch->open(fileName));
+        EXPECT_FALSE(changed->load(serialiser));
+    }
+
+    arch->remove(fileName);
+    factory.destroyInstance(arch);
+}
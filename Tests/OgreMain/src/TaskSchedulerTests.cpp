@@ -0,0 +1,321 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "OgreTaskScheduler.h"
+#include "OgreTaskGraph.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "OgreRoot.h"
+
+using namespace Ogre;
+
+TEST(TaskScheduler, RunGroup)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(3);
+
+    std::atomic<int> sum(0);
+    {
+        TaskGroup group(&scheduler);
+        for (int i = 1; i <= 1000; ++i)
+            group.run([&sum, i]() { sum += i; });
+        group.wait();
+        EXPECT_TRUE(group.isFinished());
+    }
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+TEST(TaskScheduler, NestedGroups)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(3);
+
+    std::atomic<int> count(0);
+    TaskGroup outer(&scheduler);
+    for (int i = 0; i < 16; ++i)
+    {
+        outer.run([&]() {
+            // waiting on a worker must not dead lock, it runs the inner tasks itself
+            TaskGroup inner(&scheduler);
+            for (int j = 0; j < 16; ++j)
+                inner.run([&count]() { ++count; });
+            inner.wait();
+        });
+    }
+    outer.wait();
+    EXPECT_EQ(count.load(), 256);
+}
+
+TEST(TaskScheduler, Exception)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(3);
+
+    TaskGroup group(&scheduler);
+    for (int i = 0; i < 8; ++i)
+        group.run([i]() { if (i == 5) throw std::runtime_error("task failed"); });
+    EXPECT_THROW(group.wait(), std::runtime_error);
+
+    // the group can be reused once the error was reported
+    group.run([]() {});
+    EXPECT_NO_THROW(group.wait());
+}
+
+TEST(TaskScheduler, NoWorkers)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(0);
+
+    std::vector<int> order;
+    TaskGroup group(&scheduler);
+    for (int i = 0; i < 4; ++i)
+        group.run([&order, i]() { order.push_back(i); });
+    group.wait();
+    ASSERT_EQ(order.size(), 4u);
+
+    // a group without scheduler, there is no Root, runs its tasks right away
+    TaskGroup inplace;
+    ASSERT_FALSE(inplace.getScheduler());
+    bool done = false;
+    inplace.run([&done]() { done = true; });
+    EXPECT_TRUE(done);
+}
+
+#if OGRE_THREAD_SUPPORT
+TEST(TaskScheduler, WaitForRunningTasks)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(1);
+
+    // the waiting thread finds nothing to run and has to sleep until the worker is done
+    std::atomic<bool> started(false);
+    std::atomic<bool> done(false);
+    TaskGroup group(&scheduler);
+    group.run([&]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        done = true;
+    });
+    while (!started)
+        std::this_thread::yield();
+    group.wait();
+    EXPECT_TRUE(done.load());
+    EXPECT_TRUE(group.isFinished());
+
+    // and wake up again for every following batch
+    std::atomic<int> count(0);
+    for (int i = 0; i < 200; ++i)
+    {
+        group.run([&count]() { ++count; });
+        group.wait();
+    }
+    EXPECT_EQ(count.load(), 200);
+}
+#endif
+
+TEST(TaskScheduler, ParallelFor)
+{
+    Root root("");
+    root.getTaskScheduler()->startup(3);
+
+    std::vector<int> values(10000, 0);
+    parallelFor(values.size(), [&values](size_t i) { values[i] = int(i); });
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], int(i));
+
+    EXPECT_THROW(parallelFor(100, [](size_t i) { if (i == 42) throw std::runtime_error("index failed"); }),
+                 std::runtime_error);
+}
+
+TEST(TaskScheduler, WorkQueue)
+{
+    Root root("");
+
+    struct Handler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        std::atomic<int> processed;
+        int responses;
+        Handler() : processed(0), responses(0) {}
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue*)
+        {
+            ++processed;
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+        void handleResponse(const WorkQueue::Response*, const WorkQueue*) { ++responses; }
+    } handler;
+
+    DefaultWorkQueue queue("Test");
+    queue.setWorkerThreadCount(3);
+    queue.setResponseProcessingTimeLimit(0);
+    uint16 channel = queue.getChannel("Test");
+    queue.addRequestHandler(channel, &handler);
+    queue.addResponseHandler(channel, &handler);
+
+    // requests queued before startup are picked up by the workers
+    for (int i = 0; i < 50; ++i)
+        queue.addRequest(channel, 0, Any());
+    queue.startup();
+    for (int i = 0; i < 50; ++i)
+        queue.addRequest(channel, 0, Any());
+
+    while (handler.responses < 100)
+        queue.processResponses();
+    EXPECT_EQ(handler.processed.load(), 100);
+
+    queue.shutdown();
+    queue.removeRequestHandler(channel, &handler);
+    queue.removeResponseHandler(channel, &handler);
+}
+
+TEST(TaskScheduler, RootLeavesThreadsToWorkQueue)
+{
+    Root root("");
+
+    // both pools together use one thread less than the hardware has, the caller is the last one,
+    // but a multi-core machine always gets a task worker
+    int hardwareThreads = std::max(int(OGRE_THREAD_HARDWARE_CONCURRENCY), 1);
+    size_t queueWorkers =
+        static_cast<DefaultWorkQueueBase*>(root.getWorkQueue())->getWorkerThreadCount();
+    EXPECT_EQ(root.getTaskScheduler()->getWorkerCount(),
+              size_t(std::max(hardwareThreads - 1 - int(queueWorkers), std::min(hardwareThreads - 1, 1))));
+}
+
+TEST(TaskScheduler, WorkQueuePriorities)
+{
+    Root root("");
+
+    struct Handler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        std::vector<int> order;
+        std::atomic<size_t> processed;
+        Handler() : processed(0) {}
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue*)
+        {
+            order.push_back(any_cast<int>(req->getData()));
+            ++processed;
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+        void handleResponse(const WorkQueue::Response*, const WorkQueue*) {}
+    } handler;
+
+    // a single worker processes the requests one by one
+    DefaultWorkQueue queue("Test");
+    queue.setWorkerThreadCount(1);
+    uint16 channel = queue.getChannel("Test");
+    queue.addRequestHandler(channel, &handler);
+    queue.addResponseHandler(channel, &handler);
+
+    WorkQueue::CancellationTokenPtr token(OGRE_NEW WorkQueue::CancellationToken());
+    unsigned long now = root.getTimer()->getMilliseconds();
+
+    queue.addRequest(channel, 0, Any(4));
+    queue.addPrioritisedRequest(channel, 0, Any(3), WorkQueue::RP_HIGH);
+    queue.addPrioritisedRequest(channel, 0, Any(-1), WorkQueue::RP_CRITICAL, 0, token);
+    queue.addPrioritisedRequest(channel, 0, Any(-2), WorkQueue::RP_CRITICAL, now + 1);
+    // an earlier deadline goes first among equal priorities
+    queue.addPrioritisedRequest(channel, 0, Any(2), WorkQueue::RP_HIGH, now + 100000);
+    WorkQueue::RequestID low = queue.addPrioritisedRequest(channel, 0, Any(1), WorkQueue::RP_LOW);
+    queue.addPrioritisedRequest(channel, 0, Any(5), WorkQueue::RP_LOW);
+
+    token->cancel();
+    EXPECT_TRUE(queue.setRequestPriority(low, WorkQueue::RP_CRITICAL));
+    // let the deadline pass
+    while (root.getTimer()->getMilliseconds() <= now + 1)
+        OGRE_THREAD_SLEEP(1);
+
+    queue.startup();
+    while (handler.processed < 5)
+        OGRE_THREAD_SLEEP(1);
+    queue.shutdown();
+
+    int expected[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(handler.order, std::vector<int>(expected, expected + 5));
+
+    queue.removeRequestHandler(channel, &handler);
+    queue.removeResponseHandler(channel, &handler);
+}
+
+TEST(TaskGraph, Dependencies)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(3);
+
+    // a -> (b, c) -> d
+    std::atomic<int> step(0);
+    int a = -1, b = -1, c = -1, d = -1;
+    TaskGraph graph;
+    TaskGraph::PhaseId pa = graph.addPhase("a", [&]() { a = step++; });
+    TaskGraph::PhaseId pb = graph.addPhase("b", [&]() { b = step++; });
+    TaskGraph::PhaseId pc = graph.addPhase("c", [&]() { c = step++; });
+    TaskGraph::PhaseId pd = graph.addPhase("d", [&]() { d = step++; });
+    graph.addDependency(pb, pa);
+    graph.addDependency(pc, pa);
+    graph.addDependency(pd, pb);
+    graph.addDependency(pd, pc);
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        step = 0;
+        graph.execute(&scheduler);
+        EXPECT_EQ(a, 0);
+        EXPECT_GT(b, a);
+        EXPECT_GT(c, a);
+        EXPECT_EQ(d, 3);
+    }
+
+    // serial execution keeps the order of addPhase where possible
+    graph.removeDependency(pb, pa);
+    graph.removeDependency(pc, pa);
+    step = 0;
+    graph.executeSerial();
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 1);
+    EXPECT_EQ(c, 2);
+    EXPECT_EQ(d, 3);
+    EXPECT_EQ(graph.getPhaseName(pd), "d");
+}
+
+TEST(TaskGraph, Errors)
+{
+    TaskScheduler scheduler;
+    scheduler.startup(2);
+
+    bool dependentRan = false;
+    TaskGraph graph;
+    TaskGraph::PhaseId failing = graph.addPhase("failing", []() { throw std::runtime_error("phase failed"); });
+    TaskGraph::PhaseId dependent = graph.addPhase("dependent", [&]() { dependentRan = true; });
+    graph.addDependency(dependent, failing);
+    EXPECT_THROW(graph.execute(&scheduler), std::runtime_error);
+    EXPECT_FALSE(dependentRan);
+
+    graph.addDependency(failing, dependent);
+    EXPECT_THROW(graph.execute(&scheduler), InvalidParametersException);
+    EXPECT_THROW(graph.addDependency(failing, 42), ItemIdentityException);
+}
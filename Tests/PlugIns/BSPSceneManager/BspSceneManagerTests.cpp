@@ -0,0 +1,287 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "Ogre.h"
+#include "OgreConfigFile.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreNullRenderSystem.h"
+#include "OgrePlugin.h"
+#include "OgreQuake3Types.h"
+#ifdef OGRE_STATIC_LIB
+#include "OgreBspSceneManagerPlugin.h"
+#endif
+
+#include <algorithm>
+#include <set>
+
+using namespace Ogre;
+
+namespace
+{
+    typedef std::vector<std::vector<uint32> > DrawList;
+
+    /// Keeps the indexes of every draw call with 32 bit indexes, which the level geometry uses
+    class IndexRecordingRenderSystem : public NullRenderSystem
+    {
+    public:
+        DrawList draws;
+
+        void _render(const RenderOperation& op)
+        {
+            NullRenderSystem::_render(op);
+            if (!op.useIndexes || op.indexData->indexBuffer->getType() != HardwareIndexBuffer::IT_32BIT)
+                return;
+
+            const HardwareIndexBufferSharedPtr& buffer = op.indexData->indexBuffer;
+            const uint32* indexes = static_cast<const uint32*>(buffer->lock(
+                op.indexData->indexStart * sizeof(uint32), op.indexData->indexCount * sizeof(uint32),
+                HardwareBuffer::HBL_READ_ONLY));
+            draws.push_back(std::vector<uint32>(indexes, indexes + op.indexData->indexCount));
+            buffer->unlock();
+        }
+    };
+
+    /// Installs the render system like the Null plugin, so it is gone before the managers it feeds
+    class IndexRecordingPlugin : public Plugin
+    {
+    public:
+        IndexRecordingRenderSystem* renderSystem;
+
+        IndexRecordingPlugin() : renderSystem(0) {}
+        const String& getName() const
+        {
+            static String name = "Index Recording RenderSystem";
+            return name;
+        }
+        void install()
+        {
+            renderSystem = new IndexRecordingRenderSystem();
+            Root::getSingleton().addRenderSystem(renderSystem);
+        }
+        void initialise() {}
+        void shutdown() {}
+        void uninstall()
+        {
+            delete renderSystem;
+            renderSystem = 0;
+        }
+    };
+
+    const String LEVEL = "ogretestmap.bsp";
+}
+
+class BspSceneManagerTests : public ::testing::Test
+{
+public:
+    IndexRecordingPlugin* mPlugin;
+    IndexRecordingRenderSystem* mRenderSystem;
+    Root* mRoot;
+    Viewport* mViewport;
+#ifdef OGRE_STATIC_LIB
+    BspSceneManagerPlugin* mBspPlugin;
+#endif
+
+    void SetUp()
+    {
+        mRoot = new Root("");
+        mPlugin = new IndexRecordingPlugin();
+        mRoot->installPlugin(mPlugin);
+        mRenderSystem = mPlugin->renderSystem;
+        mRoot->setRenderSystem(mRenderSystem);
+        mRoot->initialise(false);
+        mViewport = mRoot->createRenderWindow("BspWindow", 320, 240, false)->addViewport(0);
+        FileSystemLayer fsLayer(OGRE_VERSION_NAME);
+#ifdef OGRE_STATIC_LIB
+        mBspPlugin = new BspSceneManagerPlugin();
+        mRoot->installPlugin(mBspPlugin);
+#else
+        // from the plugin folder of the samples, the tests do not use the plugin directly
+        ConfigFile plugins;
+        plugins.load(fsLayer.getConfigFilePath("plugins.cfg"));
+        String pluginFolder = plugins.getSetting("PluginFolder");
+        mRoot->loadPlugin((pluginFolder.empty() ? "" : pluginFolder + "/") + "Plugin_BSPSceneManager");
+#endif
+
+        // only the archive of the level from the sample resources
+        ConfigFile cf;
+        cf.load(fsLayer.getConfigFilePath("resources.cfg"));
+        ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+        const ConfigFile::SettingsBySection_& sections = cf.getSettingsBySection();
+        for (ConfigFile::SettingsBySection_::const_iterator s = sections.begin(); s != sections.end(); ++s)
+        {
+            for (ConfigFile::SettingsMultiMap::const_iterator i = s->second.begin(); i != s->second.end(); ++i)
+            {
+                if (i->second.find("ogretestmap") != String::npos)
+                    rgm.addResourceLocation(i->second, i->first, "BSPWorld");
+            }
+        }
+        rgm.setWorldResourceGroupName("BSPWorld");
+        rgm.initialiseResourceGroup("BSPWorld");
+    }
+
+    void TearDown()
+    {
+        delete mRoot;
+        delete mPlugin;
+#ifdef OGRE_STATIC_LIB
+        delete mBspPlugin;
+#endif
+    }
+
+    /// Loads the sample level, or the given level data when there is any
+    SceneManager* createLevel(Camera** camera, const MemoryDataStreamPtr& levelData = MemoryDataStreamPtr())
+    {
+        // every level creates its lightmaps, those of a level loaded before are still in use
+        TextureManager& textureMgr = TextureManager::getSingleton();
+        for (int i = 0; textureMgr.resourceExists("@lightmap" + StringConverter::toString(i), "BSPWorld"); ++i)
+            textureMgr.remove("@lightmap" + StringConverter::toString(i), "BSPWorld");
+
+        SceneManager* sceneMgr = mRoot->createSceneManager("BspSceneManager");
+        if (levelData)
+        {
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(LEVEL, levelData->getPtr(), levelData->size()));
+            sceneMgr->setWorldGeometry(stream);
+        }
+        else
+        {
+            sceneMgr->setWorldGeometry(LEVEL);
+        }
+        *camera = sceneMgr->createCamera("Camera");
+        (*camera)->setNearClipDistance(4);
+        (*camera)->setFarClipDistance(4000);
+        sceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(*camera);
+        return sceneMgr;
+    }
+
+    DrawList render(Camera* camera, const Vector3& position, const Quaternion& orientation)
+    {
+        camera->getParentSceneNode()->setPosition(position);
+        camera->getParentSceneNode()->setOrientation(orientation);
+        mViewport->setCamera(camera);
+        mRenderSystem->draws.clear();
+        mRoot->renderOneFrame();
+        return mRenderSystem->draws;
+    }
+
+    /** Walks the camera between the player starts and around the first one, in and out of the
+        level, and checks every frame against a new scene manager, which has neither the PVS
+        leaves nor the indexes cached. Returns the draws of every frame.
+    */
+    std::vector<DrawList> walkAcrossClusters(const MemoryDataStreamPtr& levelData = MemoryDataStreamPtr())
+    {
+        Camera* camera;
+        SceneManager* sceneMgr = createLevel(&camera, levelData);
+
+        std::vector<Vector3> waypoints;
+        ViewPoint start = sceneMgr->getSuggestedViewpoint(false);
+        waypoints.push_back(start.position);
+        srand(0);
+        for (int i = 0; i < 32; ++i)
+        {
+            Vector3 pos = sceneMgr->getSuggestedViewpoint(true).position;
+            if (std::find(waypoints.begin(), waypoints.end(), pos) == waypoints.end())
+                waypoints.push_back(pos);
+        }
+        waypoints.push_back(start.position + Vector3(400, 0, 0));
+        waypoints.push_back(start.position + Vector3(0, 400, 0));
+        waypoints.push_back(start.position + Vector3(-400, -400, 0));
+        waypoints.push_back(start.position);
+
+        // Quake uses the Z axis as the up axis
+        Quaternion up(Degree(90), Vector3::UNIT_X);
+
+        std::vector<DrawList> frames;
+        const int steps = 8;
+        for (size_t w = 0; w + 1 < waypoints.size(); ++w)
+        {
+            for (int step = 0; step < steps; ++step)
+            {
+                Vector3 position = waypoints[w] + (waypoints[w + 1] - waypoints[w]) * (Real(step) / steps);
+                Quaternion orientation = Quaternion(Degree(Real(w * steps + step) * 25), Vector3::UNIT_Z) *
+                    start.orientation * up;
+
+                DrawList cached = render(camera, position, orientation);
+
+                Camera* freshCamera;
+                SceneManager* fresh = createLevel(&freshCamera, levelData);
+                DrawList uncached = render(freshCamera, position, orientation);
+                mViewport->setCamera(camera);
+                mRoot->destroySceneManager(fresh);
+
+                EXPECT_EQ(cached, uncached) << "waypoint " << w << " step " << step;
+                frames.push_back(cached);
+            }
+        }
+
+        mRoot->destroySceneManager(sceneMgr);
+        return frames;
+    }
+};
+
+TEST_F(BspSceneManagerTests, CachedWalkAcrossClusters)
+{
+    std::vector<DrawList> frames = walkAcrossClusters();
+
+    // the walk saw different parts of the level
+    std::set<DrawList> distinctDraws(frames.begin(), frames.end());
+    EXPECT_GT(distinctDraws.size(), 4u);
+}
+
+TEST_F(BspSceneManagerTests, CachedWalkAcrossSingleClusterPvs)
+{
+    // The PVS of the sample level makes every cluster visible from every other one. Patch it,
+    // so each cluster only sees itself and the leaves to render change with every cluster.
+    DataStreamPtr file = ResourceGroupManager::getSingleton().openResource(LEVEL, "BSPWorld");
+    MemoryDataStreamPtr levelData(OGRE_NEW MemoryDataStream(LEVEL, file));
+    uchar* data = levelData->getPtr();
+    const bsp_header_t* header = reinterpret_cast<const bsp_header_t*>(data);
+    bsp_vis_t* vis = reinterpret_cast<bsp_vis_t*>(data + header->lumps[BSP_VISIBILITY_LUMP].offset);
+    ASSERT_GT(vis->cluster_count, 1);
+    for (int from = 0; from < vis->cluster_count; ++from)
+    {
+        uchar* row = vis->data + from * vis->row_size;
+        std::fill(row, row + vis->row_size, 0);
+        row[from >> 3] = uchar(1 << (from & 7));
+    }
+
+    std::vector<DrawList> patchedFrames = walkAcrossClusters(levelData);
+    std::vector<DrawList> frames = walkAcrossClusters();
+    ASSERT_EQ(frames.size(), patchedFrames.size());
+
+    // inside the level the patched PVS hides faces the sample one shows
+    size_t culledFrames = 0;
+    for (size_t f = 0; f < frames.size(); ++f)
+    {
+        if (patchedFrames[f] != frames[f])
+            ++culledFrames;
+    }
+    EXPECT_GT(culledFrames, 0u);
+    std::set<DrawList> distinctDraws(patchedFrames.begin(), patchedFrames.end());
+    EXPECT_GT(distinctDraws.size(), 4u);
+}
@@ -0,0 +1,278 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+
+#include "Ogre.h"
+#include "OgrePCZSceneManager.h"
+#include "OgrePCZSceneNode.h"
+#include "OgrePCZCamera.h"
+#include "OgrePortal.h"
+#include "OgreOctreeZone.h"
+#include "OgreTaskScheduler.h"
+#include "OgreNullPlugin.h"
+#ifdef OGRE_STATIC_LIB
+#include "OgrePCZPlugin.h"
+#include "OgreOctreeZonePlugin.h"
+#endif
+
+using namespace Ogre;
+
+namespace
+{
+    /// Box shaped object, which records when it is added to the render queue
+    class RecordingBox : public MovableObject
+    {
+    public:
+        RecordingBox(const String& name, const AxisAlignedBox& box, StringVector* visible)
+            : MovableObject(name), mBox(box), mVisible(visible)
+        {
+        }
+
+        const String& getMovableType(void) const
+        {
+            static String type = "RecordingBox";
+            return type;
+        }
+        const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+        Real getBoundingRadius(void) const { return mBox.getHalfSize().length(); }
+        void _updateRenderQueue(RenderQueue* queue)
+        {
+            if (mVisible)
+                mVisible->push_back(mName);
+        }
+        void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+
+    private:
+        AxisAlignedBox mBox;
+        StringVector* mVisible;
+    };
+
+    const int GRID_SIZE = 8;
+    const Real CELL_SIZE = 100;
+    const int NODE_COUNT = 600;
+    const int FRAME_COUNT = 6;
+
+    /// Grid of rooms, which are connected by doors to their neighbours
+    struct RoomGrid
+    {
+        PCZSceneManager* sceneMgr;
+        PCZCamera* camera;
+        SceneNode* cameraNode;
+        std::vector<PCZSceneNode*> nodes;
+        std::vector<MovableObject*> objects;
+        StringVector visible;
+
+        RoomGrid(const String& zoneType, const std::vector<Vector3>& positions)
+        {
+            sceneMgr = static_cast<PCZSceneManager*>(Root::getSingleton().createSceneManager("PCZSceneManager"));
+            sceneMgr->init(zoneType);
+            PCZSceneNode* root = static_cast<PCZSceneNode*>(sceneMgr->getRootSceneNode());
+
+            for (int i = 0; i < GRID_SIZE; ++i)
+            {
+                for (int j = 0; j < GRID_SIZE; ++j)
+                {
+                    PCZone* zone = sceneMgr->createZone(zoneType, zoneName(i, j));
+                    PCZSceneNode* roomNode = static_cast<PCZSceneNode*>(root->createChildSceneNode());
+                    Vector3 min(i * CELL_SIZE, 0, j * CELL_SIZE);
+                    objects.push_back(new RecordingBox(zone->getName(),
+                        AxisAlignedBox(min, min + Vector3(CELL_SIZE)), NULL));
+                    roomNode->attachObject(objects.back());
+                    zone->setEnclosureNode(roomNode);
+                    sceneMgr->addPCZSceneNode(roomNode, zone);
+
+                    // doors in the walls to the neighbours, facing into the room
+                    Vector3 centre = min + Vector3(CELL_SIZE / 2);
+                    if (i > 0)
+                        addDoor(zone, centre - Vector3(CELL_SIZE / 2, 0, 0), Vector3::UNIT_X);
+                    if (i < GRID_SIZE - 1)
+                        addDoor(zone, centre + Vector3(CELL_SIZE / 2, 0, 0), Vector3::NEGATIVE_UNIT_X);
+                    if (j > 0)
+                        addDoor(zone, centre - Vector3(0, 0, CELL_SIZE / 2), Vector3::UNIT_Z);
+                    if (j < GRID_SIZE - 1)
+                        addDoor(zone, centre + Vector3(0, 0, CELL_SIZE / 2), Vector3::NEGATIVE_UNIT_Z);
+                }
+            }
+            sceneMgr->connectPortalsToTargetZonesByLocation();
+
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                PCZSceneNode* node =
+                    static_cast<PCZSceneNode*>(root->createChildSceneNode(positions[i]));
+                Real size = 2 + (i % 7) * 2;
+                objects.push_back(new RecordingBox("Box" + StringConverter::toString(i),
+                    AxisAlignedBox(Vector3(-size), Vector3(size)), &visible));
+                node->attachObject(objects.back());
+                sceneMgr->addPCZSceneNode(node, sceneMgr->getZoneByName(zoneName(
+                    int(positions[i].x / CELL_SIZE), int(positions[i].z / CELL_SIZE))));
+                nodes.push_back(node);
+            }
+
+            camera = static_cast<PCZCamera*>(sceneMgr->createCamera("Camera"));
+            camera->setNearClipDistance(1);
+            camera->setFarClipDistance(GRID_SIZE * CELL_SIZE * 2);
+            cameraNode = root->createChildSceneNode(Vector3(20, 50, 20));
+            cameraNode->attachObject(camera);
+            cameraNode->lookAt(Vector3(GRID_SIZE * CELL_SIZE, 50, GRID_SIZE * CELL_SIZE * 0.6f),
+                               Node::TS_WORLD);
+            sceneMgr->addPCZSceneNode(static_cast<PCZSceneNode*>(cameraNode),
+                                      sceneMgr->getZoneByName(zoneName(0, 0)));
+        }
+
+        ~RoomGrid()
+        {
+            Root::getSingleton().destroySceneManager(sceneMgr);
+            for (size_t i = 0; i < objects.size(); ++i)
+                delete objects[i];
+        }
+
+        static String zoneName(int i, int j)
+        {
+            return "Room" + StringConverter::toString(i) + "_" + StringConverter::toString(j);
+        }
+
+        void addDoor(PCZone* zone, const Vector3& centre, const Vector3& direction)
+        {
+            // corners wound so that the portal normal is the given direction
+            Vector3 u = direction.perpendicular() * (CELL_SIZE / 4);
+            Vector3 v = direction.crossProduct(u);
+            Vector3 corners[4] = {centre - u - v, centre + u - v, centre + u + v, centre - u + v};
+            Portal* portal = sceneMgr->createPortal(zone->getName() + "_Door" +
+                                                    StringConverter::toString(zone->mPortals.size()));
+            portal->setCorners(corners);
+            zone->_addPortal(portal);
+            portal->updateDerivedValues();
+        }
+
+        void renderFrame()
+        {
+            visible.clear();
+            sceneMgr->_updateSceneGraph(camera);
+            sceneMgr->_findVisibleObjects(camera, NULL, false);
+        }
+    };
+}
+
+class PCZSceneManagerTests : public ::testing::Test
+{
+public:
+    NullPlugin* mNullPlugin;
+    Root* mRoot;
+    std::vector<Vector3> mPositions;
+    std::vector<Vector3> mMoves;
+
+    void SetUp()
+    {
+        // plugins register their factories once Root is initialised and cameras need
+        // the buffers and materials set up with the first window
+        mRoot = new Root("");
+        mNullPlugin = new NullPlugin();
+        mRoot->installPlugin(mNullPlugin);
+        mRoot->setRenderSystem(mRoot->getRenderSystemByName("Null Rendering Subsystem"));
+        mRoot->initialise(false);
+        mRoot->createRenderWindow("PCZWindow", 320, 240, false);
+#ifdef OGRE_STATIC_LIB
+        mRoot->installPlugin(new PCZPlugin());
+        mRoot->installPlugin(new OctreeZonePlugin());
+#else
+        mRoot->loadPlugin("Plugin_PCZSceneManager");
+        mRoot->loadPlugin("Plugin_OctreeZone");
+#endif
+        mRoot->getTaskScheduler()->startup(3);
+
+        srand(0);
+        for (int i = 0; i < NODE_COUNT; ++i)
+        {
+            mPositions.push_back(Vector3(Math::RangeRandom(0, GRID_SIZE * CELL_SIZE),
+                                         Math::RangeRandom(10, CELL_SIZE - 10),
+                                         Math::RangeRandom(0, GRID_SIZE * CELL_SIZE)));
+            mMoves.push_back(Vector3(Math::RangeRandom(-30, 30), 0, Math::RangeRandom(-30, 30)));
+        }
+    }
+    void TearDown()
+    {
+        delete mRoot;
+        delete mNullPlugin;
+    }
+
+    /// Render the same animated scene with and without parallel updates and compare the results
+    void compareParallelUpdates(const String& zoneType)
+    {
+        RoomGrid serial(zoneType, mPositions);
+        RoomGrid parallel(zoneType, mPositions);
+        PCZone* zone = parallel.sceneMgr->getZoneByName(RoomGrid::zoneName(0, 0));
+        EXPECT_EQ(zoneType == "ZoneType_Octree", dynamic_cast<OctreeZone*>(zone) != NULL);
+        bool enabled = false;
+        ASSERT_TRUE(serial.sceneMgr->setOption("ParallelUpdates", &enabled));
+        ASSERT_TRUE(parallel.sceneMgr->getOption("ParallelUpdates", &enabled));
+        ASSERT_TRUE(enabled);
+
+        for (int frame = 0; frame < FRAME_COUNT; ++frame)
+        {
+            // move most of the boxes, some of them through the doors
+            for (size_t i = 0; i < serial.nodes.size(); ++i)
+            {
+                if ((i + frame) % 4 == 0)
+                    continue;
+                Vector3 move = mMoves[(i + frame) % mMoves.size()];
+                serial.nodes[i]->translate(move);
+                parallel.nodes[i]->translate(move);
+            }
+            serial.cameraNode->yaw(Degree(5));
+            parallel.cameraNode->yaw(Degree(5));
+
+            FrameEvent evt;
+            mRoot->_fireFrameRenderingQueued(evt);
+            serial.renderFrame();
+            parallel.renderFrame();
+
+            // the nodes of a zone are kept in a set of pointers, so only compare what is visible
+            std::sort(serial.visible.begin(), serial.visible.end());
+            std::sort(parallel.visible.begin(), parallel.visible.end());
+            EXPECT_FALSE(serial.visible.empty());
+            EXPECT_LT(serial.visible.size(), serial.nodes.size());
+            EXPECT_EQ(serial.visible, parallel.visible);
+            for (size_t i = 0; i < serial.nodes.size(); ++i)
+            {
+                EXPECT_EQ(serial.nodes[i]->getHomeZone()->getName(),
+                          parallel.nodes[i]->getHomeZone()->getName());
+            }
+        }
+    }
+};
+
+TEST_F(PCZSceneManagerTests, ParallelUpdatesDefaultZone)
+{
+    compareParallelUpdates("ZoneType_Default");
+}
+
+TEST_F(PCZSceneManagerTests, ParallelUpdatesOctreeZone)
+{
+    compareParallelUpdates("ZoneType_Octree");
+}
@@ -0,0 +1,327 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+
+#include "Ogre.h"
+#include "OgreNullPlugin.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreTaskScheduler.h"
+
+using namespace Ogre;
+
+class NullRenderSystemTests : public ::testing::Test
+{
+public:
+    NullPlugin* mPlugin;
+    Root* mRoot;
+    NullRenderSystem* mRenderSystem;
+    RenderWindow* mWindow;
+    SceneManager* mSceneMgr;
+    Camera* mCamera;
+
+    void SetUp()
+    {
+        mRoot = new Root("");
+        mPlugin = new NullPlugin();
+        mRoot->installPlugin(mPlugin);
+        mRenderSystem = static_cast<NullRenderSystem*>(
+            mRoot->getRenderSystemByName("Null Rendering Subsystem"));
+        mRoot->setRenderSystem(mRenderSystem);
+        mRoot->initialise(false);
+        mWindow = mRoot->createRenderWindow("NullWindow", 320, 240, false);
+
+        mSceneMgr = mRoot->createSceneManager();
+        mCamera = mSceneMgr->createCamera("Camera");
+        mCamera->setNearClipDistance(1);
+        SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+        camNode->attachObject(mCamera);
+        camNode->setPosition(0, 0, 500);
+        mWindow->addViewport(mCamera);
+    }
+
+    void TearDown()
+    {
+        delete mRoot;
+        delete mPlugin;
+    }
+
+    /// A row of cubes in front of a backdrop
+    void createReferenceScene(int cubes)
+    {
+        for (int i = 0; i < cubes; i++)
+        {
+            SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+            node->setPosition(Real(i - cubes / 2) * 150, 0, 0);
+            node->attachObject(mSceneMgr->createEntity(SceneManager::PT_CUBE));
+        }
+
+        MeshManager::getSingleton().createPlane("Backdrop", RGN_DEFAULT, Plane(Vector3::UNIT_Z, -200),
+                                                1000, 1000);
+        mSceneMgr->getRootSceneNode()->attachObject(mSceneMgr->createEntity("Backdrop"));
+    }
+};
+
+TEST_F(NullRenderSystemTests, ReferenceScene)
+{
+    createReferenceScene(3);
+
+    mRenderSystem->setCommandRecordingEnabled(true);
+    mRenderSystem->resetStatistics();
+    mRoot->renderOneFrame();
+
+    const NullRenderSystem::Statistics& stats = mRenderSystem->getStatistics();
+    EXPECT_EQ(stats.drawCalls, 4u);
+    EXPECT_EQ(stats.elements, 3 * 36 + 6u);
+    EXPECT_EQ(stats.clears, 1u);
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.textureBinds, 0u);
+    EXPECT_GT(stats.stateChanges, 0u);
+    EXPECT_GE(stats.constantUploads, stats.drawCalls);
+
+    const NullRenderSystem::CommandList& log = mRenderSystem->getCommandLog();
+    ASSERT_FALSE(log.empty());
+    EXPECT_EQ(log.back().type, NullRenderSystem::CMD_END_FRAME);
+
+    size_t draws = 0;
+    bool inFrame = false;
+    for (size_t i = 0; i < log.size(); i++)
+    {
+        if (log[i].type == NullRenderSystem::CMD_BEGIN_FRAME)
+            inFrame = true;
+        else if (log[i].type == NullRenderSystem::CMD_END_FRAME)
+            inFrame = false;
+        else if (log[i].type == NullRenderSystem::CMD_DRAW)
+        {
+            EXPECT_TRUE(inFrame);
+            EXPECT_EQ(log[i].arg, uint32(RenderOperation::OT_TRIANGLE_LIST));
+            draws++;
+        }
+    }
+    EXPECT_EQ(draws, stats.drawCalls);
+
+    // culled objects do not reach the render system
+    mSceneMgr->getRootSceneNode()->setVisible(false);
+    mRenderSystem->resetStatistics();
+    mRoot->renderOneFrame();
+    EXPECT_EQ(mRenderSystem->getStatistics().drawCalls, 0u);
+    EXPECT_EQ(mRenderSystem->getStatistics().clears, 1u);
+}
+
+TEST_F(NullRenderSystemTests, RedundantStateNotCounted)
+{
+    mRenderSystem->resetStatistics();
+    mRenderSystem->_setCullingMode(CULL_ANTICLOCKWISE);
+    mRenderSystem->_setDepthBufferParams(true, false, CMPF_LESS);
+    EXPECT_EQ(mRenderSystem->getStatistics().stateChanges, 2u);
+
+    // setting the same values again changes nothing
+    mRenderSystem->_setCullingMode(CULL_ANTICLOCKWISE);
+    mRenderSystem->_setDepthBufferParams(true, false, CMPF_LESS);
+    mRenderSystem->_setDepthBufferWriteEnabled(false);
+    EXPECT_EQ(mRenderSystem->getStatistics().stateChanges, 2u);
+
+    // one part of a state differing is a change
+    mRenderSystem->_setDepthBufferFunction(CMPF_GREATER);
+    mRenderSystem->_setCullingMode(CULL_NONE);
+    EXPECT_EQ(mRenderSystem->getStatistics().stateChanges, 4u);
+
+    // so is each texture unit on its own
+    mRenderSystem->_setTextureMatrix(0, Matrix4::IDENTITY);
+    mRenderSystem->_setTextureMatrix(1, Matrix4::IDENTITY);
+    mRenderSystem->_setTextureMatrix(0, Matrix4::IDENTITY);
+    EXPECT_EQ(mRenderSystem->getStatistics().stateChanges, 6u);
+}
+
+TEST_F(NullRenderSystemTests, RenderTexture)
+{
+    createReferenceScene(1);
+
+    TexturePtr tex = TextureManager::getSingleton().createManual(
+        "RTT", RGN_DEFAULT, TEX_TYPE_2D, 64, 32, 0, PF_BYTE_RGBA, TU_RENDERTARGET);
+    RenderTexture* rtt = tex->getBuffer()->getRenderTarget();
+    ASSERT_TRUE(rtt);
+    EXPECT_EQ(rtt->getWidth(), 64u);
+    EXPECT_EQ(rtt->getHeight(), 32u);
+    rtt->addViewport(mCamera);
+
+    mRenderSystem->resetStatistics();
+    mRoot->renderOneFrame();
+
+    // the window and the texture
+    EXPECT_EQ(mRenderSystem->getStatistics().drawCalls, 4u);
+    EXPECT_EQ(mRenderSystem->getStatistics().clears, 2u);
+
+    // pixel data round trips through the buffer
+    std::vector<uint32> src(64 * 32), dst(64 * 32);
+    for (size_t i = 0; i < src.size(); i++)
+        src[i] = uint32(i * 2654435761u);
+    tex->getBuffer()->blitFromMemory(PixelBox(64, 32, 1, PF_BYTE_RGBA, src.data()));
+    tex->getBuffer()->blitToMemory(PixelBox(64, 32, 1, PF_BYTE_RGBA, dst.data()));
+    EXPECT_EQ(src, dst);
+}
+
+TEST_F(NullRenderSystemTests, FrameCost)
+{
+    // many small batches, all in view
+    const int rows = 25, columns = 40, frames = 20;
+    for (int y = 0; y < rows; y++)
+    {
+        for (int x = 0; x < columns; x++)
+        {
+            SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+            node->setPosition(Real(x - columns / 2) * 12, Real(y - rows / 2) * 12, 0);
+            node->setScale(Vector3(0.1));
+            node->attachObject(mSceneMgr->createEntity(SceneManager::PT_CUBE));
+        }
+    }
+
+    Timer timer;
+    unsigned long sceneGraph = 0, visibility = 0, frame = 0;
+    VisibleObjectsBoundsInfo bounds;
+    for (int i = 0; i < frames; i++)
+    {
+        timer.reset();
+        mSceneMgr->_updateSceneGraph(mCamera);
+        sceneGraph += timer.getMicroseconds();
+
+        mSceneMgr->getRenderQueue()->clear();
+        bounds.reset();
+        timer.reset();
+        mSceneMgr->_findVisibleObjects(mCamera, &bounds, false);
+        visibility += timer.getMicroseconds();
+
+        mRenderSystem->resetStatistics();
+        timer.reset();
+        mRoot->renderOneFrame();
+        frame += timer.getMicroseconds();
+
+        const NullRenderSystem::Statistics& stats = mRenderSystem->getStatistics();
+        EXPECT_EQ(stats.drawCalls, size_t(rows * columns));
+        EXPECT_EQ(stats.elements, size_t(rows * columns * 36));
+        EXPECT_EQ(stats.clears, 1u);
+        EXPECT_EQ(stats.constantUploads, stats.drawCalls);
+        EXPECT_EQ(stats.textureBinds, 0u);
+
+        // all batches share a material, so the state is set once and then stays
+        if (i == 0)
+        {
+            EXPECT_GT(stats.stateChanges, 0u);
+            EXPECT_LT(stats.stateChanges, 32u);
+        }
+        else
+        {
+            EXPECT_EQ(stats.stateChanges, 0u);
+            EXPECT_EQ(stats.renderTargetChanges, 0u);
+            EXPECT_EQ(stats.viewportChanges, 0u);
+        }
+    }
+
+    LogManager::getSingleton().stream()
+        << "NullRenderSystemTests.FrameCost: " << rows * columns << " batches, per frame "
+        << sceneGraph / frames << "us scene graph update, " << visibility / frames
+        << "us visibility, " << frame / frames << "us whole frame";
+}
+
+namespace
+{
+    std::vector<uchar> getVertices(BillboardSet* set)
+    {
+        RenderOperation op;
+        set->getRenderOperation(op);
+        HardwareVertexBufferSharedPtr vbuf = op.vertexData->vertexBufferBinding->getBuffer(0);
+        std::vector<uchar> vertices(op.vertexData->vertexCount * vbuf->getVertexSize());
+        if (!vertices.empty())
+            vbuf->readData(0, vertices.size(), &vertices[0]);
+        return vertices;
+    }
+
+    // BillboardSet needs a render system to convert the vertex colours
+    void checkBillboardsAgainstSerial(Root* root, SceneManager* sceneMgr, bool cullIndividually)
+    {
+        Camera* cam = sceneMgr->createCamera(cullIndividually ? "culling" : "notCulling");
+        cam->setNearClipDistance(1);
+        cam->setFarClipDistance(500);
+        SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+        camNode->attachObject(cam);
+        camNode->setPosition(0, 0, 300);
+
+        // enough billboards to be split in several chunks, spread so culling drops some of them
+        const size_t numBillboards = 10000;
+        BillboardSet* set = sceneMgr->createBillboardSet(numBillboards);
+        set->setCullIndividually(cullIndividually);
+        std::vector<Billboard*> billboards;
+        for (size_t i = 0; i < numBillboards; ++i)
+        {
+            Billboard* bb = set->createBillboard(Math::RangeRandom(-500, 500), Math::RangeRandom(-500, 500),
+                                                 Math::RangeRandom(-500, 500),
+                                                 ColourValue(Math::UnitRandom(), Math::UnitRandom(), 1));
+            bb->setRotation(Degree(Math::RangeRandom(0, 360)));
+            if (i % 3 == 0)
+                bb->setDimensions(Math::RangeRandom(1, 50), Math::RangeRandom(1, 50));
+            billboards.push_back(bb);
+        }
+        SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode();
+        node->attachObject(set);
+        node->setPosition(10, 20, 30);
+        node->yaw(Degree(30));
+        sceneMgr->getRootSceneNode()->_update(true, false);
+        set->_notifyCurrentCamera(cam);
+
+        // one billboard at a time, as before the chunked generation
+        root->getTaskScheduler()->shutdown();
+        set->beginBillboards(numBillboards);
+        for (size_t i = 0; i < numBillboards; ++i)
+            set->injectBillboard(*billboards[i]);
+        set->endBillboards();
+        RenderOperation op;
+        set->getRenderOperation(op);
+        if (cullIndividually)
+            EXPECT_LT(op.vertexData->vertexCount, numBillboards * 4);
+        else
+            EXPECT_EQ(op.vertexData->vertexCount, numBillboards * 4);
+        std::vector<uchar> serial = getVertices(set);
+
+        root->getTaskScheduler()->startup(3);
+        set->_updateRenderQueue(sceneMgr->getRenderQueue());
+        std::vector<uchar> parallel = getVertices(set);
+
+        EXPECT_FALSE(serial.empty());
+        EXPECT_TRUE(serial == parallel);
+    }
+}
+
+TEST_F(NullRenderSystemTests, BillboardSetChunkedMatchesSerial)
+{
+    checkBillboardsAgainstSerial(mRoot, mSceneMgr, false);
+}
+
+TEST_F(NullRenderSystemTests, BillboardSetChunkedMatchesSerialWhenCulling)
+{
+    checkBillboardsAgainstSerial(mRoot, mSceneMgr, true);
+}